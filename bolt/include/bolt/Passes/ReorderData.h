@@ -35,6 +35,12 @@ private:
   sortedByFunc(BinaryContext &BC, const BinarySection &Section,
                std::map<uint64_t, BinaryFunction> &BFs) const;
 
+  /// Sort symbols into clusters keyed by the hottest function referencing
+  /// them, and by weight within a cluster.
+  std::pair<DataOrder, unsigned>
+  sortedByCluster(BinaryContext &BC, const BinarySection &Section,
+                  std::map<uint64_t, BinaryFunction> &BFs) const;
+
   void printOrder(const BinarySection &Section, DataOrder::const_iterator Begin,
                   DataOrder::const_iterator End) const;
 
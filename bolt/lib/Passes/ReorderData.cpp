@@ -16,8 +16,10 @@
 // - estimate temporal locality by looking at CFG?
 
 #include "bolt/Passes/ReorderData.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/MapVector.h"
 #include <algorithm>
+#include <limits>
 
 #undef  DEBUG_TYPE
 #define DEBUG_TYPE "reorder-data"
@@ -44,7 +46,8 @@ ReorderData("reorder-data",
 
 enum ReorderAlgo : char {
   REORDER_COUNT         = 0,
-  REORDER_FUNCS         = 1
+  REORDER_FUNCS         = 1,
+  REORDER_CLUSTER       = 2
 };
 
 static cl::opt<ReorderAlgo>
@@ -57,7 +60,10 @@ ReorderAlgorithm("reorder-data-algo",
       "sort hot data by read counts"),
     clEnumValN(REORDER_FUNCS,
       "funcs",
-      "sort hot data by hot function usage and count")),
+      "sort hot data by hot function usage and count"),
+    clEnumValN(REORDER_CLUSTER,
+      "cluster",
+      "group hot data by the hottest function referencing it")),
   cl::ZeroOrMore,
   cl::cat(BoltOptCategory));
 
@@ -129,6 +135,34 @@ bool filterSymbol(const BinaryData *BD) {
   return IsValid;
 }
 
+/// Return the data objects referenced by memory accesses sampled in \p BF,
+/// optionally ignoring cold blocks.
+std::set<BinaryData *> getDataUses(const BinaryContext &BC,
+                                   const BinaryFunction &BF, bool OnlyHot) {
+  std::set<BinaryData *> Uses;
+  for (const BinaryBasicBlock &BB : BF) {
+    if (OnlyHot && BB.isCold())
+      continue;
+
+    for (const MCInst &Inst : BB) {
+      auto ErrorOrMemAccessProfile =
+          BC.MIB->tryGetAnnotationAs<MemoryAccessProfile>(
+              Inst, "MemoryAccessProfile");
+      if (!ErrorOrMemAccessProfile)
+        continue;
+
+      const MemoryAccessProfile &MemAccessProfile =
+          ErrorOrMemAccessProfile.get();
+      for (const AddressAccess &AccessInfo :
+           MemAccessProfile.AddressAccessInfo) {
+        if (AccessInfo.MemoryObject)
+          Uses.insert(AccessInfo.MemoryObject);
+      }
+    }
+  }
+  return Uses;
+}
+
 } // namespace
 
 using DataOrder = ReorderData::DataOrder;
@@ -232,35 +266,10 @@ ReorderData::sortedByFunc(BinaryContext &BC, const BinarySection &Section,
   std::map<BinaryData *, std::set<BinaryFunction *>> BDtoFunc;
   std::map<BinaryData *, uint64_t> BDtoFuncCount;
 
-  auto dataUses = [&BC](const BinaryFunction &BF, bool OnlyHot) {
-    std::set<BinaryData *> Uses;
-    for (const BinaryBasicBlock &BB : BF) {
-      if (OnlyHot && BB.isCold())
-        continue;
-
-      for (const MCInst &Inst : BB) {
-        auto ErrorOrMemAccessProfile =
-            BC.MIB->tryGetAnnotationAs<MemoryAccessProfile>(
-                Inst, "MemoryAccessProfile");
-        if (!ErrorOrMemAccessProfile)
-          continue;
-
-        const MemoryAccessProfile &MemAccessProfile =
-            ErrorOrMemAccessProfile.get();
-        for (const AddressAccess &AccessInfo :
-             MemAccessProfile.AddressAccessInfo) {
-          if (AccessInfo.MemoryObject)
-            Uses.insert(AccessInfo.MemoryObject);
-        }
-      }
-    }
-    return Uses;
-  };
-
   for (auto &Entry : BFs) {
     BinaryFunction &BF = Entry.second;
     if (BF.hasValidProfile()) {
-      for (BinaryData *BD : dataUses(BF, true)) {
+      for (BinaryData *BD : getDataUses(BC, BF, /*OnlyHot=*/true)) {
         if (!BC.getFunctionForSymbol(BD->getSymbol())) {
           BDtoFunc[BD->getAtomicRoot()].insert(&BF);
           BDtoFuncCount[BD->getAtomicRoot()] += BF.getKnownExecutionCount();
@@ -298,6 +307,66 @@ ReorderData::sortedByFunc(BinaryContext &BC, const BinarySection &Section,
   return std::make_pair(Order, SplitPoint);
 }
 
+/// Place objects next to the other objects used by the hottest function that
+/// references them. Objects accessed together from the same code then share
+/// cache lines and pages, which a global sort by count does not guarantee.
+std::pair<DataOrder, unsigned>
+ReorderData::sortedByCluster(BinaryContext &BC, const BinarySection &Section,
+                             std::map<uint64_t, BinaryFunction> &BFs) const {
+  std::vector<const BinaryFunction *> HotFuncs;
+  for (auto &Entry : BFs) {
+    const BinaryFunction &BF = Entry.second;
+    if (BF.hasValidProfile() && BF.getKnownExecutionCount())
+      HotFuncs.push_back(&BF);
+  }
+  llvm::stable_sort(HotFuncs,
+                    [](const BinaryFunction *A, const BinaryFunction *B) {
+                      return A->getKnownExecutionCount() >
+                             B->getKnownExecutionCount();
+                    });
+
+  // Cluster index of each object, i.e. the rank of the hottest function
+  // referencing it.
+  DenseMap<const BinaryData *, unsigned> BDtoCluster;
+  for (unsigned Idx = 0; Idx < HotFuncs.size(); ++Idx)
+    for (BinaryData *BD : getDataUses(BC, *HotFuncs[Idx], /*OnlyHot=*/true))
+      if (!BC.getFunctionForSymbol(BD->getSymbol()))
+        BDtoCluster.try_emplace(BD->getAtomicRoot(), Idx);
+
+  constexpr unsigned NoCluster = std::numeric_limits<unsigned>::max();
+  auto getCluster = [&](const BinaryData *BD) {
+    auto Itr = BDtoCluster.find(BD);
+    return Itr == BDtoCluster.end() ? NoCluster : Itr->second;
+  };
+
+  DataOrder Order = baseOrder(BC, Section);
+  unsigned SplitPoint = Order.size();
+
+  llvm::sort(
+      Order,
+      [&](const DataOrder::value_type &A, const DataOrder::value_type &B) {
+        const unsigned ACluster = getCluster(A.first);
+        const unsigned BCluster = getCluster(B.first);
+        // Weight by number of loads/data size.
+        const double AWeight = double(A.second) / A.first->getSize();
+        const double BWeight = double(B.second) / B.first->getSize();
+        return (ACluster < BCluster ||
+                (ACluster == BCluster &&
+                 (AWeight > BWeight ||
+                  (AWeight == BWeight &&
+                   A.first->getAddress() < B.first->getAddress()))));
+      });
+
+  for (unsigned Idx = 0; Idx < Order.size(); ++Idx) {
+    if (getCluster(Order[Idx].first) == NoCluster) {
+      SplitPoint = Idx;
+      break;
+    }
+  }
+
+  return std::make_pair(Order, SplitPoint);
+}
+
 std::pair<DataOrder, unsigned>
 ReorderData::sortedByCount(BinaryContext &BC,
                            const BinarySection &Section) const {
@@ -485,10 +554,14 @@ void ReorderData::runOnFunctions(BinaryContext &BC) {
     if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_COUNT) {
       outs() << "BOLT-INFO: reorder-sections: ordering data by count\n";
       std::tie(Order, SplitPointIdx) = sortedByCount(BC, *Section);
-    } else {
+    } else if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_FUNCS) {
       outs() << "BOLT-INFO: reorder-sections: ordering data by funcs\n";
       std::tie(Order, SplitPointIdx) =
           sortedByFunc(BC, *Section, BC.getBinaryFunctions());
+    } else {
+      outs() << "BOLT-INFO: reorder-sections: clustering data by funcs\n";
+      std::tie(Order, SplitPointIdx) =
+          sortedByCluster(BC, *Section, BC.getBinaryFunctions());
     }
     auto SplitPoint = Order.begin() + SplitPointIdx;
 
@@ -38,11 +38,13 @@ from __future__ import print_function
 
 import argparse
 import glob
+import hashlib
 import json
 import multiprocessing
 import os
 import queue
 import re
+import shlex
 import shutil
 import subprocess
 import sys
@@ -207,7 +209,109 @@ def apply_fixes(args, clang_apply_replacements_binary, tmpdir):
     subprocess.call(invocation)
 
 
-def run_tidy(args, clang_tidy_binary, tmpdir, build_path, queue, lock, failed_files):
+def get_dependency_invocation(entry):
+    """Turns a compilation database entry into a command that writes the list
+    of files the translation unit reads to stdout, in Makefile syntax."""
+    if "arguments" in entry:
+        command = list(entry["arguments"])
+    else:
+        command = shlex.split(entry["command"])
+    result = [command[0]]
+    args = iter(command[1:])
+    for arg in args:
+        # Drop the outputs of the real compilation, including dependency files.
+        if arg in ("-o", "-MF", "-MT", "-MQ"):
+            next(args, None)
+        elif arg in ("-c", "-MD", "-MMD") or arg.startswith("-o"):
+            continue
+        else:
+            result.append(arg)
+    return result + ["-M", "-o", "-"]
+
+
+def parse_dependencies(output):
+    """Splits Makefile-style dependency output into the file names after the
+    target."""
+    text = output.decode("utf-8", "surrogateescape").replace("\\\n", " ")
+    _, _, deps = text.partition(": ")
+    files = []
+    current = ""
+    i = 0
+    while i < len(deps):
+        char = deps[i]
+        # Only spaces and '#' are escaped, so that Windows paths keep their
+        # backslashes.
+        if char == "\\" and i + 1 < len(deps) and deps[i + 1] in " #":
+            current += deps[i + 1]
+            i += 1
+        elif char.isspace():
+            if current:
+                files.append(current)
+            current = ""
+        else:
+            current += char
+        i += 1
+    if current:
+        files.append(current)
+    return files
+
+
+def get_cache_key(entry, invocation, clang_tidy_version):
+    """Hashes everything that the diagnostics for a file depend on: the
+    compile command, the contents of the main file and of every file it
+    includes, the clang-tidy command line and version, and the configuration
+    in effect for the file. The sources are hashed as written, so changes to
+    comments such as NOLINT and to macro spellings are seen. Returns None if
+    the dependencies of the file can't be computed."""
+    key = hashlib.sha256()
+    key.update(clang_tidy_version)
+    for arg in invocation:
+        key.update(arg.encode("utf-8") + b"\0")
+
+    config_invocation = invocation[:-1] + ["-dump-config", invocation[-1]]
+    proc = subprocess.run(
+        config_invocation,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.DEVNULL,
+    )
+    if proc.returncode != 0:
+        return None
+    key.update(proc.stdout)
+
+    dependency_invocation = get_dependency_invocation(entry)
+    for arg in dependency_invocation:
+        key.update(arg.encode("utf-8") + b"\0")
+    proc = subprocess.run(
+        dependency_invocation,
+        cwd=entry["directory"],
+        stdout=subprocess.PIPE,
+        stderr=subprocess.DEVNULL,
+    )
+    if proc.returncode != 0:
+        return None
+    for name in parse_dependencies(proc.stdout):
+        path = os.path.join(entry["directory"], name)
+        try:
+            with open(path, "rb") as f:
+                contents = f.read()
+        except OSError:
+            return None
+        key.update(name.encode("utf-8", "surrogateescape") + b"\0")
+        key.update(hashlib.sha256(contents).digest())
+    return key.hexdigest()
+
+
+def run_tidy(
+    args,
+    clang_tidy_binary,
+    tmpdir,
+    build_path,
+    queue,
+    lock,
+    failed_files,
+    entries,
+    clang_tidy_version,
+):
     """Takes filenames out of queue and runs clang-tidy on them."""
     while True:
         name = queue.get()
@@ -230,13 +334,68 @@ def run_tidy(args, clang_tidy_binary, tmpdir, build_path, queue, lock, failed_fi
             args.warnings_as_errors,
         )
 
-        proc = subprocess.Popen(
-            invocation, stdout=subprocess.PIPE, stderr=subprocess.PIPE
-        )
-        output, err = proc.communicate()
-        if proc.returncode != 0:
-            if proc.returncode < 0:
-                msg = "%s: terminated by signal %d\n" % (name, -proc.returncode)
+        # The fixes file has a fresh name each time, so it is left out of the
+        # key.
+        fixes_file = None
+        key_invocation = invocation
+        if tmpdir is not None:
+            fixes_index = invocation.index("-export-fixes") + 1
+            fixes_file = invocation[fixes_index]
+            key_invocation = (
+                invocation[: fixes_index - 1] + invocation[fixes_index + 1 :]
+            )
+
+        cache_file = None
+        if args.cache_dir:
+            key = get_cache_key(entries[name], key_invocation, clang_tidy_version)
+            if key is not None:
+                cache_file = os.path.join(args.cache_dir, key + ".json")
+
+        cached = None
+        if cache_file and os.path.isfile(cache_file):
+            try:
+                with open(cache_file, "r") as f:
+                    cached = json.load(f)
+            except (OSError, ValueError):
+                cached = None
+
+        if cached is not None:
+            returncode = cached["returncode"]
+            output = cached["stdout"].encode("utf-8")
+            err = cached["stderr"].encode("utf-8")
+            if fixes_file is not None:
+                with open(fixes_file, "w") as f:
+                    f.write(cached["fixes"])
+        else:
+            proc = subprocess.Popen(
+                invocation, stdout=subprocess.PIPE, stderr=subprocess.PIPE
+            )
+            output, err = proc.communicate()
+            returncode = proc.returncode
+            # Results from crashed runs are not worth keeping.
+            if cache_file and returncode >= 0:
+                fixes = ""
+                if fixes_file is not None and os.path.isfile(fixes_file):
+                    with open(fixes_file, "r") as f:
+                        fixes = f.read()
+                result = {
+                    "returncode": returncode,
+                    "stdout": output.decode("utf-8"),
+                    "stderr": err.decode("utf-8"),
+                    "fixes": fixes,
+                }
+                # Write to a temporary file first so that concurrent runs never
+                # read a partial result.
+                (handle, tmp_name) = tempfile.mkstemp(
+                    suffix=".tmp", dir=args.cache_dir
+                )
+                with os.fdopen(handle, "w") as f:
+                    json.dump(result, f)
+                os.replace(tmp_name, cache_file)
+
+        if returncode != 0:
+            if returncode < 0:
+                msg = "%s: terminated by signal %d\n" % (name, -returncode)
                 err += msg.encode("utf-8")
             failed_files.append(name)
         with lock:
@@ -372,6 +531,14 @@ def main():
         default=None,
         help="Upgrades warnings to errors. Same format as " "'-checks'",
     )
+    parser.add_argument(
+        "-cache-dir",
+        default=None,
+        help="Directory in which to cache the results of each run. A file "
+        "is only checked again if its compile command, its contents or "
+        "those of the files it includes, the configuration in effect for "
+        "it, the command line or the clang-tidy version have changed.",
+    )
     args = parser.parse_args()
 
     db_path = "compile_commands.json"
@@ -424,9 +591,15 @@ def main():
 
     # Load the database and extract all files.
     database = json.load(open(os.path.join(build_path, db_path)))
-    files = set(
-        [make_absolute(entry["file"], entry["directory"]) for entry in database]
-    )
+    entries = {
+        make_absolute(entry["file"], entry["directory"]): entry for entry in database
+    }
+    files = set(entries)
+
+    clang_tidy_version = None
+    if args.cache_dir:
+        os.makedirs(args.cache_dir, exist_ok=True)
+        clang_tidy_version = subprocess.check_output([clang_tidy_binary, "--version"])
 
     max_task = args.j
     if max_task == 0:
@@ -453,6 +626,8 @@ def main():
                     task_queue,
                     lock,
                     failed_files,
+                    entries,
+                    clang_tidy_version,
                 ),
             )
             t.daemon = True
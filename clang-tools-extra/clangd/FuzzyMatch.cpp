@@ -182,20 +182,22 @@ bool FuzzyMatcher::init(llvm::StringRef NewWord) {
   WordN = std::min<int>(MaxWord, NewWord.size());
   if (PatN > WordN)
     return false;
-  std::copy(NewWord.begin(), NewWord.begin() + WordN, Word);
-  if (PatN == 0)
-    return true;
-  for (int I = 0; I < WordN; ++I)
-    LowWord[I] = lower(Word[I]);
 
-  // Cheap subsequence check.
+  // Cheap subsequence check. Most candidates fail it, so it reads NewWord
+  // directly rather than waiting for the copies below.
   for (int W = 0, P = 0; P != PatN; ++W) {
     if (W == WordN)
       return false;
-    if (LowWord[W] == LowPat[P])
+    if (lower(NewWord[W]) == LowPat[P])
       ++P;
   }
 
+  std::copy(NewWord.begin(), NewWord.begin() + WordN, Word);
+  if (PatN == 0)
+    return true;
+  for (int I = 0; I < WordN; ++I)
+    LowWord[I] = lower(Word[I]);
+
   // FIXME: some words are hard to tokenize algorithmically.
   // e.g. vsprintf is V S Print F, and should match [pri] but not [int].
   // We could add a tokenization dictionary for common stdlib names.
@@ -6,8 +6,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "../FuzzyMatch.h"
 #include "../index/Serialization.h"
 #include "../index/dex/Dex.h"
+#include "../index/dex/Trigram.h"
 #include "benchmark/benchmark.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -97,6 +99,53 @@ static void dexBuild(benchmark::State &State) {
 }
 BENCHMARK(dexBuild);
 
+// Reads the names of all symbols in the index.
+std::vector<std::string> readSymbolNames() {
+  auto Buffer = llvm::MemoryBuffer::getFile(IndexFilename);
+  if (!Buffer) {
+    llvm::errs() << "Error cannot open index file: " << IndexFilename << ": "
+                 << Buffer.getError().message() << "\n";
+    exit(1);
+  }
+  auto Index = readIndexFile(Buffer.get()->getBuffer(), SymbolOrigin::Static);
+  if (!Index || !Index->Symbols) {
+    llvm::errs() << "Error when reading index file: " << IndexFilename << "\n";
+    exit(1);
+  }
+  std::vector<std::string> Names;
+  for (const auto &Sym : *Index->Symbols)
+    Names.push_back(Sym.Name.str());
+  return Names;
+}
+
+// Scores every symbol name against each query, as code completion does for
+// the candidates it gets back from the index.
+static void fuzzyMatch(benchmark::State &State) {
+  const auto Names = readSymbolNames();
+  const auto Requests = extractQueriesFromLogs();
+  for (auto _ : State)
+    for (const auto &Request : Requests) {
+      FuzzyMatcher Matcher(Request.Query);
+      for (const auto &Name : Names)
+        benchmark::DoNotOptimize(Matcher.match(Name));
+    }
+  State.SetItemsProcessed(State.iterations() * Requests.size() *
+                          Names.size());
+}
+BENCHMARK(fuzzyMatch);
+
+static void identifierTrigrams(benchmark::State &State) {
+  const auto Names = readSymbolNames();
+  std::vector<dex::Trigram> Trigrams;
+  for (auto _ : State)
+    for (const auto &Name : Names) {
+      dex::generateIdentifierTrigrams(Name, Trigrams);
+      benchmark::DoNotOptimize(Trigrams.data());
+    }
+  State.SetItemsProcessed(State.iterations() * Names.size());
+}
+BENCHMARK(identifierTrigrams);
+
 } // namespace
 } // namespace clangd
 } // namespace clang
@@ -12,6 +12,9 @@
 
 #include "CompileCommands.h"
 #include "Compiler.h"
+#include "URI.h"
+#include "index/Background.h"
+#include "index/FileIndex.h"
 #include "index/IndexAction.h"
 #include "index/Merge.h"
 #include "index/Ref.h"
@@ -23,6 +26,7 @@
 #include "clang/Tooling/Execution.h"
 #include "clang/Tooling/Tooling.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Signals.h"
 #include <utility>
 
@@ -38,23 +42,27 @@ static llvm::cl::opt<IndexFileFormat>
                                        "binary RIFF format")),
            llvm::cl::init(IndexFileFormat::RIFF));
 
+static llvm::cl::opt<std::string> ShardRoot(
+    "shard-root",
+    llvm::cl::desc(
+        "Instead of writing one index to stdout, write a shard for each file "
+        "to <shard-root>/.cache/clangd/index, where clangd's background index "
+        "for a project rooted at <shard-root> loads it from. clangd then only "
+        "reindexes the files whose contents differ from the indexed ones."),
+    llvm::cl::init(""));
+
 class IndexActionFactory : public tooling::FrontendActionFactory {
 public:
-  IndexActionFactory(IndexFileIn &Result) : Result(Result) {}
+  IndexActionFactory(IndexFileIn &Result) : Result(Result) {
+    if (!ShardRoot.empty())
+      ShardStorage = BackgroundIndexStorage::createDiskBackedStorageFactory(
+          [](PathRef) { return ProjectInfo{ShardRoot}; });
+  }
 
   std::unique_ptr<FrontendAction> create() override {
     SymbolCollector::Options Opts;
     Opts.CountReferences = true;
-    Opts.FileFilter = [&](const SourceManager &SM, FileID FID) {
-      const auto F = SM.getFileEntryRefForID(FID);
-      if (!F)
-        return false; // Skip invalid files.
-      auto AbsPath = getCanonicalPath(*F, SM.getFileManager());
-      if (!AbsPath)
-        return false; // Skip files without absolute path.
-      std::lock_guard<std::mutex> Lock(FilesMu);
-      return Files.insert(*AbsPath).second; // Skip already processed files.
-    };
+    Opts.FileFilter = makeFileFilter(/*OwnedFiles=*/nullptr);
     return createStaticIndexingAction(
         Opts,
         [&](SymbolSlab S) {
@@ -89,10 +97,21 @@ public:
                      std::shared_ptr<PCHContainerOperations> PCHContainerOps,
                      DiagnosticConsumer *DiagConsumer) override {
     disableUnsupportedOptions(*Invocation);
+    if (ShardStorage)
+      return runShardingInvocation(std::move(Invocation), Files,
+                                   std::move(PCHContainerOps), DiagConsumer);
     return tooling::FrontendActionFactory::runInvocation(
         std::move(Invocation), Files, std::move(PCHContainerOps), DiagConsumer);
   }
 
+  // Records the command line of a TU, to be stored in the shard of its main
+  // file as BackgroundIndex does.
+  void recordCommandLine(llvm::StringRef File,
+                         const std::vector<std::string> &CommandLine) {
+    std::lock_guard<std::mutex> Lock(CommandLinesMu);
+    CommandLines[getAbsolutePath("", File)] = CommandLine;
+  }
+
   // Awkward: we write the result in the destructor, because the executor
   // takes ownership so it's the easiest way to get our data back out.
   ~IndexActionFactory() {
@@ -102,6 +121,125 @@ public:
   }
 
 private:
+  // Returns a filter that skips files already indexed by another TU. Files
+  // that pass the filter are added to OwnedFiles, if it is not null.
+  std::function<bool(const SourceManager &, FileID)>
+  makeFileFilter(llvm::StringSet<> *OwnedFiles) {
+    return [this, OwnedFiles](const SourceManager &SM, FileID FID) {
+      const auto F = SM.getFileEntryRefForID(FID);
+      if (!F)
+        return false; // Skip invalid files.
+      auto AbsPath = getCanonicalPath(*F, SM.getFileManager());
+      if (!AbsPath)
+        return false; // Skip files without absolute path.
+      std::lock_guard<std::mutex> Lock(FilesMu);
+      if (!Files.insert(*AbsPath).second)
+        return false; // Skip already processed files.
+      if (OwnedFiles)
+        OwnedFiles->insert(*AbsPath);
+      return true;
+    };
+  }
+
+  // Indexes a TU the way BackgroundIndex::index() does, and writes shards for
+  // the files it owns, in the same format and location. Shards of files owned
+  // by other TUs are left alone, as they would be empty here.
+  bool runShardingInvocation(
+      std::shared_ptr<CompilerInvocation> Invocation, FileManager *Files,
+      std::shared_ptr<PCHContainerOperations> PCHContainerOps,
+      DiagnosticConsumer *DiagConsumer) {
+    IndexFileIn TU;
+    TU.Cmd = getCompileCommand(*Invocation, *Files);
+
+    CompilerInstance Compiler(std::move(PCHContainerOps));
+    Compiler.setInvocation(std::move(Invocation));
+    Compiler.setFileManager(Files);
+
+    SymbolCollector::Options Opts;
+    Opts.CountReferences = true;
+    Opts.CollectMainFileRefs = true;
+    llvm::StringSet<> OwnedFiles;
+    Opts.FileFilter = makeFileFilter(&OwnedFiles);
+    // The action must be destroyed before the compiler instance.
+    std::unique_ptr<FrontendAction> Action = createStaticIndexingAction(
+        Opts, [&](SymbolSlab S) { TU.Symbols = std::move(S); },
+        [&](RefSlab R) { TU.Refs = std::move(R); },
+        [&](RelationSlab R) { TU.Relations = std::move(R); },
+        [&](IncludeGraph IG) { TU.Sources = std::move(IG); });
+
+    Compiler.createDiagnostics(DiagConsumer, /*ShouldOwnClient=*/false);
+    if (!Compiler.hasDiagnostics())
+      return false;
+    Compiler.createSourceManager(*Files);
+    const bool Success = Compiler.ExecuteAction(*Action);
+    Files->clearStatCache();
+    if (!TU.Sources)
+      return Success;
+
+    if (Compiler.getDiagnostics().hasUncompilableErrorOccurred()) {
+      log("Failed to compile {0}, index may be incomplete", TU.Cmd->Filename);
+      for (auto &It : *TU.Sources)
+        It.second.Flags |= IncludeGraphNode::SourceFlag::HadErrors;
+    }
+    writeShards(std::move(TU), OwnedFiles);
+    return Success;
+  }
+
+  static std::string getAbsolutePath(llvm::StringRef Directory,
+                                     llvm::StringRef File) {
+    llvm::SmallString<128> Path;
+    if (!llvm::sys::path::is_absolute(File))
+      Path = Directory;
+    llvm::sys::path::append(Path, File);
+    llvm::sys::path::remove_dots(Path, /*remove_dot_dot=*/true);
+    return std::string(Path);
+  }
+
+  tooling::CompileCommand getCompileCommand(const CompilerInvocation &CI,
+                                            FileManager &Files) {
+    tooling::CompileCommand Cmd;
+    if (auto CWD = Files.getVirtualFileSystem().getCurrentWorkingDirectory())
+      Cmd.Directory = std::move(*CWD);
+    if (!CI.getFrontendOpts().Inputs.empty())
+      Cmd.Filename = getAbsolutePath(
+          Cmd.Directory, CI.getFrontendOpts().Inputs.front().getFile());
+    std::lock_guard<std::mutex> Lock(CommandLinesMu);
+    auto It = CommandLines.find(Cmd.Filename);
+    if (It != CommandLines.end())
+      Cmd.CommandLine = It->second;
+    return Cmd;
+  }
+
+  void writeShards(IndexFileIn TU, const llvm::StringSet<> &OwnedFiles) {
+    // Keys are URIs.
+    llvm::StringMap<std::pair<std::string, bool>> FilesToWrite;
+    for (const auto &It : *TU.Sources) {
+      const IncludeGraphNode &IGN = It.getValue();
+      auto AbsPath = URI::resolve(IGN.URI);
+      if (!AbsPath) {
+        elog("Failed to resolve URI: {0}", AbsPath.takeError());
+        continue;
+      }
+      if (OwnedFiles.contains(*AbsPath))
+        FilesToWrite[It.getKey()] = {
+            std::move(*AbsPath),
+            bool(IGN.Flags & IncludeGraphNode::SourceFlag::IsTU)};
+    }
+
+    FileShardedIndex ShardedIndex(std::move(TU));
+    for (const auto &FileIt : FilesToWrite) {
+      auto IF = ShardedIndex.getShard(FileIt.getKey());
+      assert(IF && "no shard for file in Sources?");
+      PathRef Path = FileIt.getValue().first;
+      // Only store command line hash for main files of the TU, since our
+      // current model keeps only one version of a header file.
+      if (!FileIt.getValue().second)
+        IF->Cmd.reset();
+      if (auto Err = ShardStorage(Path)->storeShard(Path, *IF))
+        elog("Failed to write shard for file {0}: {1}", Path, std::move(Err));
+    }
+  }
+
   IndexFileIn &Result;
   std::mutex FilesMu;
   llvm::StringSet<> Files;
@@ -111,6 +249,9 @@ private:
   RefSlab::Builder Refs;
   std::mutex RelsMu;
   RelationSlab::Builder Relations;
+  BackgroundIndexStorage::Factory ShardStorage;
+  std::mutex CommandLinesMu;
+  llvm::StringMap<std::vector<std::string>> CommandLines;
 };
 
 } // namespace
@@ -131,6 +272,10 @@ int main(int argc, const char **argv) {
 
   $ clangd-indexer File1.cpp File2.cpp ... FileN.cpp > clangd.dex
 
+  Example usage for writing background-index shards, e.g. in CI:
+
+  $ clangd-indexer --executor=all-TUs --shard-root=$PWD compile_commands.json
+
   Note: only symbols from header files will be indexed.
   )";
 
@@ -144,21 +289,30 @@ int main(int argc, const char **argv) {
 
   // Collect symbols found in each translation unit, merging as we go.
   clang::clangd::IndexFileIn Data;
+  auto Factory = std::make_unique<clang::clangd::IndexActionFactory>(Data);
+  auto *FactoryPtr = Factory.get();
   auto Err = Executor->get()->execute(
-      std::make_unique<clang::clangd::IndexActionFactory>(Data),
+      std::move(Factory),
       clang::tooling::ArgumentsAdjuster(
           [Mangler = std::make_shared<clang::clangd::CommandMangler>(
-               clang::clangd::CommandMangler::detect())](
-              const std::vector<std::string> &Args, llvm::StringRef File) {
+               clang::clangd::CommandMangler::detect()),
+           FactoryPtr](const std::vector<std::string> &Args,
+                       llvm::StringRef File) {
             clang::tooling::CompileCommand Cmd;
             Cmd.CommandLine = Args;
             Mangler->operator()(Cmd, File);
+            if (!clang::clangd::ShardRoot.empty())
+              FactoryPtr->recordCommandLine(File, Cmd.CommandLine);
             return Cmd.CommandLine;
           }));
   if (Err) {
     clang::clangd::elog("{0}", std::move(Err));
   }
 
+  // Shards have been written as each TU finished.
+  if (!clang::clangd::ShardRoot.empty())
+    return 0;
+
   // Emit collected data.
   clang::clangd::IndexFileOut Out(Data);
   Out.Format = clang::clangd::Format;
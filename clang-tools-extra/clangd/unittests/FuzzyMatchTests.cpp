@@ -284,6 +284,26 @@ TEST(FuzzyMatch, InitialismAndPrefix) {
   EXPECT_THAT("up", matches("[up]per_bound", 1.f));
 }
 
+// Candidates that fail the subsequence check are rejected before the matcher
+// copies them, so nothing of theirs may leak into the next candidate.
+TEST(FuzzyMatch, ReuseAfterRejection) {
+  FuzzyMatcher Fresh("TEdit");
+  auto Expected = Fresh.match("TextEditor");
+  ASSERT_TRUE(Expected);
+
+  FuzzyMatcher Reused("TEdit");
+  EXPECT_FALSE(Reused.match("EditorText"));
+  EXPECT_FALSE(Reused.match("TEXT_EDI"));
+  EXPECT_FALSE(Reused.match("Text"));
+  EXPECT_EQ(Reused.match("TextEditor"), Expected);
+
+  // The check only reads the first MaxWord characters of the candidate.
+  std::string Long(200, 'x');
+  Long.replace(150, 5, "tedit");
+  EXPECT_FALSE(Reused.match(Long));
+  EXPECT_TRUE(Reused.match("tedit" + Long));
+}
+
 // Returns pretty-printed segmentation of Text.
 // e.g. std::basic_string --> +--  +---- +-----
 std::string segment(llvm::StringRef Text) {
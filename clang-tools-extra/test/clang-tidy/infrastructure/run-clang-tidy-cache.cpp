@@ -0,0 +1,36 @@
+// RUN: rm -rf %t
+// RUN: mkdir %t
+// RUN: echo "[{\"directory\":\".\",\"command\":\"clang++ -c %/t/test.cpp\",\"file\":\"%/t/test.cpp\"}]" | sed -e 's/\\/\\\\/g' > %t/compile_commands.json
+// RUN: echo "Checks: '-*,modernize-use-auto'" > %t/.clang-tidy
+// RUN: echo "WarningsAsErrors: '*'" >> %t/.clang-tidy
+// RUN: echo "CheckOptions:" >> %t/.clang-tidy
+// RUN: echo "  - key:             modernize-use-auto.MinTypeNameLength" >> %t/.clang-tidy
+// RUN: echo "    value:           '0'" >> %t/.clang-tidy
+// RUN: cp "%s" "%t/test.cpp"
+// RUN: cd "%t"
+// RUN: not %run_clang_tidy -cache-dir=%t/cache "test.cpp" | FileCheck %s
+// RUN: ls %t/cache | count 1
+
+// A cache hit replays the stored output and failure without running
+// clang-tidy. Mark the stored output to tell the replay apart from a rerun.
+// RUN: sed -i -e 's/modernize-use-auto/CACHED/' %t/cache/*.json
+// RUN: not %run_clang_tidy -cache-dir=%t/cache "test.cpp" | \
+// RUN:   FileCheck %s --check-prefix=HIT
+// RUN: ls %t/cache | count 1
+
+// Only a comment changes; the preprocessed file stays the same, but the
+// cached result must not be reused.
+// RUN: sed -e 's/new int();$/new int(); \/\/ NOLINT/' "%s" > "%t/test.cpp"
+// RUN: %run_clang_tidy -cache-dir=%t/cache "test.cpp" | \
+// RUN:   FileCheck %s --check-prefix=MISS
+// RUN: ls %t/cache | count 2
+
+// CHECK: use auto when initializing with new {{.*}}[modernize-use-auto
+// HIT:   use auto when initializing with new {{.*}}[CACHED
+// MISS-NOT: use auto
+
+int main()
+{
+  int* x = new int();
+  delete x;
+}
@@ -0,0 +1,104 @@
+//===- LexerBenchmark.cpp - Raw lexing throughput -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures how fast the raw lexer gets through a corpus of source files. Set
+// CLANG_LEXER_BENCHMARK_INPUTS to a list of files separated by the platform's
+// path list separator (e.g. a handful of large system headers) to lex those;
+// otherwise a synthetic header is used.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Lex/Lexer.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/Program.h"
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace clang;
+using namespace llvm;
+
+static std::string makeSyntheticHeader() {
+  std::string Buf;
+  for (unsigned I = 0; I != 2000; ++I) {
+    std::string N = std::to_string(I);
+    Buf += "// Returns the number of elements in the given container, which is\n"
+           "// never negative for any well-formed container_type_" + N + ".\n";
+    Buf += "template <typename container_type_" + N + ">\n"
+           "static inline unsigned long long get_number_of_elements_" + N +
+           "(const container_type_" + N + " &the_container) {\n";
+    Buf += "    static const char message[] = \"an unusually long message that "
+           "describes element " + N + " in detail\\n\";\n";
+    Buf += "    auto literal = R\"(a raw string with a ) inside of it)\";\n";
+    Buf += "    return the_container.size() + sizeof(message) + " + N + ";\n"
+           "}\n\n";
+  }
+  return Buf;
+}
+
+static const std::vector<std::unique_ptr<MemoryBuffer>> &getInputs() {
+  static const std::vector<std::unique_ptr<MemoryBuffer>> Inputs = [] {
+    std::vector<std::unique_ptr<MemoryBuffer>> Result;
+    if (std::optional<std::string> Paths =
+            sys::Process::GetEnv("CLANG_LEXER_BENCHMARK_INPUTS")) {
+      SmallVector<StringRef, 16> Split;
+      StringRef(*Paths).split(Split, sys::EnvPathSeparator, -1,
+                              /*KeepEmpty=*/false);
+      for (StringRef Path : Split)
+        if (ErrorOr<std::unique_ptr<MemoryBuffer>> Buf =
+                MemoryBuffer::getFile(Path))
+          Result.push_back(std::move(*Buf));
+    }
+    if (Result.empty())
+      Result.push_back(MemoryBuffer::getMemBufferCopy(makeSyntheticHeader(),
+                                                      "<synthetic>"));
+    return Result;
+  }();
+  return Inputs;
+}
+
+static void lexInputs(benchmark::State &State, bool KeepWhitespace) {
+  LangOptions LangOpts;
+  LangOpts.CPlusPlus = LangOpts.CPlusPlus11 = LangOpts.CPlusPlus17 = true;
+  LangOpts.LineComment = true;
+  uint64_t Bytes = 0;
+  for (auto _ : State) {
+    for (const std::unique_ptr<MemoryBuffer> &Input : getInputs()) {
+      StringRef Buf = Input->getBuffer();
+      Lexer L(SourceLocation(), LangOpts, Buf.begin(), Buf.begin(),
+              Buf.end());
+      L.SetKeepWhitespaceMode(KeepWhitespace);
+      Token Tok;
+      unsigned NumTokens = 0;
+      while (!L.LexFromRawLexer(Tok))
+        ++NumTokens;
+      benchmark::DoNotOptimize(NumTokens);
+      Bytes += Buf.size();
+    }
+  }
+  State.SetBytesProcessed(Bytes);
+}
+
+static void BM_RawLex(benchmark::State &State) { lexInputs(State, false); }
+BENCHMARK(BM_RawLex);
+
+// Keeping whitespace and comments exercises the comment and whitespace
+// scanners without the token-forming work around them.
+static void BM_RawLexKeepWhitespace(benchmark::State &State) {
+  lexInputs(State, true);
+}
+BENCHMARK(BM_RawLexKeepWhitespace);
+
+BENCHMARK_MAIN();
@@ -209,6 +209,11 @@ private:
   void lazyInitImporterSharedSt(TranslationUnitDecl *ToTU);
   ASTImporter &getOrCreateASTImporter(ASTUnit *Unit);
   template <typename T>
+  llvm::Expected<const T *> getCrossTUDefinitionCached(const T *D,
+                                                       StringRef CrossTUDir,
+                                                       StringRef IndexName,
+                                                       bool DisplayCTUProgress);
+  template <typename T>
   llvm::Expected<const T *> getCrossTUDefinitionImpl(const T *D,
                                                      StringRef CrossTUDir,
                                                      StringRef IndexName,
@@ -224,6 +229,11 @@ private:
 
   ImporterMapTy ASTUnitImporterMap;
 
+  /// Canonical declarations for which looking up or importing the definition
+  /// failed in a way that won't change during the analysis of this TU, mapped
+  /// to the reason. The analyzer asks again for every call it evaluates.
+  llvm::DenseMap<const Decl *, index_error_code> FailedDefinitionLookups;
+
   ASTContext &Context;
   std::shared_ptr<ASTImporterSharedState> ImporterSharedSt;
 
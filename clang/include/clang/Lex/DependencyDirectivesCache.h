@@ -0,0 +1,67 @@
+//===- clang/Lex/DependencyDirectivesCache.h --------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines an on-disk cache of the output of
+/// scanSourceForDependencyDirectives() that can be shared between processes.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_DEPENDENCYDIRECTIVESCACHE_H
+#define LLVM_CLANG_LEX_DEPENDENCYDIRECTIVESCACHE_H
+
+#include "clang/Lex/DependencyDirectivesScanner.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+
+namespace clang {
+
+/// A directory of scanned dependency directives, keyed by the contents of the
+/// scanned file.
+///
+/// The directives of a file only depend on its contents, not on the macros
+/// defined when it is included, so every process that scans the same header
+/// can reuse the result of the first one. Each entry is a file in the cache
+/// directory named after the hash of the contents it was scanned from; it is
+/// written to a temporary file and renamed into place, so concurrent readers
+/// and writers never see a partial entry. Entries written by a different
+/// version of clang are ignored.
+///
+/// The cache is best-effort: entries that cannot be read or written are
+/// treated as misses.
+class DependencyDirectivesCache {
+public:
+  explicit DependencyDirectivesCache(StringRef Path);
+
+  /// Looks up the directives scanned from \p Input.
+  ///
+  /// \returns true if they were found, in which case \p Tokens and
+  /// \p Directives are set up as scanSourceForDependencyDirectives() would.
+  bool lookup(
+      StringRef Input,
+      SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+      SmallVectorImpl<dependency_directives_scan::Directive> &Directives) const;
+
+  /// Stores the directives scanned from \p Input. \p Directives must refer to
+  /// \p Tokens.
+  void
+  store(StringRef Input, ArrayRef<dependency_directives_scan::Token> Tokens,
+        ArrayRef<dependency_directives_scan::Directive> Directives) const;
+
+  StringRef getPath() const { return Path; }
+
+private:
+  std::string getEntryPath(StringRef Input) const;
+
+  std::string Path;
+};
+
+} // end namespace clang
+
+#endif // LLVM_CLANG_LEX_DEPENDENCYDIRECTIVESCACHE_H
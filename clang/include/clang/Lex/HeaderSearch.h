@@ -417,6 +417,11 @@ public:
   /// Retrieve the path to the module cache.
   StringRef getModuleCachePath() const { return ModuleCachePath; }
 
+  /// Retrieve the directory that holds the global module index: the first
+  /// prebuilt module path with -fmodules-prebuilt-global-index, and the
+  /// module cache otherwise.
+  StringRef getGlobalModuleIndexPath() const;
+
   /// Consider modules when including files from this directory.
   void setDirectoryHasModuleMap(const DirectoryEntry* Dir) {
     DirectoryHasModuleMap[Dir] = true;
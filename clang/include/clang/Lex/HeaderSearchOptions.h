@@ -225,6 +225,18 @@ public:
   /// diagnostics.
   unsigned ModulesStrictContextHash : 1;
 
+  /// Whether to decode the records of the top-level declarations of loaded
+  /// AST files on worker threads, ahead of their deserialization.
+  unsigned ModulesPrefetchDecls : 1;
+
+  /// Whether to keep the global module index in the first prebuilt module
+  /// path instead of the module cache, and to use it for C++20 modules too.
+  unsigned ModulesPrebuiltGlobalIndex : 1;
+
+  /// Whether to cache the results of file system lookups, including failed
+  /// ones, for the whole compilation.
+  unsigned CacheFileStatus : 1;
+
   HeaderSearchOptions(StringRef _Sysroot = "/")
       : Sysroot(_Sysroot), ModuleFormat("raw"), DisableModuleHash(false),
         ImplicitModuleMaps(false), ModuleMapFileHomeIsCwd(false),
@@ -235,7 +247,8 @@ public:
         ModulesValidateSystemHeaders(false),
         ValidateASTInputFilesContent(false), UseDebugInfo(false),
         ModulesValidateDiagnosticOptions(true), ModulesHashContent(false),
-        ModulesStrictContextHash(false) {}
+        ModulesStrictContextHash(false), ModulesPrefetchDecls(false),
+        ModulesPrebuiltGlobalIndex(false), CacheFileStatus(false) {}
 
   /// AddPath - Add the \p Path path to the specified \p Group list.
   void AddPath(StringRef Path, frontend::IncludeDirGroup Group,
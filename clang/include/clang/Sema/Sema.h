@@ -412,6 +412,12 @@ public:
   /// Flag indicating whether or not to collect detailed statistics.
   bool CollectStats;
 
+  /// The number of class and function definitions instantiated from each
+  /// pattern in this translation unit, collected when CollectStats is set.
+  /// Instantiations of patterns loaded from an AST file are the ones that a
+  /// precompiled header could have provided.
+  llvm::DenseMap<const NamedDecl *, unsigned> InstantiationsPerPattern;
+
   /// Code-completion consumer.
   CodeCompleteConsumer *CodeCompleter;
 
@@ -1678,6 +1684,12 @@ public:
 
   void PrintStats() const;
 
+  /// Record an instantiation from \p Pattern for PrintStats().
+  void noteInstantiationForStats(const NamedDecl *Pattern) {
+    if (CollectStats)
+      ++InstantiationsPerPattern[Pattern];
+  }
+
   /// Warn that the stack is nearly exhausted.
   void warnStackExhausted(SourceLocation Loc);
 
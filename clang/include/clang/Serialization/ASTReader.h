@@ -53,15 +53,21 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <atomic>
 #include <ctime>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+namespace llvm {
+class ThreadPool;
+} // namespace llvm
+
 namespace clang {
 
 class ASTConsumer;
@@ -501,6 +507,35 @@ private:
   /// = I + 1 has already been loaded.
   std::vector<Decl *> DeclsLoaded;
 
+  /// A declaration record that was decoded from the bitstream by a worker
+  /// thread before the declaration was needed.
+  struct PrefetchedDeclRecord {
+    unsigned Code = 0;
+    /// The bit offset just past the record, where the statements that belong
+    /// to the declaration start.
+    uint64_t EndBitOffset = 0;
+    SmallVector<uint64_t, 0> Record;
+  };
+
+  /// Guards PrefetchedDeclRecords, which is filled in by worker threads.
+  std::mutex PrefetchedDeclRecordsMutex;
+
+  /// The declarations whose records are being decoded or have been decoded
+  /// by worker threads, indexed by global declaration ID. The record is null
+  /// while it is still being decoded. Entries are removed when the
+  /// declaration is loaded, whether or not the record was ready, and a
+  /// record finished after that is dropped.
+  llvm::DenseMap<serialization::DeclID, std::unique_ptr<PrefetchedDeclRecord>>
+      PrefetchedDeclRecords;
+
+  /// The number of entries in PrefetchedDeclRecords, so that loading a
+  /// declaration only takes the mutex while prefetching is in progress.
+  std::atomic<size_t> NumPrefetchedDeclRecords{0};
+
+  /// The threads decoding declaration records ahead of time, if
+  /// -fmodules-prefetch-decls is in effect.
+  std::unique_ptr<llvm::ThreadPool> DeclPrefetchPool;
+
   using GlobalDeclMapType =
       ContinuousRangeMap<serialization::DeclID, ModuleFile *, 4>;
 
@@ -1428,6 +1463,19 @@ private:
   Decl *ReadDeclRecord(serialization::DeclID ID);
   void markIncompleteDeclChain(Decl *Canon);
 
+  /// Starts decoding the records of the top-level declarations of \p F on
+  /// worker threads.
+  void prefetchDeclRecords(ModuleFile &F);
+
+  /// Removes and returns the record of the declaration \p ID if a worker
+  /// thread has already decoded it.
+  std::unique_ptr<PrefetchedDeclRecord>
+  takePrefetchedDeclRecord(serialization::DeclID ID);
+
+  /// Waits for the worker threads and frees the records that were never
+  /// used.
+  void discardPrefetchedDeclRecords();
+
   /// Returns the most recent declaration of a declaration (which must be
   /// of a redeclarable kind) that is either local or has already been loaded
   /// merged into its redecl chain.
@@ -1728,6 +1776,10 @@ public:
   /// \returns true if loading the global index has failed for any reason.
   bool loadGlobalIndex();
 
+  /// Determine whether the kind of modules in use can benefit from a global
+  /// index.
+  bool usesGlobalIndex() const;
+
   /// Determine whether we tried to load the global index, but failed,
   /// e.g., because it is out-of-date or does not exist.
   bool isGlobalIndexUnavailable() const;
@@ -2035,7 +2087,7 @@ public:
   void InitializeSema(Sema &S) override;
 
   /// Inform the semantic consumer that Sema is no longer available.
-  void ForgetSema() override { SemaObj = nullptr; }
+  void ForgetSema() override;
 
   /// Retrieve the IdentifierInfo for the named identifier.
   ///
@@ -51,6 +51,13 @@ public:
   Expected<unsigned> readRecord(llvm::BitstreamCursor &Cursor,
                                 unsigned AbbrevID);
 
+  /// Takes over a record that has already been read from the stream,
+  /// resetting the internal state.
+  void setRecord(RecordDataImpl &&R) {
+    Idx = 0;
+    Record = std::move(R);
+  }
+
   /// Is this a module file for a module (rather than a PCH or similar).
   bool isModule() const { return F->isModule(); }
 
@@ -10,6 +10,7 @@
 #define LLVM_CLANG_TOOLING_DEPENDENCYSCANNING_DEPENDENCYSCANNINGFILESYSTEM_H
 
 #include "clang/Basic/LLVM.h"
+#include "clang/Lex/DependencyDirectivesCache.h"
 #include "clang/Lex/DependencyDirectivesScanner.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringMap.h"
@@ -202,9 +203,32 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Drops the entries of files whose status on \p FS differs from the cached
+  /// one, by type, unique ID, size or modification time, so that the next scan
+  /// reads them again. This lets a long-lived service rescan a build without
+  /// rereading the files that did not change. The memory of the dropped
+  /// entries is only reclaimed together with the cache.
+  ///
+  /// This must not be called while any worker is running, and worker
+  /// filesystems created before the call must not be used after it.
+  ///
+  /// \returns the number of filenames whose entries were dropped.
+  unsigned invalidateChangedEntries(llvm::vfs::FileSystem &FS);
+
+  /// Makes the workers look up the directives of each file in the on-disk
+  /// cache at \p Path before scanning it, and store the result there after.
+  /// This must be called before any worker is started.
+  void setDirectivesCachePath(StringRef Path) { DirectivesCache.emplace(Path); }
+
+  /// \returns the on-disk cache of scanned directives, if there is one.
+  const DependencyDirectivesCache *getDirectivesCache() const {
+    return DirectivesCache ? &*DirectivesCache : nullptr;
+  }
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  std::optional<DependencyDirectivesCache> DirectivesCache;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
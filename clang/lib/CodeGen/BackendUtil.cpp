@@ -1133,9 +1133,11 @@ static void runThinLTOBackend(
     const clang::TargetOptions &TOpts, const LangOptions &LOpts,
     std::unique_ptr<raw_pwrite_stream> OS, std::string SampleProfile,
     std::string ProfileRemapping, BackendAction Action) {
-  StringMap<DenseMap<GlobalValue::GUID, GlobalValueSummary *>>
-      ModuleToDefinedGVSummaries;
-  CombinedIndex->collectDefinedGVSummariesPerModule(ModuleToDefinedGVSummaries);
+  // The individual index also holds the summaries of the modules to import
+  // from; only the ones defined by this module are needed here.
+  GVSummaryMapTy DefinedGlobals;
+  CombinedIndex->collectDefinedGVSummariesForModule(M->getModuleIdentifier(),
+                                                    DefinedGlobals);
 
   setCommandLineOpts(CGOpts);
 
@@ -1223,8 +1225,8 @@ static void runThinLTOBackend(
   }
   if (Error E =
           thinBackend(Conf, -1, AddStream, *M, *CombinedIndex, ImportList,
-                      ModuleToDefinedGVSummaries[M->getModuleIdentifier()],
-                      /* ModuleMap */ nullptr, CGOpts.CmdArgs)) {
+                      DefinedGlobals, /* ModuleMap */ nullptr,
+                      CGOpts.CmdArgs)) {
     handleAllErrors(std::move(E), [&](ErrorInfoBase &EIB) {
       errs() << "Error running ThinLTO backend: " << EIB.message() << '\n';
     });
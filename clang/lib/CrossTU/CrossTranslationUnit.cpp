@@ -55,6 +55,8 @@ STATISTIC(NumLangMismatch, "The # of language mismatches");
 STATISTIC(NumLangDialectMismatch, "The # of language dialect mismatches");
 STATISTIC(NumASTLoadThresholdReached,
           "The # of ASTs not loaded because of threshold");
+STATISTIC(NumCachedLookupFailures,
+          "The # of getCTUDefinition calls answered by an earlier failure");
 
 // Same as Triple's equality operator, but we check a field only if that is
 // known in both instances.
@@ -349,13 +351,55 @@ llvm::Expected<const T *> CrossTranslationUnitContext::getCrossTUDefinitionImpl(
   return llvm::make_error<IndexError>(index_error_code::failed_import);
 }
 
+/// Returns true if a lookup that failed with \p Code would fail the same way
+/// if it was repeated later in the analysis of the same TU. Errors that carry
+/// information for a diagnostic are not remembered.
+static bool isPersistentLookupFailure(index_error_code Code) {
+  switch (Code) {
+  case index_error_code::missing_definition:
+  case index_error_code::failed_import:
+  case index_error_code::failed_to_generate_usr:
+  case index_error_code::lang_mismatch:
+  case index_error_code::lang_dialect_mismatch:
+  case index_error_code::load_threshold_reached:
+    return true;
+  default:
+    return false;
+  }
+}
+
+template <typename T>
+llvm::Expected<const T *>
+CrossTranslationUnitContext::getCrossTUDefinitionCached(
+    const T *D, StringRef CrossTUDir, StringRef IndexName,
+    bool DisplayCTUProgress) {
+  const Decl *CanonicalD = D->getCanonicalDecl();
+  auto Failed = FailedDefinitionLookups.find(CanonicalD);
+  if (Failed != FailedDefinitionLookups.end()) {
+    ++NumCachedLookupFailures;
+    return llvm::make_error<IndexError>(Failed->second);
+  }
+
+  llvm::Expected<const T *> Result =
+      getCrossTUDefinitionImpl(D, CrossTUDir, IndexName, DisplayCTUProgress);
+  if (Result)
+    return Result;
+  return llvm::handleErrors(
+      Result.takeError(),
+      [&](std::unique_ptr<IndexError> IE) -> llvm::Error {
+        if (isPersistentLookupFailure(IE->getCode()))
+          FailedDefinitionLookups[CanonicalD] = IE->getCode();
+        return llvm::Error(std::move(IE));
+      });
+}
+
 llvm::Expected<const FunctionDecl *>
 CrossTranslationUnitContext::getCrossTUDefinition(const FunctionDecl *FD,
                                                   StringRef CrossTUDir,
                                                   StringRef IndexName,
                                                   bool DisplayCTUProgress) {
-  return getCrossTUDefinitionImpl(FD, CrossTUDir, IndexName,
-                                  DisplayCTUProgress);
+  return getCrossTUDefinitionCached(FD, CrossTUDir, IndexName,
+                                    DisplayCTUProgress);
 }
 
 llvm::Expected<const VarDecl *>
@@ -363,8 +407,8 @@ CrossTranslationUnitContext::getCrossTUDefinition(const VarDecl *VD,
                                                   StringRef CrossTUDir,
                                                   StringRef IndexName,
                                                   bool DisplayCTUProgress) {
-  return getCrossTUDefinitionImpl(VD, CrossTUDir, IndexName,
-                                  DisplayCTUProgress);
+  return getCrossTUDefinitionCached(VD, CrossTUDir, IndexName,
+                                    DisplayCTUProgress);
 }
 
 void CrossTranslationUnitContext::emitCrossTUDiagnostics(const IndexError &IE) {
@@ -4676,6 +4676,11 @@ IntrusiveRefCntPtr<llvm::vfs::FileSystem>
 clang::createVFSFromCompilerInvocation(
     const CompilerInvocation &CI, DiagnosticsEngine &Diags,
     IntrusiveRefCntPtr<llvm::vfs::FileSystem> BaseFS) {
+  // Cache the underlying file system, so that the overlays see the cached
+  // results as well.
+  if (CI.getHeaderSearchOpts().CacheFileStatus)
+    BaseFS = llvm::makeIntrusiveRefCnt<llvm::vfs::CachingFileSystem>(
+        std::move(BaseFS));
   return createVFSFromOverlayFiles(CI.getHeaderSearchOpts().VFSOverlayFiles,
                                    Diags, std::move(BaseFS));
 }
@@ -0,0 +1,178 @@
+//===- DependencyDirectivesCache.cpp --------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An entry of the cache is a little-endian file with this layout:
+//
+//   char     Magic[8]       "CLDEPDIR"
+//   uint64_t VersionHash    hash of the clang version that wrote the entry
+//   uint64_t InputHash      xxh3 hash of the scanned contents
+//   uint64_t InputSize      size of the scanned contents
+//   uint32_t NumTokens
+//   uint32_t NumDirectives
+//   Tokens[NumTokens]:         uint32_t Offset, Length; uint16_t Kind, Flags
+//   Directives[NumDirectives]: uint32_t NumTokens, Kind
+//
+// The tokens of each directive follow those of the previous one, in the same
+// way as the output of scanSourceForDependencyDirectives().
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/DependencyDirectivesCache.h"
+#include "clang/Basic/TokenKinds.h"
+#include "clang/Basic/Version.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace clang;
+using namespace clang::dependency_directives_scan;
+using namespace llvm;
+
+static constexpr StringLiteral EntryMagic = "CLDEPDIR";
+static constexpr size_t HeaderSize = 8 + 8 * 3 + 4 * 2;
+static constexpr size_t TokenSize = 4 * 2 + 2 * 2;
+static constexpr size_t DirectiveSize = 4 * 2;
+
+static uint64_t getVersionHash() {
+  static const uint64_t Hash = xxh3_64bits(getClangFullRepositoryVersion());
+  return Hash;
+}
+
+DependencyDirectivesCache::DependencyDirectivesCache(StringRef Path)
+    : Path(Path) {}
+
+std::string DependencyDirectivesCache::getEntryPath(StringRef Input) const {
+  SmallString<256> EntryPath(Path);
+  sys::path::append(EntryPath, utohexstr(xxh3_64bits(Input), /*LowerCase=*/true,
+                                         /*Width=*/16) +
+                                   ".ddir");
+  return std::string(EntryPath);
+}
+
+bool DependencyDirectivesCache::lookup(
+    StringRef Input, SmallVectorImpl<Token> &Tokens,
+    SmallVectorImpl<Directive> &Directives) const {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+      MemoryBuffer::getFile(getEntryPath(Input), /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (!BufOrErr)
+    return false;
+  StringRef Data = (*BufOrErr)->getBuffer();
+  if (Data.size() < HeaderSize || !Data.starts_with(EntryMagic))
+    return false;
+
+  const char *P = Data.data() + EntryMagic.size();
+  auto Read32 = [&] {
+    return support::endian::readNext<uint32_t, support::little,
+                                     support::unaligned>(P);
+  };
+  auto Read64 = [&] {
+    return support::endian::readNext<uint64_t, support::little,
+                                     support::unaligned>(P);
+  };
+  auto Read16 = [&] {
+    return support::endian::readNext<uint16_t, support::little,
+                                     support::unaligned>(P);
+  };
+  if (Read64() != getVersionHash() || Read64() != xxh3_64bits(Input) ||
+      Read64() != Input.size())
+    return false;
+  uint64_t NumTokens = Read32();
+  uint64_t NumDirectives = Read32();
+  if (Data.size() !=
+      HeaderSize + NumTokens * TokenSize + NumDirectives * DirectiveSize)
+    return false;
+
+  size_t FirstToken = Tokens.size();
+  Tokens.reserve(FirstToken + NumTokens);
+  for (uint64_t I = 0; I != NumTokens; ++I) {
+    unsigned Offset = Read32();
+    unsigned Length = Read32();
+    unsigned Kind = Read16();
+    unsigned short Flags = Read16();
+    if (uint64_t(Offset) + Length > Input.size() || Kind >= tok::NUM_TOKENS) {
+      Tokens.truncate(FirstToken);
+      return false;
+    }
+    Tokens.emplace_back(Offset, Length, tok::TokenKind(Kind), Flags);
+  }
+
+  // Directives refer into Tokens, which must not grow any more.
+  ArrayRef<Token> Remaining = ArrayRef(Tokens).drop_front(FirstToken);
+  size_t FirstDirective = Directives.size();
+  for (uint64_t I = 0; I != NumDirectives; ++I) {
+    uint32_t DirTokens = Read32();
+    uint32_t Kind = Read32();
+    if (DirTokens > Remaining.size() || Kind > pp_eof) {
+      Tokens.truncate(FirstToken);
+      Directives.truncate(FirstDirective);
+      return false;
+    }
+    Directives.emplace_back(DirectiveKind(Kind),
+                            Remaining.take_front(DirTokens));
+    Remaining = Remaining.drop_front(DirTokens);
+  }
+  if (!Remaining.empty()) {
+    Tokens.truncate(FirstToken);
+    Directives.truncate(FirstDirective);
+    return false;
+  }
+  return true;
+}
+
+void DependencyDirectivesCache::store(
+    StringRef Input, ArrayRef<Token> Tokens,
+    ArrayRef<Directive> Directives) const {
+  SmallString<0> Data;
+  raw_svector_ostream OS(Data);
+  support::endian::Writer W(OS, support::little);
+  OS << EntryMagic;
+  W.write<uint64_t>(getVersionHash());
+  W.write<uint64_t>(xxh3_64bits(Input));
+  W.write<uint64_t>(Input.size());
+  W.write<uint32_t>(Tokens.size());
+  W.write<uint32_t>(Directives.size());
+  for (const Token &Tok : Tokens) {
+    W.write<uint32_t>(Tok.Offset);
+    W.write<uint32_t>(Tok.Length);
+    W.write<uint16_t>(Tok.Kind);
+    W.write<uint16_t>(Tok.Flags);
+  }
+  for (const Directive &Dir : Directives) {
+    W.write<uint32_t>(Dir.Tokens.size());
+    W.write<uint32_t>(Dir.Kind);
+  }
+
+  if (sys::fs::create_directories(Path))
+    return;
+  std::string EntryPath = getEntryPath(Input);
+  Expected<sys::fs::TempFile> Temp =
+      sys::fs::TempFile::create(EntryPath + ".tmp-%%%%%%%%");
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+  raw_fd_ostream TempOS(Temp->FD, /*shouldClose=*/false);
+  TempOS << Data;
+  TempOS.flush();
+  if (TempOS.has_error()) {
+    TempOS.clear_error();
+    consumeError(Temp->discard());
+    return;
+  }
+  // Another process may have stored the same entry in the meantime; either
+  // copy is fine.
+  if (Error E = Temp->keep(EntryPath)) {
+    consumeError(std::move(E));
+    consumeError(Temp->discard());
+  }
+}
@@ -180,6 +180,13 @@ std::string HeaderSearch::getCachedModuleFileName(Module *Module) {
   return getCachedModuleFileName(Module->Name, ModuleMap->getName());
 }
 
+StringRef HeaderSearch::getGlobalModuleIndexPath() const {
+  if (HSOpts->ModulesPrebuiltGlobalIndex &&
+      !HSOpts->PrebuiltModulePaths.empty())
+    return HSOpts->PrebuiltModulePaths.front();
+  return ModuleCachePath;
+}
+
 std::string HeaderSearch::getPrebuiltModuleFileName(StringRef ModuleName,
                                                     bool FileMapOnly) {
   // First check the module name to pcm file map.
@@ -1820,9 +1820,155 @@ bool Lexer::LexUnicodeIdentifierStart(Token &Result, uint32_t C,
   return true;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Vectorized scanners for the runs of characters that the lexer's inner loops
+// skip one at a time: identifier bodies, line comment bodies, the plain
+// characters of string literals, and horizontal whitespace. Each returns a
+// pointer to the first character in [Ptr, End) that its caller has to look
+// at. They only look at whole 16-byte blocks, so the result may be earlier
+// than that, down to Ptr itself; the callers' scalar loops take over from
+// there. Every scanner stops at a '\0', so they never step over the end of
+// the buffer or a code-completion point.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+namespace {
+#ifdef __SSE2__
+using ByteBlock = __m128i;
+
+ByteBlock loadBlock(const char *Ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+}
+ByteBlock equalTo(ByteBlock B, char C) {
+  return _mm_cmpeq_epi8(B, _mm_set1_epi8(C));
+}
+// Lanes holding a character in [Lo, Hi].
+ByteBlock inRange(ByteBlock B, char Lo, char Hi) {
+  // Bias the unsigned difference so that a signed comparison can test it.
+  return _mm_cmplt_epi8(_mm_sub_epi8(B, _mm_set1_epi8(char(Lo + 0x80))),
+                        _mm_set1_epi8(char(Hi - Lo + 1 - 0x80)));
+}
+ByteBlock nonASCII(ByteBlock B) {
+  return _mm_cmplt_epi8(B, _mm_setzero_si128());
+}
+ByteBlock anyOf(ByteBlock A, ByteBlock B) { return _mm_or_si128(A, B); }
+ByteBlock noneOf(ByteBlock B) { return _mm_xor_si128(B, _mm_set1_epi8(-1)); }
+// The index of the first set lane, or 16 if no lane is set.
+unsigned firstSetLane(ByteBlock B) {
+  return llvm::countr_zero<unsigned>(_mm_movemask_epi8(B) | 0x10000);
+}
+#else
+using ByteBlock = uint8x16_t;
+
+ByteBlock loadBlock(const char *Ptr) {
+  return vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+}
+ByteBlock equalTo(ByteBlock B, char C) { return vceqq_u8(B, vdupq_n_u8(C)); }
+ByteBlock inRange(ByteBlock B, char Lo, char Hi) {
+  return vcleq_u8(vsubq_u8(B, vdupq_n_u8(Lo)), vdupq_n_u8(Hi - Lo));
+}
+ByteBlock nonASCII(ByteBlock B) { return vcgeq_u8(B, vdupq_n_u8(0x80)); }
+ByteBlock anyOf(ByteBlock A, ByteBlock B) { return vorrq_u8(A, B); }
+ByteBlock noneOf(ByteBlock B) { return vmvnq_u8(B); }
+unsigned firstSetLane(ByteBlock B) {
+  // Narrow each lane to a nibble, as NEON has no movemask.
+  uint64_t Mask = vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(B), 4)), 0);
+  return Mask ? llvm::countr_zero(Mask) / 4 : 16;
+}
+#endif
+
+// Advances Ptr over whole blocks for which StopLanes() selects no lane, and
+// then to the first selected lane of the block that has one.
+template <typename... BlockTys>
+ByteBlock anyOf(ByteBlock A, ByteBlock B, BlockTys... Rest) {
+  return anyOf(anyOf(A, B), Rest...);
+}
+
+template <typename StopFn>
+const char *scanBlocks(const char *Ptr, const char *End, StopFn StopLanes) {
+  while (End - Ptr >= 16) {
+    unsigned Lane = firstSetLane(StopLanes(loadBlock(Ptr)));
+    Ptr += Lane;
+    if (Lane != 16)
+      break;
+  }
+  return Ptr;
+}
+} // namespace
+
+/// Skips [_A-Za-z0-9]*.
+static const char *skipAsciiIdentifierContinue(const char *Ptr,
+                                               const char *End) {
+  return scanBlocks(Ptr, End, [](ByteBlock B) {
+    return noneOf(anyOf(inRange(B, 'a', 'z'), inRange(B, 'A', 'Z'),
+                        inRange(B, '0', '9'), equalTo(B, '_')));
+  });
+}
+
+/// Skips the ASCII characters of a line comment that neither end it nor can
+/// be part of an escaped newline.
+static const char *skipLineCommentBody(const char *Ptr, const char *End) {
+  return scanBlocks(Ptr, End, [](ByteBlock B) {
+    return anyOf(nonASCII(B), equalTo(B, '\n'), equalTo(B, '\r'),
+                 equalTo(B, 0));
+  });
+}
+
+/// Skips the characters of a string literal that getAndAdvanceChar() would
+/// return unchanged and that do not need a closer look: anything except the
+/// closing quote, backslashes, trigraph starts, newlines and NULs.
+static const char *skipSimpleStringChars(const char *Ptr, const char *End) {
+  return scanBlocks(Ptr, End, [](ByteBlock B) {
+    return anyOf(equalTo(B, '"'), equalTo(B, '\\'), equalTo(B, '?'),
+                 equalTo(B, '\n'), equalTo(B, '\r'), equalTo(B, 0));
+  });
+}
+
+/// Skips the characters of a raw string literal body up to the next ')' or
+/// NUL.
+static const char *skipRawStringChars(const char *Ptr, const char *End) {
+  return scanBlocks(Ptr, End, [](ByteBlock B) {
+    return anyOf(equalTo(B, ')'), equalTo(B, 0));
+  });
+}
+
+/// Skips spaces, tabs, form feeds and vertical tabs.
+static const char *skipHorizontalWhitespace(const char *Ptr,
+                                            const char *End) {
+  return scanBlocks(Ptr, End, [](ByteBlock B) {
+    return noneOf(anyOf(equalTo(B, ' '), equalTo(B, '\t'), equalTo(B, '\f'),
+                        equalTo(B, '\v')));
+  });
+}
+#else
+static const char *skipAsciiIdentifierContinue(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *skipLineCommentBody(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *skipSimpleStringChars(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *skipRawStringChars(const char *Ptr, const char *) {
+  return Ptr;
+}
+static const char *skipHorizontalWhitespace(const char *Ptr, const char *) {
+  return Ptr;
+}
+#endif
+
 bool Lexer::LexIdentifierContinue(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched an identifier start.
   while (true) {
+    CurPtr = skipAsciiIdentifierContinue(CurPtr, BufferEnd);
     unsigned char C = *CurPtr;
     // Fast path.
     if (isAsciiIdentifierContinue(C)) {
@@ -2086,6 +2232,7 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
     Diag(BufferPtr, LangOpts.CPlusPlus ? diag::warn_cxx98_compat_unicode_literal
                                        : diag::warn_c99_compat_unicode_literal);
 
+  CurPtr = skipSimpleStringChars(CurPtr, BufferEnd);
   char C = getAndAdvanceChar(CurPtr, Result);
   while (C != '"') {
     // Skip escaped characters.  Escaped newlines will already be processed by
@@ -2114,6 +2261,7 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
 
       NulCharacter = CurPtr-1;
     }
+    CurPtr = skipSimpleStringChars(CurPtr, BufferEnd);
     C = getAndAdvanceChar(CurPtr, Result);
   }
 
@@ -2184,6 +2332,7 @@ bool Lexer::LexRawStringLiteral(Token &Result, const char *CurPtr,
   CurPtr += PrefixLen + 1; // skip over prefix and '('
 
   while (true) {
+    CurPtr = skipRawStringChars(CurPtr, BufferEnd);
     char C = *CurPtr++;
 
     if (C == ')') {
@@ -2377,6 +2526,8 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   // Skip consecutive spaces efficiently.
   while (true) {
     // Skip horizontal whitespace very aggressively.
+    CurPtr = skipHorizontalWhitespace(CurPtr, BufferEnd);
+    Char = *CurPtr;
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
 
@@ -2462,6 +2613,11 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+    if (const char *Next = skipLineCommentBody(CurPtr, BufferEnd);
+        Next != CurPtr) {
+      CurPtr = Next;
+      UnicodeDecodingAlreadyDiagnosed = false;
+    }
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2700,13 +2856,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -565,6 +565,30 @@ void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
 
+  unsigned NumClasses = 0, NumFunctions = 0, NumFromAST = 0;
+  std::vector<std::pair<unsigned, std::string>> Patterns;
+  for (const auto &[Pattern, Count] : InstantiationsPerPattern) {
+    (isa<CXXRecordDecl>(Pattern) ? NumClasses : NumFunctions) += Count;
+    if (Pattern->isFromASTFile()) {
+      NumFromAST += Count;
+      Patterns.emplace_back(Count, Pattern->getQualifiedNameAsString());
+    }
+  }
+  llvm::errs() << NumClasses << " class template instantiations.\n";
+  llvm::errs() << NumFunctions << " function template instantiations.\n";
+  llvm::errs() << NumFromAST
+               << " instantiations of templates loaded from an AST file.\n";
+
+  // The templates from an AST file that are instantiated the most are the
+  // ones worth instantiating once in the precompiled header, either with
+  // -fpch-instantiate-templates or with explicit instantiation definitions.
+  llvm::sort(Patterns, [](const auto &LHS, const auto &RHS) {
+    return LHS.first != RHS.first ? LHS.first > RHS.first
+                                  : LHS.second < RHS.second;
+  });
+  for (const auto &[Count, Name] : llvm::ArrayRef(Patterns).take_front(10))
+    llvm::errs() << "  " << Count << " " << Name << "\n";
+
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
 }
@@ -3181,6 +3181,7 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
   assert(!Inst.isAlreadyInstantiating() && "should have been caught by caller");
   PrettyDeclStackTraceEntry CrashInfo(Context, Instantiation, SourceLocation(),
                                       "instantiating class definition");
+  noteInstantiationForStats(Pattern);
 
   // Enter the scope of this instantiation. We don't use
   // PushDeclContext because we don't have a scope.
@@ -119,6 +119,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/VersionTuple.h"
@@ -4206,16 +4207,15 @@ bool ASTReader::loadGlobalIndex() {
   if (GlobalIndex)
     return false;
 
-  if (TriedLoadingGlobalIndex || !UseGlobalIndex ||
-      !PP.getLangOpts().Modules)
+  if (TriedLoadingGlobalIndex || !UseGlobalIndex || !usesGlobalIndex())
     return true;
 
   // Try to load the global index.
   TriedLoadingGlobalIndex = true;
-  StringRef ModuleCachePath
-    = getPreprocessor().getHeaderSearchInfo().getModuleCachePath();
+  StringRef IndexPath =
+      getPreprocessor().getHeaderSearchInfo().getGlobalModuleIndexPath();
   std::pair<GlobalModuleIndex *, llvm::Error> Result =
-      GlobalModuleIndex::readIndex(ModuleCachePath);
+      GlobalModuleIndex::readIndex(IndexPath);
   if (llvm::Error Err = std::move(Result.second)) {
     assert(!Result.first);
     consumeError(std::move(Err)); // FIXME this drops errors on the floor.
@@ -4227,9 +4227,18 @@ bool ASTReader::loadGlobalIndex() {
   return false;
 }
 
+bool ASTReader::usesGlobalIndex() const {
+  // Named modules have no module cache, so only look for an index that the
+  // user put in a prebuilt module path.
+  return PP.getLangOpts().Modules ||
+         (PP.getLangOpts().CPlusPlusModules &&
+          PP.getHeaderSearchInfo().getHeaderSearchOpts()
+              .ModulesPrebuiltGlobalIndex);
+}
+
 bool ASTReader::isGlobalIndexUnavailable() const {
-  return PP.getLangOpts().Modules && UseGlobalIndex &&
-         !hasGlobalIndex() && TriedLoadingGlobalIndex;
+  return usesGlobalIndex() && UseGlobalIndex && !hasGlobalIndex() &&
+         TriedLoadingGlobalIndex;
 }
 
 static void updateModuleTimestamp(ModuleFile &MF) {
@@ -4424,6 +4433,10 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
       F.ImportLoc = TranslateSourceLocation(*M.ImportedBy, M.ImportLoc);
   }
 
+  if (PP.getHeaderSearchInfo().getHeaderSearchOpts().ModulesPrefetchDecls)
+    for (ImportedModule &M : Loaded)
+      prefetchDeclRecords(*M.Mod);
+
   if (!PP.getLangOpts().CPlusPlus ||
       (Type != MK_ImplicitModule && Type != MK_ExplicitModule &&
        Type != MK_PrebuiltModule)) {
@@ -8051,6 +8064,13 @@ void ASTReader::InitializeSema(Sema &S) {
   UpdateSema();
 }
 
+void ASTReader::ForgetSema() {
+  SemaObj = nullptr;
+  // Declarations that are loaded from now on, if any, read their records
+  // themselves.
+  discardPrefetchedDeclRecords();
+}
+
 void ASTReader::UpdateSema() {
   assert(SemaObj && "no Sema to update");
 
@@ -10011,6 +10031,8 @@ ASTReader::ASTReader(Preprocessor &PP, InMemoryModuleCache &ModuleCache,
 }
 
 ASTReader::~ASTReader() {
+  // The workers read from the module files.
+  discardPrefetchedDeclRecords();
   if (OwnsDeserializationListener)
     delete DeserializationListener;
 }
@@ -63,6 +63,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/ThreadPool.h"
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
@@ -3187,6 +3188,122 @@ ASTReader::DeclCursorForID(DeclID ID, SourceLocation &Loc) {
   return RecordLocation(M, DOffs.getBitOffset(M->DeclsBlockStartOffset));
 }
 
+void ASTReader::prefetchDeclRecords(ModuleFile &F) {
+  // The top-level declarations are the ones name lookup into the AST file
+  // finds first. Collect those of them that live in this file and have not
+  // been loaded yet.
+  SmallVector<std::pair<DeclID, uint64_t>, 0> Decls;
+  for (const auto &Lexical : TULexicalDecls) {
+    if (Lexical.first != &F)
+      continue;
+    for (unsigned I = 1, N = Lexical.second.size(); I < N; I += 2) {
+      DeclID LocalID = Lexical.second[I];
+      if (LocalID < NUM_PREDEF_DECL_IDS)
+        continue;
+      DeclID ID = getGlobalDeclID(F, LocalID);
+      if (ID < F.BaseDeclID + NUM_PREDEF_DECL_IDS ||
+          ID >= F.BaseDeclID + NUM_PREDEF_DECL_IDS + F.LocalNumDecls ||
+          DeclsLoaded[ID - NUM_PREDEF_DECL_IDS])
+        continue;
+      const DeclOffset &DOffs =
+          F.DeclOffsets[ID - F.BaseDeclID - NUM_PREDEF_DECL_IDS];
+      Decls.emplace_back(ID, DOffs.getBitOffset(F.DeclsBlockStartOffset));
+    }
+  }
+  if (Decls.empty())
+    return;
+
+  if (!DeclPrefetchPool)
+    DeclPrefetchPool =
+        std::make_unique<llvm::ThreadPool>(llvm::hardware_concurrency());
+
+  {
+    std::lock_guard<std::mutex> Lock(PrefetchedDeclRecordsMutex);
+    for (const auto &[ID, Offset] : Decls)
+      PrefetchedDeclRecords.try_emplace(ID);
+    NumPrefetchedDeclRecords.store(PrefetchedDeclRecords.size(),
+                                   std::memory_order_release);
+  }
+
+  // The workers only decode the bitstream, for which they need nothing but
+  // their own copy of the cursor; creating the declarations stays on this
+  // thread. Each batch is published under the mutex once it is complete.
+  constexpr size_t BatchSize = 256;
+  for (size_t Begin = 0, E = Decls.size(); Begin < E; Begin += BatchSize) {
+    std::vector<std::pair<DeclID, uint64_t>> Batch(
+        Decls.begin() + Begin, Decls.begin() + std::min(E, Begin + BatchSize));
+    DeclPrefetchPool->async([this, Cursor = F.DeclsCursor,
+                             Batch = std::move(Batch)]() mutable {
+      SmallVector<std::pair<DeclID, std::unique_ptr<PrefetchedDeclRecord>>, 0>
+          Results;
+      for (auto [ID, Offset] : Batch) {
+        // Leave it to ReadDeclRecord() to report any problem.
+        Results.emplace_back(ID, nullptr);
+        if (llvm::Error Err = Cursor.JumpToBit(Offset)) {
+          consumeError(std::move(Err));
+          continue;
+        }
+        Expected<unsigned> MaybeCode = Cursor.ReadCode();
+        if (!MaybeCode) {
+          consumeError(MaybeCode.takeError());
+          continue;
+        }
+        auto Prefetched = std::make_unique<PrefetchedDeclRecord>();
+        Expected<unsigned> MaybeDeclCode =
+            Cursor.readRecord(MaybeCode.get(), Prefetched->Record);
+        if (!MaybeDeclCode) {
+          consumeError(MaybeDeclCode.takeError());
+          continue;
+        }
+        Prefetched->Code = MaybeDeclCode.get();
+        Prefetched->EndBitOffset = Cursor.GetCurrentBitNo();
+        Results.back().second = std::move(Prefetched);
+      }
+
+      // Records of declarations that were loaded in the meantime, and
+      // records that could not be decoded, are dropped.
+      std::lock_guard<std::mutex> Lock(PrefetchedDeclRecordsMutex);
+      for (auto &[ID, Prefetched] : Results) {
+        auto It = PrefetchedDeclRecords.find(ID);
+        if (It == PrefetchedDeclRecords.end())
+          continue;
+        if (Prefetched)
+          It->second = std::move(Prefetched);
+        else
+          PrefetchedDeclRecords.erase(It);
+      }
+      NumPrefetchedDeclRecords.store(PrefetchedDeclRecords.size(),
+                                     std::memory_order_release);
+    });
+  }
+}
+
+std::unique_ptr<ASTReader::PrefetchedDeclRecord>
+ASTReader::takePrefetchedDeclRecord(DeclID ID) {
+  if (NumPrefetchedDeclRecords.load(std::memory_order_acquire) == 0)
+    return nullptr;
+  std::lock_guard<std::mutex> Lock(PrefetchedDeclRecordsMutex);
+  auto It = PrefetchedDeclRecords.find(ID);
+  if (It == PrefetchedDeclRecords.end())
+    return nullptr;
+  // If the record is still being decoded, the caller reads it itself and the
+  // worker's copy is dropped once it is done.
+  std::unique_ptr<PrefetchedDeclRecord> Result = std::move(It->second);
+  PrefetchedDeclRecords.erase(It);
+  NumPrefetchedDeclRecords.store(PrefetchedDeclRecords.size(),
+                                 std::memory_order_release);
+  return Result;
+}
+
+void ASTReader::discardPrefetchedDeclRecords() {
+  if (!DeclPrefetchPool)
+    return;
+  DeclPrefetchPool->wait();
+  std::lock_guard<std::mutex> Lock(PrefetchedDeclRecordsMutex);
+  PrefetchedDeclRecords.clear();
+  NumPrefetchedDeclRecords.store(0, std::memory_order_release);
+}
+
 ASTReader::RecordLocation ASTReader::getLocalBitOffset(uint64_t GlobalOffset) {
   auto I = GlobalBitOffsetsMap.find(GlobalOffset);
 
@@ -3736,23 +3853,36 @@ Decl *ASTReader::ReadDeclRecord(DeclID ID) {
                              ": " + toString(std::move(Err)));
   };
 
-  if (llvm::Error JumpFailed = DeclsCursor.JumpToBit(Loc.Offset))
-    Fail("jumping", std::move(JumpFailed));
   ASTRecordReader Record(*this, *Loc.F);
   ASTDeclReader Reader(*this, Record, Loc, ID, DeclLoc);
-  Expected<unsigned> MaybeCode = DeclsCursor.ReadCode();
-  if (!MaybeCode)
-    Fail("reading code", MaybeCode.takeError());
-  unsigned Code = MaybeCode.get();
+  unsigned RecordCode;
+  if (std::unique_ptr<PrefetchedDeclRecord> Prefetched =
+          takePrefetchedDeclRecord(ID)) {
+    // Position the cursor as if we had read the record ourselves, as the
+    // statements of the declaration follow it.
+    if (llvm::Error JumpFailed =
+            DeclsCursor.JumpToBit(Prefetched->EndBitOffset))
+      Fail("jumping", std::move(JumpFailed));
+    Record.setRecord(std::move(Prefetched->Record));
+    RecordCode = Prefetched->Code;
+  } else {
+    if (llvm::Error JumpFailed = DeclsCursor.JumpToBit(Loc.Offset))
+      Fail("jumping", std::move(JumpFailed));
+    Expected<unsigned> MaybeCode = DeclsCursor.ReadCode();
+    if (!MaybeCode)
+      Fail("reading code", MaybeCode.takeError());
+    Expected<unsigned> MaybeDeclCode =
+        Record.readRecord(DeclsCursor, MaybeCode.get());
+    if (!MaybeDeclCode)
+      llvm::report_fatal_error(
+          Twine("ASTReader::readDeclRecord failed reading decl code: ") +
+          toString(MaybeDeclCode.takeError()));
+    RecordCode = MaybeDeclCode.get();
+  }
 
   ASTContext &Context = getContext();
   Decl *D = nullptr;
-  Expected<unsigned> MaybeDeclCode = Record.readRecord(DeclsCursor, Code);
-  if (!MaybeDeclCode)
-    llvm::report_fatal_error(
-        Twine("ASTReader::readDeclRecord failed reading decl code: ") +
-        toString(MaybeDeclCode.takeError()));
-  switch ((DeclCode)MaybeDeclCode.get()) {
+  switch ((DeclCode)RecordCode) {
   case DECL_CONTEXT_LEXICAL:
   case DECL_CONTEXT_VISIBLE:
     llvm_unreachable("Record cannot be de-serialized with readDeclRecord");
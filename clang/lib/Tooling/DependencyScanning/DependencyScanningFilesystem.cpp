@@ -61,10 +61,18 @@ EntryRef DependencyScanningWorkerFilesystem::scanForDirectivesIfNecessary(
     return EntryRef(Filename, Entry);
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
+  StringRef Input = Contents->Original->getBuffer();
+  const DependencyDirectivesCache *DiskCache = SharedCache.getDirectivesCache();
+  if (DiskCache &&
+      DiskCache->lookup(Input, Contents->DepDirectiveTokens, Directives)) {
+    Contents->DepDirectives.store(
+        new std::optional<DependencyDirectivesTy>(std::move(Directives)));
+    return EntryRef(Filename, Entry);
+  }
+
   // Scan the file for preprocessor directives that might affect the
   // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
+  if (scanSourceForDependencyDirectives(Input, Contents->DepDirectiveTokens,
                                         Directives)) {
     Contents->DepDirectiveTokens.clear();
     // FIXME: Propagate the diagnostic if desired by the client.
@@ -72,6 +80,9 @@ EntryRef DependencyScanningWorkerFilesystem::scanForDirectivesIfNecessary(
     return EntryRef(Filename, Entry);
   }
 
+  if (DiskCache)
+    DiskCache->store(Input, Contents->DepDirectiveTokens, Directives);
+
   // This function performed double-checked locking using `DepDirectives`.
   // Assigning it must be the last thing this function does, otherwise other
   // threads may skip the
@@ -106,6 +117,56 @@ DependencyScanningFilesystemSharedCache::getShardForUID(
   return CacheShards[Hash % NumShards];
 }
 
+/// \returns true if \p Entry still describes what \p Stat says is on disk.
+static bool isEntryUpToDate(const CachedFileSystemEntry &Entry,
+                            const llvm::ErrorOr<llvm::vfs::Status> &Stat) {
+  if (Entry.isError())
+    return !Stat && Stat.getError() == Entry.getError();
+  if (!Stat || Stat->getUniqueID() != Entry.getUniqueID() ||
+      Stat->isDirectory() != Entry.isDirectory())
+    return false;
+  // Adding or removing a file changes the modification time of a directory,
+  // but not anything that is cached about it.
+  if (Entry.isDirectory())
+    return true;
+  llvm::vfs::Status Cached = Entry.getStatus();
+  return Stat->getSize() == Cached.getSize() &&
+         Stat->getLastModificationTime() == Cached.getLastModificationTime();
+}
+
+unsigned DependencyScanningFilesystemSharedCache::invalidateChangedEntries(
+    llvm::vfs::FileSystem &FS) {
+  unsigned NumInvalidated = 0;
+  for (unsigned I = 0; I != NumShards; ++I) {
+    CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    for (auto It = Shard.EntriesByFilename.begin(),
+              End = Shard.EntriesByFilename.end();
+         It != End;) {
+      auto Current = It++;
+      const CachedFileSystemEntry *Entry = Current->getValue();
+      if (isEntryUpToDate(*Entry, FS.status(Current->getKey())))
+        continue;
+
+      if (!Entry->isError()) {
+        llvm::sys::fs::UniqueID UID = Entry->getUniqueID();
+        CacheShard &UIDShard = getShardForUID(UID);
+        // The UID shard may be this one, whose lock is already held.
+        std::unique_lock<std::mutex> UIDLock(UIDShard.CacheLock,
+                                             std::defer_lock);
+        if (&UIDShard != &Shard)
+          UIDLock.lock();
+        auto UIDIt = UIDShard.EntriesByUID.find(UID);
+        if (UIDIt != UIDShard.EntriesByUID.end() && UIDIt->second == Entry)
+          UIDShard.EntriesByUID.erase(UIDIt);
+      }
+      Shard.EntriesByFilename.erase(Current);
+      ++NumInvalidated;
+    }
+  }
+  return NumInvalidated;
+}
+
 const CachedFileSystemEntry *
 DependencyScanningFilesystemSharedCache::CacheShard::findEntryByFilename(
     StringRef Filename) const {
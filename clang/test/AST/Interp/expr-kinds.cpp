@@ -0,0 +1,84 @@
+// RUN: %clang_cc1 -fexperimental-new-constant-interpreter -std=c++20 -Wno-c11-extensions -verify %s
+// RUN: %clang_cc1 -std=c++20 -Wno-c11-extensions -verify=ref %s
+
+// expected-no-diagnostics
+// ref-no-diagnostics
+
+namespace ChooseExpr {
+  static_assert(__builtin_choose_expr(1, 10, 20) == 10);
+  static_assert(__builtin_choose_expr(0, 10, 20) == 20);
+
+  constexpr int choose(int A, int B) {
+    return __builtin_choose_expr(sizeof(int) == 4, A, B);
+  }
+  static_assert(choose(1, 2) == (sizeof(int) == 4 ? 1 : 2));
+}
+
+namespace GenericSelection {
+  static_assert(_Generic(1, int : 1, long : 2, default : 3) == 1);
+  static_assert(_Generic(1L, int : 1, long : 2, default : 3) == 2);
+  static_assert(_Generic(1.0, int : 1, long : 2, default : 3) == 3);
+
+  constexpr int generic(long L) { return _Generic(L, long : L + 1, default : 0); }
+  static_assert(generic(41) == 42);
+}
+
+namespace Noexcept {
+  void mayThrow();
+  void noThrow() noexcept;
+
+  static_assert(noexcept(noThrow()));
+  static_assert(!noexcept(mayThrow()));
+
+  constexpr bool isNoexcept() { return noexcept(noThrow()); }
+  static_assert(isNoexcept());
+}
+
+namespace SizeOfPack {
+  template <typename... Ts> constexpr unsigned count() { return sizeof...(Ts); }
+  static_assert(count<>() == 0);
+  static_assert(count<int, char, long>() == 3);
+
+  template <int... Is> constexpr int sum() {
+    int S = sizeof...(Is);
+    ((S += Is), ...);
+    return S;
+  }
+  static_assert(sum<1, 2, 3>() == 9);
+}
+
+namespace ScalarValueInit {
+  using IntPtr = int *;
+  static_assert(int() == 0);
+  static_assert(bool() == false);
+  static_assert(double() == 0.0);
+  static_assert(IntPtr() == nullptr);
+
+  constexpr int zero() {
+    int I = int();
+    void();
+    return I;
+  }
+  static_assert(zero() == 0);
+}
+
+namespace ArrayTypeTrait {
+  static_assert(__array_rank(int[1][2][3]) == 3);
+  static_assert(__array_rank(int) == 0);
+  static_assert(__array_extent(int[1][2][3], 1) == 2);
+  static_assert(__array_extent(int[4], 1) == 0);
+
+  constexpr unsigned long rank() { return __array_rank(char[2][2]); }
+  static_assert(rank() == 2);
+}
+
+namespace ExpressionTrait {
+  int I;
+  static_assert(__is_lvalue_expr(I));
+  static_assert(!__is_lvalue_expr(1));
+  static_assert(__is_rvalue_expr(1));
+  static_assert(!__is_rvalue_expr(I));
+
+  constexpr bool lvalue() { return __is_lvalue_expr(I); }
+  static_assert(lvalue());
+}
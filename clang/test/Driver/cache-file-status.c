@@ -0,0 +1,9 @@
+// RUN: %clang -### -fcache-file-status %s 2>&1 | FileCheck %s --check-prefix=CACHE
+// RUN: %clang -### -fno-cache-file-status -fcache-file-status %s 2>&1 | \
+// RUN:   FileCheck %s --check-prefix=CACHE
+// CACHE: "-fcache-file-status"
+
+// RUN: %clang -### %s 2>&1 | FileCheck %s --check-prefix=NO-CACHE
+// RUN: %clang -### -fcache-file-status -fno-cache-file-status %s 2>&1 | \
+// RUN:   FileCheck %s --check-prefix=NO-CACHE
+// NO-CACHE-NOT: "-fcache-file-status"
@@ -0,0 +1,26 @@
+// RUN: rm -rf %t && split-file %s %t
+
+// A file given twice is formatted once, and the messages of each file are
+// printed in the order of the files.
+// RUN: clang-format -style=LLVM -i -j 2 --verbose %t/a.cpp %t/b.cpp \
+// RUN:   %t/./a.cpp 2>&1 | FileCheck %s --check-prefix=VERBOSE
+// VERBOSE:      Formatting [1/2] {{.*}}a.cpp
+// VERBOSE-NEXT: Formatting [2/2] {{.*}}b.cpp
+// VERBOSE-NOT:  Formatting
+
+// RUN: FileCheck %s --input-file=%t/a.cpp --check-prefix=A
+// RUN: FileCheck %s --input-file=%t/b.cpp --check-prefix=B
+// A: {{^int a;$}}
+// B: {{^int b;$}}
+
+// RUN: not clang-format -style=LLVM -i -j 2 --verbose %t/a.cpp \
+// RUN:   %t/missing.cpp %t/b.cpp 2>&1 | FileCheck %s --check-prefix=ERR
+// ERR:      Formatting [1/3] {{.*}}a.cpp
+// ERR-NEXT: Formatting [2/3] {{.*}}missing.cpp
+// ERR-NEXT: {{.*}}o such file or directory
+// ERR-NEXT: Formatting [3/3] {{.*}}b.cpp
+
+//--- a.cpp
+int   a;
+//--- b.cpp
+int   b;
@@ -0,0 +1,39 @@
+// Check that -print-stats reports the templates from a module that the
+// importing translation unit had to instantiate.
+//
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+//
+// RUN: %clang_cc1 -std=c++20 %t/A.cppm -emit-module-interface -o %t/A.pcm
+// RUN: %clang_cc1 -std=c++20 -fprebuilt-module-path=%t %t/Use.cpp \
+// RUN:   -fsyntax-only -print-stats 2>&1 | FileCheck %s
+
+// CHECK-LABEL: *** Semantic Analysis Stats:
+// CHECK: 3 class template instantiations.
+// CHECK: 4 function template instantiations.
+// CHECK: 6 instantiations of templates loaded from an AST file.
+// CHECK-NEXT: 3 Box
+// CHECK-NEXT: 2 twice
+// CHECK-NEXT: 1 Box::get
+
+//--- A.cppm
+export module A;
+
+export template <typename T> struct Box {
+  T value;
+  T get() const { return value; }
+};
+
+export template <typename T> T twice(T t) { return t + t; }
+
+//--- Use.cpp
+import A;
+
+template <typename T> T local(T t) { return t; }
+
+int use() {
+  Box<int> a{1};
+  Box<long> b{2};
+  Box<char> c{3};
+  return a.get() + twice(1) + twice(2.0) + local(b.value) + c.value;
+}
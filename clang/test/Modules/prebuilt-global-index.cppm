@@ -0,0 +1,41 @@
+// Check that a global module index can be kept with prebuilt C++20 modules.
+//
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+//
+// RUN: %clang_cc1 -std=c++20 %t/A.cppm -emit-module-interface -o %t/A.pcm
+// RUN: %clang_cc1 -std=c++20 %t/B.cppm -emit-module-interface -o %t/B.pcm
+//
+// The first importer finds no index and creates one.
+// RUN: %clang_cc1 -std=c++20 -fprebuilt-module-path=%t \
+// RUN:   -fmodules-prebuilt-global-index %t/Use.cpp -verify -fsyntax-only
+// RUN: ls %t/modules.idx
+//
+// RUN: %clang_cc1 -std=c++20 -fprebuilt-module-path=%t \
+// RUN:   -fmodules-prebuilt-global-index %t/Use.cpp -verify -fsyntax-only \
+// RUN:   -print-stats 2>&1 | FileCheck %s
+//
+// CHECK: *** Global Module Index Statistics:
+//
+// Without the flag, no index is used.
+// RUN: rm %t/modules.idx
+// RUN: %clang_cc1 -std=c++20 -fprebuilt-module-path=%t %t/Use.cpp -verify \
+// RUN:   -fsyntax-only
+// RUN: not ls %t/modules.idx
+
+//--- A.cppm
+export module A;
+
+export int fromA() { return 1; }
+
+//--- B.cppm
+export module B;
+
+export int fromB() { return 2; }
+
+//--- Use.cpp
+// expected-no-diagnostics
+import A;
+import B;
+
+int use() { return fromA() + fromB(); }
@@ -0,0 +1,55 @@
+// Check that modules can be used when the records of their declarations are
+// decoded ahead of time on worker threads.
+//
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+//
+// RUN: %clang_cc1 -std=c++20 %t/A.cppm -emit-module-interface -o %t/A.pcm
+// RUN: %clang_cc1 -std=c++20 -fprebuilt-module-path=%t %t/Use.cpp \
+// RUN:   -fmodules-prefetch-decls -verify -fsyntax-only
+//
+// Also use a module that was built with the prefetching reader.
+// RUN: %clang_cc1 -std=c++20 -fprebuilt-module-path=%t %t/B.cppm \
+// RUN:   -fmodules-prefetch-decls -emit-module-interface -o %t/B.pcm
+// RUN: %clang_cc1 -std=c++20 -fprebuilt-module-path=%t %t/UseB.cpp \
+// RUN:   -fmodules-prefetch-decls -verify -fsyntax-only
+
+//--- A.cppm
+export module A;
+
+export int answer = 42;
+
+export struct S {
+  int x = answer;
+  int get() const { return x; }
+};
+
+export template <typename T> T twice(T t) { return t + t; }
+
+export namespace ns {
+enum class Color { Red, Green };
+constexpr Color favorite() { return Color::Green; }
+} // namespace ns
+
+//--- Use.cpp
+// expected-no-diagnostics
+import A;
+
+static_assert(ns::favorite() == ns::Color::Green);
+
+int use() {
+  S s;
+  return s.get() + twice(answer);
+}
+
+//--- B.cppm
+export module B;
+export import A;
+
+export int more() { return twice(S().get()); }
+
+//--- UseB.cpp
+// expected-no-diagnostics
+import B;
+
+int use() { return more() + (ns::favorite() == ns::Color::Red); }
@@ -0,0 +1,20 @@
+// RUN: rm -rf %t
+// RUN: mkdir -p %t/a %t/b
+// RUN: echo "void baz(void);" > %t/b/real.h
+// RUN: sed -e "s@INPUT_DIR@%{/S:regex_replacement}/Inputs@g" -e "s@OUT_DIR@%{/t:regex_replacement}@g" %S/Inputs/vfsoverlay.yaml > %t.yaml
+
+// Header search misses in %t/a before it finds the headers in %t/b and in the
+// overlay. The misses are cached, and the overlay sits on top of the cache.
+// RUN: %clang_cc1 -Werror -fcache-file-status -I %t/a -I %t/b -I %t \
+// RUN:   -ivfsoverlay %t.yaml -fsyntax-only %s
+// RUN: %clang_cc1 -Werror -fcache-file-status -fno-cache-file-status \
+// RUN:   -I %t/a -I %t/b -I %t -ivfsoverlay %t.yaml -fsyntax-only %s
+
+#include "real.h"
+#include "real.h"
+#include "not_real.h"
+
+void foo(void) {
+  bar();
+  baz();
+}
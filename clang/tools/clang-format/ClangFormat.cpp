@@ -19,11 +19,13 @@
 #include "clang/Basic/Version.h"
 #include "clang/Format/Format.h"
 #include "clang/Rewrite/Core/Rewriter.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
 #include <fstream>
 
 using namespace llvm;
@@ -125,6 +127,13 @@ static cl::opt<std::string> QualifierAlignment(
              "determined by the QualifierAlignment style flag"),
     cl::init(""), cl::cat(ClangFormatCategory));
 
+static cl::opt<unsigned> NumThreads(
+    "j",
+    cl::desc("Number of files to format in parallel when editing in-place\n"
+             "with -i (0 = one per core). Output to stdout and\n"
+             "--dry-run are always sequential."),
+    cl::init(1), cl::cat(ClangFormatCategory));
+
 static cl::opt<std::string> Files(
     "files",
     cl::desc("A file containing a list of files to process, one per line."),
@@ -224,8 +233,8 @@ static bool parseLineRange(StringRef Input, unsigned &FromLine,
          LineRange.second.getAsInteger(0, ToLine);
 }
 
-static bool fillRanges(MemoryBuffer *Code,
-                       std::vector<tooling::Range> &Ranges) {
+static bool fillRanges(MemoryBuffer *Code, std::vector<tooling::Range> &Ranges,
+                       raw_ostream &ErrOS) {
   IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemoryFileSystem(
       new llvm::vfs::InMemoryFileSystem);
   FileManager Files(FileSystemOptions(), InMemoryFileSystem);
@@ -237,22 +246,22 @@ static bool fillRanges(MemoryBuffer *Code,
                                  InMemoryFileSystem.get());
   if (!LineRanges.empty()) {
     if (!Offsets.empty() || !Lengths.empty()) {
-      errs() << "error: cannot use -lines with -offset/-length\n";
+      ErrOS << "error: cannot use -lines with -offset/-length\n";
       return true;
     }
 
     for (unsigned i = 0, e = LineRanges.size(); i < e; ++i) {
       unsigned FromLine, ToLine;
       if (parseLineRange(LineRanges[i], FromLine, ToLine)) {
-        errs() << "error: invalid <start line>:<end line> pair\n";
+        ErrOS << "error: invalid <start line>:<end line> pair\n";
         return true;
       }
       if (FromLine < 1) {
-        errs() << "error: start line should be at least 1\n";
+        ErrOS << "error: start line should be at least 1\n";
         return true;
       }
       if (FromLine > ToLine) {
-        errs() << "error: start line should not exceed end line\n";
+        ErrOS << "error: start line should not exceed end line\n";
         return true;
       }
       SourceLocation Start = Sources.translateLineCol(ID, FromLine, 1);
@@ -270,12 +279,12 @@ static bool fillRanges(MemoryBuffer *Code,
     Offsets.push_back(0);
   if (Offsets.size() != Lengths.size() &&
       !(Offsets.size() == 1 && Lengths.empty())) {
-    errs() << "error: number of -offset and -length arguments must match.\n";
+    ErrOS << "error: number of -offset and -length arguments must match.\n";
     return true;
   }
   for (unsigned i = 0, e = Offsets.size(); i != e; ++i) {
     if (Offsets[i] >= Code->getBufferSize()) {
-      errs() << "error: offset " << Offsets[i] << " is outside the file\n";
+      ErrOS << "error: offset " << Offsets[i] << " is outside the file\n";
       return true;
     }
     SourceLocation Start =
@@ -283,9 +292,9 @@ static bool fillRanges(MemoryBuffer *Code,
     SourceLocation End;
     if (i < Lengths.size()) {
       if (Offsets[i] + Lengths[i] > Code->getBufferSize()) {
-        errs() << "error: invalid length " << Lengths[i]
-               << ", offset + length (" << Offsets[i] + Lengths[i]
-               << ") is outside the file.\n";
+        ErrOS << "error: invalid length " << Lengths[i]
+              << ", offset + length (" << Offsets[i] + Lengths[i]
+              << ") is outside the file.\n";
         return true;
       }
       End = Start.getLocWithOffset(Lengths[i]);
@@ -339,7 +348,8 @@ static void outputReplacementsXML(const Replacements &Replaces) {
 
 static bool
 emitReplacementWarnings(const Replacements &Replaces, StringRef AssumedFileName,
-                        const std::unique_ptr<llvm::MemoryBuffer> &Code) {
+                        const std::unique_ptr<llvm::MemoryBuffer> &Code,
+                        raw_ostream &ErrOS) {
   if (Replaces.empty())
     return false;
 
@@ -357,7 +367,7 @@ emitReplacementWarnings(const Replacements &Replaces, StringRef AssumedFileName,
                            : SourceMgr::DiagKind::DK_Warning,
           "code should be clang-formatted [-Wclang-format-violations]");
 
-      Diag.print(nullptr, llvm::errs(), (ShowColors && !NoShowColors));
+      Diag.print(nullptr, ErrOS, (ShowColors && !NoShowColors));
       if (ErrorLimit && ++Errors >= ErrorLimit)
         break;
     }
@@ -386,6 +396,8 @@ static void outputXML(const Replacements &Replaces,
 }
 
 class ClangFormatDiagConsumer : public DiagnosticConsumer {
+  raw_ostream &OS;
+
   virtual void anchor() {}
 
   void HandleDiagnostic(DiagnosticsEngine::Level DiagLevel,
@@ -393,14 +405,17 @@ class ClangFormatDiagConsumer : public DiagnosticConsumer {
 
     SmallVector<char, 16> vec;
     Info.FormatDiagnostic(vec);
-    errs() << "clang-format error:" << vec << "\n";
+    OS << "clang-format error:" << vec << "\n";
   }
+
+public:
+  explicit ClangFormatDiagConsumer(raw_ostream &OS) : OS(OS) {}
 };
 
-// Returns true on error.
-static bool format(StringRef FileName) {
+// Returns true on error. Errors are written to \p ErrOS.
+static bool format(StringRef FileName, raw_ostream &ErrOS) {
   if (!OutputXML && Inplace && FileName == "-") {
-    errs() << "error: cannot use -i when reading from stdin.\n";
+    ErrOS << "error: cannot use -i when reading from stdin.\n";
     return false;
   }
   // On Windows, overwriting a file with an open file mapping doesn't work,
@@ -409,7 +424,7 @@ static bool format(StringRef FileName) {
       !OutputXML && Inplace ? MemoryBuffer::getFileAsStream(FileName)
                             : MemoryBuffer::getFileOrSTDIN(FileName);
   if (std::error_code EC = CodeOrErr.getError()) {
-    errs() << EC.message() << "\n";
+    ErrOS << EC.message() << "\n";
     return true;
   }
   std::unique_ptr<llvm::MemoryBuffer> Code = std::move(CodeOrErr.get());
@@ -421,20 +436,20 @@ static bool format(StringRef FileName) {
   const char *InvalidBOM = SrcMgr::ContentCache::getInvalidBOM(BufStr);
 
   if (InvalidBOM) {
-    errs() << "error: encoding with unsupported byte order mark \""
-           << InvalidBOM << "\" detected";
+    ErrOS << "error: encoding with unsupported byte order mark \""
+          << InvalidBOM << "\" detected";
     if (FileName != "-")
-      errs() << " in file '" << FileName << "'";
-    errs() << ".\n";
+      ErrOS << " in file '" << FileName << "'";
+    ErrOS << ".\n";
     return true;
   }
 
   std::vector<tooling::Range> Ranges;
-  if (fillRanges(Code.get(), Ranges))
+  if (fillRanges(Code.get(), Ranges, ErrOS))
     return true;
   StringRef AssumedFileName = (FileName == "-") ? AssumeFileName : FileName;
   if (AssumedFileName.empty()) {
-    llvm::errs() << "error: empty filenames are not allowed\n";
+    ErrOS << "error: empty filenames are not allowed\n";
     return true;
   }
 
@@ -442,7 +457,7 @@ static bool format(StringRef FileName) {
       getStyle(Style, AssumedFileName, FallbackStyle, Code->getBuffer(),
                nullptr, WNoErrorList.isSet(WNoError::Unknown));
   if (!FormatStyle) {
-    llvm::errs() << llvm::toString(FormatStyle.takeError()) << "\n";
+    ErrOS << llvm::toString(FormatStyle.takeError()) << "\n";
     return true;
   }
 
@@ -483,12 +498,12 @@ static bool format(StringRef FileName) {
     auto Err = Replaces.add(tooling::Replacement(
         tooling::Replacement(AssumedFileName, 0, 0, "x = ")));
     if (Err)
-      llvm::errs() << "Bad Json variable insertion\n";
+      ErrOS << "Bad Json variable insertion\n";
   }
 
   auto ChangedCode = tooling::applyAllReplacements(Code->getBuffer(), Replaces);
   if (!ChangedCode) {
-    llvm::errs() << llvm::toString(ChangedCode.takeError()) << "\n";
+    ErrOS << llvm::toString(ChangedCode.takeError()) << "\n";
     return true;
   }
   // Get new affected ranges after sorting `#includes`.
@@ -499,7 +514,7 @@ static bool format(StringRef FileName) {
   Replaces = Replaces.merge(FormatChanges);
   if (OutputXML || DryRun) {
     if (DryRun)
-      return emitReplacementWarnings(Replaces, AssumedFileName, Code);
+      return emitReplacementWarnings(Replaces, AssumedFileName, Code, ErrOS);
     else
       outputXML(Replaces, FormatChanges, Status, Cursor, CursorPosition);
   } else {
@@ -508,7 +523,7 @@ static bool format(StringRef FileName) {
     FileManager Files(FileSystemOptions(), InMemoryFileSystem);
 
     IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts(new DiagnosticOptions());
-    ClangFormatDiagConsumer IgnoreDiagnostics;
+    ClangFormatDiagConsumer IgnoreDiagnostics(ErrOS);
     DiagnosticsEngine Diagnostics(
         IntrusiveRefCntPtr<DiagnosticIDs>(new DiagnosticIDs), &*DiagOpts,
         &IgnoreDiagnostics, false);
@@ -612,7 +627,7 @@ int main(int argc, const char **argv) {
 
   bool Error = false;
   if (FileNames.empty()) {
-    Error = clang::format::format("-");
+    Error = clang::format::format("-", errs());
     return Error ? 1 : 0;
   }
   if (FileNames.size() != 1 &&
@@ -622,13 +637,51 @@ int main(int argc, const char **argv) {
     return 1;
   }
 
+  // Files edited in place are independent, so they can be formatted
+  // concurrently. Anything written to stdout must stay in order.
+  if (NumThreads != 1 && Inplace && !OutputXML && !DryRun &&
+      FileNames.size() > 1) {
+    // Two threads must not rewrite the same file, so format each file once,
+    // however it is spelled.
+    std::vector<StringRef> UniqueFileNames;
+    StringSet<> Seen;
+    for (const auto &FileName : FileNames) {
+      SmallString<128> Path;
+      if (llvm::sys::fs::real_path(FileName, Path))
+        Path = FileName;
+      if (Seen.insert(Path).second)
+        UniqueFileNames.push_back(FileName);
+    }
+
+    // Collect the messages of each file and print them in the order of the
+    // files, so that they don't interleave.
+    std::vector<std::string> Messages(UniqueFileNames.size());
+    // Not std::vector<bool>, whose elements can't be written concurrently.
+    std::vector<char> Errors(UniqueFileNames.size());
+    llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+    for (size_t I = 0, E = UniqueFileNames.size(); I != E; ++I) {
+      Pool.async([&, I]() {
+        raw_string_ostream OS(Messages[I]);
+        if (Verbose) {
+          OS << "Formatting [" << I + 1 << "/" << UniqueFileNames.size()
+             << "] " << UniqueFileNames[I] << "\n";
+        }
+        Errors[I] = clang::format::format(UniqueFileNames[I], OS);
+      });
+    }
+    Pool.wait();
+    for (const std::string &Msg : Messages)
+      errs() << Msg;
+    return llvm::is_contained(Errors, true) ? 1 : 0;
+  }
+
   unsigned FileNo = 1;
   for (const auto &FileName : FileNames) {
     if (Verbose) {
       errs() << "Formatting [" << FileNo++ << "/" << FileNames.size() << "] "
              << FileName << "\n";
     }
-    Error |= clang::format::format(FileName);
+    Error |= clang::format::format(FileName, errs());
   }
   return Error ? 1 : 0;
 }
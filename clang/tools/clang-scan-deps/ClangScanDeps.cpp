@@ -18,6 +18,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/InitLLVM.h"
@@ -83,6 +84,7 @@ enum ResourceDirRecipeKind {
 static ScanningMode ScanMode = ScanningMode::DependencyDirectivesScan;
 static ScanningOutputFormat Format = ScanningOutputFormat::Make;
 static std::string ModuleFilesDir;
+static std::string DirectivesCachePath;
 static bool OptimizeArgs;
 static bool EagerLoadModules;
 static unsigned NumThreads = 0;
@@ -93,6 +95,7 @@ static bool DeprecatedDriverCommand;
 static ResourceDirRecipeKind ResourceDirRecipe;
 static bool Verbose;
 static bool PrintTiming;
+static bool Server;
 static std::vector<const char *> CommandLine;
 
 #ifndef NDEBUG
@@ -158,6 +161,9 @@ static void ParseArgs(int argc, char **argv) {
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_module_files_dir_EQ))
     ModuleFilesDir = A->getValue();
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_directives_cache_path_EQ))
+    DirectivesCachePath = A->getValue();
+
   OptimizeArgs = Args.hasArg(OPT_optimize_args);
   EagerLoadModules = Args.hasArg(OPT_eager_load_pcm);
 
@@ -205,6 +211,13 @@ static void ParseArgs(int argc, char **argv) {
 
   PrintTiming = Args.hasArg(OPT_print_timing);
 
+  Server = Args.hasArg(OPT_server);
+  if (Server && CompilationDB.empty()) {
+    llvm::errs() << ToolName
+                 << ": the -server option requires --compilation-database\n";
+    std::exit(1);
+  }
+
   Verbose = Args.hasArg(OPT_verbose);
 
   RoundTripArgs = Args.hasArg(OPT_round_trip_args);
@@ -764,95 +777,48 @@ getCompilationDataBase(int argc, char **argv, std::string &ErrorMessage) {
       FEOpts.Inputs[0].getFile(), OutputFile, CommandLine);
 }
 
-int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
-  std::string ErrorMessage;
-  std::unique_ptr<tooling::CompilationDatabase> Compilations =
-      getCompilationDataBase(argc, argv, ErrorMessage);
-  if (!Compilations) {
-    llvm::errs() << ErrorMessage << "\n";
-    return 1;
+/// Scans every command of \p Compilations on the workers of \p Pool and
+/// prints the dependencies to \p DependencyOS.
+///
+/// \returns true if any of the commands failed.
+/// Reads the next line of standard input into \p Line, without its newline.
+/// \p Pending holds what was read past the previous line. Reads only as much
+/// as is available, so that a client can wait for the output of each line
+/// before sending the next one. Returns false at the end of the input.
+static bool readStdinLine(std::string &Line, std::string &Pending) {
+  llvm::sys::fs::file_t Stdin = llvm::sys::fs::getStdinHandle();
+  char Buf[4096];
+  size_t Newline;
+  while ((Newline = Pending.find('\n')) == std::string::npos) {
+    llvm::Expected<size_t> Read = llvm::sys::fs::readNativeFile(Stdin, Buf);
+    if (!Read) {
+      llvm::consumeError(Read.takeError());
+      return false;
+    }
+    if (*Read == 0) {
+      if (Pending.empty())
+        return false;
+      Line = std::move(Pending);
+      Pending.clear();
+      return true;
+    }
+    Pending.append(Buf, *Read);
   }
+  Line = Pending.substr(0, Newline);
+  Pending.erase(0, Newline + 1);
+  return true;
+}
 
-  llvm::cl::PrintOptionValues();
-
-  // The command options are rewritten to run Clang in preprocessor only mode.
-  auto AdjustingCompilations =
-      std::make_unique<tooling::ArgumentsAdjustingCompilations>(
-          std::move(Compilations));
-  ResourceDirectoryCache ResourceDirCache;
-
-  AdjustingCompilations->appendArgumentsAdjuster(
-      [&ResourceDirCache](const tooling::CommandLineArguments &Args,
-                          StringRef FileName) {
-        std::string LastO;
-        bool HasResourceDir = false;
-        bool ClangCLMode = false;
-        auto FlagsEnd = llvm::find(Args, "--");
-        if (FlagsEnd != Args.begin()) {
-          ClangCLMode =
-              llvm::sys::path::stem(Args[0]).contains_insensitive("clang-cl") ||
-              llvm::is_contained(Args, "--driver-mode=cl");
-
-          // Reverse scan, starting at the end or at the element before "--".
-          auto R = std::make_reverse_iterator(FlagsEnd);
-          for (auto I = R, E = Args.rend(); I != E; ++I) {
-            StringRef Arg = *I;
-            if (ClangCLMode) {
-              // Ignore arguments that are preceded by "-Xclang".
-              if ((I + 1) != E && I[1] == "-Xclang")
-                continue;
-              if (LastO.empty()) {
-                // With clang-cl, the output obj file can be specified with
-                // "/opath", "/o path", "/Fopath", and the dash counterparts.
-                // Also, clang-cl adds ".obj" extension if none is found.
-                if ((Arg == "-o" || Arg == "/o") && I != R)
-                  LastO = I[-1]; // Next argument (reverse iterator)
-                else if (Arg.startswith("/Fo") || Arg.startswith("-Fo"))
-                  LastO = Arg.drop_front(3).str();
-                else if (Arg.startswith("/o") || Arg.startswith("-o"))
-                  LastO = Arg.drop_front(2).str();
-
-                if (!LastO.empty() && !llvm::sys::path::has_extension(LastO))
-                  LastO.append(".obj");
-              }
-            }
-            if (Arg == "-resource-dir")
-              HasResourceDir = true;
-          }
-        }
-        tooling::CommandLineArguments AdjustedArgs(Args.begin(), FlagsEnd);
-        // The clang-cl driver passes "-o -" to the frontend. Inject the real
-        // file here to ensure "-MT" can be deduced if need be.
-        if (ClangCLMode && !LastO.empty()) {
-          AdjustedArgs.push_back("/clang:-o");
-          AdjustedArgs.push_back("/clang:" + LastO);
-        }
-
-        if (!HasResourceDir && ResourceDirRecipe == RDRK_InvokeCompiler) {
-          StringRef ResourceDir =
-              ResourceDirCache.findResourceDir(Args, ClangCLMode);
-          if (!ResourceDir.empty()) {
-            AdjustedArgs.push_back("-resource-dir");
-            AdjustedArgs.push_back(std::string(ResourceDir));
-          }
-        }
-        AdjustedArgs.insert(AdjustedArgs.end(), FlagsEnd, Args.end());
-        return AdjustedArgs;
-      });
-
-  SharedStream Errs(llvm::errs());
-  // Print out the dependency results to STDOUT by default.
-  SharedStream DependencyOS(llvm::outs());
-
-  DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
-                                    EagerLoadModules);
-  llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+static bool scanCompilations(DependencyScanningService &Service,
+                             llvm::ThreadPool &Pool,
+                             const tooling::CompilationDatabase &Compilations,
+                             SharedStream &DependencyOS, SharedStream &Errs) {
   std::vector<std::unique_ptr<DependencyScanningTool>> WorkerTools;
   for (unsigned I = 0; I < Pool.getThreadCount(); ++I)
     WorkerTools.push_back(std::make_unique<DependencyScanningTool>(Service));
 
   std::vector<tooling::CompileCommand> Inputs =
-      AdjustingCompilations->getAllCompileCommands();
+      Compilations.getAllCompileCommands();
 
   std::atomic<bool> HadErrors(false);
   std::optional<FullDeps> FD;
@@ -860,6 +826,8 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   std::mutex Lock;
   size_t Index = 0;
+  std::mutex MakeformatLock;
+  llvm::StringMap<llvm::raw_fd_ostream> OSs;
   auto GetNextInputIndex = [&]() -> std::optional<size_t> {
     std::unique_lock<std::mutex> LockGuard(Lock);
     if (Index < Inputs.size())
@@ -921,13 +889,11 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
           if (!MakeformatOutputPath.empty() && !MakeformatOutput.empty() &&
               !HadErrors) {
-            static std::mutex Lock;
             // With compilation database, we may open different files
             // concurrently or we may write the same file concurrently. So we
             // use a map here to allow multiple compile commands to write to the
             // same file. Also we need a lock here to avoid data race.
-            static llvm::StringMap<llvm::raw_fd_ostream> OSs;
-            std::unique_lock<std::mutex> LockGuard(Lock);
+            std::unique_lock<std::mutex> LockGuard(MakeformatLock);
 
             auto OSIter = OSs.find(MakeformatOutputPath);
             if (OSIter == OSs.end()) {
@@ -984,3 +950,131 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   return HadErrors;
 }
+
+int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
+  std::string ErrorMessage;
+  std::unique_ptr<tooling::CompilationDatabase> Compilations =
+      getCompilationDataBase(argc, argv, ErrorMessage);
+  if (!Compilations) {
+    llvm::errs() << ErrorMessage << "\n";
+    return 1;
+  }
+
+  llvm::cl::PrintOptionValues();
+
+  // The command options are rewritten to run Clang in preprocessor only mode.
+  ResourceDirectoryCache ResourceDirCache;
+  tooling::ArgumentsAdjuster AdjustArgs =
+      [&ResourceDirCache](const tooling::CommandLineArguments &Args,
+                          StringRef FileName) {
+        std::string LastO;
+        bool HasResourceDir = false;
+        bool ClangCLMode = false;
+        auto FlagsEnd = llvm::find(Args, "--");
+        if (FlagsEnd != Args.begin()) {
+          ClangCLMode =
+              llvm::sys::path::stem(Args[0]).contains_insensitive("clang-cl") ||
+              llvm::is_contained(Args, "--driver-mode=cl");
+
+          // Reverse scan, starting at the end or at the element before "--".
+          auto R = std::make_reverse_iterator(FlagsEnd);
+          for (auto I = R, E = Args.rend(); I != E; ++I) {
+            StringRef Arg = *I;
+            if (ClangCLMode) {
+              // Ignore arguments that are preceded by "-Xclang".
+              if ((I + 1) != E && I[1] == "-Xclang")
+                continue;
+              if (LastO.empty()) {
+                // With clang-cl, the output obj file can be specified with
+                // "/opath", "/o path", "/Fopath", and the dash counterparts.
+                // Also, clang-cl adds ".obj" extension if none is found.
+                if ((Arg == "-o" || Arg == "/o") && I != R)
+                  LastO = I[-1]; // Next argument (reverse iterator)
+                else if (Arg.startswith("/Fo") || Arg.startswith("-Fo"))
+                  LastO = Arg.drop_front(3).str();
+                else if (Arg.startswith("/o") || Arg.startswith("-o"))
+                  LastO = Arg.drop_front(2).str();
+
+                if (!LastO.empty() && !llvm::sys::path::has_extension(LastO))
+                  LastO.append(".obj");
+              }
+            }
+            if (Arg == "-resource-dir")
+              HasResourceDir = true;
+          }
+        }
+        tooling::CommandLineArguments AdjustedArgs(Args.begin(), FlagsEnd);
+        // The clang-cl driver passes "-o -" to the frontend. Inject the real
+        // file here to ensure "-MT" can be deduced if need be.
+        if (ClangCLMode && !LastO.empty()) {
+          AdjustedArgs.push_back("/clang:-o");
+          AdjustedArgs.push_back("/clang:" + LastO);
+        }
+
+        if (!HasResourceDir && ResourceDirRecipe == RDRK_InvokeCompiler) {
+          StringRef ResourceDir =
+              ResourceDirCache.findResourceDir(Args, ClangCLMode);
+          if (!ResourceDir.empty()) {
+            AdjustedArgs.push_back("-resource-dir");
+            AdjustedArgs.push_back(std::string(ResourceDir));
+          }
+        }
+        AdjustedArgs.insert(AdjustedArgs.end(), FlagsEnd, Args.end());
+        return AdjustedArgs;
+      };
+  auto AdjustingCompilations =
+      std::make_unique<tooling::ArgumentsAdjustingCompilations>(
+          std::move(Compilations));
+  AdjustingCompilations->appendArgumentsAdjuster(AdjustArgs);
+
+  SharedStream Errs(llvm::errs());
+  // Print out the dependency results to STDOUT by default.
+  SharedStream DependencyOS(llvm::outs());
+
+  DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
+                                    EagerLoadModules);
+  if (!DirectivesCachePath.empty())
+    Service.getSharedCache().setDirectivesCachePath(DirectivesCachePath);
+  llvm::ThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+
+  bool HadErrors = scanCompilations(Service, Pool, *AdjustingCompilations,
+                                    DependencyOS, Errs);
+  if (!Server)
+    return HadErrors;
+
+  // Keep the caches of the service alive and rescan whenever asked to. Only
+  // the files that changed since the previous scan are read again.
+  auto ReportDone = [&]() {
+    llvm::outs() << "clang-scan-deps: done " << HadErrors << "\n";
+    llvm::outs().flush();
+  };
+  ReportDone();
+  auto FS = llvm::vfs::createPhysicalFileSystem();
+  std::string Line, Pending;
+  for (; readStdinLine(Line, Pending); ReportDone()) {
+    StringRef Path = StringRef(Line).trim();
+    if (Path.empty())
+      Path = CompilationDB;
+    Compilations = tooling::JSONCompilationDatabase::loadFromFile(
+        Path, ErrorMessage, tooling::JSONCommandLineSyntax::AutoDetect);
+    if (!Compilations) {
+      llvm::errs() << ErrorMessage << "\n";
+      HadErrors = true;
+      continue;
+    }
+
+    unsigned NumInvalidated =
+        Service.getSharedCache().invalidateChangedEntries(*FS);
+    if (Verbose)
+      llvm::outs() << "Invalidated " << NumInvalidated
+                   << " cached file system entries\n";
+
+    AdjustingCompilations =
+        std::make_unique<tooling::ArgumentsAdjustingCompilations>(
+            std::move(Compilations));
+    AdjustingCompilations->appendArgumentsAdjuster(AdjustArgs);
+    HadErrors = scanCompilations(Service, Pool, *AdjustingCompilations,
+                                 DependencyOS, Errs);
+  }
+  return HadErrors;
+}
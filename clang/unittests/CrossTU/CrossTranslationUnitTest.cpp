@@ -12,6 +12,7 @@
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -135,6 +136,95 @@ private:
   const unsigned OverrideLimit;
 };
 
+class CTUMissingDefinitionConsumer : public clang::ASTConsumer {
+public:
+  explicit CTUMissingDefinitionConsumer(clang::CompilerInstance &CI)
+      : CTU(CI) {}
+
+  void HandleTranslationUnit(ASTContext &Ctx) override {
+    const FunctionDecl *FD = nullptr;
+    for (const Decl *D : Ctx.getTranslationUnitDecl()->decls()) {
+      FD = dyn_cast<FunctionDecl>(D);
+      if (FD && FD->getName() == "f")
+        break;
+    }
+    ASSERT_TRUE(FD && FD->getName() == "f");
+
+    // The index points at an AST file that has no definition of f, so the
+    // lookup loads it and fails.
+    int ASTFD;
+    llvm::SmallString<256> ASTFileName;
+    ASSERT_FALSE(
+        llvm::sys::fs::createTemporaryFile("g_ast", "ast", ASTFD, ASTFileName));
+    llvm::ToolOutputFile ASTFile(ASTFileName, ASTFD);
+
+    int IndexFD;
+    llvm::SmallString<256> IndexFileName;
+    ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("index", "txt", IndexFD,
+                                                    IndexFileName));
+    llvm::ToolOutputFile IndexFile(IndexFileName, IndexFD);
+    IndexFile.os() << "9:c:@F@f#I# " << ASTFileName << "\n";
+    IndexFile.os().flush();
+
+    StringRef SourceText = "int g(int) { return 0; }\n";
+    int SourceFD;
+    llvm::SmallString<256> SourceFileName;
+    ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("input", "cpp", SourceFD,
+                                                    SourceFileName));
+    llvm::ToolOutputFile SourceFile(SourceFileName, SourceFD);
+    SourceFile.os() << SourceText;
+    SourceFile.os().flush();
+
+    std::unique_ptr<ASTUnit> ASTWithoutDefinition =
+        tooling::buildASTFromCode(SourceText, SourceFileName);
+    ASTWithoutDefinition->Save(ASTFileName.str());
+
+    auto Lookup = [&]() {
+      index_error_code Code = index_error_code::success;
+      llvm::handleAllErrors(
+          CTU.getCrossTUDefinition(FD, "", IndexFileName,
+                                   /*DisplayCTUProgress=*/true)
+              .takeError(),
+          [&](IndexError &IE) { Code = IE.getCode(); });
+      return Code;
+    };
+
+    testing::internal::CaptureStderr();
+    EXPECT_EQ(Lookup(), index_error_code::failed_import);
+    std::string Progress = testing::internal::GetCapturedStderr();
+    EXPECT_NE(Progress.find("CTU loaded AST file"), std::string::npos);
+
+    // The second lookup is answered by the first failure. The AST file is not
+    // loaded and searched again.
+#if LLVM_ENABLE_STATS
+    auto NumCachedLookupFailures = []() -> uint64_t {
+      for (const auto &S : llvm::GetStatistics())
+        if (S.first == "NumCachedLookupFailures")
+          return S.second;
+      return 0;
+    };
+    uint64_t CachedBefore = NumCachedLookupFailures();
+#endif
+    testing::internal::CaptureStderr();
+    EXPECT_EQ(Lookup(), index_error_code::failed_import);
+    EXPECT_EQ(testing::internal::GetCapturedStderr(), "");
+#if LLVM_ENABLE_STATS
+    EXPECT_EQ(NumCachedLookupFailures(), CachedBefore + 1);
+#endif
+  }
+
+private:
+  CrossTranslationUnitContext CTU;
+};
+
+class CTUMissingDefinitionAction : public clang::ASTFrontendAction {
+protected:
+  std::unique_ptr<clang::ASTConsumer>
+  CreateASTConsumer(clang::CompilerInstance &CI, StringRef) override {
+    return std::make_unique<CTUMissingDefinitionConsumer>(CI);
+  }
+};
+
 } // end namespace
 
 TEST(CrossTranslationUnit, CanLoadFunctionDefinition) {
@@ -151,6 +241,12 @@ TEST(CrossTranslationUnit, RespectsLoadThreshold) {
   EXPECT_FALSE(Success);
 }
 
+TEST(CrossTranslationUnit, RemembersMissingDefinition) {
+  llvm::EnableStatistics(/*DoPrintOnExit=*/false);
+  EXPECT_TRUE(tooling::runToolOnCode(
+      std::make_unique<CTUMissingDefinitionAction>(), "int f(int);"));
+}
+
 TEST(CrossTranslationUnit, IndexFormatCanBeParsed) {
   llvm::StringMap<std::string> Index;
   Index["a"] = "/b/f1";
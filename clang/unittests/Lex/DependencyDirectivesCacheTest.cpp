@@ -0,0 +1,109 @@
+//===- unittests/Lex/DependencyDirectivesCacheTest.cpp --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/DependencyDirectivesCache.h"
+#include "clang/Basic/TokenKinds.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace clang;
+using namespace clang::dependency_directives_scan;
+
+namespace {
+
+constexpr StringLiteral Source = "#ifndef GUARD\n"
+                                 "#define GUARD\n"
+                                 "#include <a.h>\n"
+                                 "int x;\n"
+                                 "#endif\n";
+
+std::string printDirectives(StringRef Input,
+                            ArrayRef<Directive> Directives) {
+  std::string Out;
+  raw_string_ostream OS(Out);
+  printDependencyDirectivesAsSource(Input, Directives, OS);
+  return OS.str();
+}
+
+TEST(DependencyDirectivesCacheTest, RoundTrip) {
+  unittest::TempDir Dir("dep-directives-cache", /*Unique=*/true);
+  DependencyDirectivesCache Cache(Dir.path("cache"));
+
+  SmallVector<Token, 16> Tokens;
+  SmallVector<Directive, 16> Directives;
+  EXPECT_FALSE(Cache.lookup(Source, Tokens, Directives));
+  EXPECT_TRUE(Tokens.empty());
+  EXPECT_TRUE(Directives.empty());
+
+  ASSERT_FALSE(scanSourceForDependencyDirectives(Source, Tokens, Directives));
+  Cache.store(Source, Tokens, Directives);
+
+  SmallVector<Token, 16> CachedTokens;
+  SmallVector<Directive, 16> CachedDirectives;
+  ASSERT_TRUE(Cache.lookup(Source, CachedTokens, CachedDirectives));
+  ASSERT_EQ(Tokens.size(), CachedTokens.size());
+  for (size_t I = 0, E = Tokens.size(); I != E; ++I) {
+    EXPECT_EQ(Tokens[I].Offset, CachedTokens[I].Offset);
+    EXPECT_EQ(Tokens[I].Length, CachedTokens[I].Length);
+    EXPECT_EQ(Tokens[I].Kind, CachedTokens[I].Kind);
+    EXPECT_EQ(Tokens[I].Flags, CachedTokens[I].Flags);
+  }
+  ASSERT_EQ(Directives.size(), CachedDirectives.size());
+  for (size_t I = 0, E = Directives.size(); I != E; ++I) {
+    EXPECT_EQ(Directives[I].Kind, CachedDirectives[I].Kind);
+    EXPECT_EQ(Directives[I].Tokens.size(), CachedDirectives[I].Tokens.size());
+  }
+  EXPECT_EQ(printDirectives(Source, Directives),
+            printDirectives(Source, CachedDirectives));
+
+  // Other contents are not found.
+  CachedTokens.clear();
+  CachedDirectives.clear();
+  EXPECT_FALSE(Cache.lookup("#include <b.h>\n", CachedTokens,
+                            CachedDirectives));
+  EXPECT_TRUE(CachedTokens.empty());
+  EXPECT_TRUE(CachedDirectives.empty());
+}
+
+TEST(DependencyDirectivesCacheTest, CorruptEntry) {
+  unittest::TempDir Dir("dep-directives-cache", /*Unique=*/true);
+  DependencyDirectivesCache Cache(Dir.path());
+
+  SmallVector<Token, 16> Tokens;
+  SmallVector<Directive, 16> Directives;
+  ASSERT_FALSE(scanSourceForDependencyDirectives(Source, Tokens, Directives));
+  Cache.store(Source, Tokens, Directives);
+
+  // Cut the only entry in the cache short.
+  std::error_code EC;
+  sys::fs::directory_iterator It(Dir.path(), EC);
+  ASSERT_FALSE(EC);
+  ASSERT_NE(It, sys::fs::directory_iterator());
+  std::string EntryPath = It->path();
+  uint64_t Size;
+  ASSERT_FALSE(sys::fs::file_size(EntryPath, Size));
+  int FD;
+  ASSERT_FALSE(sys::fs::openFileForReadWrite(EntryPath, FD,
+                                             sys::fs::CD_OpenExisting,
+                                             sys::fs::OF_None));
+  EXPECT_FALSE(sys::fs::resize_file(FD, Size - 1));
+  sys::Process::SafelyCloseFileDescriptor(FD);
+
+  SmallVector<Token, 16> CachedTokens;
+  SmallVector<Directive, 16> CachedDirectives;
+  EXPECT_FALSE(Cache.lookup(Source, CachedTokens, CachedDirectives));
+  EXPECT_TRUE(CachedTokens.empty());
+  EXPECT_TRUE(CachedDirectives.empty());
+}
+
+} // namespace
@@ -660,4 +660,62 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   }
   EXPECT_TRUE(ToksView.empty());
 }
+
+// The lexer skips long runs of simple characters in blocks; check that it
+// stops at the right places when the interesting character is deep inside a
+// block, at its edges, or beyond the last whole block.
+TEST_F(LexerTest, LongIdentifiers) {
+  std::string LongId(61, 'a');
+  LongId += "_Z09";
+  // The sources must outlive the tokens lexed from them.
+  std::vector<std::string> Sources;
+  for (size_t Len = 1; Len <= LongId.size(); ++Len) {
+    std::string Id = LongId.substr(0, Len);
+    Sources.push_back(Id + "+" + Id);
+    auto Toks = CheckLex(Sources.back(),
+                         {tok::identifier, tok::plus, tok::identifier});
+    EXPECT_EQ(Id, getSourceText(Toks[0], Toks[0]));
+    EXPECT_EQ(Id, getSourceText(Toks[2], Toks[2]));
+  }
+}
+
+TEST_F(LexerTest, LongWhitespace) {
+  std::string Spaces = " \t\f\v                                 \t";
+  std::string Source = "x" + Spaces + "y" + Spaces + "\n" + Spaces + "z";
+  auto Toks = CheckLex(Source,
+                       {tok::identifier, tok::identifier, tok::identifier});
+  EXPECT_EQ("y", getSourceText(Toks[1], Toks[1]));
+  EXPECT_TRUE(Toks[1].hasLeadingSpace());
+  EXPECT_FALSE(Toks[1].isAtStartOfLine());
+  EXPECT_TRUE(Toks[2].isAtStartOfLine());
+}
+
+TEST_F(LexerTest, LongLineComments) {
+  auto Toks =
+      CheckLex("// a line comment that spans more than one block\n"
+               "x // and one with a non-ASCII \xc3\xa9 character\r\n"
+               "y // and an escaped newline at the end of a block \\\n"
+               "z\n"
+               "w",
+               {tok::identifier, tok::identifier, tok::identifier});
+  EXPECT_EQ("x", getSourceText(Toks[0], Toks[0]));
+  EXPECT_EQ("y", getSourceText(Toks[1], Toks[1]));
+  EXPECT_EQ("w", getSourceText(Toks[2], Toks[2]));
+}
+
+TEST_F(LexerTest, LongStringLiterals) {
+  auto Toks = CheckLex(R"cpp("a string literal that is longer than a block"
+                             "with an escaped \" quote past the first block"
+                             "and a trigraph ??' past the first block")cpp",
+                       {tok::string_literal, tok::string_literal,
+                        tok::string_literal});
+  EXPECT_EQ(R"cpp("with an escaped \" quote past the first block")cpp",
+            getSourceText(Toks[1], Toks[1]));
+
+  LangOpts.CPlusPlus11 = true;
+  Toks = CheckLex(R"cpp(R"x(a raw string with ) and )" past the first block)x"
+                        R"(short)")cpp",
+                  {tok::string_literal, tok::string_literal});
+  EXPECT_EQ(R"cpp(R"(short)")cpp", getSourceText(Toks[1], Toks[1]));
+}
 } // anonymous namespace
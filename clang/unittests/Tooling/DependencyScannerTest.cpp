@@ -14,6 +14,7 @@
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Tooling/CompilationDatabase.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningTool.h"
 #include "clang/Tooling/Tooling.h"
 #include "llvm/ADT/STLExtras.h"
@@ -301,3 +302,40 @@ TEST(DependencyScanner, ScanDepsWithModuleLookup) {
               InterceptFS->StatPaths.end());
   EXPECT_EQ(InterceptFS->ReadFiles, std::vector<std::string>{"test.m"});
 }
+
+TEST(DependencyScanner, InvalidateChangedEntries) {
+  auto Sept = llvm::sys::path::get_separator();
+  std::string ChangedPath =
+      std::string(llvm::formatv("{0}root{0}changed.h", Sept));
+  std::string SamePath = std::string(llvm::formatv("{0}root{0}same.h", Sept));
+  std::string NewPath = std::string(llvm::formatv("{0}root{0}new.h", Sept));
+
+  auto OldFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  OldFS->addFile(ChangedPath, 0, llvm::MemoryBuffer::getMemBuffer("old\n"));
+  OldFS->addFile(SamePath, 0, llvm::MemoryBuffer::getMemBuffer("same\n"));
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  {
+    DependencyScanningWorkerFilesystem DepFS(SharedCache, OldFS);
+    EXPECT_TRUE(DepFS.status(ChangedPath));
+    EXPECT_TRUE(DepFS.status(SamePath));
+    EXPECT_FALSE(DepFS.status(NewPath));
+  }
+
+  // The same files, except that one was rewritten and one was created.
+  auto NewFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  NewFS->addFile(ChangedPath, 1, llvm::MemoryBuffer::getMemBuffer("new!\n"));
+  NewFS->addFile(SamePath, 0, llvm::MemoryBuffer::getMemBuffer("same\n"));
+  NewFS->addFile(NewPath, 0, llvm::MemoryBuffer::getMemBuffer("\n"));
+  EXPECT_EQ(SharedCache.invalidateChangedEntries(*NewFS), 2u);
+  EXPECT_EQ(SharedCache.invalidateChangedEntries(*NewFS), 0u);
+
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, NewFS);
+  auto Changed = DepFS.getOrCreateFileSystemEntry(ChangedPath);
+  ASSERT_TRUE(Changed);
+  EXPECT_EQ(Changed->getContents(), "new!\n");
+  auto Same = DepFS.getOrCreateFileSystemEntry(SamePath);
+  ASSERT_TRUE(Same);
+  EXPECT_EQ(Same->getContents(), "same\n");
+  EXPECT_TRUE(DepFS.status(NewPath));
+}
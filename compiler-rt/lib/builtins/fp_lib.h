@@ -145,62 +145,29 @@ static __inline int rep_clz(rep_t a) {
   return __builtin_clzll(word) + add;
 }
 
-#define Word_LoMask UINT64_C(0x00000000ffffffff)
-#define Word_HiMask UINT64_C(0xffffffff00000000)
-#define Word_FullMask UINT64_C(0xffffffffffffffff)
-#define Word_1(a) (uint64_t)((a >> 96) & Word_LoMask)
-#define Word_2(a) (uint64_t)((a >> 64) & Word_LoMask)
-#define Word_3(a) (uint64_t)((a >> 32) & Word_LoMask)
-#define Word_4(a) (uint64_t)(a & Word_LoMask)
-
-// 128x128 -> 256 wide multiply for platforms that don't have such an operation;
-// many 64-bit platforms have this operation, but they tend to have hardware
-// floating-point, so we don't bother with a special case for them here.
-static __inline void wideMultiply(rep_t a, rep_t b, rep_t *hi, rep_t *lo) {
-
-  const uint64_t product11 = Word_1(a) * Word_1(b);
-  const uint64_t product12 = Word_1(a) * Word_2(b);
-  const uint64_t product13 = Word_1(a) * Word_3(b);
-  const uint64_t product14 = Word_1(a) * Word_4(b);
-  const uint64_t product21 = Word_2(a) * Word_1(b);
-  const uint64_t product22 = Word_2(a) * Word_2(b);
-  const uint64_t product23 = Word_2(a) * Word_3(b);
-  const uint64_t product24 = Word_2(a) * Word_4(b);
-  const uint64_t product31 = Word_3(a) * Word_1(b);
-  const uint64_t product32 = Word_3(a) * Word_2(b);
-  const uint64_t product33 = Word_3(a) * Word_3(b);
-  const uint64_t product34 = Word_3(a) * Word_4(b);
-  const uint64_t product41 = Word_4(a) * Word_1(b);
-  const uint64_t product42 = Word_4(a) * Word_2(b);
-  const uint64_t product43 = Word_4(a) * Word_3(b);
-  const uint64_t product44 = Word_4(a) * Word_4(b);
-
-  const __uint128_t sum0 = (__uint128_t)product44;
-  const __uint128_t sum1 = (__uint128_t)product34 + (__uint128_t)product43;
-  const __uint128_t sum2 =
-      (__uint128_t)product24 + (__uint128_t)product33 + (__uint128_t)product42;
-  const __uint128_t sum3 = (__uint128_t)product14 + (__uint128_t)product23 +
-                           (__uint128_t)product32 + (__uint128_t)product41;
-  const __uint128_t sum4 =
-      (__uint128_t)product13 + (__uint128_t)product22 + (__uint128_t)product31;
-  const __uint128_t sum5 = (__uint128_t)product12 + (__uint128_t)product21;
-  const __uint128_t sum6 = (__uint128_t)product11;
-
-  const __uint128_t r0 = (sum0 & Word_FullMask) + ((sum1 & Word_LoMask) << 32);
-  const __uint128_t r1 = (sum0 >> 64) + ((sum1 >> 32) & Word_FullMask) +
-                         (sum2 & Word_FullMask) + ((sum3 << 32) & Word_HiMask);
+#define loWord(a) (uint64_t)(a)
+#define hiWord(a) (uint64_t)((a) >> 64)
 
+// 128x128 -> 256 wide multiply. __uint128_t is always available here, so
+// build the result from four 64x64 -> 128 products rather than sixteen
+// 32x32 -> 64 ones; targets with a widening multiply (x86-64 MUL, AArch64
+// MUL/UMULH) lower each of these to one or two instructions.
+static __inline void wideMultiply(rep_t a, rep_t b, rep_t *hi, rep_t *lo) {
+  // Each of the component 64x64 -> 128 products
+  const __uint128_t plolo = (__uint128_t)loWord(a) * loWord(b);
+  const __uint128_t plohi = (__uint128_t)loWord(a) * hiWord(b);
+  const __uint128_t philo = (__uint128_t)hiWord(a) * loWord(b);
+  const __uint128_t phihi = (__uint128_t)hiWord(a) * hiWord(b);
+  // Sum terms that contribute to lo in a way that allows us to get the carry
+  const __uint128_t r0 = loWord(plolo);
+  const __uint128_t r1 =
+      (__uint128_t)hiWord(plolo) + loWord(plohi) + loWord(philo);
   *lo = r0 + (r1 << 64);
-  *hi = (r1 >> 64) + (sum1 >> 96) + (sum2 >> 64) + (sum3 >> 32) + sum4 +
-        (sum5 << 32) + (sum6 << 64);
+  // Sum terms contributing to hi with the carry from lo
+  *hi = phihi + hiWord(plohi) + hiWord(philo) + hiWord(r1);
 }
-#undef Word_1
-#undef Word_2
-#undef Word_3
-#undef Word_4
-#undef Word_HiMask
-#undef Word_LoMask
-#undef Word_FullMask
+#undef loWord
+#undef hiWord
 #endif // __LDBL_MANT_DIG__ == 113 && __SIZEOF_INT128__
 #else
 #error SINGLE_PRECISION, DOUBLE_PRECISION or QUAD_PRECISION must be defined.
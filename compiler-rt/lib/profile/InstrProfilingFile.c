@@ -564,16 +564,18 @@ static int writeProfileWithFileObject(const char *Filename, FILE *File) {
   return rc;
 }
 
-static void initializeProfileForContinuousMode(void) {
+/* Map the counters into the profile file. Return 0 on success, or if there is
+ * nothing to do, and 1 if the counters could not be mapped. */
+static int mapProfileForContinuousMode(void) {
   if (!__llvm_profile_is_continuous_mode_enabled())
-    return;
+    return 0;
   if (!ContinuousModeSupported) {
     PROF_ERR("%s\n", "continuous mode is unsupported on this platform");
-    return;
+    return 1;
   }
   if (UseBiasVar && BiasAddr == BiasDefaultAddr) {
     PROF_ERR("%s\n", "__llvm_profile_counter_bias is undefined");
-    return;
+    return 1;
   }
 
   /* Get the sizes of counter section. */
@@ -584,7 +586,7 @@ static void initializeProfileForContinuousMode(void) {
   char *FilenameBuf = (char *)COMPILER_RT_ALLOCA(Length + 1);
   const char *Filename = getCurFilename(FilenameBuf, 0);
   if (!Filename)
-    return;
+    return 1;
 
   FILE *File = NULL;
   uint64_t CurrentFileOffset = 0;
@@ -595,13 +597,13 @@ static void initializeProfileForContinuousMode(void) {
      * section mapped. */
     File = lprofOpenFileEx(Filename);
     if (!File)
-      return;
+      return 1;
 
     uint64_t ProfileFileSize = 0;
     if (getProfileFileSizeForMerging(File, &ProfileFileSize) == -1) {
       lprofUnlockFileHandle(File);
       fclose(File);
-      return;
+      return 1;
     }
     if (ProfileFileSize == 0) {
       /* Grow the profile so that mmap() can succeed.  Leak the file handle, as
@@ -609,7 +611,7 @@ static void initializeProfileForContinuousMode(void) {
       if (writeProfileWithFileObject(Filename, File) != 0) {
         lprofUnlockFileHandle(File);
         fclose(File);
-        return;
+        return 1;
       }
     } else {
       /* The merged profile has a non-zero length. Check that it is compatible
@@ -618,14 +620,14 @@ static void initializeProfileForContinuousMode(void) {
       if (mmapProfileForMerging(File, ProfileFileSize, &ProfileBuffer) == -1) {
         lprofUnlockFileHandle(File);
         fclose(File);
-        return;
+        return 1;
       }
       (void)munmap(ProfileBuffer, ProfileFileSize);
     }
   } else {
     File = fopen(Filename, FileOpenMode);
     if (!File)
-      return;
+      return 1;
     /* Check that the offset within the file is page-aligned. */
     CurrentFileOffset = ftell(File);
     unsigned PageSize = getpagesize();
@@ -633,23 +635,35 @@ static void initializeProfileForContinuousMode(void) {
       PROF_ERR("Continuous counter sync mode is enabled, but raw profile is not"
                "page-aligned. CurrentFileOffset = %" PRIu64 ", pagesz = %u.\n",
                (uint64_t)CurrentFileOffset, PageSize);
-      return;
+      return 1;
     }
     if (writeProfileWithFileObject(Filename, File) != 0) {
       fclose(File);
-      return;
+      return 1;
     }
   }
 
   /* mmap() the profile counters so long as there is at least one counter.
    * If there aren't any counters, mmap() would fail with EINVAL. */
+  int rc = 0;
   if (CountersSize > 0)
-    mmapForContinuousMode(CurrentFileOffset, File);
+    rc = mmapForContinuousMode(CurrentFileOffset, File);
 
   if (doMerging()) {
     lprofUnlockFileHandle(File);
     fclose(File);
   }
+  return rc;
+}
+
+static void initializeProfileForContinuousMode(void) {
+  if (!mapProfileForContinuousMode())
+    return;
+  /* The counters still live in memory. Rather than silently losing them, fall
+   * back to writing the profile out at exit. */
+  PROF_WARN("%s\n", "continuous mode could not be set up, the profile will be "
+                    "written at exit instead");
+  lprofDisableContinuousMode();
 }
 
 static const char *DefaultProfileName = "default.profraw";
@@ -183,6 +183,10 @@ uint64_t lprofGetLoadModuleSignature();
 unsigned lprofProfileDumped(void);
 void lprofSetProfileDumped(unsigned);
 
+/* Turn continuous mode off again, so that the profile is written out at exit
+ * instead. Used when the counters could not be mapped into the profile. */
+void lprofDisableContinuousMode(void);
+
 COMPILER_RT_VISIBILITY extern void (*FreeHook)(void *);
 COMPILER_RT_VISIBILITY extern uint8_t *DynamicBufferIOBuffer;
 COMPILER_RT_VISIBILITY extern uint32_t VPBufferSize;
@@ -63,12 +63,17 @@ class StackDepotBase {
 
  private:
   friend Node;
-  u32 find(u32 s, args_type args, hash_type hash) const;
+  u32 find(u32 s, args_type args, hash_type hash, u32 stop = 0) const;
+  u32 acquire_id();
+  void release_id(u32 id);
   static u32 lock(atomic_uint32_t *p);
   static void unlock(atomic_uint32_t *p, u32 s);
   atomic_uint32_t tab[kTabSize];  // Hash table of Node's.
 
   atomic_uint32_t n_uniq_ids;
+  // An id taken by a Put() that found the stack inserted by another thread
+  // before publishing its node, or 0. Reused by the next insert.
+  atomic_uint32_t free_id;
 
   TwoLevelMap<Node, kNodesSize1, kNodesSize2> nodes;
 
@@ -77,9 +82,10 @@ class StackDepotBase {
 
 template <class Node, int kReservedBits, int kTabSizeLog>
 u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::find(
-    u32 s, args_type args, hash_type hash) const {
-  // Searches linked list s for the stack, returns its id.
-  for (; s;) {
+    u32 s, args_type args, hash_type hash, u32 stop) const {
+  // Searches linked list s for the stack, returns its id. Nodes are only ever
+  // prepended, so the search can stop at the head of an earlier search.
+  for (; s && s != stop;) {
     const Node &node = nodes[s];
     if (node.eq(hash, args))
       return s;
@@ -111,6 +117,25 @@ void StackDepotBase<Node, kReservedBits, kTabSizeLog>::unlock(
   atomic_store(p, s, memory_order_release);
 }
 
+template <class Node, int kReservedBits, int kTabSizeLog>
+u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::acquire_id() {
+  u32 id = atomic_exchange(&free_id, 0, memory_order_acquire);
+  if (id)
+    return id;
+  id = atomic_fetch_add(&n_uniq_ids, 1, memory_order_relaxed) + 1;
+  CHECK_EQ(id & kUnlockMask, id);
+  CHECK_EQ(id & (((u32)-1) >> kReservedBits), id);
+  return id;
+}
+
+template <class Node, int kReservedBits, int kTabSizeLog>
+void StackDepotBase<Node, kReservedBits, kTabSizeLog>::release_id(u32 id) {
+  // The node was never published, so nobody can be reading it. If the slot is
+  // already taken the id is lost, which only happens under heavy contention.
+  u32 cmp = 0;
+  atomic_compare_exchange_strong(&free_id, &cmp, id, memory_order_release);
+}
+
 template <class Node, int kReservedBits, int kTabSizeLog>
 u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Put(args_type args,
                                                           bool *inserted) {
@@ -127,24 +152,52 @@ u32 StackDepotBase<Node, kReservedBits, kTabSizeLog>::Put(args_type args,
   if (LIKELY(node))
     return node;
 
-  // If failed, lock, retry and insert new.
-  u32 s2 = lock(p);
-  if (s2 != s) {
-    node = find(s2, args, h);
+  // If failed, store the new node first and then publish it with a CAS on the
+  // bucket head. Storing may allocate or compress the stack store, so doing it
+  // without the bucket locked keeps other inserts into the bucket from waiting.
+  u32 id = acquire_id();
+  // Another thread may have inserted the stack meanwhile. Check only the part
+  // of the bucket added since the search above.
+  v = atomic_load(p, memory_order_consume);
+  if ((v & kUnlockMask) != s) {
+    node = find(v & kUnlockMask, args, h, s);
     if (node) {
-      unlock(p, s2);
+      release_id(id);
       return node;
     }
+    s = v & kUnlockMask;
+  }
+  Node &new_node = nodes[id];
+  new_node.store(id, args, h);
+  for (int i = 0;; i++) {
+    if ((v & kLockMask) == 0) {
+      new_node.link = s;
+      if (atomic_compare_exchange_weak(p, &v, id, memory_order_release)) {
+        if (inserted)
+          *inserted = true;
+        return id;
+      }
+    } else {
+      // The table is locked by LockAll(); wait for UnlockAll().
+      if (i < 10)
+        proc_yield(10);
+      else
+        internal_sched_yield();
+      v = atomic_load(p, memory_order_consume);
+    }
+    // The bucket changed; another thread may have inserted the same stack.
+    // If so, use its id and give ours to the next insert. Only the copy of
+    // the trace stored above is lost.
+    u32 s2 = v & kUnlockMask;
+    if (s2 != s) {
+      node = find(s2, args, h, s);
+      if (node) {
+        release_id(id);
+        return node;
+      }
+      s = s2;
+    }
   }
-  s = atomic_fetch_add(&n_uniq_ids, 1, memory_order_relaxed) + 1;
-  CHECK_EQ(s & kUnlockMask, s);
-  CHECK_EQ(s & (((u32)-1) >> kReservedBits), s);
-  Node &new_node = nodes[s];
-  new_node.store(s, args, h);
-  new_node.link = s2;
-  unlock(p, s);
-  if (inserted) *inserted = true;
-  return s;
 }
 
 template <class Node, int kReservedBits, int kTabSizeLog>
@@ -164,10 +217,12 @@ void StackDepotBase<Node, kReservedBits, kTabSizeLog>::LockAll() {
   for (int i = 0; i < kTabSize; ++i) {
     lock(&tab[i]);
   }
+  nodes.Lock();
 }
 
 template <class Node, int kReservedBits, int kTabSizeLog>
 void StackDepotBase<Node, kReservedBits, kTabSizeLog>::UnlockAll() {
+  nodes.Unlock();
   for (int i = 0; i < kTabSize; ++i) {
     atomic_uint32_t *p = &tab[i];
     uptr s = atomic_load(p, memory_order_relaxed);
@@ -83,6 +83,33 @@ TEST_F(StackDepotTest, Several) {
   EXPECT_NE(i1, i2);
 }
 
+TEST_F(StackDepotTest, ConcurrentSame) {
+  constexpr u32 kThreads = 8;
+  constexpr u32 kStacks = 1000;
+  std::vector<std::vector<u32>> ids(kThreads, std::vector<u32>(kStacks));
+  std::atomic<u32> ready = {};
+  auto thread = [&](u32 t) {
+    ready++;
+    while (ready < kThreads) std::this_thread::yield();
+    for (u32 i = 0; i < kStacks; ++i) {
+      uptr array[] = {0x111, 0x222, i, 0x444, 0x555};
+      StackTrace s(array, ARRAY_SIZE(array));
+      ids[t][i] = StackDepotPut(s);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (u32 t = 0; t < kThreads; ++t) threads.emplace_back(thread, t);
+  for (auto& t : threads) t.join();
+
+  for (u32 t = 1; t < kThreads; ++t) EXPECT_EQ(ids[0], ids[t]);
+  for (u32 i = 0; i < kStacks; ++i) {
+    uptr array[] = {0x111, 0x222, i, 0x444, 0x555};
+    StackTrace stack = StackDepotGet(ids[0][i]);
+    ASSERT_EQ(ARRAY_SIZE(array), stack.size);
+    EXPECT_EQ(0, internal_memcmp(stack.trace, array, sizeof(array)));
+  }
+}
+
 TEST_F(StackDepotTest, Print) {
   uptr array1[] = {0x111, 0x222, 0x333, 0x444, 0x777};
   StackTrace s1(array1, ARRAY_SIZE(array1));
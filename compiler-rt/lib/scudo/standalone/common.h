@@ -142,6 +142,11 @@ inline uptr getPageSizeCached() {
 // Returns 0 if the number of CPUs could not be determined.
 u32 getNumberOfCPUs();
 
+// Returns the index of the CPU the calling thread is running on, or ~0U if it
+// could not be determined. The result is only a hint, as the thread may be
+// migrated right after the call.
+u32 getCurrentCPU();
+
 const char *getEnv(const char *Name);
 
 uptr GetRSS();
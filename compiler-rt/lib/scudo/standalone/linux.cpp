@@ -160,6 +160,11 @@ u32 getNumberOfCPUs() {
   return static_cast<u32>(CPU_COUNT(&CPUs));
 }
 
+u32 getCurrentCPU() {
+  const int CPU = sched_getcpu();
+  return CPU < 0 ? ~0U : static_cast<u32>(CPU);
+}
+
 u32 getThreadID() {
 #if SCUDO_ANDROID
   return static_cast<u32>(gettid());
@@ -11,6 +11,7 @@
 
 #include "bytemap.h"
 #include "common.h"
+#include "flags.h"
 #include "list.h"
 #include "local_cache.h"
 #include "mem_map.h"
@@ -69,6 +70,10 @@ public:
     const uptr PageSize = getPageSizeCached();
     const uptr GroupSize = (1U << GroupSizeLog);
     const uptr PagesInGroup = GroupSize / PageSize;
+    // A huge page is what one page-sized table of 8-byte page table entries
+    // maps, e.g. 2MB with 4KB pages.
+    if (getFlags()->release_whole_huge_pages)
+      ReleaseGranularity = PageSize * (PageSize / sizeof(u64));
     const uptr MinSizeClass = getSizeByClassId(1);
     // When trying to release pages back to memory, visiting smaller size
     // classes is expensive. Therefore, we only try to release smaller size
@@ -131,6 +136,9 @@ public:
         Region->TryReleaseThreshold = PageSize * SmallerBlockReleasePageDelta;
       else
         Region->TryReleaseThreshold = PageSize;
+      // Nothing can be released until a whole granule may be free.
+      Region->TryReleaseThreshold =
+          Max(Region->TryReleaseThreshold, ReleaseGranularity);
       Region->ReleaseInfo.LastReleaseAtNs = Time;
     }
     shuffle(RegionInfoArray, NumClasses, &Seed);
@@ -488,6 +496,7 @@ private:
     uptr BytesInFreeListAtLastCheckpoint;
     uptr RangesReleased;
     uptr LastReleasedBytes;
+    uptr LastRetainedBytes;
     u64 LastReleaseAtNs;
   };
 
@@ -533,6 +542,9 @@ private:
   // The minimum size of pushed blocks that we will try to release the pages in
   // that size class.
   uptr SmallerBlockReleasePageDelta = 0;
+  // If non-zero, pages are only released in whole, aligned ranges of this
+  // size. See the `release_whole_huge_pages` flag.
+  uptr ReleaseGranularity = 0;
   atomic_s32 ReleaseToOsIntervalMs = {};
   alignas(SCUDO_CACHE_LINE_SIZE) RegionInfo RegionInfoArray[NumClasses];
 
@@ -908,13 +920,14 @@ private:
         Region->MemMapInfo.AllocatedUser / getSizeByClassId(ClassId);
     Str->append("%s %02zu (%6zu): mapped: %6zuK popped: %7zu pushed: %7zu "
                 "inuse: %6zu total: %6zu rss: %6zuK releases: %6zu last "
-                "released: %6zuK region: 0x%zx (0x%zx)\n",
+                "released: %6zuK retained: %6zuK region: 0x%zx (0x%zx)\n",
                 Region->Exhausted ? "F" : " ", ClassId,
                 getSizeByClassId(ClassId), Region->MemMapInfo.MappedUser >> 10,
                 Region->FreeListInfo.PoppedBlocks,
                 Region->FreeListInfo.PushedBlocks, InUse, TotalChunks,
                 Rss >> 10, Region->ReleaseInfo.RangesReleased,
-                Region->ReleaseInfo.LastReleasedBytes >> 10, Region->RegionBeg,
+                Region->ReleaseInfo.LastReleasedBytes >> 10,
+                Region->ReleaseInfo.LastRetainedBytes >> 10, Region->RegionBeg,
                 getRegionBaseByClassId(ClassId));
   }
 
@@ -1175,7 +1188,8 @@ private:
       // back to normal.
       if (MinDistToThreshold == GroupSize)
         MinDistToThreshold = PageSize * SmallerBlockReleasePageDelta;
-      Region->TryReleaseThreshold = MinDistToThreshold;
+      // As in init(), don't try to release less than a whole granule.
+      Region->TryReleaseThreshold = Max(MinDistToThreshold, ReleaseGranularity);
     }
 
     if (GroupToRelease.empty())
@@ -1197,7 +1211,8 @@ private:
     const uptr ReleaseOffset = ReleaseBase - Region->RegionBeg;
 
     RegionReleaseRecorder<MemMapT> Recorder(&Region->MemMapInfo.MemMap,
-                                            Region->RegionBeg, ReleaseOffset);
+                                            Region->RegionBeg, ReleaseOffset,
+                                            ReleaseGranularity);
     PageReleaseContext Context(BlockSize, /*NumberOfRegions=*/1U,
                                ReleaseRangeSize, ReleaseOffset);
     // We may not be able to do the page release in a rare case that we may
@@ -1254,6 +1269,7 @@ private:
       Region->ReleaseInfo.RangesReleased += Recorder.getReleasedRangesCount();
       Region->ReleaseInfo.LastReleasedBytes = Recorder.getReleasedBytes();
     }
+    Region->ReleaseInfo.LastRetainedBytes = Recorder.getRetainedBytes();
     Region->ReleaseInfo.LastReleaseAtNs = getMonotonicTimeFast();
 
     // Merge GroupToRelease back to the Region::FreeListInfo.BlockList. Note
@@ -19,32 +19,54 @@ namespace scudo {
 
 template <typename MemMapT> class RegionReleaseRecorder {
 public:
-  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0)
-      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset) {}
+  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0,
+                        uptr Granularity = 0)
+      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset),
+        Granularity(Granularity) {}
 
   uptr getReleasedRangesCount() const { return ReleasedRangesCount; }
 
   uptr getReleasedBytes() const { return ReleasedBytes; }
 
+  // Free bytes that were kept mapped because they did not cover a whole
+  // release granule.
+  uptr getRetainedBytes() const { return RetainedBytes; }
+
   uptr getBase() const { return Base; }
 
   // Releases [From, To) range of pages back to OS. Note that `From` and `To`
-  // are offseted from `Base` + Offset.
+  // are offseted from `Base` + Offset. If a granularity is set, the range is
+  // shrunk to the whole, aligned granules it contains, which keeps huge pages
+  // backing the rest of the region intact.
   void releasePageRangeToOS(uptr From, uptr To) {
-    const uptr Size = To - From;
-    RegionMemMap->releasePagesToOS(getBase() + Offset + From, Size);
+    uptr Beg = getBase() + Offset + From;
+    uptr End = getBase() + Offset + To;
+    if (Granularity) {
+      const uptr Size = To - From;
+      Beg = roundUp(Beg, Granularity);
+      End = roundDown(End, Granularity);
+      if (End <= Beg) {
+        RetainedBytes += Size;
+        return;
+      }
+      RetainedBytes += Size - (End - Beg);
+    }
+    RegionMemMap->releasePagesToOS(Beg, End - Beg);
     ReleasedRangesCount++;
-    ReleasedBytes += Size;
+    ReleasedBytes += End - Beg;
   }
 
 private:
   uptr ReleasedRangesCount = 0;
   uptr ReleasedBytes = 0;
+  uptr RetainedBytes = 0;
   MemMapT *RegionMemMap = nullptr;
   uptr Base = 0;
   // The release offset from Base. This is used when we know a given range after
   // Base will not be released.
   uptr Offset = 0;
+  // If non-zero, only whole and aligned ranges of this size are released.
+  uptr Granularity = 0;
 };
 
 class ReleaseRecorder {
@@ -657,3 +657,34 @@ TEST(ScudoReleaseTest, BufferPool) {
   for (auto &Buffer : Buffers)
     Pool->releaseBuffer(Buffer.first, Buffer.second);
 }
+
+TEST(ScudoReleaseTest, RegionReleaseRecorderGranularity) {
+  struct MockMemMap {
+    void releasePagesToOS(scudo::uptr From, scudo::uptr Size) {
+      Released.emplace_back(From, Size);
+    }
+    std::vector<std::pair<scudo::uptr, scudo::uptr>> Released;
+  };
+  constexpr scudo::uptr Granularity = 1UL << 21;
+  constexpr scudo::uptr Base = 0x40000000;
+  constexpr scudo::uptr PageSize = 4096;
+  MockMemMap MemMap;
+  scudo::RegionReleaseRecorder<MockMemMap> Recorder(&MemMap, Base,
+                                                    /*Offset=*/PageSize,
+                                                    Granularity);
+
+  // Too small to cover a whole granule: nothing is released.
+  Recorder.releasePageRangeToOS(0, Granularity / 2);
+  EXPECT_TRUE(MemMap.Released.empty());
+  EXPECT_EQ(Recorder.getRetainedBytes(), Granularity / 2);
+
+  // Only the aligned granule in the middle of the range is released.
+  Recorder.releasePageRangeToOS(Granularity - 2 * PageSize,
+                                2 * Granularity + Granularity / 2);
+  ASSERT_EQ(MemMap.Released.size(), 1U);
+  EXPECT_EQ(MemMap.Released[0].first, Base + Granularity);
+  EXPECT_EQ(MemMap.Released[0].second, Granularity);
+  EXPECT_EQ(Recorder.getReleasedRangesCount(), 1U);
+  EXPECT_EQ(Recorder.getReleasedBytes(), Granularity);
+  EXPECT_EQ(Recorder.getRetainedBytes(), Granularity + 2 * PageSize);
+}
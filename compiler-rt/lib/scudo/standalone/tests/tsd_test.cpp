@@ -250,3 +250,54 @@ TEST(ScudoTSDTest, TSDRegistryTSDsCount) {
   // We should get 16 distinct TSDs back.
   EXPECT_EQ(Pointers.size(), 16U);
 }
+
+static void getOwnTSD(MockAllocator<SharedCaches> *Allocator, void **P) {
+  auto Registry = Allocator->getTSDRegistry();
+  Registry->initThreadMaybe(Allocator, /*MinimalInit=*/false);
+  bool UnlockRequired;
+  auto TSD = Registry->getTSDAndLock(&UnlockRequired);
+  EXPECT_NE(TSD, nullptr);
+  *P = reinterpret_cast<void *>(TSD);
+  if (UnlockRequired)
+    TSD->unlock();
+}
+
+TEST(ScudoTSDTest, TSDRegistryRoundRobin) {
+  using AllocatorT = MockAllocator<SharedCaches>;
+  auto Deleter = [](AllocatorT *A) {
+    A->unmapTestOnly();
+    delete A;
+  };
+  std::unique_ptr<AllocatorT, decltype(Deleter)> Allocator(new AllocatorT,
+                                                           Deleter);
+  auto Registry = Allocator->getTSDRegistry();
+  Registry->initOnceMaybe(Allocator.get());
+  Registry->setOption(scudo::Option::MaxTSDsCount, 16);
+  // Threads are assigned their initial TSD in a round-robin fashion, regardless
+  // of the CPU they run on, so that 16 threads created one after the other get
+  // 16 distinct TSDs when nothing is contended.
+  std::set<void *> Set;
+  for (scudo::uptr I = 0; I < 16U; I++) {
+    void *P = nullptr;
+    std::thread T(getOwnTSD, Allocator.get(), &P);
+    T.join();
+    Set.insert(P);
+  }
+  EXPECT_EQ(Set.size(), 16U);
+
+  // When the current TSD is locked, the slow path hands out another one.
+  std::thread T([&Allocator, Registry]() {
+    Registry->initThreadMaybe(Allocator.get(), /*MinimalInit=*/false);
+    bool UnlockRequired1, UnlockRequired2;
+    auto TSD1 = Registry->getTSDAndLock(&UnlockRequired1);
+    auto TSD2 = Registry->getTSDAndLock(&UnlockRequired2);
+    EXPECT_NE(TSD1, nullptr);
+    EXPECT_NE(TSD2, nullptr);
+    EXPECT_NE(TSD1, TSD2);
+    if (UnlockRequired2)
+      TSD2->unlock();
+    if (UnlockRequired1)
+      TSD1->unlock();
+  });
+  T.join();
+}
@@ -101,6 +101,8 @@ u64 getMonotonicTimeFast() {
 
 u32 getNumberOfCPUs() { return 0; }
 
+u32 getCurrentCPU() { return ~0U; }
+
 u32 getThreadID() { return 0; }
 
 bool getRandom(UNUSED void *Buffer, UNUSED uptr Length, UNUSED bool Blocking) {
@@ -202,6 +202,16 @@ private:
       Inc = CoPrimes[R % NumberOfCoPrimes];
     }
     if (N > 1U) {
+      // The thread has likely been migrated since it picked its context, so
+      // first try the one associated with the CPU it is running on now.
+      const u32 CPU = getCurrentCPU();
+      if (CPU != ~0U) {
+        TSD<Allocator> *CPUTSD = &TSDs[CPU % N];
+        if (CPUTSD != CurrentTSD && CPUTSD->tryLock()) {
+          setCurrentTSD(CPUTSD);
+          return CPUTSD;
+        }
+      }
       u32 Index = R % N;
       uptr LowestPrecedence = UINTPTR_MAX;
       TSD<Allocator> *CandidateTSD = nullptr;
@@ -56,6 +56,14 @@ static bool IsAcqRelOrder(morder mo) {
   return mo == mo_acq_rel || mo == mo_seq_cst;
 }
 
+// Atomic accesses are only recorded in shadow memory to find races with
+// plain accesses and with free. Synchronization does not depend on it.
+ALWAYS_INLINE static void AtomicAccess(ThreadState *thr, uptr pc, uptr addr,
+                                       uptr size, AccessType typ) {
+  if (LIKELY(flags()->track_atomic_accesses))
+    MemoryAccess(thr, pc, addr, size, typ | kAccessAtomic);
+}
+
 template<typename T> T func_xchg(volatile T *v, T op) {
   T res = __sync_lock_test_and_set(v, op);
   // __sync_lock_test_and_set does not contain full barrier.
@@ -226,8 +234,7 @@ static T AtomicLoad(ThreadState *thr, uptr pc, const volatile T *a, morder mo) {
   // This fast-path is critical for performance.
   // Assume the access is atomic.
   if (!IsAcquireOrder(mo)) {
-    MemoryAccess(thr, pc, (uptr)a, AccessSize<T>(),
-                 kAccessRead | kAccessAtomic);
+    AtomicAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessRead);
     return NoTsanAtomicLoad(a, mo);
   }
   // Don't create sync object if it does not exist yet. For example, an atomic
@@ -242,7 +249,7 @@ static T AtomicLoad(ThreadState *thr, uptr pc, const volatile T *a, morder mo) {
     // of the value and the clock we acquire.
     v = NoTsanAtomicLoad(a, mo);
   }
-  MemoryAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessRead | kAccessAtomic);
+  AtomicAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessRead);
   return v;
 }
 
@@ -262,7 +269,7 @@ template <typename T>
 static void AtomicStore(ThreadState *thr, uptr pc, volatile T *a, T v,
                         morder mo) {
   DCHECK(IsStoreOrder(mo));
-  MemoryAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessWrite | kAccessAtomic);
+  AtomicAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessWrite);
   // This fast-path is critical for performance.
   // Assume the access is atomic.
   // Strictly saying even relaxed store cuts off release sequence,
@@ -283,7 +290,7 @@ static void AtomicStore(ThreadState *thr, uptr pc, volatile T *a, T v,
 
 template <typename T, T (*F)(volatile T *v, T op)>
 static T AtomicRMW(ThreadState *thr, uptr pc, volatile T *a, T v, morder mo) {
-  MemoryAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessWrite | kAccessAtomic);
+  AtomicAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessWrite);
   if (LIKELY(mo == mo_relaxed))
     return F(a, v);
   SlotLocker locker(thr);
@@ -411,7 +418,7 @@ static bool AtomicCAS(ThreadState *thr, uptr pc, volatile T *a, T *c, T v,
   // (mo_relaxed) when those are used.
   DCHECK(IsLoadOrder(fmo));
 
-  MemoryAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessWrite | kAccessAtomic);
+  AtomicAccess(thr, pc, (uptr)a, AccessSize<T>(), kAccessWrite);
   if (LIKELY(mo == mo_relaxed && fmo == mo_relaxed)) {
     T cc = *c;
     T pr = func_cas(a, cc, v);
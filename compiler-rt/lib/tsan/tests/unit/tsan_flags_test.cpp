@@ -40,6 +40,7 @@ static const char *options1 =
   " report_mutex_bugs=0"
   " report_signal_unsafe=0"
   " report_atomic_races=0"
+  " track_atomic_accesses=0"
   " force_seq_cst_atomics=0"
   " halt_on_error=0"
   " atexit_sleep_ms=222"
@@ -63,6 +64,7 @@ static const char *options2 =
   " report_mutex_bugs=true"
   " report_signal_unsafe=true"
   " report_atomic_races=true"
+  " track_atomic_accesses=true"
   " force_seq_cst_atomics=true"
   " halt_on_error=true"
   " atexit_sleep_ms=123"
@@ -86,6 +88,7 @@ void VerifyOptions1(Flags *f) {
   EXPECT_EQ(f->report_mutex_bugs, 0);
   EXPECT_EQ(f->report_signal_unsafe, 0);
   EXPECT_EQ(f->report_atomic_races, 0);
+  EXPECT_EQ(f->track_atomic_accesses, 0);
   EXPECT_EQ(f->force_seq_cst_atomics, 0);
   EXPECT_EQ(f->halt_on_error, 0);
   EXPECT_EQ(f->atexit_sleep_ms, 222);
@@ -109,6 +112,7 @@ void VerifyOptions2(Flags *f) {
   EXPECT_EQ(f->report_mutex_bugs, true);
   EXPECT_EQ(f->report_signal_unsafe, true);
   EXPECT_EQ(f->report_atomic_races, true);
+  EXPECT_EQ(f->track_atomic_accesses, true);
   EXPECT_EQ(f->force_seq_cst_atomics, true);
   EXPECT_EQ(f->halt_on_error, true);
   EXPECT_EQ(f->atexit_sleep_ms, 123);
@@ -137,6 +137,7 @@ BufferQueue::ErrorCode BufferQueue::init(size_t BS, size_t BC) {
   Next = Buffers;
   First = Buffers;
   LiveBuffers = 0;
+  atomic_store(&Exhausted, 0, memory_order_relaxed);
   atomic_store(&Finalizing, 0, memory_order_release);
   Success = true;
   return BufferQueue::ErrorCode::Ok;
@@ -154,7 +155,8 @@ BufferQueue::BufferQueue(size_t B, size_t N,
       Next(Buffers),
       First(Buffers),
       LiveBuffers(0),
-      Generation{0} {
+      Generation{0},
+      Exhausted{0} {
   Success = init(B, N) == BufferQueue::ErrorCode::Ok;
 }
 
@@ -165,8 +167,10 @@ BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
   BufferRep *B = nullptr;
   {
     SpinMutexLock Guard(&Mutex);
-    if (LiveBuffers == BufferCount)
+    if (LiveBuffers == BufferCount) {
+      atomic_fetch_add(&Exhausted, 1, memory_order_relaxed);
       return ErrorCode::NotEnoughMemory;
+    }
     B = Next++;
     if (Next == (Buffers + BufferCount))
       Next = Buffers;
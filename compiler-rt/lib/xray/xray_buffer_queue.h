@@ -163,6 +163,10 @@ private:
   // associated with.
   atomic_uint64_t Generation;
 
+  // Count of 'getBuffer' calls in the current generation that failed because
+  // all buffers were handed out.
+  atomic_uint64_t Exhausted;
+
   /// Releases references to the buffers backed by the current buffer queue.
   void cleanupBuffers();
 
@@ -237,6 +241,13 @@ public:
     return atomic_load(&Generation, memory_order_acquire);
   }
 
+  /// Returns how many times 'getBuffer' failed with ErrorCode::NotEnoughMemory
+  /// since the last 'init'. Each of these means that a thread dropped records
+  /// until it could get a buffer again.
+  uint64_t exhausted() const {
+    return atomic_load(&Exhausted, memory_order_relaxed);
+  }
+
   /// Returns the configured size of the buffers in the buffer queue.
   size_t ConfiguredBufferSize() const { return BufferSize; }
 
@@ -319,6 +319,11 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
       TLD.Controller->flush();
   });
 
+  if (uint64_t Exhausted = BQ->exhausted())
+    Report("XRay FDR: ran out of buffers %llu times; records were dropped. "
+           "Consider increasing 'buffer_max'.\n",
+           static_cast<unsigned long long>(Exhausted));
+
   if (fdrFlags()->no_file_flush) {
     if (Verbosity())
       Report("XRay FDR: Not flushing to file, 'no_file_flush=true'.\n");
@@ -0,0 +1,27 @@
+// REQUIRES: linux
+
+// Without -runtime-counter-relocation the counters cannot be mapped into the
+// profile. Check that the runtime falls back to writing it out at exit.
+
+// RUN: %clang -fprofile-instr-generate -fcoverage-mapping -o %t.exe %s
+// RUN: rm -f %t.profraw
+// RUN: env LLVM_PROFILE_FILE="%c%t.profraw" %run %t.exe 2>&1 | FileCheck %s -check-prefix=CHECK-WARN
+// RUN: llvm-profdata show --counts --all-functions %t.profraw | FileCheck %s -check-prefix=CHECK-COUNTS
+
+// CHECK-WARN: __llvm_profile_counter_bias is undefined
+// CHECK-WARN: continuous mode could not be set up, the profile will be written at exit instead
+
+// CHECK-COUNTS: Counters:
+// CHECK-COUNTS-NEXT:   main:
+// CHECK-COUNTS-NEXT:     Hash: 0x{{.*}}
+// CHECK-COUNTS-NEXT:     Counters: 2
+// CHECK-COUNTS-NEXT:     Function count: 1
+// CHECK-COUNTS-NEXT:     Block counts: [1]
+
+extern int __llvm_profile_is_continuous_mode_enabled(void);
+
+int main() {
+  if (__llvm_profile_is_continuous_mode_enabled())
+    return 1;
+  return 0;
+}
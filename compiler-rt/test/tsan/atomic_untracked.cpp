@@ -0,0 +1,33 @@
+// RUN: %clangxx_tsan -O1 %s -o %t && %env_tsan_opts=track_atomic_accesses=0 %run %t 2>&1 | FileCheck %s
+#include "test.h"
+
+// With track_atomic_accesses=0 races between atomic and plain accesses are
+// not reported, but atomics still synchronize plain accesses.
+
+long long counter;
+int data;
+int ready;
+
+void *Thread(void *p) {
+  counter = 42;
+  data = 1;
+  __atomic_store_n(&ready, 1, __ATOMIC_RELEASE);
+  barrier_wait(&barrier);
+  return 0;
+}
+
+int main() {
+  barrier_init(&barrier, 2);
+  pthread_t t;
+  pthread_create(&t, 0, Thread, 0);
+  __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+  barrier_wait(&barrier);
+  while (!__atomic_load_n(&ready, __ATOMIC_ACQUIRE)) {
+  }
+  data++;
+  pthread_join(t, 0);
+  fprintf(stderr, "DONE\n");
+}
+
+// CHECK-NOT: WARNING: ThreadSanitizer
+// CHECK: DONE
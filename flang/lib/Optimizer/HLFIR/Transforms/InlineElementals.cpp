@@ -67,7 +67,8 @@ namespace {
 class InlineElementalConversion
     : public mlir::OpRewritePattern<hlfir::ElementalOp> {
 public:
-  using mlir::OpRewritePattern<hlfir::ElementalOp>::OpRewritePattern;
+  InlineElementalConversion(mlir::MLIRContext *context, unsigned &numInlined)
+      : OpRewritePattern{context}, numInlined{numInlined} {}
 
   mlir::LogicalResult
   matchAndRewrite(hlfir::ElementalOp elemental,
@@ -95,9 +96,13 @@ public:
     rewriter.eraseOp(apply);
     rewriter.eraseOp(destroy);
     rewriter.eraseOp(elemental);
+    ++numInlined;
 
     return mlir::success();
   }
+
+private:
+  unsigned &numInlined;
 };
 
 class InlineElementalsPass
@@ -111,14 +116,16 @@ public:
     // Prevent the pattern driver from merging blocks.
     config.enableRegionSimplification = false;
 
+    unsigned numInlined = 0;
     mlir::RewritePatternSet patterns(context);
-    patterns.insert<InlineElementalConversion>(context);
+    patterns.insert<InlineElementalConversion>(context, numInlined);
 
     if (mlir::failed(mlir::applyPatternsAndFoldGreedily(
             func, std::move(patterns), config))) {
       mlir::emitError(func->getLoc(), "failure in HLFIR elemental inlining");
       signalPassFailure();
     }
+    numInlinedElementals += numInlined;
   }
 };
 } // namespace
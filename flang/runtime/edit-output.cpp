@@ -124,10 +124,32 @@ bool EditIntegerOutput(IoStatementState &io, const DataEdit &edit,
     if (isNegative || (edit.modes.editingFlags & signPlus)) {
       signChars = 1; // '-' or '+'
     }
-    while (un > 0) {
-      auto quotient{un / 10u};
-      *--p = '0' + static_cast<int>(un - Unsigned{10} * quotient);
-      un = quotient;
+    if constexpr (sizeof un > sizeof(std::uint64_t)) {
+      // Peel off 19 digits per wide division so that the digit loops run on
+      // 64-bit values instead of performing a wide division for every digit.
+      constexpr std::uint64_t tenToThe19{10000000000000000000u};
+      while (un >= Unsigned{tenToThe19}) {
+        auto quotient{un / Unsigned{tenToThe19}};
+        auto chunk{
+            static_cast<std::uint64_t>(un - Unsigned{tenToThe19} * quotient)};
+        for (int j{0}; j < 19; ++j) {
+          auto q{chunk / 10u};
+          *--p = '0' + static_cast<int>(chunk - 10u * q);
+          chunk = q;
+        }
+        un = quotient;
+      }
+      for (auto low{static_cast<std::uint64_t>(un)}; low > 0;) {
+        auto q{low / 10u};
+        *--p = '0' + static_cast<int>(low - 10u * q);
+        low = q;
+      }
+    } else {
+      while (un > 0) {
+        auto quotient{un / 10u};
+        *--p = '0' + static_cast<int>(un - Unsigned{10} * quotient);
+        un = quotient;
+      }
     }
     break;
   case 'B':
@@ -61,12 +61,12 @@ private:
 //     DO 1 K = 1, N
 //   1  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J)
 // With loop distribution and transposition to avoid the inner sum
-// reduction and to avoid non-unit strides:
-//   DO 1 I = 1, NROWS
-//    DO 1 J = 1, NCOLS
+// reduction and to avoid non-unit strides, one column of the result
+// at a time so that it stays in cache while all N terms are added:
+//   DO 2 J = 1, NCOLS
+//    DO 1 I = 1, NROWS
 //   1 RES(I,J) = 0
-//   DO 2 K = 1, N
-//    DO 2 J = 1, NCOLS
+//    DO 2 K = 1, N
 //     DO 2 I = 1, NROWS
 //   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
@@ -75,17 +75,16 @@ inline void MatrixTimesMatrix(CppTypeFor<RCAT, RKIND> *RESTRICT product,
     const YT *RESTRICT y, SubscriptValue n) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
   std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
+  for (SubscriptValue j{0}; j < cols; ++j) {
+    ResultType *RESTRICT p0{product + j * rows};
+    const XT *RESTRICT xp{x};
+    for (SubscriptValue k{0}; k < n; ++k) {
+      ResultType *RESTRICT p{p0};
       auto yv{static_cast<ResultType>(y[k + j * n])};
       for (SubscriptValue i{0}; i < rows; ++i) {
         *p++ += static_cast<ResultType>(*xp++) * yv;
       }
     }
-    xp0 += rows;
   }
 }
 
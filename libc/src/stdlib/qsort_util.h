@@ -15,7 +15,9 @@
 
 namespace __llvm_libc::internal {
 
-// A simple quicksort implementation using the Hoare partition scheme.
+// An introsort: quicksort using the Hoare partition scheme, with insertion
+// sort for short ranges and a heapsort fallback once the recursion gets too
+// deep, which bounds the worst case to O(n log n).
 
 using Compare = int(const void *, const void *);
 using CompareWithState = int(const void *, const void *, void *);
@@ -71,7 +73,17 @@ public:
   void swap(size_t i, size_t j) const {
     uint8_t *elem_i = get(i);
     uint8_t *elem_j = get(j);
-    for (size_t b = 0; b < elem_size; ++b) {
+    size_t b = 0;
+    // Most element types are a multiple of the word size, so move whole
+    // words first and only fall back to bytes for the tail.
+    for (; b + sizeof(uint64_t) <= elem_size; b += sizeof(uint64_t)) {
+      uint64_t temp_i, temp_j;
+      __builtin_memcpy(&temp_i, elem_i + b, sizeof(uint64_t));
+      __builtin_memcpy(&temp_j, elem_j + b, sizeof(uint64_t));
+      __builtin_memcpy(elem_i + b, &temp_j, sizeof(uint64_t));
+      __builtin_memcpy(elem_j + b, &temp_i, sizeof(uint64_t));
+    }
+    for (; b < elem_size; ++b) {
       uint8_t temp = elem_i[b];
       elem_i[b] = elem_j[b];
       elem_j[b] = temp;
@@ -134,17 +146,81 @@ static size_t partition(const Array &array) {
   }
 }
 
+// Ranges of at most this many elements are finished with insertion sort.
+static constexpr size_t INSERTION_SORT_THRESHOLD = 16;
+
+static void insertion_sort(const Array &array) {
+  const size_t array_size = array.size();
+  for (size_t i = 1; i < array_size; ++i)
+    for (size_t j = i; j > 0 && array.elem_compare(j - 1, array.get(j)) > 0;
+         --j)
+      array.swap(j - 1, j);
+}
+
+static void sift_down(const Array &array, size_t root, size_t count) {
+  while (true) {
+    size_t child = 2 * root + 1;
+    if (child >= count)
+      return;
+    if (child + 1 < count &&
+        array.elem_compare(child, array.get(child + 1)) < 0)
+      ++child;
+    if (array.elem_compare(root, array.get(child)) >= 0)
+      return;
+    array.swap(root, child);
+    root = child;
+  }
+}
+
+static void heapsort(const Array &array) {
+  const size_t array_size = array.size();
+  for (size_t i = array_size / 2; i-- > 0;)
+    sift_down(array, i, array_size);
+  for (size_t end = array_size; end-- > 1;) {
+    array.swap(0, end);
+    sift_down(array, 0, end);
+  }
+}
+
+static void introsort(const Array &array, size_t depth_limit) {
+  size_t start = 0;
+  size_t array_size = array.size();
+  while (true) {
+    const Array range = array.make_array(start, array_size);
+    if (array_size <= INSERTION_SORT_THRESHOLD) {
+      insertion_sort(range);
+      return;
+    }
+    if (depth_limit == 0) {
+      heapsort(range);
+      return;
+    }
+    --depth_limit;
+    const size_t split_index = partition(range);
+    // Recurse into the smaller half and loop on the larger one so that the
+    // stack depth stays logarithmic.
+    if (split_index < array_size - split_index) {
+      introsort(range.make_array(0, split_index), depth_limit);
+      start += split_index;
+      array_size -= split_index;
+    } else {
+      introsort(range.make_array(split_index, array_size - split_index),
+                depth_limit);
+      array_size = split_index;
+    }
+  }
+}
+
 LIBC_INLINE void quicksort(const Array &array) {
   const size_t array_size = array.size();
   if (array_size <= 1)
     return;
-  size_t split_index = partition(array);
-  if (array_size <= 2) {
-    // The partition operation sorts the two element array.
-    return;
-  }
-  quicksort(array.make_array(0, split_index));
-  quicksort(array.make_array(split_index, array.size() - split_index));
+  // Allow twice the depth of a perfectly balanced recursion before switching
+  // to heapsort.
+  size_t depth_limit = 0;
+  for (size_t n = array_size; n > 1; n >>= 1)
+    depth_limit += 2;
+  introsort(array, depth_limit);
 }
 
 } // namespace __llvm_libc::internal
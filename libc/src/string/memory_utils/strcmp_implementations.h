@@ -9,14 +9,57 @@
 #ifndef LLVM_LIBC_SRC_STRING_MEMORY_UTILS_STRCMP_IMPLEMENTATIONS_H
 #define LLVM_LIBC_SRC_STRING_MEMORY_UTILS_STRCMP_IMPLEMENTATIONS_H
 
+#include "src/__support/macros/attributes.h" // LIBC_INLINE
+#include "src/string/memory_utils/utils.h"
+
 #include <stddef.h>
+#include <stdint.h>
 
 namespace __llvm_libc {
 
+#ifdef LIBC_COPT_STRCMP_WORD_AT_A_TIME
+// Comparing a word at a time reads the bytes that follow the terminator in
+// its aligned word. The loads cannot fault, but they access memory outside of
+// the string, which sanitizers and some memory checkers report. This is why
+// the word loop is only enabled with LIBC_COPT_STRCMP_WORD_AT_A_TIME.
+
+// Returns true if any byte of 'word' is zero.
+LIBC_INLINE static constexpr bool has_zero_byte(uintptr_t word) {
+  constexpr uintptr_t LOW_BITS = ~uintptr_t(0) / 0xff; // 0x0101...01
+  constexpr uintptr_t HIGH_BITS = LOW_BITS << 7;       // 0x8080...80
+  return ((word - LOW_BITS) & ~word & HIGH_BITS) != 0;
+}
+
+// Advances 'left' and 'right' past the longest run of aligned words that are
+// identical in both strings and hold no terminator. Every skipped character
+// is equal to its counterpart, so this is valid for any comparator that treats
+// a character as equal to itself. Words are only read once the string is
+// known to reach into them and never straddle an alignment boundary, so the
+// loads cannot cross into an unmapped page.
+LIBC_INLINE static void skip_equal_words(const char *&left,
+                                         const char *&right) {
+  constexpr size_t WORD_SIZE = sizeof(uintptr_t);
+  if (distance_to_align_down<WORD_SIZE>(left) !=
+      distance_to_align_down<WORD_SIZE>(right))
+    return;
+  for (; distance_to_align_down<WORD_SIZE>(left) != 0; ++left, ++right)
+    if (*left == '\0' || *left != *right)
+      return;
+  for (;; left += WORD_SIZE, right += WORD_SIZE) {
+    const uintptr_t l = load<uintptr_t>(reinterpret_cast<CPtr>(left));
+    const uintptr_t r = load<uintptr_t>(reinterpret_cast<CPtr>(right));
+    if (l != r || has_zero_byte(l))
+      return;
+  }
+}
+#endif // LIBC_COPT_STRCMP_WORD_AT_A_TIME
+
 template <typename Comp>
 constexpr static int strcmp_implementation(const char *left, const char *right,
                                            Comp &&comp) {
-  // TODO: Look at benefits for comparing words at a time.
+#ifdef LIBC_COPT_STRCMP_WORD_AT_A_TIME
+  skip_equal_words(left, right);
+#endif
   for (; *left && !comp(*left, *right); ++left, ++right)
     ;
   return comp(*reinterpret_cast<const unsigned char *>(left),
@@ -263,3 +263,42 @@ TEST(LlvmLibcQSortTest, SingleElementArray) {
 
   ASSERT_LE(array[0], ELEM);
 }
+
+TEST(LlvmLibcQsortTest, LargeArrayWithFewDistinctValues) {
+  constexpr size_t ARRAY_SIZE = 1000;
+  int array[ARRAY_SIZE];
+  for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    array[i] = int((i * 7919) % 13);
+
+  __llvm_libc::qsort(array, ARRAY_SIZE, sizeof(int), int_compare);
+
+  for (size_t i = 1; i < ARRAY_SIZE; ++i)
+    ASSERT_LE(array[i - 1], array[i]);
+}
+
+struct ThreeInts {
+  int key;
+  int a;
+  int b;
+};
+
+static int three_ints_compare(const void *l, const void *r) {
+  return int_compare(&reinterpret_cast<const ThreeInts *>(l)->key,
+                     &reinterpret_cast<const ThreeInts *>(r)->key);
+}
+
+TEST(LlvmLibcQsortTest, ReverseSortedStructArray) {
+  // Twelve byte elements exercise both the word and the byte part of swap.
+  constexpr size_t ARRAY_SIZE = 100;
+  ThreeInts array[ARRAY_SIZE];
+  for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    array[i] = {int(ARRAY_SIZE - i), int(i), -int(i)};
+
+  __llvm_libc::qsort(array, ARRAY_SIZE, sizeof(ThreeInts), three_ints_compare);
+
+  for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+    ASSERT_EQ(array[i].key, int(i + 1));
+    ASSERT_EQ(array[i].a, int(ARRAY_SIZE - 1 - i));
+    ASSERT_EQ(array[i].b, -int(ARRAY_SIZE - 1 - i));
+  }
+}
@@ -106,3 +106,46 @@ TEST(LlvmLibcStrCmpTest, Case) {
   result = __llvm_libc::strcmp(s2, s1);
   ASSERT_GT(result, 0);
 }
+
+TEST(LlvmLibcStrCmpTest, MismatchedAlignment) {
+  // Equal prefixes longer than a word, starting at every combination of
+  // offsets from a word boundary.
+  const char *str = "abcdefghijklmnopqrstuvwxyz0123456789";
+  alignas(16) char s1[64];
+  alignas(16) char s2[64];
+  for (size_t off1 = 0; off1 < 16; ++off1) {
+    for (size_t off2 = 0; off2 < 16; ++off2) {
+      size_t i = 0;
+      for (; str[i] != '\0'; ++i)
+        s1[off1 + i] = s2[off2 + i] = str[i];
+      s1[off1 + i] = s2[off2 + i] = '\0';
+      ASSERT_EQ(__llvm_libc::strcmp(s1 + off1, s2 + off2), 0);
+
+      // This should return '9' - '!' = 24.
+      s2[off2 + i - 1] = '!';
+      ASSERT_EQ(__llvm_libc::strcmp(s1 + off1, s2 + off2), 24);
+      ASSERT_EQ(__llvm_libc::strcmp(s2 + off2, s1 + off1), -24);
+    }
+  }
+}
+
+TEST(LlvmLibcStrCmpTest, TerminatorInsideWord) {
+  // The strings are equal up to a terminator in the middle of a word, and the
+  // bytes after it differ.
+  alignas(16) char s1[32];
+  alignas(16) char s2[32];
+  for (size_t len = 0; len < 24; ++len) {
+    for (size_t i = 0; i < 32; ++i) {
+      s1[i] = i < len ? 'a' : 'x';
+      s2[i] = i < len ? 'a' : 'y';
+    }
+    s1[len] = s2[len] = '\0';
+    ASSERT_EQ(__llvm_libc::strcmp(s1, s2), 0);
+
+    // A terminator in only one of the strings.
+    s2[len] = 'b';
+    // This should return '\0' - 'b' = -98.
+    ASSERT_EQ(__llvm_libc::strcmp(s1, s2), -98);
+    ASSERT_EQ(__llvm_libc::strcmp(s2, s1), 98);
+  }
+}
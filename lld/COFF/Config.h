@@ -184,6 +184,11 @@ struct Configuration {
   // Used for /opt:lldltocachepolicy=policy
   llvm::CachePruningPolicy ltoCachePolicy;
 
+  // Used for /lldghashcache:path
+  StringRef ghashCache;
+  // Used for /lldghashcachepolicy:policy
+  llvm::CachePruningPolicy ghashCachePolicy;
+
   // Used for /opt:[no]ltodebugpassmanager
   bool ltoDebugPassManager = false;
 
@@ -26,6 +26,9 @@
 #include "llvm/DebugInfo/PDB/Native/PDBFile.h"
 #include "llvm/DebugInfo/PDB/Native/TpiHashing.h"
 #include "llvm/DebugInfo/PDB/Native/TpiStream.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
@@ -581,15 +584,97 @@ void PrecompSource::registerMapping() {
 // Parellel GHash type merging implementation.
 //===----------------------------------------------------------------------===//
 
+// With /lldghashcache:, the ghashes of objects without .debug$H are saved to a
+// cache directory and reused by later links. Computing them takes a SHA-1 of
+// every type record, while the cache is keyed by a single 128-bit BLAKE3 hash
+// of the whole .debug$T section. A cache file consists of the magic, the size
+// of .debug$T and the number of ghashes, each a little-endian uint64_t,
+// followed by the ghashes. The magic also serves as the ghash version: bump it
+// if the ghash algorithm changes, so that stale entries are rejected. Entries
+// use the "llvmcache-" prefix so that pruneCache() can prune them.
+static constexpr uint64_t ghashCacheMagic = 0x3148534148474c4cULL; // LLGHASH1
+static constexpr size_t ghashCacheHeaderSize = 3 * sizeof(uint64_t);
+
+static std::string getGHashCachePath(StringRef dir, ArrayRef<uint8_t> debugT) {
+  SmallString<128> path(dir);
+  sys::path::append(path,
+                    "llvmcache-ghash-" + toHex(BLAKE3::hash<16>(debugT)));
+  return std::string(path);
+}
+
+static std::optional<std::vector<GloballyHashedType>>
+readGHashCache(StringRef path, size_t debugTSize) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(path, /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return std::nullopt;
+  ArrayRef<uint8_t> data = arrayRefFromStringRef((*mbOrErr)->getBuffer());
+  if (data.size() < ghashCacheHeaderSize)
+    return std::nullopt;
+  uint64_t count = support::endian::read64le(data.data() + 16);
+  if (support::endian::read64le(data.data()) != ghashCacheMagic ||
+      support::endian::read64le(data.data() + 8) != debugTSize ||
+      data.size() != ghashCacheHeaderSize + count * sizeof(GloballyHashedType))
+    return std::nullopt;
+
+  std::vector<GloballyHashedType> hashes(count);
+  memcpy(hashes.data(), data.data() + ghashCacheHeaderSize,
+         count * sizeof(GloballyHashedType));
+  return hashes;
+}
+
+// Writes the cache file through a temporary file so that concurrent links
+// never see a partially written one. The cache is best effort: failures are
+// only logged.
+static void writeGHashCache(StringRef path, size_t debugTSize,
+                            ArrayRef<GloballyHashedType> hashes) {
+  int fd;
+  SmallString<128> tmpPath;
+  if (std::error_code ec =
+          sys::fs::createUniqueFile(path + ".tmp%%%%%%", fd, tmpPath)) {
+    log("/lldghashcache: cannot create " + path + ": " + ec.message());
+    return;
+  }
+  {
+    raw_fd_ostream os(fd, /*shouldClose=*/true);
+    support::endian::Writer w(os, support::little);
+    w.write<uint64_t>(ghashCacheMagic);
+    w.write<uint64_t>(debugTSize);
+    w.write<uint64_t>(hashes.size());
+    os.write(reinterpret_cast<const char *>(hashes.data()),
+             hashes.size() * sizeof(GloballyHashedType));
+  }
+  if (std::error_code ec = sys::fs::rename(tmpPath, path)) {
+    log("/lldghashcache: cannot create " + path + ": " + ec.message());
+    sys::fs::remove(tmpPath);
+  }
+}
+
 void TpiSource::loadGHashes() {
   if (std::optional<ArrayRef<uint8_t>> debugH = getDebugH(file)) {
     ghashes = getHashesFromDebugH(*debugH);
     ownedGHashes = false;
   } else {
+    std::string cachePath;
+    if (!ctx.config.ghashCache.empty()) {
+      cachePath = getGHashCachePath(ctx.config.ghashCache, file->debugTypes);
+      if (std::optional<std::vector<GloballyHashedType>> hashes =
+              readGHashCache(cachePath, file->debugTypes.size())) {
+        assignGHashesFromVector(std::move(*hashes));
+        fillIsItemIndexFromDebugT();
+        return;
+      }
+    }
+
     CVTypeArray types;
     BinaryStreamReader reader(file->debugTypes, support::little);
     cantFail(reader.readArray(types, reader.getLength()));
-    assignGHashesFromVector(GloballyHashedType::hashTypes(types));
+    std::vector<GloballyHashedType> hashes =
+        GloballyHashedType::hashTypes(types);
+    if (!cachePath.empty())
+      writeGHashCache(cachePath, file->debugTypes.size(), hashes);
+    assignGHashesFromVector(std::move(hashes));
   }
 
   fillIsItemIndexFromDebugT();
@@ -1073,6 +1158,8 @@ void TypeMerger::mergeTypesWithGHash() {
                     [&](TpiSource *source) { source->loadGHashes(); });
     parallelForEach(objectSources,
                     [&](TpiSource *source) { source->loadGHashes(); });
+    if (!ctx.config.ghashCache.empty())
+      pruneCache(ctx.config.ghashCache, ctx.config.ghashCachePolicy);
   }
 
   ScopedTimer t2(ctx.mergeGHashTimer);
@@ -1842,6 +1842,21 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
         parseCachePruningPolicy(arg->getValue()),
         Twine("/lldltocachepolicy: invalid cache policy: ") + arg->getValue());
 
+  // Handle /lldghashcache
+  if (auto *arg = args.getLastArg(OPT_lldghashcache)) {
+    config->ghashCache = arg->getValue();
+    if (std::error_code ec = sys::fs::create_directories(config->ghashCache))
+      error("/lldghashcache: cannot create " + config->ghashCache + ": " +
+            ec.message());
+  }
+
+  // Handle /lldghashcachepolicy
+  if (auto *arg = args.getLastArg(OPT_lldghashcachepolicy))
+    config->ghashCachePolicy =
+        CHECK(parseCachePruningPolicy(arg->getValue()),
+              Twine("/lldghashcachepolicy: invalid cache policy: ") +
+                  arg->getValue());
+
   // Handle /failifmismatch
   for (auto *arg : args.filtered(OPT_failifmismatch))
     checkFailIfMismatch(arg->getValue(), nullptr);
@@ -19,6 +19,9 @@
 #if LLVM_ON_UNIX
 #include <unistd.h>
 #endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
 #include <thread>
 
 using namespace llvm;
@@ -127,3 +130,48 @@ std::error_code lld::tryCreateFile(StringRef path) {
     return std::error_code();
   return errorToErrorCode(FileOutputBuffer::create(path, 1).takeError());
 }
+
+// Writes data, which must be the bytes of inFd at inOffset, to outFd at
+// outOffset. On Linux this uses copy_file_range(2), which copies the bytes
+// inside the kernel without duplicating them in the page cache, and shares
+// the extents on file systems with reflink support. If the kernel cannot
+// copy between the two files, data is written with pwrite(2) instead.
+std::error_code lld::copyFileRange(int inFd, uint64_t inOffset, int outFd,
+                                   uint64_t outOffset, ArrayRef<uint8_t> data) {
+#if defined(__linux__) && defined(SYS_copy_file_range)
+  while (!data.empty()) {
+    loff_t in = inOffset, out = outOffset;
+    long n = syscall(SYS_copy_file_range, inFd, &in, outFd, &out,
+                     data.size(), 0u);
+    if (n < 0 && errno == EINTR)
+      continue;
+    // Fails with EXDEV, ENOSYS or EINVAL if the kernel or the file systems do
+    // not support it, and returns 0 if inFd is shorter than expected.
+    if (n <= 0)
+      break;
+    inOffset += n;
+    outOffset += n;
+    data = data.drop_front(n);
+  }
+#endif
+#if LLVM_ON_UNIX
+  while (!data.empty()) {
+    ssize_t n = ::pwrite(outFd, data.data(), data.size(), outOffset);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return std::error_code(errno, std::generic_category());
+    }
+    outOffset += n;
+    data = data.drop_front(n);
+  }
+  return std::error_code();
+#else
+  (void)inFd;
+  (void)inOffset;
+  (void)outFd;
+  (void)outOffset;
+  return data.empty() ? std::error_code()
+                      : make_error_code(std::errc::function_not_supported);
+#endif
+}
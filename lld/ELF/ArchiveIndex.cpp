@@ -0,0 +1,178 @@
+//===- ArchiveIndex.cpp ---------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements --archive-index. By default, the linker reads the
+// symbol table of every member of an archive and inserts a lazy symbol for
+// each definition (see the comment in LinkerDriver::addFile). For archives
+// with many members of which only a few are used, reading the members and
+// creating the symbols dominates the time spent on the archive.
+//
+// With --archive-index, the archive symbol table, which maps each defined name
+// to the member that defines it, is used instead. When the linker reaches the
+// archive on the command line, it extracts the members that define a symbol
+// that is undefined at that point, and records the names defined by the other
+// members in ctx.lazyArchiveSymbols. A later non-weak undefined reference to
+// one of those names extracts the member, just like a reference to a lazy
+// symbol does. Members that are never extracted are never parsed and do not
+// add anything to the symbol table.
+//
+// As long as the archive symbol table is complete and lists the members in
+// order, this selects the same members as the default mode.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ArchiveIndex.h"
+#include "Config.h"
+#include "InputFiles.h"
+#include "SymbolTable.h"
+#include "Symbols.h"
+#include "lld/Common/ErrorHandler.h"
+#include "lld/Common/Memory.h"
+#include "llvm/BinaryFormat/Magic.h"
+#include "llvm/LTO/LTO.h"
+#include "llvm/Object/Archive.h"
+
+using namespace llvm;
+using namespace llvm::object;
+using namespace lld;
+using namespace lld::elf;
+
+ArchiveIndex *ArchiveIndex::create(
+    MemoryBufferRef mb, StringRef path,
+    ArrayRef<std::pair<MemoryBufferRef, uint64_t>> members, size_t filePos) {
+  std::unique_ptr<Archive> file =
+      CHECK(Archive::create(mb), path + ": failed to parse archive");
+  if (!file->hasSymbolTable())
+    return nullptr;
+
+  DenseMap<uint64_t, uint32_t> memberIndex;
+  for (size_t i = 0, e = members.size(); i != e; ++i)
+    memberIndex[members[i].second] = i;
+
+  SmallVector<std::pair<uint32_t, StringRef>, 0> symbols;
+  for (const Archive::Symbol &sym : file->symbols()) {
+    Expected<Archive::Child> c = sym.getMember();
+    if (!c) {
+      log(path + ": ignoring the archive symbol table: " +
+          toString(c.takeError()));
+      return nullptr;
+    }
+    auto it = memberIndex.find(c->getChildOffset());
+    if (it == memberIndex.end()) {
+      log(path + ": ignoring the archive symbol table: " + sym.getName() +
+          " refers to an unknown member");
+      return nullptr;
+    }
+    symbols.emplace_back(it->second, sym.getName());
+  }
+  if (symbols.empty())
+    return nullptr;
+
+  auto *index = make<ArchiveIndex>(path, filePos);
+  SmallVector<bool, 0> extractable;
+  for (const std::pair<MemoryBufferRef, uint64_t> &p : members) {
+    auto magic = identify_magic(p.first.getBuffer());
+    extractable.push_back(magic == file_magic::elf_relocatable ||
+                          magic == file_magic::bitcode);
+    if (!extractable.back())
+      warn(path + ": archive member '" + p.first.getBufferIdentifier() +
+           "' is neither ET_REL nor LLVM bitcode");
+    index->members.push_back(
+        {p.first, p.second, magic == file_magic::bitcode});
+  }
+
+  // Drop the names defined by members that cannot be extracted, and visit the
+  // members in archive order, like --start-lib does, regardless of the order
+  // of the archive symbol table.
+  llvm::erase_if(symbols, [&](const std::pair<uint32_t, StringRef> &s) {
+    return !extractable[s.first];
+  });
+  llvm::stable_sort(symbols, less_first());
+  index->symbols = std::move(symbols);
+
+  // All members get the same group ID to allow mutual references for
+  // --warn-backrefs.
+  index->groupId = InputFile::nextGroupId;
+  if (!InputFile::isInGroup)
+    ++InputFile::nextGroupId;
+  ctx.archiveIndexes.push_back(index);
+  return index;
+}
+
+void ArchiveIndex::scan() {
+  ArrayRef<std::pair<uint32_t, StringRef>> rest = symbols;
+  while (!rest.empty()) {
+    uint32_t i = rest[0].first;
+    size_t n = 1;
+    while (n != rest.size() && rest[n].first == i)
+      ++n;
+    ArrayRef<std::pair<uint32_t, StringRef>> names = rest.take_front(n);
+    rest = rest.drop_front(n);
+    if (members[i].file)
+      continue;
+
+    // This mirrors Symbol::resolve(const LazyObject &): a non-weak undefined
+    // symbol extracts the member, and a definition dismisses a pending
+    // --warn-backrefs diagnostic.
+    Symbol *ref = nullptr;
+    for (const std::pair<uint32_t, StringRef> &s : names) {
+      Symbol *sym = symtab.find(s.second);
+      if (!sym)
+        continue;
+      if (sym->isUndefined() && !sym->isWeak()) {
+        ref = sym;
+        break;
+      }
+      if (sym->isDefined())
+        ctx.backwardReferences.erase(sym);
+    }
+
+    if (ref) {
+      const InputFile *reference = ref->file;
+      InputFile *file = extract(i);
+      if (!config->whyExtract.empty())
+        ctx.whyExtractRecords.emplace_back(toString(reference), file, *ref);
+      continue;
+    }
+
+    // The first archive member defining a name wins.
+    for (const std::pair<uint32_t, StringRef> &s : names)
+      ctx.lazyArchiveSymbols.try_emplace(CachedHashStringRef(s.second), this,
+                                         i);
+  }
+}
+
+InputFile *ArchiveIndex::extract(uint32_t i) {
+  Member &m = members[i];
+  assert(!m.file && "member already extracted");
+
+  // Keep the constructor from consuming a group ID; the member belongs to
+  // the group of the archive.
+  bool saved = InputFile::isInGroup;
+  InputFile::isInGroup = true;
+  if (m.isBitcode)
+    m.file = make<BitcodeFile>(m.mb, path, m.offsetInArchive, false);
+  else
+    m.file = createObjFile(m.mb, path);
+  InputFile::isInGroup = saved;
+  m.file->groupId = groupId;
+
+  parseFile(m.file);
+  return m.file;
+}
+
+InputFile *elf::extractLazyArchiveMember(StringRef name, bool bitcodeOnly) {
+  auto it = ctx.lazyArchiveSymbols.find(CachedHashStringRef(name));
+  if (it == ctx.lazyArchiveSymbols.end())
+    return nullptr;
+  auto [index, i] = it->second;
+  const ArchiveIndex::Member &m = index->members[i];
+  if (m.file || (bitcodeOnly && !m.isBitcode))
+    return nullptr;
+  return index->extract(i);
+}
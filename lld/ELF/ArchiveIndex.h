@@ -0,0 +1,68 @@
+//===- ArchiveIndex.h -------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_ELF_ARCHIVEINDEX_H
+#define LLD_ELF_ARCHIVEINDEX_H
+
+#include "lld/Common/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MemoryBufferRef.h"
+
+namespace lld::elf {
+class InputFile;
+
+// An archive added with --archive-index. Instead of reading the symbol table
+// of every member, the linker consults the archive symbol table to find the
+// member that defines a symbol, and only creates and parses the members it
+// extracts.
+class ArchiveIndex {
+public:
+  struct Member {
+    MemoryBufferRef mb;
+    uint64_t offsetInArchive;
+    bool isBitcode;
+    // Set once the member has been extracted.
+    InputFile *file = nullptr;
+  };
+
+  ArchiveIndex(StringRef path, size_t filePos) : path(path), filePos(filePos) {}
+
+  // Creates an index for the archive mb, whose members are given by members,
+  // and appends it to ctx.archiveIndexes. Returns nullptr if the archive has
+  // no usable symbol table, in which case the caller should read the members
+  // as usual.
+  static ArchiveIndex *
+  create(MemoryBufferRef mb, StringRef path,
+         ArrayRef<std::pair<MemoryBufferRef, uint64_t>> members,
+         size_t filePos);
+
+  // Visits the archive at its position on the command line: extracts the
+  // members that define a symbol that is currently undefined and makes the
+  // remaining ones available to later references.
+  void scan();
+
+  // Creates and parses the i-th member.
+  InputFile *extract(uint32_t i);
+
+  StringRef path;
+  // The number of files that precede the archive in LinkerDriver::files.
+  size_t filePos;
+  uint32_t groupId = 0;
+  SmallVector<Member, 0> members;
+  // (member index, symbol name) pairs from the archive symbol table, sorted by
+  // member index.
+  SmallVector<std::pair<uint32_t, StringRef>, 0> symbols;
+};
+
+// If name is defined by a member of a scanned archive that has not been
+// extracted yet, extracts that member and returns it. If bitcodeOnly is true,
+// only a bitcode member is extracted.
+InputFile *extractLazyArchiveMember(StringRef name, bool bitcodeOnly = false);
+} // namespace lld::elf
+
+#endif
@@ -0,0 +1,91 @@
+//===- BPSectionOrderer.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// Orders executable input sections so that sections with similar contents
+/// are placed next to each other, which improves the compression ratio of the
+/// output. This uses balanced partitioning from "Optimizing Function Layout
+/// for Mobile Applications" (https://arxiv.org/abs/2211.09285).
+///
+/// Each section is a function node whose utility nodes are hashes of the
+/// k-byte windows of its contents. Balanced partitioning then recursively
+/// bisects the sections so that sections sharing many windows end up close
+/// together.
+///
+//===----------------------------------------------------------------------===//
+
+#include "BPSectionOrderer.h"
+#include "Config.h"
+#include "InputSection.h"
+#include "SyntheticSections.h"
+#include "lld/Common/ErrorHandler.h"
+#include "llvm/Support/BalancedPartitioning.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace llvm;
+using namespace llvm::ELF;
+using namespace lld;
+using namespace lld::elf;
+
+// The window size in bytes. Short windows match common instruction sequences
+// across functions without making every section look alike.
+static constexpr size_t windowSize = 8;
+
+// Sections larger than this are still ordered but only their first bytes are
+// hashed, which bounds the cost of the partitioning on huge inputs.
+static constexpr size_t maxHashedBytes = 1 << 16;
+
+static SmallVector<BPFunctionNode::UtilityNodeT, 0>
+getUtilityNodes(ArrayRef<uint8_t> data) {
+  SmallVector<BPFunctionNode::UtilityNodeT, 0> nodes;
+  data = data.take_front(maxHashedBytes);
+  if (data.size() < windowSize)
+    return nodes;
+  nodes.reserve(data.size() - windowSize + 1);
+  for (size_t i = 0, e = data.size() - windowSize; i <= e; ++i)
+    nodes.push_back(xxh3_64bits(data.slice(i, windowSize)));
+  llvm::sort(nodes);
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+  return nodes;
+}
+
+DenseMap<const InputSectionBase *, int> elf::computeBPCompressionOrder() {
+  llvm::TimeTraceScope timeScope("Balanced partitioning section order");
+  SmallVector<InputSection *, 0> sections;
+  for (InputSectionBase *sec : ctx.inputSections) {
+    auto *isec = dyn_cast<InputSection>(sec);
+    if (!isec || isa<SyntheticSection>(isec) || !isec->isLive() ||
+        !(isec->flags & SHF_EXECINSTR) || isec->getSize() == 0)
+      continue;
+    sections.push_back(isec);
+  }
+
+  SmallVector<SmallVector<BPFunctionNode::UtilityNodeT, 0>, 0> utilityNodes(
+      sections.size());
+  parallelFor(0, sections.size(), [&](size_t i) {
+    utilityNodes[i] = getUtilityNodes(sections[i]->content());
+  });
+
+  std::vector<BPFunctionNode> nodes;
+  nodes.reserve(sections.size());
+  for (size_t i = 0, e = sections.size(); i != e; ++i)
+    nodes.emplace_back(i, utilityNodes[i]);
+
+  BalancedPartitioningConfig bpConfig;
+  BalancedPartitioning bp(bpConfig);
+  bp.run(nodes);
+
+  // Like the symbol ordering file, ordered sections get negative priorities
+  // so that they are placed before any section without a priority.
+  DenseMap<const InputSectionBase *, int> orderMap;
+  int priority = -nodes.size();
+  for (const BPFunctionNode &node : nodes)
+    orderMap[sections[node.Id]] = priority++;
+  return orderMap;
+}
@@ -0,0 +1,20 @@
+//===- BPSectionOrderer.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_ELF_BP_SECTION_ORDERER_H
+#define LLD_ELF_BP_SECTION_ORDERER_H
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace lld::elf {
+class InputSectionBase;
+
+llvm::DenseMap<const InputSectionBase *, int> computeBPCompressionOrder();
+} // namespace lld::elf
+
+#endif
@@ -32,6 +32,7 @@
 
 namespace lld::elf {
 
+class ArchiveIndex;
 class InputFile;
 class BinaryFile;
 class BitcodeFile;
@@ -197,12 +198,14 @@ struct Config {
       callGraphProfile;
   bool allowMultipleDefinition;
   bool androidPackDynRelocs = false;
+  bool archiveIndex;
   bool armHasBlx = false;
   bool armHasMovtMovw = false;
   bool armJ1J2BranchEncoding = false;
   bool asNeeded = false;
   bool armBe8 = false;
   BsymbolicKind bsymbolic = BsymbolicKind::None;
+  bool bpCompressionSort;
   bool callGraphProfileSort;
   bool checkSections;
   bool checkDynamicRelocs;
@@ -210,6 +213,8 @@ struct Config {
   bool cref;
   llvm::SmallVector<std::pair<llvm::GlobPattern, uint64_t>, 0>
       deadRelocInNonAlloc;
+  bool debugNames;
+  bool debugPassthrough;
   bool demangle = true;
   bool dependentLibraries;
   bool disableVerify;
@@ -228,6 +233,7 @@ struct Config {
   bool gnuHash = false;
   bool gnuUnique;
   bool hasDynSymTab;
+  bool hugePagesOutputFile;
   bool ignoreDataAddressEquality;
   bool ignoreFunctionAddressEquality;
   bool ltoCSProfileGenerate;
@@ -453,6 +459,12 @@ struct Ctx {
   llvm::DenseMap<const Symbol *,
                  std::pair<const InputFile *, const InputFile *>>
       backwardReferences;
+  // Archives added with --archive-index, in command line order.
+  SmallVector<ArchiveIndex *, 0> archiveIndexes;
+  // A mapping from a symbol name to the first scanned archive member that
+  // defines it according to its archive symbol table. Used by --archive-index.
+  llvm::DenseMap<llvm::CachedHashStringRef, std::pair<ArchiveIndex *, uint32_t>>
+      lazyArchiveSymbols;
   // True if SHT_LLVM_SYMPART is used.
   std::atomic<bool> hasSympart{false};
   // True if there are TLS IE relocations. Set DF_STATIC_TLS if -shared.
@@ -0,0 +1,176 @@
+//===- DebugPassthrough.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements --debug-passthrough. Debug sections usually make up
+// most of the output, and many input debug sections, such as .debug_abbrev,
+// have no relocations and end up in the output exactly as they are in the
+// input. Instead of copying those bytes into the output
+// buffer, which dirties as many pages of the page cache as the debug info is
+// large, such sections are left out of the buffer and copied from the input
+// files into the output file with copy_file_range(2) after it is committed.
+// On file systems with reflink support the kernel then shares the extents
+// instead of copying the data.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DebugPassthrough.h"
+#include "Config.h"
+#include "InputSection.h"
+#include "OutputSections.h"
+#include "lld/Common/ErrorHandler.h"
+#include "lld/Common/Filesystem.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/TimeProfiler.h"
+
+using namespace llvm;
+using namespace llvm::ELF;
+using namespace llvm::object;
+using namespace llvm::sys;
+using namespace lld;
+using namespace lld::elf;
+
+namespace {
+// The input files read from disk, sorted by address, to find the file and the
+// file offset that a section's contents were read from.
+class InputBuffers {
+public:
+  InputBuffers() {
+    for (const std::unique_ptr<MemoryBuffer> &mb : ctx.memoryBuffers)
+      bufs.push_back(mb.get());
+    llvm::sort(bufs, [](const MemoryBuffer *a, const MemoryBuffer *b) {
+      return a->getBufferStart() < b->getBufferStart();
+    });
+  }
+
+  const MemoryBuffer *find(const uint8_t *p, size_t size) const {
+    auto *c = reinterpret_cast<const char *>(p);
+    auto it = llvm::upper_bound(
+        bufs, c, [](const char *c, const MemoryBuffer *mb) {
+          return c < mb->getBufferStart();
+        });
+    if (it == bufs.begin())
+      return nullptr;
+    const MemoryBuffer *mb = *std::prev(it);
+    if (c + size > mb->getBufferEnd())
+      return nullptr;
+    return mb;
+  }
+
+private:
+  SmallVector<const MemoryBuffer *, 0> bufs;
+};
+
+// A range of the output file to be copied from one input file.
+struct Run {
+  const MemoryBuffer *mb;
+  uint64_t inOffset;
+  uint64_t outOffset;
+  uint64_t size;
+};
+} // namespace
+
+template <class ELFT> void elf::selectDebugPassthroughSections() {
+  // Copying requires the output to be a regular file. Compressed debug
+  // sections are written from the compressed shards.
+  if (config->outputFile == "-" ||
+      config->compressDebugSections != DebugCompressionType::None)
+    return;
+  llvm::TimeTraceScope timeScope("Select debug passthrough sections");
+  InputBuffers bufs;
+  SmallVector<InputSection *, 0> storage;
+  for (OutputSection *osec : outputSections) {
+    if ((osec->flags & SHF_ALLOC) || osec->type != SHT_PROGBITS ||
+        !osec->name.starts_with(".debug_"))
+      continue;
+    for (InputSection *isec : getInputSections(*osec, storage)) {
+      if (isec->kind() != SectionBase::Regular || isec->type != SHT_PROGBITS ||
+          isec->compressed || isec->content().empty())
+        continue;
+      // Non-alloc sections are only modified by their relocations.
+      const RelsOrRelas<ELFT> rels = isec->template relsOrRelas<ELFT>();
+      if (!rels.rels.empty() || !rels.relas.empty())
+        continue;
+      // Sections from LTO or from decompressed input have no file to copy
+      // from.
+      if (bufs.find(isec->content().data(), isec->content().size()))
+        isec->passthrough = true;
+    }
+  }
+}
+
+void elf::copyDebugPassthroughSections() {
+  llvm::TimeTraceScope timeScope("Copy debug passthrough sections");
+  InputBuffers bufs;
+  SmallVector<Run, 0> runs;
+  SmallVector<InputSection *, 0> storage;
+  for (OutputSection *osec : outputSections) {
+    for (InputSection *isec : getInputSections(*osec, storage)) {
+      if (!isec->passthrough)
+        continue;
+      ArrayRef<uint8_t> data = isec->content();
+      const MemoryBuffer *mb = bufs.find(data.data(), data.size());
+      uint64_t inOffset =
+          reinterpret_cast<const char *>(data.data()) - mb->getBufferStart();
+      uint64_t outOffset = osec->offset + isec->outSecOff;
+      // Adjacent sections of the same file are copied with one call.
+      if (!runs.empty() && runs.back().mb == mb &&
+          runs.back().inOffset + runs.back().size == inOffset &&
+          runs.back().outOffset + runs.back().size == outOffset)
+        runs.back().size += data.size();
+      else
+        runs.push_back({mb, inOffset, outOffset, data.size()});
+    }
+  }
+  if (runs.empty())
+    return;
+
+  int outFd;
+  if (std::error_code ec = fs::openFileForReadWrite(
+          config->outputFile, outFd, fs::CD_OpenExisting, fs::OF_None)) {
+    error("--debug-passthrough: cannot open " + config->outputFile + ": " +
+          ec.message());
+    return;
+  }
+
+  // If an input cannot be reopened, copyFileRange() falls back to writing
+  // from the buffer we already have.
+  DenseMap<const MemoryBuffer *, int> inFds;
+  for (const Run &run : runs) {
+    auto [it, inserted] = inFds.try_emplace(run.mb, -1);
+    if (inserted && fs::openFileForRead(run.mb->getBufferIdentifier(),
+                                        it->second))
+      it->second = -1;
+  }
+
+  std::atomic<bool> failed = false;
+  parallelForEach(runs, [&](const Run &run) {
+    ArrayRef<uint8_t> data(
+        reinterpret_cast<const uint8_t *>(run.mb->getBufferStart()) +
+            run.inOffset,
+        run.size);
+    if (std::error_code ec = copyFileRange(inFds.lookup(run.mb), run.inOffset,
+                                           outFd, run.outOffset, data))
+      if (!failed.exchange(true))
+        error("--debug-passthrough: failed to write " + config->outputFile +
+              ": " + ec.message());
+  });
+
+  for (auto &it : inFds)
+    if (it.second != -1)
+      Process::SafelyCloseFileDescriptor(it.second);
+  Process::SafelyCloseFileDescriptor(outFd);
+}
+
+template void elf::selectDebugPassthroughSections<ELF32LE>();
+template void elf::selectDebugPassthroughSections<ELF32BE>();
+template void elf::selectDebugPassthroughSections<ELF64LE>();
+template void elf::selectDebugPassthroughSections<ELF64BE>();
@@ -0,0 +1,21 @@
+//===- DebugPassthrough.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_ELF_DEBUGPASSTHROUGH_H
+#define LLD_ELF_DEBUGPASSTHROUGH_H
+
+namespace lld::elf {
+// Marks the debug sections whose contents can be copied verbatim from the
+// input files, so that they are not written to the output buffer.
+template <class ELFT> void selectDebugPassthroughSections();
+
+// Copies the marked sections into the output file once it has been committed.
+void copyDebugPassthroughSections();
+} // namespace lld::elf
+
+#endif
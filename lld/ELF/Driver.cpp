@@ -23,6 +23,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Driver.h"
+#include "ArchiveIndex.h"
 #include "Config.h"
 #include "ICF.h"
 #include "InputFiles.h"
@@ -103,6 +104,8 @@ void Ctx::reset() {
   nonPrevailingSyms.clear();
   whyExtractRecords.clear();
   backwardReferences.clear();
+  archiveIndexes.clear();
+  lazyArchiveSymbols.clear();
   hasSympart.store(false, std::memory_order_relaxed);
   needsTlsLd.store(false, std::memory_order_relaxed);
 }
@@ -261,6 +264,12 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
 
     archiveFiles.emplace_back(path, members.size());
 
+    // With --archive-index, the members are created when they are extracted.
+    // --fortran-common needs to look at the definitions of every member.
+    if (config->archiveIndex && !config->fortranCommon &&
+        ArchiveIndex::create(mbref, path, members, files.size()))
+      return;
+
     // Handle archives and --start-lib/--end-lib using the same code path. This
     // scans all the ELF relocatable object files and bitcode files in the
     // archive rather than just the index file, with the benefit that the
@@ -381,9 +390,16 @@ static void checkOptions() {
   if (config->zText && config->zIfuncNoplt)
     error("-z text and -z ifunc-noplt may not be used together");
 
+  // The build ID is computed from the output buffer, which does not contain
+  // the debug sections that are copied after the output is committed.
+  if (config->debugPassthrough && config->buildId != BuildIdKind::None)
+    error("--debug-passthrough and --build-id may not be used together");
+
   if (config->relocatable) {
     if (config->shared)
       error("-r and -shared may not be used together");
+    if (config->debugNames)
+      error("-r and --debug-names may not be used together");
     if (config->gdbIndex)
       error("-r and --gdb-index may not be used together");
     if (config->icf != ICFLevel::None)
@@ -1117,6 +1133,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->androidMemtagStack = args.hasFlag(OPT_android_memtag_stack,
                                             OPT_no_android_memtag_stack, false);
   config->androidMemtagMode = getMemtagMode(args);
+  config->archiveIndex =
+      args.hasFlag(OPT_archive_index, OPT_no_archive_index, false);
   config->auxiliaryList = args::getStrings(args, OPT_auxiliary);
   config->armBe8 = args.hasArg(OPT_be8);
   if (opt::Arg *arg =
@@ -1134,6 +1152,10 @@ static void readConfigs(opt::InputArgList &args) {
   config->chroot = args.getLastArgValue(OPT_chroot);
   config->compressDebugSections = getCompressDebugSections(args);
   config->cref = args.hasArg(OPT_cref);
+  config->debugNames =
+      args.hasFlag(OPT_debug_names, OPT_no_debug_names, false);
+  config->debugPassthrough =
+      args.hasFlag(OPT_debug_passthrough, OPT_no_debug_passthrough, false);
   config->optimizeBBJumps =
       args.hasFlag(OPT_optimize_bb_jumps, OPT_no_optimize_bb_jumps, false);
   config->demangle = args.hasFlag(OPT_demangle, OPT_no_demangle, true);
@@ -1147,6 +1169,8 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasFlag(OPT_eh_frame_hdr, OPT_no_eh_frame_hdr, false);
   config->emitLLVM = args.hasArg(OPT_plugin_opt_emit_llvm, false);
   config->emitRelocs = args.hasArg(OPT_emit_relocs);
+  config->bpCompressionSort =
+      args.hasFlag(OPT_bp_compression_sort, OPT_no_bp_compression_sort, false);
   config->callGraphProfileSort = args.hasFlag(
       OPT_call_graph_profile_sort, OPT_no_call_graph_profile_sort, true);
   config->enableNewDtags =
@@ -1171,6 +1195,8 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasFlag(OPT_fortran_common, OPT_no_fortran_common, false);
   config->gcSections = args.hasFlag(OPT_gc_sections, OPT_no_gc_sections, false);
   config->gnuUnique = args.hasFlag(OPT_gnu_unique, OPT_no_gnu_unique, true);
+  config->hugePagesOutputFile = args.hasFlag(
+      OPT_huge_pages_output_file, OPT_no_huge_pages_output_file, false);
   config->gdbIndex = args.hasFlag(OPT_gdb_index, OPT_no_gdb_index, false);
   config->icf = getICF(args);
   config->ignoreDataAddressEquality =
@@ -1552,6 +1578,18 @@ static void readConfigs(opt::InputArgList &args) {
     }
   }
 
+  // The balanced partitioning order replaces the call graph profile order.
+  // Explicit orders take precedence and may not be combined with it.
+  if (config->bpCompressionSort) {
+    if (args.hasArg(OPT_symbol_ordering_file))
+      error("--bp-compression-sort and --symbol-ordering-file "
+            "may not be used together");
+    if (args.hasArg(OPT_call_graph_ordering_file))
+      error("--bp-compression-sort and --call-graph-ordering-file "
+            "may not be used together");
+    config->callGraphProfileSort = false;
+  }
+
   assert(config->versionDefinitions.empty());
   config->versionDefinitions.push_back(
       {"local", (uint16_t)VER_NDX_LOCAL, {}, {}});
@@ -1919,6 +1957,24 @@ static void handleUndefined(Symbol *sym, const char *option) {
     ctx.whyExtractRecords.emplace_back(option, sym->file, *sym);
 }
 
+// With --archive-index, a symbol defined by an archive member that has not
+// been extracted is either absent from the symbol table or undefined. Extract
+// the member like handleUndefined() extracts a lazy symbol.
+static void handleArchiveIndexUndefined(StringRef name, const char *option) {
+  Symbol *sym = symtab.find(name);
+  if (sym && !sym->isPlaceholder() && !sym->isUndefined())
+    return;
+  InputFile *file = extractLazyArchiveMember(name);
+  if (!file)
+    return;
+  sym = symtab.find(name);
+  if (!sym)
+    return;
+  sym->isUsedInRegularObj = true;
+  if (!config->whyExtract.empty())
+    ctx.whyExtractRecords.emplace_back(option, file, *sym);
+}
+
 // As an extension to GNU linkers, lld supports a variant of `-u`
 // which accepts wildcard patterns. All symbols that match a given
 // pattern are handled as if they were given by `-u`.
@@ -1938,12 +1994,26 @@ static void handleUndefinedGlob(StringRef arg) {
 
   for (Symbol *sym : syms)
     handleUndefined(sym, "--undefined-glob");
+
+  // Names that only appear in archive symbol tables are not in the symbol
+  // table.
+  SmallVector<StringRef, 0> names;
+  for (ArchiveIndex *index : ctx.archiveIndexes)
+    for (const std::pair<uint32_t, StringRef> &s : index->symbols)
+      if (pat->match(s.second))
+        names.push_back(s.second);
+  for (StringRef name : names)
+    handleArchiveIndexUndefined(name, "--undefined-glob");
 }
 
 static void handleLibcall(StringRef name) {
   Symbol *sym = symtab.find(name);
-  if (!sym || !sym->isLazy())
+  if (!sym || !sym->isLazy()) {
+    if (config->archiveIndex &&
+        (!sym || sym->isPlaceholder() || sym->isUndefined()))
+      extractLazyArchiveMember(name, /*bitcodeOnly=*/true);
     return;
+  }
 
   MemoryBufferRef mb;
   mb = cast<LazyObject>(sym)->file->mb;
@@ -2617,7 +2687,26 @@ void LinkerDriver::link(opt::InputArgList &args) {
   // appended to the Files vector.
   {
     llvm::TimeTraceScope timeScope("Parse input files");
-    for (size_t i = 0; i < files.size(); ++i) {
+    // Archives added with --archive-index are not in files. Scan each of them
+    // when the loop reaches its position on the command line.
+    size_t numScanned = 0;
+    auto scanArchives = [&](size_t pos) {
+      for (; numScanned != ctx.archiveIndexes.size() &&
+             ctx.archiveIndexes[numScanned]->filePos <= pos;
+           ++numScanned) {
+        ArchiveIndex *index = ctx.archiveIndexes[numScanned];
+        llvm::TimeTraceScope timeScope("Scan archive index", index->path);
+        index->scan();
+      }
+    };
+
+    insertObjectSymbols(ArrayRef(files).take_front(
+        ctx.archiveIndexes.empty() ? files.size()
+                                   : ctx.archiveIndexes[0]->filePos));
+    for (size_t i = 0;; ++i) {
+      scanArchives(i);
+      if (i == files.size())
+        break;
       llvm::TimeTraceScope timeScope("Parse input files", files[i]->getName());
       parseFile(files[i]);
     }
@@ -2648,6 +2737,8 @@ void LinkerDriver::link(opt::InputArgList &args) {
   // If an entry symbol is in a static archive, pull out that file now.
   if (Symbol *sym = symtab.find(config->entry))
     handleUndefined(sym, "--entry");
+  if (config->archiveIndex)
+    handleArchiveIndexUndefined(config->entry, "--entry");
 
   // Handle the `--undefined-glob <pattern>` options.
   for (StringRef pat : args::getStrings(args, OPT_undefined_glob))
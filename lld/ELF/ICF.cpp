@@ -451,6 +451,26 @@ static void combineRelocHashes(unsigned cnt, InputSection *isec,
   isec->eqClass[(cnt + 1) % 2] = hash | (1U << 31);
 }
 
+// Computes the initial hash of a section from the parts of it that
+// equalsConstant() compares exactly: flags, contents, and the offsets and
+// types of relocations. Template instantiations often have identical contents
+// and differ only in where they are relocated; starting them in different
+// classes saves segregate() from separating them pairwise.
+template <class ELFT, class RelTy>
+static uint32_t computeConstantHash(const InputSection *isec,
+                                    ArrayRef<RelTy> rels) {
+  // FNV-1a style mixing keeps the result independent of the host.
+  constexpr uint64_t prime = 0x100000001b3;
+  uint64_t hash = xxHash64(isec->content());
+  hash = (hash ^ isec->flags) * prime;
+  hash = (hash ^ rels.size()) * prime;
+  for (const RelTy &rel : rels) {
+    hash = (hash ^ rel.r_offset) * prime;
+    hash = (hash ^ rel.getType(config->isMips64EL)) * prime;
+  }
+  return hash ^ (hash >> 32);
+}
+
 static void print(const Twine &s) {
   if (config->printIcfSections)
     message(s);
@@ -493,8 +513,12 @@ template <class ELFT> void ICF<ELFT>::run() {
 
   // Initially, we use hash values to partition sections.
   parallelForEach(sections, [&](InputSection *s) {
+    const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+    uint32_t hash = rels.areRelocsRel()
+                        ? computeConstantHash<ELFT>(s, rels.rels)
+                        : computeConstantHash<ELFT>(s, rels.relas);
     // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxHash64(s->content()) | (1U << 31);
+    s->eqClass[0] = hash | (1U << 31);
   });
 
   // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
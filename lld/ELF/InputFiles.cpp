@@ -20,12 +20,14 @@
 #include "lld/Common/DWARF.h"
 #include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/BinaryFormat/Magic.h"
 #include "llvm/LTO/LTO.h"
 #include "llvm/Object/IRObjectFile.h"
 #include "llvm/Support/ARMAttributeParser.h"
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TarWriter.h"
@@ -228,6 +230,12 @@ std::optional<MemoryBufferRef> elf::readFile(StringRef path) {
     return std::nullopt;
   }
 
+  // Most of an input file is going to be read, so ask the kernel to start
+  // paging it in now rather than faulting pages in one by one later. Only a
+  // few members of an archive are usually extracted, so skip those.
+  if (identify_magic((*mbOrErr)->getBuffer()) != file_magic::archive)
+    (*mbOrErr)->willNeedIfMmap();
+
   MemoryBufferRef mbref = (*mbOrErr)->getMemBufferRef();
   ctx.memoryBuffers.push_back(std::move(*mbOrErr)); // take MB ownership
 
@@ -317,6 +325,44 @@ template <class ELFT> static void doParseFile(InputFile *file) {
 // Add symbols in File to the symbol table.
 void elf::parseFile(InputFile *file) { invokeELFT(doParseFile, file); }
 
+// Symbol lookup dominates parsing of large links and is serial in
+// parseFile(). For the regular object files at the front of the list, the
+// lookups can be done up front in parallel without changing the result: no
+// lazy or shared symbol exists before them, so parsing them cannot extract
+// other files, and the symbol table creates symbols in the same order.
+// Resolution itself is still done by parseFile() in command line order.
+template <class ELFT>
+static void doInsertObjectSymbols(ArrayRef<InputFile *> files) {
+  SmallVector<ObjFile<ELFT> *, 0> objs;
+  for (InputFile *file : files) {
+    auto *f = dyn_cast<ObjFile<ELFT>>(file);
+    // Leave files that isCompatible() rejects to parseFile().
+    if (!f || f->lazy || f->justSymbols || f->ekind != config->ekind ||
+        f->emachine != config->emachine || config->emachine == EM_MIPS)
+      break;
+    objs.push_back(f);
+  }
+  if (objs.size() < 2)
+    return;
+
+  std::vector<SmallVector<StringRef, 0>> nameLists(objs.size());
+  std::vector<char> valid(objs.size());
+  parallelFor(0, objs.size(), [&](size_t i) {
+    valid[i] = objs[i]->getGlobalSymbolNames(nameLists[i]);
+  });
+  // Stop at a malformed file. Its error ends the link when it is parsed.
+  size_t n = llvm::find(valid, 0) - valid.begin();
+
+  SmallVector<MutableArrayRef<Symbol *>, 0> symLists;
+  for (ObjFile<ELFT> *f : ArrayRef(objs).take_front(n))
+    symLists.push_back(f->getMutableGlobalSymbols());
+  symtab.insertParallel(ArrayRef(nameLists).take_front(n), symLists);
+}
+
+void elf::insertObjectSymbols(ArrayRef<InputFile *> files) {
+  invokeELFT(doInsertObjectSymbols, files);
+}
+
 // Concatenates arguments to construct a string representing an error location.
 static std::string createFileLineMsg(StringRef path, unsigned line) {
   std::string filename = std::string(path::filename(path));
@@ -1041,7 +1087,7 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
     symbols = std::make_unique<Symbol *[]>(numSymbols);
   }
 
-  // Some entries have been filled by LazyObjFile.
+  // Some entries have been filled by LazyObjFile or insertObjectSymbols().
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
     if (!symbols[i])
       symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
@@ -1771,6 +1817,23 @@ ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
   return f;
 }
 
+template <class ELFT>
+bool ObjFile<ELFT>::getGlobalSymbolNames(SmallVector<StringRef, 0> &names) {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  names.reserve(eSyms.size() - firstGlobal);
+  for (const Elf_Sym &eSym : eSyms.slice(firstGlobal)) {
+    Expected<StringRef> name = eSym.getName(stringTable);
+    if (!name) {
+      consumeError(name.takeError());
+      return false;
+    }
+    names.push_back(*name);
+  }
+  numSymbols = eSyms.size();
+  symbols = std::make_unique<Symbol *[]>(numSymbols);
+  return true;
+}
+
 template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   const ArrayRef<typename ELFT::Sym> eSyms = this->getELFSyms<ELFT>();
   numSymbols = eSyms.size();
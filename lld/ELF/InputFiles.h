@@ -48,6 +48,10 @@ std::optional<MemoryBufferRef> readFile(StringRef path);
 // Add symbols in File to the symbol table.
 void parseFile(InputFile *file);
 
+// Insert the global symbols of the regular object files at the front of files
+// into the symbol table ahead of parseFile().
+void insertObjectSymbols(ArrayRef<InputFile *> files);
+
 // The root class of input files.
 class InputFile {
 protected:
@@ -231,6 +235,11 @@ public:
   void parse(bool ignoreComdats = false);
   void parseLazy();
 
+  // Allocates the symbol array and returns the names of the global symbols so
+  // that the symbol table can fill in the array before parse(). Returns false
+  // if a name cannot be read, in which case parse() reports the error.
+  bool getGlobalSymbolNames(SmallVector<StringRef, 0> &names);
+
   StringRef getShtGroupSignature(ArrayRef<Elf_Shdr> sections,
                                  const Elf_Shdr &sec);
 
@@ -1082,7 +1082,7 @@ void InputSectionBase::adjustSplitStackFunctionPrologues(uint8_t *buf,
 }
 
 template <class ELFT> void InputSection::writeTo(uint8_t *buf) {
-  if (LLVM_UNLIKELY(type == SHT_NOBITS))
+  if (LLVM_UNLIKELY(type == SHT_NOBITS || passthrough))
     return;
   // If -r or --emit-relocs is given, then an InputSection
   // may be a relocation section.
@@ -146,6 +146,10 @@ public:
   // deleteFallThruJmpInsn.
   bool nopFiller = false;
 
+  // Set by --debug-passthrough if the contents are copied from the input file
+  // into the output file after it is written instead of by writeTo().
+  bool passthrough = false;
+
   void drop_back(unsigned num) {
     assert(bytesDropped + num < 256);
     bytesDropped += num;
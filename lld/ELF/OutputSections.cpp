@@ -293,13 +293,25 @@ static void fill(uint8_t *buf, size_t size,
   memcpy(buf + i, filler.data(), size - i);
 }
 
+// Returns the size of the shards that a debug section of the given size is
+// split into for parallel compression. Every shard boundary costs some
+// compression ratio, so large sections use large shards, while there are
+// still enough shards to keep many threads busy. This deliberately does not
+// depend on the number of threads, so that the output does not either.
+[[maybe_unused]] static size_t getShardSize(size_t size) {
+  return std::max<size_t>(size / 128, 1 << 20);
+}
+
 #if LLVM_ENABLE_ZLIB
-static SmallVector<uint8_t, 0> deflateShard(ArrayRef<uint8_t> in, int level,
+static SmallVector<uint8_t, 0> deflateShard(ArrayRef<uint8_t> in,
+                                            ArrayRef<uint8_t> dict, int level,
                                             int flush) {
   // 15 and 8 are default. windowBits=-15 is negative to generate raw deflate
   // data with no zlib header or trailer.
   z_stream s = {};
   deflateInit2(&s, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  if (!dict.empty())
+    deflateSetDictionary(&s, dict.data(), dict.size());
   s.next_in = const_cast<uint8_t *>(in.data());
   s.avail_in = in.size();
 
@@ -344,46 +356,64 @@ template <class ELFT> void OutputSection::maybeCompress() {
   }
 
 #if LLVM_ENABLE_ZSTD
-  // Use ZSTD's streaming compression API which permits parallel workers working
-  // on the stream. See http://facebook.github.io/zstd/zstd_manual.html
-  // "Streaming compression - HowTo".
   if (config->compressDebugSections == DebugCompressionType::Zstd) {
-    // Allocate a buffer of half of the input size, and grow it by 1.5x if
-    // insufficient.
-    compressed.shards = std::make_unique<SmallVector<uint8_t, 0>[]>(1);
-    SmallVector<uint8_t, 0> &out = compressed.shards[0];
-    out.resize_for_overwrite(std::max<size_t>(size / 2, 32));
-    size_t pos = 0;
-
-    ZSTD_CCtx *cctx = ZSTD_createCCtx();
-    // Ignore error if zstd was not built with ZSTD_MULTITHREAD.
-    (void)ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers,
-                                 parallel::strategy.compute_thread_count());
-    ZSTD_outBuffer zob = {out.data(), out.size(), 0};
-    ZSTD_EndDirective directive = ZSTD_e_continue;
-    const size_t blockSize = ZSTD_CStreamInSize();
-    do {
-      const size_t n = std::min(static_cast<size_t>(size - pos), blockSize);
-      if (n == size - pos)
-        directive = ZSTD_e_end;
-      ZSTD_inBuffer zib = {buf.get() + pos, n, 0};
-      size_t bytesRemaining = 0;
-      while (zib.pos != zib.size ||
-             (directive == ZSTD_e_end && bytesRemaining != 0)) {
-        if (zob.pos == zob.size) {
-          out.resize_for_overwrite(out.size() * 3 / 2);
-          zob.dst = out.data();
-          zob.size = out.size();
+    if (compression::zstd::supportsMultithreading()) {
+      // Compress into one frame with zstd's own worker threads. Allocate a
+      // buffer of half of the input size, and grow it by 1.5x if insufficient.
+      compressed.shards = std::make_unique<SmallVector<uint8_t, 0>[]>(1);
+      compressed.numShards = 1;
+      SmallVector<uint8_t, 0> &out = compressed.shards[0];
+      out.resize_for_overwrite(std::max<size_t>(size / 2, 32));
+      size_t pos = 0;
+
+      ZSTD_CCtx *cctx = ZSTD_createCCtx();
+      (void)ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers,
+                                   parallel::strategy.compute_thread_count());
+      ZSTD_outBuffer zob = {out.data(), out.size(), 0};
+      ZSTD_EndDirective directive = ZSTD_e_continue;
+      const size_t blockSize = ZSTD_CStreamInSize();
+      do {
+        const size_t n = std::min(static_cast<size_t>(size - pos), blockSize);
+        if (n == size - pos)
+          directive = ZSTD_e_end;
+        ZSTD_inBuffer zib = {buf.get() + pos, n, 0};
+        size_t bytesRemaining = 0;
+        while (zib.pos != zib.size ||
+               (directive == ZSTD_e_end && bytesRemaining != 0)) {
+          if (zob.pos == zob.size) {
+            out.resize_for_overwrite(out.size() * 3 / 2);
+            zob.dst = out.data();
+            zob.size = out.size();
+          }
+          bytesRemaining = ZSTD_compressStream2(cctx, &zob, &zib, directive);
+          assert(!ZSTD_isError(bytesRemaining));
         }
-        bytesRemaining = ZSTD_compressStream2(cctx, &zob, &zib, directive);
-        assert(!ZSTD_isError(bytesRemaining));
-      }
-      pos += n;
-    } while (directive != ZSTD_e_end);
-    out.resize(zob.pos);
-    ZSTD_freeCCtx(cctx);
+        pos += n;
+      } while (directive != ZSTD_e_end);
+      out.resize(zob.pos);
+      ZSTD_freeCCtx(cctx);
+
+      size = sizeof(Elf_Chdr) + out.size();
+      flags |= SHF_COMPRESSED;
+      return;
+    }
 
-    size = sizeof(Elf_Chdr) + out.size();
+    // Otherwise, compress shards as independent frames in parallel. Decoders
+    // decompress concatenated frames as a single stream.
+    auto shardsIn =
+        split(ArrayRef<uint8_t>(buf.get(), size), getShardSize(size));
+    const size_t numShards = shardsIn.size();
+    auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
+    parallelFor(0, numShards, [&](size_t i) {
+      compression::zstd::compress(shardsIn[i], shardsOut[i],
+                                  ZSTD_CLEVEL_DEFAULT);
+    });
+
+    size = sizeof(Elf_Chdr);
+    for (size_t i = 0; i != numShards; ++i)
+      size += shardsOut[i].size();
+    compressed.shards = std::move(shardsOut);
+    compressed.numShards = numShards;
     flags |= SHF_COMPRESSED;
     return;
   }
@@ -397,18 +427,24 @@ template <class ELFT> void OutputSection::maybeCompress() {
   // seems enough.
   const int level = config->optimize >= 2 ? 6 : Z_BEST_SPEED;
 
-  // Split input into 1-MiB shards.
-  constexpr size_t shardSize = 1 << 20;
-  auto shardsIn = split(ArrayRef<uint8_t>(buf.get(), size), shardSize);
+  ArrayRef<uint8_t> in(buf.get(), size);
+  auto shardsIn = split(in, getShardSize(size));
   const size_t numShards = shardsIn.size();
 
   // Compress shards and compute Alder-32 checksums. Use Z_SYNC_FLUSH for all
   // shards but the last to flush the output to a byte boundary to be
-  // concatenated with the next shard.
+  // concatenated with the next shard. Since the shards form a single deflate
+  // stream, the decompressor still has the preceding 32 KiB of output in its
+  // window at the start of a shard, so that can be used as a dictionary to
+  // let the shard refer back to it.
   auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
   auto shardsAdler = std::make_unique<uint32_t[]>(numShards);
   parallelFor(0, numShards, [&](size_t i) {
-    shardsOut[i] = deflateShard(shardsIn[i], level,
+    size_t start = shardsIn[i].data() - in.data();
+    ArrayRef<uint8_t> dict =
+        in.slice(start - std::min<size_t>(start, 1 << 15),
+                 std::min<size_t>(start, 1 << 15));
+    shardsOut[i] = deflateShard(shardsIn[i], dict, level,
                                 i != numShards - 1 ? Z_SYNC_FLUSH : Z_FINISH);
     shardsAdler[i] = adler32(1, shardsIn[i].data(), shardsIn[i].size());
   });
@@ -456,27 +492,28 @@ void OutputSection::writeTo(uint8_t *buf, parallel::TaskGroup &tg) {
     chdr->ch_size = compressed.uncompressedSize;
     chdr->ch_addralign = addralign;
     buf += sizeof(*chdr);
-    if (config->compressDebugSections == DebugCompressionType::Zstd) {
-      chdr->ch_type = ELFCOMPRESS_ZSTD;
-      memcpy(buf, compressed.shards[0].data(), compressed.shards[0].size());
-      return;
-    }
-    chdr->ch_type = ELFCOMPRESS_ZLIB;
+    const bool zstd =
+        config->compressDebugSections == DebugCompressionType::Zstd;
+    chdr->ch_type = zstd ? ELFCOMPRESS_ZSTD : ELFCOMPRESS_ZLIB;
 
-    // Compute shard offsets.
+    // Compute shard offsets. zstd shards are complete frames, while zlib
+    // shards are parts of one stream with a header and a trailing checksum.
     auto offsets = std::make_unique<size_t[]>(compressed.numShards);
-    offsets[0] = 2; // zlib header
+    offsets[0] = zstd ? 0 : 2; // zlib header
     for (size_t i = 1; i != compressed.numShards; ++i)
       offsets[i] = offsets[i - 1] + compressed.shards[i - 1].size();
 
-    buf[0] = 0x78; // CMF
-    buf[1] = 0x01; // FLG: best speed
+    if (!zstd) {
+      buf[0] = 0x78; // CMF
+      buf[1] = 0x01; // FLG: best speed
+    }
     parallelFor(0, compressed.numShards, [&](size_t i) {
       memcpy(buf + offsets[i], compressed.shards[i].data(),
              compressed.shards[i].size());
     });
 
-    write32be(buf + (size - sizeof(*chdr) - 4), compressed.checksum);
+    if (!zstd)
+      write32be(buf + (size - sizeof(*chdr) - 4), compressed.checksum);
     return;
   }
 
@@ -22,6 +22,7 @@
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Demangle/Demangle.h"
+#include "llvm/Support/Parallel.h"
 
 using namespace llvm;
 using namespace llvm::object;
@@ -33,12 +34,15 @@ SymbolTable elf::symtab;
 
 void SymbolTable::wrap(Symbol *sym, Symbol *real, Symbol *wrap) {
   // Redirect __real_foo to the original foo and foo to the original __wrap_foo.
-  int &idx1 = symMap[CachedHashStringRef(sym->getName())];
-  int &idx2 = symMap[CachedHashStringRef(real->getName())];
-  int &idx3 = symMap[CachedHashStringRef(wrap->getName())];
+  CachedHashStringRef name1(sym->getName());
+  CachedHashStringRef name2(real->getName());
+  CachedHashStringRef name3(wrap->getName());
+  Symbol *&sym1 = getShard(name1)[name1];
+  Symbol *&sym2 = getShard(name2)[name2];
+  Symbol *&sym3 = getShard(name3)[name3];
 
-  idx2 = idx1;
-  idx1 = idx3;
+  sym2 = sym1;
+  sym1 = sym3;
 
   // Propagate symbol usage information to the redirected symbols.
   if (sym->isUsedInRegularObj)
@@ -62,22 +66,41 @@ void SymbolTable::wrap(Symbol *sym, Symbol *real, Symbol *wrap) {
   real->isUsedInRegularObj = false;
 }
 
-// Find an existing symbol or create a new one.
-Symbol *SymbolTable::insert(StringRef name) {
-  // <name>@@<version> means the symbol is the default version. In that
-  // case <name>@@<version> will be used to resolve references to <name>.
-  //
-  // Since this is a hot path, the following string search code is
-  // optimized for speed. StringRef::find(char) is much faster than
-  // StringRef::find(StringRef).
-  StringRef stem = name;
-  size_t pos = name.find('@');
+// <name>@@<version> means the symbol is the default version. In that
+// case <name>@@<version> will be used to resolve references to <name>.
+// Returns the part of name that is used as the symbol table key.
+//
+// Since this is a hot path, the following string search code is
+// optimized for speed. StringRef::find(char) is much faster than
+// StringRef::find(StringRef).
+static StringRef getStem(StringRef name, size_t &pos) {
+  pos = name.find('@');
   if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
-    stem = name.take_front(pos);
+    return name.take_front(pos);
+  return name;
+}
+
+// Initializes the memory of a new symbol. *sym was not initialized by a
+// constructor, so all Symbol fields are set here.
+static Symbol *initSymbol(SymbolUnion *mem, StringRef name, size_t pos) {
+  Symbol *sym = reinterpret_cast<Symbol *>(mem);
+  memset(sym, 0, sizeof(Symbol));
+  sym->setName(name);
+  sym->partition = 1;
+  sym->verdefIndex = -1;
+  sym->versionId = VER_NDX_GLOBAL;
+  if (pos != StringRef::npos)
+    sym->hasVersionSuffix = true;
+  return sym;
+}
 
-  auto p = symMap.insert({CachedHashStringRef(stem), (int)symVector.size()});
+// Find an existing symbol or create a new one.
+Symbol *SymbolTable::insert(StringRef name) {
+  size_t pos;
+  CachedHashStringRef stem(getStem(name, pos));
+  auto p = getShard(stem).insert({stem, nullptr});
   if (!p.second) {
-    Symbol *sym = symVector[p.first->second];
+    Symbol *sym = p.first->second;
     if (stem.size() != name.size()) {
       sym->setName(name);
       sym->hasVersionSuffix = true;
@@ -85,20 +108,85 @@ Symbol *SymbolTable::insert(StringRef name) {
     return sym;
   }
 
-  Symbol *sym = reinterpret_cast<Symbol *>(make<SymbolUnion>());
+  Symbol *sym = initSymbol(make<SymbolUnion>(), name, pos);
+  p.first->second = sym;
   symVector.push_back(sym);
-
-  // *sym was not initialized by a constructor. Initialize all Symbol fields.
-  memset(sym, 0, sizeof(Symbol));
-  sym->setName(name);
-  sym->partition = 1;
-  sym->verdefIndex = -1;
-  sym->versionId = VER_NDX_GLOBAL;
-  if (pos != StringRef::npos)
-    sym->hasVersionSuffix = true;
   return sym;
 }
 
+void SymbolTable::insertParallel(
+    ArrayRef<SmallVector<StringRef, 0>> nameLists,
+    ArrayRef<MutableArrayRef<Symbol *>> symLists) {
+  assert(nameLists.size() == symLists.size());
+  if (parallel::strategy.compute_thread_count() == 1) {
+    for (auto [names, syms] : llvm::zip(nameLists, symLists))
+      for (auto [j, name] : llvm::enumerate(names))
+        syms[j] = insert(name);
+    return;
+  }
+
+  // Hashing the names does not depend on the table, so do it up front. Only
+  // the shard indexes are kept; each shard rehashes its own names, which is
+  // cheap compared with the memory they would otherwise occupy.
+  std::vector<SmallVector<uint8_t, 0>> shardLists(nameLists.size());
+  parallelFor(0, nameLists.size(), [&](size_t i) {
+    SmallVector<uint8_t, 0> &shards = shardLists[i];
+    shards.resize_for_overwrite(nameLists[i].size());
+    size_t pos;
+    for (auto [j, name] : llvm::enumerate(nameLists[i]))
+      shards[j] = getShardIndex(CachedHashStringRef(getStem(name, pos)));
+  });
+
+  // Each shard walks all names in order and handles those that belong to it.
+  // All occurrences of a name are in the same shard, so they are processed in
+  // the same order as a serial insert() would, and a symbol is created when
+  // its first occurrence is seen. Record where that happened so that the new
+  // symbols can be appended to symVector in serial order afterwards.
+  struct NewSymbol {
+    uint32_t list;
+    uint32_t index;
+    Symbol *sym;
+  };
+  std::array<SmallVector<NewSymbol, 0>, numShards> newSyms;
+  parallelFor(0, numShards, [&](size_t shardIdx) {
+    DenseMap<CachedHashStringRef, Symbol *> &shard = symMap[shardIdx];
+    for (size_t i = 0, e = nameLists.size(); i != e; ++i) {
+      ArrayRef<uint8_t> shards = shardLists[i];
+      for (size_t j = 0, f = shards.size(); j != f; ++j) {
+        if (shards[j] != shardIdx)
+          continue;
+        StringRef name = nameLists[i][j];
+        size_t pos;
+        CachedHashStringRef stem(getStem(name, pos));
+        auto p = shard.insert({stem, nullptr});
+        if (!p.second) {
+          Symbol *sym = p.first->second;
+          if (stem.size() != name.size()) {
+            sym->setName(name);
+            sym->hasVersionSuffix = true;
+          }
+          symLists[i][j] = sym;
+          continue;
+        }
+        Symbol *sym = initSymbol(makeThreadLocal<SymbolUnion>(), name, pos);
+        p.first->second = sym;
+        symLists[i][j] = sym;
+        newSyms[shardIdx].push_back({uint32_t(i), uint32_t(j), sym});
+      }
+    }
+  });
+
+  SmallVector<NewSymbol, 0> all;
+  for (SmallVector<NewSymbol, 0> &v : newSyms)
+    all.append(v.begin(), v.end());
+  parallelSort(all, [](const NewSymbol &a, const NewSymbol &b) {
+    return std::tie(a.list, a.index) < std::tie(b.list, b.index);
+  });
+  symVector.reserve(symVector.size() + all.size());
+  for (const NewSymbol &ns : all)
+    symVector.push_back(ns.sym);
+}
+
 // This variant of addSymbol is used by BinaryFile::parse to check duplicate
 // symbol errors.
 Symbol *SymbolTable::addAndCheckDuplicate(const Defined &newSym) {
@@ -111,10 +199,12 @@ Symbol *SymbolTable::addAndCheckDuplicate(const Defined &newSym) {
 }
 
 Symbol *SymbolTable::find(StringRef name) {
-  auto it = symMap.find(CachedHashStringRef(name));
-  if (it == symMap.end())
+  CachedHashStringRef key(name);
+  auto &shard = getShard(key);
+  auto it = shard.find(key);
+  if (it == shard.end())
     return nullptr;
-  return symVector[it->second];
+  return it->second;
 }
 
 // A version script/dynamic list is only meaningful for a Defined symbol.
@@ -13,6 +13,7 @@
 #include "llvm/ADT/CachedHashString.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Compiler.h"
+#include <array>
 
 namespace lld::elf {
 
@@ -39,6 +40,13 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Inserts the names of nameLists and stores the resulting symbols to the
+  // corresponding elements of symLists. The result, including the order of
+  // getSymbols(), is the same as calling insert() for every name in order,
+  // but names in different shards of the table are handled in parallel.
+  void insertParallel(ArrayRef<SmallVector<StringRef, 0>> nameLists,
+                      ArrayRef<MutableArrayRef<Symbol *>> symLists);
+
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
     sym->resolve(newSym);
@@ -71,10 +79,25 @@ private:
   void assignWildcardVersion(SymbolVersion ver, uint16_t versionId,
                              bool includeNonDefault);
 
-  // Global symbols and a map from symbol name to the index. The order is not
-  // defined. We can use an arbitrary order, but it has to be deterministic even
-  // when cross linking.
-  llvm::DenseMap<llvm::CachedHashStringRef, int> symMap;
+  // The map from symbol names to symbols is split into shards selected by the
+  // high bits of the name hash so that insertParallel() can fill different
+  // shards concurrently. DenseMap picks buckets with the low bits, so the
+  // shards stay well distributed.
+  static constexpr unsigned shardBits = 6;
+  static constexpr unsigned numShards = 1 << shardBits;
+  static unsigned getShardIndex(llvm::CachedHashStringRef name) {
+    return name.hash() >> (32 - shardBits);
+  }
+  llvm::DenseMap<llvm::CachedHashStringRef, Symbol *> &
+  getShard(llvm::CachedHashStringRef name) {
+    return symMap[getShardIndex(name)];
+  }
+
+  // Global symbols and a map from symbol name to the symbol. The order of
+  // symVector is not defined. We can use an arbitrary order, but it has to be
+  // deterministic even when cross linking.
+  std::array<llvm::DenseMap<llvm::CachedHashStringRef, Symbol *>, numShards>
+      symMap;
   SmallVector<Symbol *, 0> symVector;
 
   // A map from demangled symbol names to their symbol objects.
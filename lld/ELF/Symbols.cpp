@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "Symbols.h"
+#include "ArchiveIndex.h"
 #include "Driver.h"
 #include "InputFiles.h"
 #include "InputSection.h"
@@ -388,11 +389,29 @@ void Symbol::mergeProperties(const Symbol &other) {
   }
 }
 
+// With --archive-index, archive members that have not been extracted have no
+// lazy symbols. A non-weak reference to a name that is absent from the symbol
+// table or only weakly referenced so far consults the archive symbol tables
+// instead. See the isLazy() case in resolve(const Undefined &).
+static void extractFromArchiveIndex(Symbol &sym, const Undefined &other) {
+  InputFile *file = extractLazyArchiveMember(sym.getName());
+  if (!file)
+    return;
+  if (!config->whyExtract.empty())
+    recordWhyExtract(other.file, *file, sym);
+  if (config->warnBackrefs && other.file &&
+      file->groupId < other.file->groupId && !sym.isWeak())
+    ctx.backwardReferences.try_emplace(&sym, std::make_pair(other.file, file));
+}
+
 void Symbol::resolve(const Undefined &other) {
   if (other.visibility() != STV_DEFAULT) {
     uint8_t v = visibility(), ov = other.visibility();
     setVisibility(v == STV_DEFAULT ? ov : std::min(v, ov));
   }
+  bool checkArchiveIndex = LLVM_UNLIKELY(!ctx.lazyArchiveSymbols.empty()) &&
+                           other.binding != STB_WEAK &&
+                           (isPlaceholder() || (isUndefined() && isWeak()));
   // An undefined symbol with non default visibility must be satisfied
   // in the same DSO.
   //
@@ -401,6 +420,8 @@ void Symbol::resolve(const Undefined &other) {
   if (isPlaceholder() || (isShared() && other.visibility() != STV_DEFAULT) ||
       (isUndefined() && other.binding != STB_WEAK && other.discardedSecIdx)) {
     other.overwrite(*this);
+    if (checkArchiveIndex)
+      extractFromArchiveIndex(*this, other);
     return;
   }
 
@@ -488,16 +509,17 @@ void Symbol::resolve(const Undefined &other) {
   }
 
   // Undefined symbols in a SharedFile do not change the binding.
-  if (isa_and_nonnull<SharedFile>(other.file))
-    return;
-
-  if (isUndefined() || isShared()) {
+  if (!isa_and_nonnull<SharedFile>(other.file) &&
+      (isUndefined() || isShared())) {
     // The binding will be weak if there is at least one reference and all are
     // weak. The binding has one opportunity to change to weak: if the first
     // reference is weak.
     if (other.binding != STB_WEAK || !referenced)
       binding = other.binding;
   }
+
+  if (checkArchiveIndex)
+    extractFromArchiveIndex(*this, other);
 }
 
 // Compare two symbols. Return true if the new symbol should win.
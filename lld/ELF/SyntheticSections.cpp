@@ -35,6 +35,7 @@
 #include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugPubTable.h"
+#include "llvm/Support/DJB.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
@@ -1701,7 +1702,6 @@ RelocationSection<ELFT>::RelocationSection(StringRef name, bool combreloc,
 }
 
 template <class ELFT> void RelocationSection<ELFT>::writeTo(uint8_t *buf) {
-  computeRels();
   for (const DynamicReloc &rel : relocs) {
     auto *p = reinterpret_cast<Elf_Rela *>(buf);
     p->r_offset = rel.r_offset;
@@ -2859,14 +2859,11 @@ createSymbols(
   return {ret, off};
 }
 
-// Returns a newly-created .gdb_index section.
-template <class ELFT> GdbIndexSection *GdbIndexSection::create() {
-  llvm::TimeTraceScope timeScope("Create gdb index");
-
-  // Collect InputFiles with .debug_info. See the comment in
-  // LLDDwarfObj<ELFT>::LLDDwarfObj. If we do lightweight parsing in the future,
-  // note that isec->data() may uncompress the full content, which should be
-  // parallelized.
+// Returns the InputFiles with .debug_info, for --gdb-index and --debug-names.
+// See the comment in LLDDwarfObj<ELFT>::LLDDwarfObj. If we do lightweight
+// parsing in the future, note that isec->data() may uncompress the full
+// content, which should be parallelized.
+static SetVector<InputFile *> getDebugInfoFiles() {
   SetVector<InputFile *> files;
   for (InputSectionBase *s : ctx.inputSections) {
     InputSection *isec = dyn_cast<InputSection>(s);
@@ -2887,6 +2884,13 @@ template <class ELFT> GdbIndexSection *GdbIndexSection::create() {
         return !rel->isLive();
     return !s->isLive();
   });
+  return files;
+}
+
+// Returns a newly-created .gdb_index section.
+template <class ELFT> GdbIndexSection *GdbIndexSection::create() {
+  llvm::TimeTraceScope timeScope("Create gdb index");
+  SetVector<InputFile *> files = getDebugInfoFiles();
 
   SmallVector<GdbChunk, 0> chunks(files.size());
   SmallVector<SmallVector<NameAttrEntry, 0>, 0> nameAttrs(files.size());
@@ -2990,6 +2994,296 @@ void GdbIndexSection::writeTo(uint8_t *buf) {
 
 bool GdbIndexSection::isNeeded() const { return !chunks.empty(); }
 
+DebugNamesSection::DebugNamesSection()
+    : SyntheticSection(0, SHT_PROGBITS, 1, ".debug_names") {}
+
+DebugNamesStrSection::DebugNamesStrSection(const DebugNamesSection &names)
+    : SyntheticSection(SHF_MERGE | SHF_STRINGS, SHT_PROGBITS, 1, ".debug_str"),
+      names(names) {
+  entsize = 1;
+}
+
+void DebugNamesStrSection::writeTo(uint8_t *buf) {
+  parallelForEach(names.getNames(), [&](const DebugNamesSection::NameData &n) {
+    memcpy(buf + n.stringOffset, n.name.val().data(), n.name.size());
+    buf[n.stringOffset + n.name.size()] = '\0';
+  });
+}
+
+namespace {
+struct DebugNamesInput {
+  InputSection *sec = nullptr;
+  SmallVector<uint64_t, 0> cuOffsets;
+  // The CU indices are relative to this object file.
+  SmallVector<std::pair<CachedHashStringRef, DebugNamesSection::IndexEntry>, 0>
+      entries;
+};
+} // namespace
+
+// Reads the names of the DIEs listed in .debug_gnu_pub{names,types}. The index
+// is keyed by the DW_AT_name and DW_AT_linkage_name of the DIEs, which, unlike
+// the names in those sections, are not qualified by the enclosing scopes.
+template <class ELFT>
+static void readDebugNamesInput(DWARFContext &dwarf,
+                                const LLDDwarfObj<ELFT> &obj,
+                                DebugNamesInput &in) {
+  SmallVector<DWARFUnit *, 0> units;
+  for (std::unique_ptr<DWARFUnit> &cu : dwarf.compile_units()) {
+    in.cuOffsets.push_back(cu->getOffset());
+    units.push_back(cu.get());
+  }
+
+  for (const LLDDWARFSection *pub :
+       {&obj.getGnuPubnamesSection(), &obj.getGnuPubtypesSection()}) {
+    DWARFDataExtractor data(obj, *pub, config->isLE, config->wordsize);
+    DWARFDebugPubTable table;
+    table.extract(data, /*GnuStyle=*/true, [&](Error e) {
+      warn(toString(pub->sec) + ": " + toString(std::move(e)));
+    });
+    for (const DWARFDebugPubTable::Set &set : table.getData()) {
+      uint32_t i = llvm::lower_bound(in.cuOffsets, set.Offset) -
+                   in.cuOffsets.begin();
+      if (i == units.size() || in.cuOffsets[i] != set.Offset)
+        continue;
+      DWARFUnit *cu = units[i];
+      if (Error e = cu->tryExtractDIEsIfNeeded(false)) {
+        warn(toString(in.sec) + ": " + toString(std::move(e)));
+        continue;
+      }
+      for (const DWARFDebugPubTable::Entry &ent : set.Entries) {
+        DWARFDie die = cu->getDIEForOffset(cu->getOffset() + ent.SecOffset);
+        if (!die)
+          continue;
+        DebugNamesSection::IndexEntry e{i, uint32_t(ent.SecOffset),
+                                        uint16_t(die.getTag())};
+        const char *name = die.getShortName();
+        if (name)
+          in.entries.push_back({CachedHashStringRef(name), e});
+        if (const char *linkageName = die.getLinkageName())
+          if (!name || StringRef(name) != linkageName)
+            in.entries.push_back({CachedHashStringRef(linkageName), e});
+      }
+    }
+  }
+}
+
+// Returns a newly-created .debug_names section.
+template <class ELFT> DebugNamesSection *DebugNamesSection::create() {
+  llvm::TimeTraceScope timeScope("Create debug names");
+  SetVector<InputFile *> files = getDebugInfoFiles();
+
+  SmallVector<DebugNamesInput, 0> inputs(files.size());
+  parallelFor(0, files.size(), [&](size_t i) {
+    // As with .gdb_index, avoid the cached DWARFContext of getDwarf().
+    ObjFile<ELFT> *file = cast<ObjFile<ELFT>>(files[i]);
+    DWARFContext dwarf(std::make_unique<LLDDwarfObj<ELFT>>(file));
+    auto &dobj = static_cast<const LLDDwarfObj<ELFT> &>(dwarf.getDWARFObj());
+    inputs[i].sec = dobj.getInfoSection();
+    readDebugNamesInput<ELFT>(dwarf, dobj, inputs[i]);
+  });
+
+  auto *ret = make<DebugNamesSection>();
+  SmallVector<uint32_t, 0> cuBase(inputs.size());
+  for (size_t i = 0, e = inputs.size(); i != e; ++i) {
+    cuBase[i] = ret->cus.size();
+    for (uint64_t cuOffset : inputs[i].cuOffsets)
+      ret->cus.push_back({inputs[i].sec, cuOffset});
+  }
+
+  // Uniquify the names with a sharded map, as createSymbols() does for
+  // .gdb_index. Each shard is visited in input order, so the entries of a name
+  // are in input order as well.
+  constexpr size_t numShards = 32;
+  const size_t concurrency =
+      llvm::bit_floor(std::min<size_t>(config->threadCount, numShards));
+  const size_t shift = 32 - llvm::countr_zero(numShards);
+  auto maps =
+      std::make_unique<DenseMap<CachedHashStringRef, size_t>[]>(numShards);
+  auto shards = std::make_unique<SmallVector<NameData, 0>[]>(numShards);
+  parallelFor(0, concurrency, [&](size_t threadId) {
+    for (size_t i = 0, e = inputs.size(); i != e; ++i) {
+      for (auto [name, entry] : inputs[i].entries) {
+        size_t shardId = name.hash() >> shift;
+        if ((shardId & (concurrency - 1)) != threadId)
+          continue;
+        entry.cuIndex += cuBase[i];
+        size_t &idx = maps[shardId][name];
+        if (!idx) {
+          shards[shardId].push_back({name, 0, 0, 0, {}});
+          idx = shards[shardId].size();
+        }
+        shards[shardId][idx - 1].entries.push_back(entry);
+      }
+    }
+  });
+  for (size_t i = 0; i != numShards; ++i)
+    for (NameData &n : shards[i])
+      ret->names.push_back(std::move(n));
+  shards.reset();
+  maps.reset();
+  SmallVector<NameData, 0> &names = ret->names;
+
+  parallelForEach(names, [](NameData &n) {
+    n.hashValue = caseFoldingDjbHash(n.name.val());
+    // A DIE may be listed in both .debug_gnu_pubnames and .debug_gnu_pubtypes.
+    llvm::sort(n.entries, [](const IndexEntry &a, const IndexEntry &b) {
+      return std::tie(a.cuIndex, a.dieOffset) <
+             std::tie(b.cuIndex, b.dieOffset);
+    });
+    n.entries.erase(std::unique(n.entries.begin(), n.entries.end(),
+                                [](const IndexEntry &a, const IndexEntry &b) {
+                                  return a.cuIndex == b.cuIndex &&
+                                         a.dieOffset == b.dieOffset;
+                                }),
+                    n.entries.end());
+  });
+
+  // Choose the bucket count the same way as llvm::AccelTableBase.
+  SmallVector<uint32_t, 0> hashes;
+  hashes.reserve(names.size());
+  for (const NameData &n : names)
+    hashes.push_back(n.hashValue);
+  parallelSort(hashes, std::less<uint32_t>());
+  size_t uniqueHashCount =
+      std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+  uint32_t bucketCount;
+  if (uniqueHashCount > 1024)
+    bucketCount = uniqueHashCount / 4;
+  else if (uniqueHashCount > 16)
+    bucketCount = uniqueHashCount / 2;
+  else
+    bucketCount = std::max<uint32_t>(uniqueHashCount, 1);
+
+  // Sort the names into hash table order. Ties are broken by name so that the
+  // order does not depend on how the names were sharded.
+  parallelSort(names, [&](const NameData &a, const NameData &b) {
+    return std::make_tuple(a.hashValue % bucketCount, a.hashValue,
+                           a.name.val()) <
+           std::make_tuple(b.hashValue % bucketCount, b.hashValue,
+                           b.name.val());
+  });
+  ret->buckets.assign(bucketCount, 0);
+  for (size_t i = names.size(); i != 0; --i)
+    ret->buckets[names[i - 1].hashValue % bucketCount] = i;
+
+  // Create an abbreviation for each tag.
+  BitVector seenTags(1 << 16);
+  for (const NameData &n : names)
+    for (const IndexEntry &e : n.entries)
+      seenTags.set(e.tag);
+  for (unsigned tag : seenTags.set_bits())
+    ret->tags.push_back(tag);
+
+  unsigned cuIndexForm;
+  if (isUInt<8>(ret->cus.size())) {
+    ret->cuIndexSize = 1;
+    cuIndexForm = DW_FORM_data1;
+  } else if (isUInt<16>(ret->cus.size())) {
+    ret->cuIndexSize = 2;
+    cuIndexForm = DW_FORM_data2;
+  } else {
+    ret->cuIndexSize = 4;
+    cuIndexForm = DW_FORM_data4;
+  }
+  raw_svector_ostream os(ret->abbrevTable);
+  for (size_t i = 0, e = ret->tags.size(); i != e; ++i) {
+    encodeULEB128(i + 1, os);
+    encodeULEB128(ret->tags[i], os);
+    encodeULEB128(DW_IDX_compile_unit, os);
+    encodeULEB128(cuIndexForm, os);
+    encodeULEB128(DW_IDX_die_offset, os);
+    encodeULEB128(DW_FORM_ref4, os);
+    encodeULEB128(0, os);
+    encodeULEB128(0, os);
+  }
+  encodeULEB128(0, os);
+
+  // Assign string and entry pool offsets.
+  DenseMap<uint16_t, unsigned> codes;
+  for (size_t i = 0, e = ret->tags.size(); i != e; ++i)
+    codes[ret->tags[i]] = i + 1;
+  size_t strOff = 0, entryOff = 0;
+  for (NameData &n : names) {
+    n.stringOffset = strOff;
+    strOff += n.name.size() + 1;
+    n.entryOffset = entryOff;
+    for (const IndexEntry &e : n.entries)
+      entryOff += getULEB128Size(codes[e.tag]) + ret->cuIndexSize + 4;
+    entryOff += 1; // The terminating 0 abbreviation code.
+  }
+  ret->stringsSize = strOff;
+
+  // The header is followed by the CU list, the buckets, the hashes, the string
+  // offsets, the entry offsets, the abbreviation table and the entry pool.
+  ret->entryPoolOff = 36 + ret->cus.size() * 4 + bucketCount * 4 +
+                      names.size() * 12 + ret->abbrevTable.size();
+  ret->size = ret->entryPoolOff + entryOff;
+  if (!isUInt<32>(ret->size) || !isUInt<32>(strOff))
+    errorOrWarn("--debug-names: index size (" + Twine(ret->size) +
+                ") or string size (" + Twine(strOff) + ") exceeds UINT32_MAX");
+
+  ret->strSec = make<DebugNamesStrSection>(*ret);
+  return ret;
+}
+
+void DebugNamesSection::writeEntries(uint8_t *buf,
+                                     const NameData &name) const {
+  buf += entryPoolOff + name.entryOffset;
+  for (const IndexEntry &e : name.entries) {
+    unsigned code = llvm::lower_bound(tags, e.tag) - tags.begin() + 1;
+    buf += encodeULEB128(code, buf);
+    if (cuIndexSize == 1)
+      *buf = e.cuIndex;
+    else if (cuIndexSize == 2)
+      write16(buf, e.cuIndex);
+    else
+      write32(buf, e.cuIndex);
+    buf += cuIndexSize;
+    write32(buf, e.dieOffset);
+    buf += 4;
+  }
+  *buf = 0;
+}
+
+void DebugNamesSection::writeTo(uint8_t *buf) {
+  uint8_t *start = buf;
+
+  // Write the header. There are no type units and no augmentation string.
+  write32(buf, size - 4); // unit_length
+  write16(buf + 4, 5);    // version
+  write16(buf + 6, 0);    // padding
+  write32(buf + 8, cus.size());
+  write32(buf + 12, 0);   // local_type_unit_count
+  write32(buf + 16, 0);   // foreign_type_unit_count
+  write32(buf + 20, buckets.size());
+  write32(buf + 24, names.size());
+  write32(buf + 28, abbrevTable.size());
+  write32(buf + 32, 0);   // augmentation_string_size
+  buf += 36;
+
+  for (const CuEntry &cu : cus) {
+    write32(buf, cu.sec->outSecOff + cu.cuOffset);
+    buf += 4;
+  }
+  for (uint32_t bucket : buckets) {
+    write32(buf, bucket);
+    buf += 4;
+  }
+
+  uint8_t *hashes = buf;
+  uint8_t *strOffsets = hashes + names.size() * 4;
+  uint8_t *entryOffsets = strOffsets + names.size() * 4;
+  uint64_t strBase = strSec->outSecOff;
+  parallelFor(0, names.size(), [&](size_t i) {
+    write32(hashes + i * 4, names[i].hashValue);
+    write32(strOffsets + i * 4, strBase + names[i].stringOffset);
+    write32(entryOffsets + i * 4, names[i].entryOffset);
+    writeEntries(start, names[i]);
+  });
+  buf = entryOffsets + names.size() * 4;
+  memcpy(buf, abbrevTable.data(), abbrevTable.size());
+}
+
 EhFrameHeader::EhFrameHeader()
     : SyntheticSection(SHF_ALLOC, SHT_PROGBITS, 4, ".eh_frame_hdr") {}
 
@@ -3909,6 +4203,11 @@ template GdbIndexSection *GdbIndexSection::create<ELF32BE>();
 template GdbIndexSection *GdbIndexSection::create<ELF64LE>();
 template GdbIndexSection *GdbIndexSection::create<ELF64BE>();
 
+template DebugNamesSection *DebugNamesSection::create<ELF32LE>();
+template DebugNamesSection *DebugNamesSection::create<ELF32BE>();
+template DebugNamesSection *DebugNamesSection::create<ELF64LE>();
+template DebugNamesSection *DebugNamesSection::create<ELF64BE>();
+
 template void elf::splitSections<ELF32LE>();
 template void elf::splitSections<ELF32BE>();
 template void elf::splitSections<ELF64LE>();
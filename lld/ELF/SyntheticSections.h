@@ -543,11 +543,15 @@ public:
            (d->type == llvm::ELF::SHT_RELA || d->type == llvm::ELF::SHT_REL ||
             d->type == llvm::ELF::SHT_RELR);
   }
+  // Computes the final r_offset, symbol index and addend of relocs and sorts
+  // them. Writer calls this before writeTo() so that it can use the thread
+  // pool; writeTo() runs in a task where nested parallelism is serialized.
+  void computeRels();
+
   int32_t dynamicTag, sizeDynamicTag;
   SmallVector<DynamicReloc, 0> relocs;
 
 protected:
-  void computeRels();
   // Used when parallel relocation scanning adds relocations. The elements
   // will be moved into relocs by mergeRel().
   SmallVector<SmallVector<DynamicReloc, 0>, 0> relocsVec;
@@ -836,6 +840,74 @@ private:
   size_t size;
 };
 
+class DebugNamesStrSection;
+
+// --debug-names creates a DWARF v5 .debug_names index. Like the .gdb_index,
+// it is built from the .debug_gnu_pub{names,types} sections of the inputs.
+class DebugNamesSection final : public SyntheticSection {
+public:
+  struct CuEntry {
+    InputSection *sec;
+    uint64_t cuOffset;
+  };
+
+  struct IndexEntry {
+    uint32_t cuIndex;
+    uint32_t dieOffset;
+    uint16_t tag;
+  };
+
+  struct NameData {
+    llvm::CachedHashStringRef name;
+    uint32_t hashValue;
+    uint32_t stringOffset;
+    uint32_t entryOffset;
+    SmallVector<IndexEntry, 0> entries;
+  };
+
+  DebugNamesSection();
+  template <typename ELFT> static DebugNamesSection *create();
+  void writeTo(uint8_t *buf) override;
+  size_t getSize() const override { return size; }
+  bool isNeeded() const override { return !names.empty(); }
+
+  ArrayRef<NameData> getNames() const { return names; }
+  size_t getStringsSize() const { return stringsSize; }
+
+  // The names are not in the input .debug_str sections, so they are emitted
+  // into the .debug_str output section by this section.
+  DebugNamesStrSection *strSec;
+
+private:
+  void writeEntries(uint8_t *buf, const NameData &name) const;
+
+  SmallVector<CuEntry, 0> cus;
+
+  // The names in the order of the hash table.
+  SmallVector<NameData, 0> names;
+  SmallVector<uint32_t, 0> buckets;
+
+  // The abbreviation code of tags[i] is i + 1.
+  SmallVector<uint16_t, 0> tags;
+  SmallVector<char, 0> abbrevTable;
+  uint8_t cuIndexSize;
+
+  size_t stringsSize = 0;
+  size_t entryPoolOff = 0;
+  size_t size = 0;
+};
+
+class DebugNamesStrSection final : public SyntheticSection {
+public:
+  DebugNamesStrSection(const DebugNamesSection &names);
+  void writeTo(uint8_t *buf) override;
+  size_t getSize() const override { return names.getStringsSize(); }
+  bool isNeeded() const override { return names.isNeeded(); }
+
+private:
+  const DebugNamesSection &names;
+};
+
 // --eh-frame-hdr option tells linker to construct a header for all the
 // .eh_frame sections. This header is placed to a section named .eh_frame_hdr
 // and also to a PT_GNU_EH_FRAME segment.
@@ -9,8 +9,10 @@
 #include "Writer.h"
 #include "AArch64ErrataFix.h"
 #include "ARMErrataFix.h"
+#include "BPSectionOrderer.h"
 #include "CallGraphSort.h"
 #include "Config.h"
+#include "DebugPassthrough.h"
 #include "InputFiles.h"
 #include "LinkerScript.h"
 #include "MapFile.h"
@@ -27,6 +29,7 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/Parallel.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/RandomNumberGenerator.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
@@ -465,6 +468,11 @@ template <class ELFT> void elf::createSyntheticSections() {
 
   if (config->gdbIndex)
     add(*GdbIndexSection::create<ELFT>());
+  if (config->debugNames) {
+    DebugNamesSection *sec = DebugNamesSection::create<ELFT>();
+    add(*sec);
+    add(*sec->strSec);
+  }
 
   // We always need to add rel[a].plt to output if it has entries.
   // Even for static linking it can contain R_[*]_IRELATIVE relocations.
@@ -581,6 +589,8 @@ template <class ELFT> void Writer<ELFT>::run() {
       if (config->zSeparate != SeparateSegmentKind::None)
         writeTrapInstr();
       writeHeader();
+      if (config->debugPassthrough)
+        selectDebugPassthroughSections<ELFT>();
       writeSections();
     } else {
       writeSectionsBinary();
@@ -595,6 +605,9 @@ template <class ELFT> void Writer<ELFT>::run() {
     if (auto e = buffer->commit())
       fatal("failed to write output '" + buffer->getPath() +
             "': " + toString(std::move(e)));
+
+    if (config->debugPassthrough)
+      copyDebugPassthroughSections();
   }
 }
 
@@ -1227,6 +1240,9 @@ static DenseMap<const InputSectionBase *, int> buildSectionOrder() {
   if (!config->callGraphProfile.empty())
     return computeCallGraphProfileOrder();
 
+  if (config->bpCompressionSort)
+    return computeBPCompressionOrder();
+
   if (config->symbolOrderingFile.empty())
     return sectionOrder;
 
@@ -2852,8 +2868,12 @@ template <class ELFT> void Writer<ELFT>::openFile() {
   unsigned flags = 0;
   if (!config->relocatable)
     flags |= FileOutputBuffer::F_executable;
-  if (!config->mmapOutputFile)
+  // Huge pages only help an anonymous buffer, so --huge-pages-output-file
+  // implies --no-mmap-output-file.
+  if (!config->mmapOutputFile || config->hugePagesOutputFile)
     flags |= FileOutputBuffer::F_no_mmap;
+  if (config->hugePagesOutputFile)
+    flags |= FileOutputBuffer::F_huge_pages;
   Expected<std::unique_ptr<FileOutputBuffer>> bufferOrErr =
       FileOutputBuffer::create(config->outputFile, fileSize, flags);
 
@@ -2864,9 +2884,44 @@ template <class ELFT> void Writer<ELFT>::openFile() {
   }
   buffer = std::move(*bufferOrErr);
   Out::bufferStart = buffer->getBufferStart();
+
+  // Fault the buffer in from all threads up front. Otherwise the section
+  // writers take the page faults one by one while writing in parallel, and
+  // with a first-touch NUMA policy the pages end up on a single node.
+  if (config->hugePagesOutputFile) {
+    llvm::TimeTraceScope timeScope("Prefault output buffer");
+    constexpr size_t chunkSize = 2 * 1024 * 1024;
+    // The buffer is host memory, so the host's page size applies, not the
+    // target's.
+    const size_t pageSize = llvm::sys::Process::getPageSizeEstimate();
+    uint8_t *start = buffer->getBufferStart();
+    size_t size = buffer->getBufferSize();
+    parallelFor(0, divideCeil(size, chunkSize), [&](size_t i) {
+      size_t end = std::min(size, (i + 1) * chunkSize);
+      for (size_t off = i * chunkSize; off < end; off += pageSize)
+        start[off] = 0;
+    });
+  }
+}
+
+// Finalize dynamic relocations before any section is written. Sorting a
+// large .rela.dyn is expensive, and the writeTo() tasks would do it serially.
+// Every output path must call this before writing the relocation sections.
+static void computeDynamicRelocations() {
+  llvm::TimeTraceScope timeScope("Compute dynamic relocations");
+  auto computeRels = [](RelocationBaseSection *sec) {
+    if (sec && sec->getParent() &&
+        (sec->type == SHT_REL || sec->type == SHT_RELA))
+      sec->computeRels();
+  };
+  for (Partition &part : partitions)
+    computeRels(part.relaDyn.get());
+  computeRels(in.relaPlt.get());
+  computeRels(in.relaIplt.get());
 }
 
 template <class ELFT> void Writer<ELFT>::writeSectionsBinary() {
+  computeDynamicRelocations();
   parallel::TaskGroup tg;
   for (OutputSection *sec : outputSections)
     if (sec->flags & SHF_ALLOC)
@@ -2913,19 +2968,30 @@ template <class ELFT> void Writer<ELFT>::writeTrapInstr() {
 template <class ELFT> void Writer<ELFT>::writeSections() {
   llvm::TimeTraceScope timeScope("Write sections");
 
+  computeDynamicRelocations();
+
+  auto isRelSection = [](OutputSection *sec) {
+    return sec->type == SHT_REL || sec->type == SHT_RELA;
+  };
   {
     // In -r or --emit-relocs mode, write the relocation sections first as in
     // ELf_Rel targets we might find out that we need to modify the relocated
-    // section while doing it.
+    // section while doing it. Otherwise the only relocation sections are
+    // dynamic ones, which no other section depends on, so write everything in
+    // one group to overlap them with the copying of section contents.
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
-      if (sec->type == SHT_REL || sec->type == SHT_RELA)
+      if (isRelSection(sec))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
+    if (!config->copyRelocs)
+      for (OutputSection *sec : outputSections)
+        if (!isRelSection(sec))
+          sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
-  {
+  if (config->copyRelocs) {
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
-      if (sec->type != SHT_REL && sec->type != SHT_RELA)
+      if (!isRelSection(sec))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
 
@@ -15,6 +15,7 @@
 #include "Target.h"
 #include "lld/Common/CommonLinkerContext.h"
 #include "llvm/BinaryFormat/MachO.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/TimeProfiler.h"
 
@@ -360,26 +361,21 @@ void TextOutputSection::finalize() {
       ", thunks = " + std::to_string(thunkCount));
 }
 
+// Input sections occupy disjoint ranges of the output, so they can be written
+// and relocated in parallel.
 void ConcatOutputSection::writeTo(uint8_t *buf) const {
-  for (ConcatInputSection *isec : inputs)
+  parallelForEach(inputs, [&](ConcatInputSection *isec) {
     isec->writeTo(buf + isec->outSecOff);
+  });
 }
 
 void TextOutputSection::writeTo(uint8_t *buf) const {
-  // Merge input sections from thunk & ordinary vectors
-  size_t i = 0, ie = inputs.size();
-  size_t t = 0, te = thunks.size();
-  while (i < ie || t < te) {
-    while (i < ie && (t == te || inputs[i]->empty() ||
-                      inputs[i]->outSecOff < thunks[t]->outSecOff)) {
-      inputs[i]->writeTo(buf + inputs[i]->outSecOff);
-      ++i;
-    }
-    while (t < te && (i == ie || thunks[t]->outSecOff < inputs[i]->outSecOff)) {
-      thunks[t]->writeTo(buf + thunks[t]->outSecOff);
-      ++t;
-    }
-  }
+  // Thunks are interleaved with the ordinary inputs by address, but neither
+  // overlaps the other, so the two vectors can be written independently.
+  ConcatOutputSection::writeTo(buf);
+  parallelForEach(thunks, [&](ConcatInputSection *isec) {
+    isec->writeTo(buf + isec->outSecOff);
+  });
 }
 
 void ConcatOutputSection::finalizeFlags(InputSection *input) {
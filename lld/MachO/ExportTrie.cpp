@@ -41,6 +41,7 @@
 #include "lld/Common/Memory.h"
 #include "llvm/BinaryFormat/MachO.h"
 #include "llvm/Support/LEB128.h"
+#include "llvm/Support/Parallel.h"
 #include <optional>
 
 using namespace llvm;
@@ -86,13 +87,14 @@ struct macho::TrieNode {
   std::vector<Edge> edges;
   std::optional<ExportInfo> info;
   // Estimated offset from the start of the serialized trie to the current node.
-  // This will converge to the true offset when updateOffset() is run to a
-  // fixpoint.
+  // This will converge to the true offset when TrieBuilder::build() has run
+  // the offset assignment to a fixpoint.
   size_t offset = 0;
 
   uint32_t getTerminalSize() const;
-  // Returns whether the new estimated offset differs from the old one.
-  bool updateOffset(size_t &nextOffset);
+  // Returns the size of the serialized node given the current estimated
+  // offsets of its children.
+  size_t getSize() const;
   void writeTo(uint8_t *buf) const;
 };
 
@@ -134,7 +136,7 @@ uint32_t TrieNode::getTerminalSize() const {
   return size;
 }
 
-bool TrieNode::updateOffset(size_t &nextOffset) {
+size_t TrieNode::getSize() const {
   // Size of the whole node (including the terminalSize and the outgoing edges.)
   // In contrast, terminalSize only records the size of the other data in the
   // node.
@@ -153,12 +155,7 @@ bool TrieNode::updateOffset(size_t &nextOffset) {
     nodeSize += edge.substring.size() + 1             // String length.
                 + getULEB128Size(edge.child->offset); // Offset len.
   }
-  // On input, 'nextOffset' is the new preferred location for this node.
-  bool result = (offset != nextOffset);
-  // Store new location in node object for use by parents.
-  offset = nextOffset;
-  nextOffset += nodeSize;
-  return result;
+  return nodeSize;
 }
 
 void TrieNode::writeTo(uint8_t *buf) const {
@@ -200,69 +197,44 @@ TrieNode *TrieBuilder::makeNode() {
   return node;
 }
 
-static int charAt(const Symbol *sym, size_t pos) {
-  StringRef str = sym->getName();
-  if (pos >= str.size())
-    return -1;
-  return str[pos];
-}
-
-// Build the trie by performing a three-way radix quicksort: We start by sorting
-// the strings by their first characters, then sort the strings with the same
-// first characters by their second characters, and so on recursively. Each
-// time the prefixes diverge, we add a node to the trie.
+// Build the trie from the exported symbols sorted by name. The strings in vec
+// all have the prefix of length pos that leads to node, and because vec is
+// sorted, the prefix they all share is the common prefix of the first and the
+// last string. Each time the prefixes diverge, we add a node to the trie.
 //
-// node:    The most recently created node along this path in the trie (i.e.
-//          the furthest from the root.)
-// lastPos: The prefix length of the most recently created node, i.e. the number
-//          of characters along its path from the root.
-// pos:     The string index we are currently sorting on. Note that each symbol
-//          S contained in vec has the same prefix S[0...pos).
-void TrieBuilder::sortAndBuild(MutableArrayRef<const Symbol *> vec,
-                               TrieNode *node, size_t lastPos, size_t pos) {
-tailcall:
-  if (vec.empty())
-    return;
-
-  // Partition items so that items in [0, i) are less than the pivot,
-  // [i, j) are the same as the pivot, and [j, vec.size()) are greater than
-  // the pivot.
-  const Symbol *pivotSymbol = vec[vec.size() / 2];
-  int pivot = charAt(pivotSymbol, pos);
-  size_t i = 0;
-  size_t j = vec.size();
-  for (size_t k = 0; k < j;) {
-    int c = charAt(vec[k], pos);
-    if (c < pivot)
-      std::swap(vec[i++], vec[k++]);
-    else if (c > pivot)
-      std::swap(vec[--j], vec[k]);
-    else
-      k++;
-  }
-
-  bool isTerminal = pivot == -1;
-  bool prefixesDiverge = i != 0 || j != vec.size();
-  if (lastPos != pos && (isTerminal || prefixesDiverge)) {
+// Nodes are created in preorder with the edges of each node sorted, so the
+// layout of the trie only depends on the set of exported names.
+void TrieBuilder::build(ArrayRef<const Symbol *> vec, TrieNode *node,
+                        size_t pos) {
+  StringRef first = vec.front()->getName();
+  StringRef last = vec.back()->getName();
+  size_t commonPos = pos;
+  size_t maxPos = std::min(first.size(), last.size());
+  while (commonPos < maxPos && first[commonPos] == last[commonPos])
+    ++commonPos;
+
+  if (commonPos != pos) {
     TrieNode *newNode = makeNode();
-    node->edges.emplace_back(pivotSymbol->getName().slice(lastPos, pos),
-                             newNode);
+    node->edges.emplace_back(first.slice(pos, commonPos), newNode);
     node = newNode;
-    lastPos = pos;
+    pos = commonPos;
   }
 
-  sortAndBuild(vec.slice(0, i), node, lastPos, pos);
-  sortAndBuild(vec.slice(j), node, lastPos, pos);
+  // A name that ends here sorts before all the names it is a prefix of.
+  if (first.size() == pos) {
+    assert((vec.size() == 1 || vec[1]->getName().size() != pos) &&
+           "no duplicate symbols");
+    node->info = ExportInfo(*vec.front(), imageBase);
+    vec = vec.drop_front();
+  }
 
-  if (isTerminal) {
-    assert(j - i == 1); // no duplicate symbols
-    node->info = ExportInfo(*pivotSymbol, imageBase);
-  } else {
-    // This is the tail-call-optimized version of the following:
-    // sortAndBuild(vec.slice(i, j - i), node, lastPos, pos + 1);
-    vec = vec.slice(i, j - i);
-    ++pos;
-    goto tailcall;
+  while (!vec.empty()) {
+    char c = vec.front()->getName()[pos];
+    size_t n = 1;
+    while (n != vec.size() && vec[n]->getName()[pos] == c)
+      ++n;
+    build(vec.take_front(n), node, pos);
+    vec = vec.drop_front(n);
   }
 }
 
@@ -270,18 +242,29 @@ size_t TrieBuilder::build() {
   if (exported.empty())
     return 0;
 
+  parallelSort(exported, [](const Symbol *a, const Symbol *b) {
+    return a->getName() < b->getName();
+  });
   TrieNode *root = makeNode();
-  sortAndBuild(exported, root, 0, 0);
+  build(exported, root, 0);
 
   // Assign each node in the vector an offset in the trie stream, iterating
-  // until all uleb128 sizes have stabilized.
+  // until all uleb128 sizes have stabilized. A node's size depends on the
+  // offsets of its children, which come after it, so the sizes can be computed
+  // in parallel from the offsets of the previous iteration.
+  std::vector<size_t> sizes(nodes.size());
   size_t offset;
   bool more;
   do {
+    parallelFor(0, nodes.size(),
+                [&](size_t i) { sizes[i] = nodes[i]->getSize(); });
     offset = 0;
     more = false;
-    for (TrieNode *node : nodes)
-      more |= node->updateOffset(offset);
+    for (size_t i = 0, e = nodes.size(); i != e; ++i) {
+      more |= nodes[i]->offset != offset;
+      nodes[i]->offset = offset;
+      offset += sizes[i];
+    }
   } while (more);
 
   return offset;
@@ -30,8 +30,7 @@ public:
 
 private:
   TrieNode *makeNode();
-  void sortAndBuild(llvm::MutableArrayRef<const Symbol *> vec, TrieNode *node,
-                    size_t lastPos, size_t pos);
+  void build(llvm::ArrayRef<const Symbol *> vec, TrieNode *node, size_t pos);
 
   uint64_t imageBase = 0;
   std::vector<const Symbol *> exported;
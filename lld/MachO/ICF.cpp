@@ -412,6 +412,7 @@ void macho::foldIdenticalSections(bool onlyCfStrings) {
   // someone keep the numbers straight in case we ever need to debug the
   // ICF::segregate()
   std::vector<ConcatInputSection *> foldable;
+  std::vector<ConcatInputSection *> addendsRemoved;
   uint64_t icfUniqueID = inputSections.size();
   for (ConcatInputSection *isec : inputSections) {
     bool isFoldableWithAddendsRemoved = isCfStringSection(isec) ||
@@ -438,26 +439,26 @@ void macho::foldIdenticalSections(bool onlyCfStrings) {
       // information gets recorded in our Reloc structs.) We therefore create a
       // mutable copy of the section data and zero out the embedded addends
       // before performing any hashing / equality checks.
-      if (isFoldableWithAddendsRemoved) {
-        // We have to do this copying serially as the BumpPtrAllocator is not
-        // thread-safe. FIXME: Make a thread-safe allocator.
-        MutableArrayRef<uint8_t> copy = isec->data.copy(bAlloc());
-        for (const Reloc &r : isec->relocs)
-          target->relocateOne(copy.data() + r.offset, r, /*va=*/0,
-                              /*relocVA=*/0);
-        isec->data = copy;
-      }
+      if (isFoldableWithAddendsRemoved)
+        addendsRemoved.push_back(isec);
     } else if (!isEhFrameSection(isec)) {
       // EH frames are gathered as foldables from unwindEntry above; give a
       // unique ID to everything else.
       isec->icfEqClass[0] = ++icfUniqueID;
     }
   }
+  parallelForEach(addendsRemoved, [](ConcatInputSection *isec) {
+    uint8_t *copy = makeThreadLocalN<uint8_t>(isec->data.size());
+    memcpy(copy, isec->data.data(), isec->data.size());
+    for (const Reloc &r : isec->relocs)
+      target->relocateOne(copy + r.offset, r, /*va=*/0, /*relocVA=*/0);
+    isec->data = ArrayRef(copy, isec->data.size());
+  });
   parallelForEach(foldable, [](ConcatInputSection *isec) {
     assert(isec->icfEqClass[0] == 0); // don't overwrite a unique ID!
     // Turn-on the top bit to guarantee that valid hashes have no collisions
     // with the small-integer unique IDs for ICF-ineligible sections
-    isec->icfEqClass[0] = xxHash64(isec->data) | (1ull << 31);
+    isec->icfEqClass[0] = xxh3_64bits(isec->data) | (1ull << 31);
   });
   // Now that every input section is either hashed or marked as unique, run the
   // segregation algorithm to detect foldable subsections.
@@ -2149,11 +2149,12 @@ void ChainedFixupsSection::finalizeContents() {
   else
     importFormat = DYLD_CHAINED_IMPORT;
 
-  for (Location &loc : locations)
+  parallelForEach(locations, [](Location &loc) {
     loc.offset =
         loc.isec->parent->getSegmentOffset() + loc.isec->getOffset(loc.offset);
+  });
 
-  llvm::sort(locations, [](const Location &a, const Location &b) {
+  parallelSort(locations, [](const Location &a, const Location &b) {
     const OutputSegment *segA = a.isec->parent->parent;
     const OutputSegment *segB = b.isec->parent->parent;
     if (segA == segB)
@@ -2165,20 +2166,29 @@ void ChainedFixupsSection::finalizeContents() {
     return a.isec->parent->parent == b.isec->parent->parent;
   };
 
+  // Find the range of locations of each segment, then compute the page starts
+  // of the segments in parallel.
+  SmallVector<size_t, 4> segmentBegins;
+  for (size_t i = 0, count = locations.size(); i < count; ++i) {
+    if (i == 0 || !sameSegment(locations[i - 1], locations[i])) {
+      segmentBegins.push_back(i);
+      fixupSegments.emplace_back(locations[i].isec->parent->parent);
+    }
+  }
+  segmentBegins.push_back(locations.size());
+
   const uint64_t pageSize = target->getPageSize();
-  for (size_t i = 0, count = locations.size(); i < count;) {
-    const Location &firstLoc = locations[i];
-    fixupSegments.emplace_back(firstLoc.isec->parent->parent);
-    while (i < count && sameSegment(locations[i], firstLoc)) {
+  parallelFor(0, fixupSegments.size(), [&](size_t seg) {
+    for (size_t i = segmentBegins[seg], end = segmentBegins[seg + 1];
+         i < end;) {
       uint32_t pageIdx = locations[i].offset / pageSize;
-      fixupSegments.back().pageStarts.emplace_back(
+      fixupSegments[seg].pageStarts.emplace_back(
           pageIdx, locations[i].offset % pageSize);
       ++i;
-      while (i < count && sameSegment(locations[i], firstLoc) &&
-             locations[i].offset / pageSize == pageIdx)
+      while (i < end && locations[i].offset / pageSize == pageIdx)
         ++i;
     }
-  }
+  });
 
   // Compute expected encoded size.
   size = alignTo<8>(sizeof(dyld_chained_fixups_header));
@@ -458,8 +458,10 @@ void UnwindInfoSectionImpl::finalize() {
   // vector of indices to entries and sort & fold that instead.
   cuIndices.resize(cuEntries.size());
   std::iota(cuIndices.begin(), cuIndices.end(), 0);
-  llvm::sort(cuIndices, [&](size_t a, size_t b) {
-    return cuEntries[a].functionAddress < cuEntries[b].functionAddress;
+  // Break ties by index so that the parallel sort is deterministic.
+  parallelSort(cuIndices, [&](size_t a, size_t b) {
+    return std::make_pair(cuEntries[a].functionAddress, a) <
+           std::make_pair(cuEntries[b].functionAddress, b);
   });
 
   // Record the ending boundary before we fold the entries.
@@ -672,16 +674,19 @@ void UnwindInfoSectionImpl::writeTo(uint8_t *buf) const {
   // LSDAs
   auto *lep =
       reinterpret_cast<unwind_info_section_header_lsda_index_entry *>(iep);
-  for (size_t idx : entriesWithLsda) {
-    const CompactUnwindEntry &cu = cuEntries[idx];
-    lep->lsdaOffset = cu.lsda->getVA(/*off=*/0) - in.header->addr;
-    lep->functionOffset = cu.functionAddress - in.header->addr;
-    lep++;
-  }
-
-  // Level-2 pages
-  auto *pp = reinterpret_cast<uint32_t *>(lep);
-  for (const SecondLevelPage &page : secondLevelPages) {
+  parallelFor(0, entriesWithLsda.size(), [&](size_t i) {
+    const CompactUnwindEntry &cu = cuEntries[entriesWithLsda[i]];
+    lep[i].lsdaOffset = cu.lsda->getVA(/*off=*/0) - in.header->addr;
+    lep[i].functionOffset = cu.functionAddress - in.header->addr;
+  });
+  lep += entriesWithLsda.size();
+
+  // Level-2 pages. Each page has a fixed size, so they can be written in
+  // parallel.
+  auto *pages = reinterpret_cast<uint32_t *>(lep);
+  parallelFor(0, secondLevelPages.size(), [&](size_t pageIdx) {
+    const SecondLevelPage &page = secondLevelPages[pageIdx];
+    uint32_t *pp = pages + pageIdx * SECOND_LEVEL_PAGE_WORDS;
     if (page.kind == UNWIND_SECOND_LEVEL_COMPRESSED) {
       uintptr_t functionAddressBase =
           cuEntries[cuIndices[page.entryIndex]].functionAddress;
@@ -723,8 +728,7 @@ void UnwindInfoSectionImpl::writeTo(uint8_t *buf) const {
         *ep++ = cue.encoding;
       }
     }
-    pp += SECOND_LEVEL_PAGE_WORDS;
-  }
+  });
 }
 
 UnwindInfoSection *macho::makeUnwindInfoSection() {
@@ -1156,7 +1156,18 @@ void Writer::writeSections() {
   for (const OutputSegment *seg : outputSegments)
     append_range(osecs, seg->getSections());
 
-  parallelForEach(osecs.begin(), osecs.end(), [&](const OutputSection *osec) {
+  // ConcatOutputSections, which hold the bulk of the output, and
+  // __unwind_info are written in parallel internally. Nested parallelism runs
+  // serially inside a worker, so write them one at a time from this thread,
+  // and the remaining sections in parallel with each other.
+  std::vector<const OutputSection *> others;
+  for (const OutputSection *osec : osecs) {
+    if (isa<ConcatOutputSection>(osec) || osec == in.unwindInfo)
+      osec->writeTo(buf + osec->fileOff);
+    else
+      others.push_back(osec);
+  }
+  parallelForEach(others, [&](const OutputSection *osec) {
     osec->writeTo(buf + osec->fileOff);
   });
 }
@@ -1216,35 +1227,67 @@ void Writer::buildFixupChains() {
   const uint64_t pageSize = target->getPageSize();
   constexpr uint32_t stride = 4; // for DYLD_CHAINED_PTR_64
 
-  for (size_t i = 0, count = loc.size(); i < count;) {
-    const OutputSegment *oseg = loc[i].isec->parent->parent;
-    uint8_t *buf = buffer->getBufferStart() + oseg->fileOff;
-    uint64_t pageIdx = loc[i].offset / pageSize;
-    ++i;
-
-    while (i < count && loc[i].isec->parent->parent == oseg &&
-           (loc[i].offset / pageSize) == pageIdx) {
-      uint64_t offset = loc[i].offset - loc[i - 1].offset;
-
-      auto fail = [&](Twine message) {
-        error(loc[i].isec->getSegName() + "," + loc[i].isec->getName() +
-              ", offset " +
-              Twine(loc[i].offset - loc[i].isec->parent->getSegmentOffset()) +
-              ": " + message);
-      };
-
-      if (offset < target->wordSize)
-        return fail("fixups overlap");
-      if (offset % stride != 0)
-        return fail(
-            "fixups are unaligned (offset " + Twine(offset) +
-            " is not a multiple of the stride). Re-link with -no_fixup_chains");
+  auto samePage = [&](size_t i, size_t j) {
+    return loc[i].isec->parent->parent == loc[j].isec->parent->parent &&
+           loc[i].offset / pageSize == loc[j].offset / pageSize;
+  };
+
+  // Returns an error message if the fixup at i cannot be chained to the one
+  // before it on the same page.
+  auto check = [&](size_t i) -> std::optional<std::string> {
+    uint64_t offset = loc[i].offset - loc[i - 1].offset;
+    if (offset < target->wordSize)
+      return "fixups overlap";
+    if (offset % stride != 0)
+      return ("fixups are unaligned (offset " + Twine(offset) +
+              " is not a multiple of the stride). Re-link with "
+              "-no_fixup_chains")
+          .str();
+    return std::nullopt;
+  };
+
+  // Every page has its own chain, so split the locations into shards that
+  // begin at a page boundary and link the shards in parallel. A shard stops
+  // at its first bad fixup; only the first one overall is reported so that
+  // the diagnostic does not depend on the number of threads.
+  const size_t count = loc.size();
+  const size_t numShards =
+      std::min<size_t>(count, parallel::strategy.compute_thread_count() * 4);
+  std::vector<size_t> shardBegins(numShards + 1, count);
+  shardBegins[0] = 0;
+  for (size_t shard = 1; shard < numShards; ++shard) {
+    size_t i = std::max(count * shard / numShards, shardBegins[shard - 1]);
+    while (i < count && samePage(i - 1, i))
+      ++i;
+    shardBegins[shard] = i;
+  }
+  std::vector<size_t> firstError(numShards, count);
 
+  uint8_t *bufferStart = buffer->getBufferStart();
+  parallelFor(0, numShards, [&](size_t shard) {
+    for (size_t i = shardBegins[shard], end = shardBegins[shard + 1];
+         i < end; ++i) {
+      if (i == shardBegins[shard] || !samePage(i - 1, i))
+        continue;
+      if (check(i)) {
+        firstError[shard] = i;
+        return;
+      }
       // The "next" field is in the same location for bind and rebase entries.
+      uint8_t *buf = bufferStart + loc[i].isec->parent->parent->fileOff;
       reinterpret_cast<dyld_chained_ptr_64_bind *>(buf + loc[i - 1].offset)
-          ->next = offset / stride;
-      ++i;
+          ->next = (loc[i].offset - loc[i - 1].offset) / stride;
     }
+  });
+
+  for (size_t i : firstError) {
+    if (i == count)
+      continue;
+    error(loc[i].isec->getSegName() + "," + loc[i].isec->getName() +
+          ", offset " +
+          Twine(loc[i].offset - loc[i].isec->parent->getSegmentOffset()) +
+          ": " + *check(i));
+    return;
   }
 }
 
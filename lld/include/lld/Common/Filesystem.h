@@ -15,6 +15,8 @@
 namespace lld {
 void unlinkAsync(StringRef path);
 std::error_code tryCreateFile(StringRef path);
+std::error_code copyFileRange(int inFd, uint64_t inOffset, int outFd,
+                              uint64_t outOffset, ArrayRef<uint8_t> data);
 } // namespace lld
 
 #endif
@@ -0,0 +1,43 @@
+# REQUIRES: x86
+## With --archive-index, a non-weak reference that follows a weak reference
+## extracts the member and makes the binding global, as without the option.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 weak.s -o weak.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 strong.s -o strong.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 def.s -o def.o
+# RUN: llvm-ar rc lib.a def.o
+
+## Only weak references: nothing is extracted and the bindings stay weak.
+# RUN: ld.lld -shared --archive-index lib.a weak.o -o weak.so
+# RUN: llvm-readelf --dyn-syms weak.so | FileCheck %s --check-prefix=WEAK
+
+# WEAK-DAG: WEAK   DEFAULT UND foo
+# WEAK-DAG: WEAK   DEFAULT UND missing
+
+## A weak reference followed by a strong one.
+# RUN: ld.lld -shared --archive-index lib.a weak.o strong.o -o weak-strong.so
+# RUN: llvm-readelf --dyn-syms weak-strong.so | FileCheck %s --check-prefix=GLOBAL
+## A strong reference followed by a weak one.
+# RUN: ld.lld -shared --archive-index lib.a strong.o weak.o -o strong-weak.so
+# RUN: llvm-readelf --dyn-syms strong-weak.so | FileCheck %s --check-prefix=GLOBAL
+## The default mode gives the same result.
+# RUN: ld.lld -shared lib.a weak.o strong.o -o default.so
+# RUN: llvm-readelf --dyn-syms default.so | FileCheck %s --check-prefix=GLOBAL
+
+# GLOBAL-DAG: GLOBAL DEFAULT UND missing
+# GLOBAL-DAG: GLOBAL DEFAULT   {{[0-9]+}} foo
+
+#--- weak.s
+.weak foo, missing
+.quad foo
+.quad missing
+
+#--- strong.s
+.globl foo, missing
+.quad foo
+.quad missing
+
+#--- def.s
+.globl foo
+foo:
@@ -0,0 +1,67 @@
+# REQUIRES: x86
+## --bp-compression-sort places executable sections with similar contents next
+## to each other.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+
+## Without the option, the input order is kept.
+# RUN: ld.lld -e fa1 %t.o -o %t
+# RUN: llvm-nm -n %t | FileCheck %s --check-prefix=NOSORT
+
+# NOSORT:      T fa1
+# NOSORT-NEXT: T fb1
+# NOSORT-NEXT: T fa2
+# NOSORT-NEXT: T fb2
+
+## With it, the two fa* and the two fb* functions end up adjacent.
+# RUN: ld.lld -e fa1 --bp-compression-sort %t.o -o %t.sorted
+# RUN: llvm-nm -n %t.sorted | FileCheck %s --check-prefix=SORT
+# RUN: ld.lld -e fa1 --no-bp-compression-sort --bp-compression-sort %t.o \
+# RUN:   -o %t.sorted2
+# RUN: cmp %t.sorted %t.sorted2
+
+# SORT:      T f[[A:a|b]]{{[12]$}}
+# SORT-NEXT: T f[[A]]{{[12]$}}
+# SORT-NEXT: T f[[B:a|b]]{{[12]$}}
+# SORT-NEXT: T f[[B]]{{[12]$}}
+
+## The output does not depend on the number of threads.
+# RUN: ld.lld -e fa1 --bp-compression-sort --threads=1 %t.o -o %t.sorted3
+# RUN: cmp %t.sorted %t.sorted3
+
+## The option may not be combined with an explicit order.
+# RUN: echo fa1 > %t.order
+# RUN: not ld.lld -e fa1 --bp-compression-sort --symbol-ordering-file=%t.order \
+# RUN:   %t.o -o /dev/null 2>&1 | FileCheck %s --check-prefix=ERR-SYM
+# ERR-SYM: error: --bp-compression-sort and --symbol-ordering-file may not be used together
+
+# RUN: echo "fa1 fb1 10" > %t.cg
+# RUN: not ld.lld -e fa1 --bp-compression-sort --call-graph-ordering-file=%t.cg \
+# RUN:   %t.o -o /dev/null 2>&1 | FileCheck %s --check-prefix=ERR-CG
+# ERR-CG: error: --bp-compression-sort and --call-graph-ordering-file may not be used together
+
+## --no-bp-compression-sort turns it off, so the explicit order is accepted.
+# RUN: ld.lld -e fa1 --bp-compression-sort --no-bp-compression-sort \
+# RUN:   --symbol-ordering-file=%t.order %t.o -o /dev/null
+
+.globl fa1, fa2, fb1, fb2
+
+.section .text.fa1,"ax",@progbits
+fa1:
+  .fill 64, 1, 0x90
+  ret
+
+.section .text.fb1,"ax",@progbits
+fb1:
+  .fill 64, 1, 0xcc
+  ret
+
+.section .text.fa2,"ax",@progbits
+fa2:
+  .fill 64, 1, 0x90
+  ret
+
+.section .text.fb2,"ax",@progbits
+fb2:
+  .fill 64, 1, 0xcc
+  ret
@@ -0,0 +1,146 @@
+# REQUIRES: x86
+## --debug-names builds a .debug_names index from .debug_gnu_pubnames. Each
+## name is indexed by its DW_AT_name and DW_AT_linkage_name, and a name found
+## in several compile units gets one entry per unit.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --defsym MAIN=1 %s -o %t1.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t2.o
+# RUN: ld.lld --debug-names %t1.o %t2.o -o %t
+# RUN: llvm-dwarfdump --debug-names %t | FileCheck %s
+# RUN: llvm-dwarfdump --verify %t | FileCheck %s --check-prefix=VERIFY
+
+## The index does not depend on the number of threads.
+# RUN: ld.lld --debug-names --threads=1 %t1.o %t2.o -o %t.1
+# RUN: cmp %t %t.1
+
+## Without the option, or with --no-debug-names, there is no index.
+# RUN: ld.lld --debug-names --no-debug-names %t1.o %t2.o -o %t.no
+# RUN: llvm-readelf -S %t.no | FileCheck %s --check-prefix=NO
+# NO-NOT: .debug_names
+
+# RUN: not ld.lld --debug-names -r %t1.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=ERR
+# ERR: error: -r and --debug-names may not be used together
+
+# CHECK:      .debug_names contents:
+# CHECK-NEXT: Name Index @ 0x0 {
+# CHECK:        Version: 5
+# CHECK-NEXT:   CU count: 2
+# CHECK-NEXT:   Local TU count: 0
+# CHECK-NEXT:   Foreign TU count: 0
+# CHECK-NEXT:   Bucket count: 3
+# CHECK-NEXT:   Name count: 3
+# CHECK:      Compilation Unit offsets [
+# CHECK-NEXT:   CU[0]: 0x00000000
+# CHECK-NEXT:   CU[1]: 0x00000023
+# CHECK-NEXT: ]
+# CHECK:      Bucket 0 [
+# CHECK-NEXT:   Name 1 {
+# CHECK-NEXT:     Hash: 0xB887389
+# CHECK-NEXT:     String: 0x{{[0-9a-f]+}} "foo"
+# CHECK-NEXT:     Entry @ 0x{{[0-9a-f]+}} {
+# CHECK-NEXT:       Abbrev: 0x1
+# CHECK-NEXT:       Tag: DW_TAG_subprogram
+# CHECK-NEXT:       DW_IDX_compile_unit: 0x00
+# CHECK-NEXT:       DW_IDX_die_offset: 0x00000010
+# CHECK-NEXT:     }
+# CHECK-NEXT:     Entry @ 0x{{[0-9a-f]+}} {
+# CHECK-NEXT:       Abbrev: 0x1
+# CHECK-NEXT:       Tag: DW_TAG_subprogram
+# CHECK-NEXT:       DW_IDX_compile_unit: 0x01
+# CHECK-NEXT:       DW_IDX_die_offset: 0x00000010
+# CHECK-NEXT:     }
+# CHECK-NEXT:   }
+# CHECK-NEXT:   Name 2 {
+# CHECK-NEXT:     Hash: 0xB88B5CE
+# CHECK-NEXT:     String: 0x{{[0-9a-f]+}} "var"
+# CHECK-NEXT:     Entry @ 0x{{[0-9a-f]+}} {
+# CHECK-NEXT:       Abbrev: 0x2
+# CHECK-NEXT:       Tag: DW_TAG_variable
+# CHECK-NEXT:       DW_IDX_compile_unit: 0x00
+# CHECK-NEXT:       DW_IDX_die_offset: 0x0000001d
+# CHECK-NEXT:     }
+# CHECK-NEXT:     Entry @ 0x{{[0-9a-f]+}} {
+# CHECK-NEXT:       Abbrev: 0x2
+# CHECK-NEXT:       Tag: DW_TAG_variable
+# CHECK-NEXT:       DW_IDX_compile_unit: 0x01
+# CHECK-NEXT:       DW_IDX_die_offset: 0x0000001d
+# CHECK-NEXT:     }
+# CHECK-NEXT:   }
+# CHECK-NEXT: ]
+# CHECK-NEXT: Bucket 1 [
+# CHECK-NEXT:   Name 3 {
+# CHECK-NEXT:     Hash: 0xB5063D0B
+# CHECK-NEXT:     String: 0x{{[0-9a-f]+}} "_Z3foov"
+# CHECK:      Bucket 2 [
+# CHECK-NEXT:   EMPTY
+# CHECK-NEXT: ]
+
+# VERIFY: No errors.
+
+.ifdef MAIN
+.globl _start
+.text
+_start:
+  ret
+.endif
+
+.section .debug_abbrev,"",@progbits
+  .byte 1              # Abbreviation code
+  .byte 17             # DW_TAG_compile_unit
+  .byte 1              # DW_CHILDREN_yes
+  .byte 3              # DW_AT_name
+  .byte 8              # DW_FORM_string
+  .byte 0
+  .byte 0
+  .byte 2              # Abbreviation code
+  .byte 46             # DW_TAG_subprogram
+  .byte 0              # DW_CHILDREN_no
+  .byte 3              # DW_AT_name
+  .byte 8              # DW_FORM_string
+  .byte 0x6e           # DW_AT_linkage_name
+  .byte 8              # DW_FORM_string
+  .byte 0
+  .byte 0
+  .byte 3              # Abbreviation code
+  .byte 52             # DW_TAG_variable
+  .byte 0              # DW_CHILDREN_no
+  .byte 3              # DW_AT_name
+  .byte 8              # DW_FORM_string
+  .byte 0
+  .byte 0
+  .byte 0
+
+.section .debug_info,"",@progbits
+.Lcu_begin0:
+  .long .Lcu_end0-.Lcu_start0 # Length of Unit
+.Lcu_start0:
+  .short 4             # DWARF version number
+  .long .debug_abbrev  # Offset Into Abbrev. Section
+  .byte 8              # Address Size
+  .byte 1              # Abbrev [1] DW_TAG_compile_unit
+  .asciz "a.c"         # DW_AT_name
+.Ldie_foo:
+  .byte 2              # Abbrev [2] DW_TAG_subprogram
+  .asciz "foo"         # DW_AT_name
+  .asciz "_Z3foov"     # DW_AT_linkage_name
+.Ldie_var:
+  .byte 3              # Abbrev [3] DW_TAG_variable
+  .asciz "var"         # DW_AT_name
+  .byte 0              # End Of Children Mark
+.Lcu_end0:
+
+.section .debug_gnu_pubnames,"",@progbits
+  .long .LpubNames_end0-.LpubNames_begin0 # Length of Public Names Info
+.LpubNames_begin0:
+  .short 2             # DWARF Version
+  .long .Lcu_begin0    # Offset of Compilation Unit Info
+  .long .Lcu_end0-.Lcu_begin0 # Compilation Unit Length
+  .long .Ldie_foo-.Lcu_begin0 # DIE offset
+  .byte 48             # Attributes: FUNCTION, EXTERNAL
+  .asciz "foo"         # External Name
+  .long .Ldie_var-.Lcu_begin0 # DIE offset
+  .byte 32             # Attributes: VARIABLE, EXTERNAL
+  .asciz "var"         # External Name
+  .long 0              # End Mark
+.LpubNames_end0:
@@ -0,0 +1,76 @@
+# REQUIRES: x86, zlib
+## --debug-passthrough copies debug sections without relocations from the
+## input files after the output is written. The output must be identical to
+## the one written through the output buffer.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 c.s -o c.o
+# RUN: llvm-ar rc c.a c.o
+
+# RUN: ld.lld a.o b.o c.a -o out
+# RUN: ld.lld --debug-passthrough a.o b.o c.a -o out.pass
+# RUN: cmp out out.pass
+# RUN: llvm-readelf -x .debug_abbrev -x .debug_info -x .debug_line out.pass | \
+# RUN:   FileCheck %s
+
+## Sections of archive members are copied from the archive. .debug_info has
+## relocations in a.o, so it is written through the buffer.
+# CHECK:      Hex dump of section '.debug_abbrev':
+# CHECK-NEXT: 0x00000000 01020304 05060708 11121314 15161718
+# CHECK-NEXT: 0x00000010 21222324 25262728
+# CHECK:      Hex dump of section '.debug_info':
+# CHECK-NEXT: 0x00000000 aaaaaaaa {{.*}} bbbbbbbb
+# CHECK:      Hex dump of section '.debug_line':
+# CHECK-NEXT: 0x00000000 31323334 35363738 41424344 45464748
+
+# RUN: ld.lld --debug-passthrough --threads=1 a.o b.o c.a -o out.pass1
+# RUN: cmp out out.pass1
+
+## Relocatable links keep the relocation sections.
+# RUN: ld.lld -r a.o b.o -o out.ro
+# RUN: ld.lld -r --debug-passthrough a.o b.o -o out.pass.ro
+# RUN: cmp out.ro out.pass.ro
+
+## Compressed output sections are written from the compressed shards.
+# RUN: ld.lld --compress-debug-sections=zlib a.o b.o c.a -o out.z
+# RUN: ld.lld --compress-debug-sections=zlib --debug-passthrough a.o b.o c.a \
+# RUN:   -o out.pass.z
+# RUN: cmp out.z out.pass.z
+
+## --no-debug-passthrough turns it off.
+# RUN: ld.lld --debug-passthrough --no-debug-passthrough --build-id a.o -o /dev/null
+
+# RUN: not ld.lld --debug-passthrough --build-id a.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=ERR
+# ERR: error: --debug-passthrough and --build-id may not be used together
+
+#--- a.s
+.globl _start
+_start:
+  call c
+
+.section .debug_abbrev,"",@progbits
+  .byte 1, 2, 3, 4, 5, 6, 7, 8
+.section .debug_line,"",@progbits
+  .byte 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38
+.section .debug_info,"",@progbits
+  .long 0xaaaaaaaa
+  .quad _start
+
+#--- b.s
+.section .debug_abbrev,"",@progbits
+  .byte 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18
+.section .debug_line,"",@progbits
+  .byte 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48
+
+#--- c.s
+.globl c
+c:
+  ret
+
+.section .debug_abbrev,"",@progbits
+  .byte 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28
+.section .debug_info,"",@progbits
+  .long 0xbbbbbbbb
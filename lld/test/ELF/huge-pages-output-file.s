@@ -0,0 +1,23 @@
+# REQUIRES: x86
+## --huge-pages-output-file writes the output through a huge page backed,
+## prefaulted in-memory buffer. The output must be the same as without it.
+## .data is large enough that the buffer spans several 2 MiB prefault chunks.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld %t.o -o %t
+# RUN: ld.lld %t.o -o %t.huge --huge-pages-output-file
+# RUN: cmp %t %t.huge
+# RUN: ld.lld %t.o -o %t.huge.1 --huge-pages-output-file --threads=1
+# RUN: cmp %t %t.huge.1
+
+## The last of --huge-pages-output-file and --no-huge-pages-output-file wins.
+# RUN: ld.lld %t.o -o %t.no --huge-pages-output-file --no-huge-pages-output-file
+# RUN: cmp %t %t.no
+
+.globl _start
+_start:
+  ret
+
+.data
+  .long 42
+  .zero 0x500000
@@ -0,0 +1,49 @@
+# REQUIRES: x86
+## ICF seeds its classes with a digest of the section contents, flags, and the
+## offsets and types of relocations. Sections with identical bytes that differ
+## only in their relocations must still be kept apart, and sections that are
+## identical including their relocations must still be folded.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: ld.lld %t.o -o %t --icf=all --print-icf-sections | FileCheck %s
+
+## The result does not depend on the number of threads.
+# RUN: ld.lld %t.o -o %t.1 --icf=all --threads=1
+# RUN: cmp %t %t.1
+
+# CHECK:      selected section {{.*}}.o:(.text.f1)
+# CHECK-NEXT:   removing identical section {{.*}}.o:(.text.f2)
+# CHECK-NOT:  removing
+
+.globl _start
+_start:
+  ret
+
+## f1 and f2 are identical.
+.section .text.f1,"ax",@progbits
+  .quad g
+  .quad 0
+
+.section .text.f2,"ax",@progbits
+  .quad g
+  .quad 0
+
+## Same bytes as f1, but the relocation is at another offset.
+.section .text.f3,"ax",@progbits
+  .quad 0
+  .quad g
+
+## Same bytes as f1, but the relocation has another type.
+.section .text.f4,"ax",@progbits
+  .quad g - .
+  .quad 0
+
+## Same bytes as f1, but without a relocation.
+.section .text.f5,"ax",@progbits
+  .quad 0
+  .quad 0
+
+.data
+.globl g
+g:
+  .quad 0
@@ -0,0 +1,16 @@
+# REQUIRES: x86
+## Dynamic relocations must be computed before they are written for
+## --oformat=binary as well as for ELF output.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+# RUN: echo "SECTIONS { .rela.dyn : { *(.rela.dyn) } .data : { *(.data) } }" > %t.lds
+# RUN: ld.lld -pie --oformat=binary -T %t.lds %t.o -o %t.bin
+# RUN: od -A x -t x1 -N 24 %t.bin | FileCheck %s
+
+## R_X86_64_RELATIVE at .data (0x18) with addend foo (0x18).
+# CHECK:      000000 18 00 00 00 00 00 00 00 08 00 00 00 00 00 00 00
+# CHECK-NEXT: 000010 18 00 00 00 00 00 00 00
+
+.data
+foo:
+.quad foo
@@ -0,0 +1,40 @@
+# REQUIRES: x86
+## The export trie is built from the sorted exported names. Nodes are laid out
+## in preorder, with the edges of each node in sorted order, so the layout only
+## depends on the set of exported names and not on the number of threads.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64-apple-macos10.15 %s -o %t.o
+# RUN: %lld -dylib -no_uuid --threads=1 %t.o -o %t.dylib
+# RUN: %lld -dylib -no_uuid --threads=4 %t.o -o %t.4.dylib
+# RUN: cmp %t.dylib %t.4.dylib
+# RUN: obj2yaml %t.dylib | FileCheck %s
+
+# CHECK:      ExportTrie:
+# CHECK:        NodeOffset: 0
+# CHECK-NEXT:   Name: ''
+# CHECK:        NodeOffset: 5
+# CHECK-NEXT:   Name: _
+# CHECK:        NodeOffset: 15
+# CHECK-NEXT:   Name: ba
+# CHECK:        NodeOffset: 23
+# CHECK-NEXT:   Name: r
+# CHECK-NEXT:   Flags: 0x2
+# CHECK-NEXT:   Address: 0x3
+# CHECK:        NodeOffset: 27
+# CHECK-NEXT:   Name: z
+# CHECK-NEXT:   Flags: 0x2
+# CHECK-NEXT:   Address: 0x4
+# CHECK:        NodeOffset: 31
+# CHECK-NEXT:   Name: fo
+# CHECK-NEXT:   Flags: 0x2
+# CHECK-NEXT:   Address: 0x1
+# CHECK:        NodeOffset: 38
+# CHECK-NEXT:   Name: o
+# CHECK-NEXT:   Flags: 0x2
+# CHECK-NEXT:   Address: 0x2
+
+.globl _fo, _foo, _bar, _baz
+_fo = 1
+_foo = 2
+_bar = 3
+_baz = 4
@@ -0,0 +1,102 @@
+# REQUIRES: x86
+## Sections, ICF's addend removal and __unwind_info are written in parallel.
+## The output must not depend on the number of threads.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64-apple-macos10.15 %s -o %t.o
+# RUN: %lld -lSystem -no_uuid --icf=all --threads=1 %t.o -o %t.1
+# RUN: %lld -lSystem -no_uuid --icf=all --threads=2 %t.o -o %t.2
+# RUN: %lld -lSystem -no_uuid --icf=all --threads=8 %t.o -o %t.8
+# RUN: cmp %t.1 %t.2
+# RUN: cmp %t.1 %t.8
+
+## ICF still folds the identical functions and cfstrings.
+# RUN: llvm-nm %t.1 | FileCheck %s
+# CHECK:      [[#%.16x,F:]] T _f1
+# CHECK-NEXT: [[#%.16x,F]] T _f2
+# CHECK-NEXT: [[#%.16x,G:]] T _g1
+# CHECK-NEXT: [[#%.16x,G]] T _g2
+
+.text
+.globl _main, _f1, _f2, _g1, _g2, _h
+.p2align 4
+_main:
+  .cfi_startproc
+  pushq %rbp
+  .cfi_def_cfa_offset 16
+  callq _f1
+  callq _f2
+  callq _g1
+  callq _g2
+  callq _h
+  popq %rbp
+  retq
+  .cfi_endproc
+
+.p2align 4
+_f1:
+  .cfi_startproc
+  leaq L_cfstr1(%rip), %rax
+  retq
+  .cfi_endproc
+
+.p2align 4
+_f2:
+  .cfi_startproc
+  leaq L_cfstr2(%rip), %rax
+  retq
+  .cfi_endproc
+
+.p2align 4
+_g1:
+  .cfi_startproc
+  pushq %rbp
+  .cfi_def_cfa_offset 16
+  movq _data@GOTPCREL(%rip), %rax
+  popq %rbp
+  retq
+  .cfi_endproc
+
+.p2align 4
+_g2:
+  .cfi_startproc
+  pushq %rbp
+  .cfi_def_cfa_offset 16
+  movq _data@GOTPCREL(%rip), %rax
+  popq %rbp
+  retq
+  .cfi_endproc
+
+.p2align 4
+_h:
+  .cfi_startproc
+  movq _data@GOTPCREL(%rip), %rax
+  retq
+  .cfi_endproc
+
+.section __TEXT,__cstring,cstring_literals
+L_str:
+  .asciz "foo"
+
+.section __DATA,__cfstring
+.p2align 3
+L_cfstr1:
+  .quad ___CFConstantStringClassReference
+  .long 1992
+  .space 4
+  .quad L_str
+  .quad 3
+L_cfstr2:
+  .quad ___CFConstantStringClassReference
+  .long 1992
+  .space 4
+  .quad L_str
+  .quad 3
+
+.data
+.globl _data, ___CFConstantStringClassReference
+_data:
+  .quad 0
+___CFConstantStringClassReference:
+  .quad 0
+
+.subsections_via_symbols
@@ -0,0 +1,53 @@
+## Object files are decoded, and code and data are relocated, in parallel.
+## The output must not depend on the number of threads, and errors are still
+## reported in command-line order.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=wasm32-unknown-unknown a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=wasm32-unknown-unknown b.s -o b.o
+
+# RUN: wasm-ld a.o b.o -o out.wasm
+# RUN: wasm-ld --threads=1 a.o b.o -o out1.wasm
+# RUN: cmp out.wasm out1.wasm
+# RUN: wasm-ld --threads=3 a.o b.o -o out3.wasm
+# RUN: cmp out.wasm out3.wasm
+
+## Linked outputs are not relocatable, so both inputs are rejected. Only the
+## first one on the command line is reported.
+# RUN: not wasm-ld out.wasm out1.wasm -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=ERR --implicit-check-not=error:
+# ERR: error: out.wasm: not a relocatable wasm file
+
+#--- a.s
+.functype b () -> (i32)
+
+.globl _start
+_start:
+  .functype _start () -> ()
+  call b
+  drop
+  i32.const 0
+  i32.load data_b
+  drop
+  end_function
+
+.section .data.data_a,"",@
+.globl data_a
+data_a:
+  .int32 b
+  .size data_a, 4
+
+#--- b.s
+.functype _start () -> ()
+
+.globl b
+b:
+  .functype b () -> (i32)
+  i32.const data_a
+  end_function
+
+.section .data.data_b,"",@
+.globl data_b
+data_b:
+  .int32 data_a
+  .size data_b, 4
@@ -1166,6 +1166,13 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
 
   createSyntheticSymbols();
 
+  // Decoding the wasm binaries does not depend on the symbol table, so do it
+  // for all object files up front in parallel.
+  parallelForEach(files, [](InputFile *f) {
+    if (auto *obj = dyn_cast<ObjFile>(f))
+      obj->preload();
+  });
+
   // Add all files to the symbol table. This will add almost all
   // symbols that we need to the symbol table.
   for (InputFile *f : files)
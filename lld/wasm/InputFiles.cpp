@@ -390,21 +390,36 @@ static bool shouldMerge(const WasmSegment &seg) {
   return true;
 }
 
+void ObjFile::preload() {
+  Expected<std::unique_ptr<Binary>> bin = createBinary(mb);
+  if (!bin) {
+    consumeError(bin.takeError());
+    return;
+  }
+  auto *obj = dyn_cast<WasmObjectFile>(bin->get());
+  if (obj && obj->isRelocatableObject()) {
+    bin->release();
+    wasmObj.reset(obj);
+  }
+}
+
 void ObjFile::parse(bool ignoreComdats) {
-  // Parse a memory buffer as a wasm file.
+  // Parse a memory buffer as a wasm file, unless preload() already did.
   LLVM_DEBUG(dbgs() << "Parsing object: " << toString(this) << "\n");
-  std::unique_ptr<Binary> bin = CHECK(createBinary(mb), toString(this));
+  if (!wasmObj) {
+    std::unique_ptr<Binary> bin = CHECK(createBinary(mb), toString(this));
 
-  auto *obj = dyn_cast<WasmObjectFile>(bin.get());
-  if (!obj)
-    fatal(toString(this) + ": not a wasm file");
-  if (!obj->isRelocatableObject())
-    fatal(toString(this) + ": not a relocatable wasm file");
+    auto *obj = dyn_cast<WasmObjectFile>(bin.get());
+    if (!obj)
+      fatal(toString(this) + ": not a wasm file");
+    if (!obj->isRelocatableObject())
+      fatal(toString(this) + ": not a relocatable wasm file");
 
-  bin.release();
-  wasmObj.reset(obj);
+    bin.release();
+    wasmObj.reset(obj);
+  }
 
-  checkArch(obj->getArch());
+  checkArch(wasmObj->getArch());
 
   // Build up a map of function indices to table indices for use when
   // verifying the existing table index relocations
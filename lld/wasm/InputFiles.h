@@ -115,6 +115,11 @@ public:
 
   void parse(bool ignoreComdats = false);
 
+  // Decodes the wasm binary so that parse() does not have to. This touches no
+  // global state and can be called for many files in parallel. Errors are
+  // left for parse() to report.
+  void preload();
+
   // Returns the underlying wasm file.
   const WasmObjectFile *getWasmObj() const { return wasmObj.get(); }
 
@@ -53,10 +53,12 @@ void CodeSection::finalizeContents() {
   os.flush();
   bodySize = codeSectionHeader.size();
 
+  // Computing the compressed size of a function means decoding all of its
+  // relocations, so do that in parallel and only assign offsets serially.
+  parallelForEach(functions, [](InputFunction *func) { func->calculateSize(); });
   for (InputFunction *func : functions) {
     func->outputSec = this;
     func->outSecOff = bodySize;
-    func->calculateSize();
     // All functions should have a non-empty body at this point
     assert(func->getSize());
     bodySize += func->getSize();
@@ -79,9 +81,11 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
+  // Write code section bodies. Each function is relocated into its own
+  // range of the output, so they can be written in parallel.
+  parallelForEach(functions, [buf](const InputChunk *chunk) {
     chunk->writeTo(buf);
+  });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -184,8 +188,8 @@ void DataSection::writeTo(uint8_t *buf) {
     memcpy(segStart, segment->header.data(), segment->header.size());
 
     // Write segment data payload
-    for (const InputChunk *chunk : segment->inputSegments)
-      chunk->writeTo(buf);
+    parallelForEach(segment->inputSegments,
+                    [buf](const InputChunk *chunk) { chunk->writeTo(buf); });
   }
 }
 
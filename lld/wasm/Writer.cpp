@@ -218,10 +218,18 @@ void Writer::writeHeader() {
 
 void Writer::writeSections() {
   uint8_t *buf = buffer->getBufferStart();
-  parallelForEach(outputSections, [buf](OutputSection *s) {
+  // The code and data sections write their chunks in parallel themselves,
+  // which only helps when they are not written from a parallel worker, so
+  // write them from this thread and everything else concurrently.
+  std::vector<OutputSection *> rest;
+  for (OutputSection *s : outputSections) {
     assert(s->isNeeded());
-    s->writeTo(buf);
-  });
+    if (isa<CodeSection>(s) || isa<DataSection>(s))
+      s->writeTo(buf);
+    else
+      rest.push_back(s);
+  }
+  parallelForEach(rest, [buf](OutputSection *s) { s->writeTo(buf); });
 }
 
 // Computes a hash value of Data using a given hash function.
@@ -1158,6 +1158,17 @@ public:
                                const EvaluateExpressionOptions &options,
                                ValueObject *ctx_obj, Status &error);
 
+  /// Returns an already parsed user expression stored under \p key that can
+  /// run in \p exe_ctx, or nullptr. This lets an expression that is
+  /// evaluated again at the same code address skip parsing and JITing.
+  lldb::UserExpressionSP GetCachedUserExpression(llvm::StringRef key,
+                                                 ExecutionContext &exe_ctx);
+
+  /// Stores a parsed user expression for GetCachedUserExpression. The cache
+  /// is cleared whenever modules are loaded or unloaded.
+  void CacheUserExpression(llvm::StringRef key,
+                           lldb::UserExpressionSP user_expression_sp);
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1552,6 +1563,9 @@ protected:
   PathMappingList m_image_search_paths;
   TypeSystemMap m_scratch_type_system_map;
 
+  std::mutex m_user_expression_cache_mutex;
+  llvm::StringMap<lldb::UserExpressionSP> m_user_expression_cache;
+
   typedef std::map<lldb::LanguageType, lldb::REPLSP> REPLMap;
   REPLMap m_repl_map;
 
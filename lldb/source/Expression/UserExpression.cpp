@@ -252,10 +252,43 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
+  // An expression that is evaluated again at the same code address, e.g. from
+  // a stop hook or a watch window stepping through a loop, can reuse the
+  // parsed and JITed expression instead of going through clang again. Skip
+  // anything that could depend on state other than the text and the location:
+  // persistent variables, a context object, or top level code. Expressions
+  // parsed without a frame aren't tied to an address, so don't reuse those.
+  std::string cache_key;
+  if (exe_ctx.GetFramePtr() && !ctx_obj && execution_policy != eExecutionPolicyTopLevel &&
+      !options.GetREPLEnabled() && !expr.contains('$') &&
+      !full_prefix.contains('$')) {
+    llvm::raw_string_ostream os(cache_key);
+    // Every option that is consulted while parsing or generating code has to
+    // be part of the key.
+    const char *pound_line_file = options.GetPoundLineFilePath();
+    os << static_cast<int>(language) << ':' << static_cast<int>(desired_type)
+       << ':' << static_cast<int>(execution_policy) << ':'
+       << options.GetGenerateDebugInfo() << ':'
+       << static_cast<int>(options.GetUseDynamic()) << ':'
+       << options.IsForUtilityExpr() << ':' << options.DoesKeepInMemory()
+       << ':' << options.DoesCoerceToId() << ':'
+       << options.GetSuppressPersistentResult() << ':'
+       << options.GetAutoApplyFixIts() << ':'
+       << options.GetRetriesWithFixIts() << ':' << options.GetDebug() << ':'
+       << options.GetColorizeErrors() << ':' << options.GetPoundLineLine()
+       << ':' << (pound_line_file ? pound_line_file : "") << '\0'
+       << full_prefix.size() << ':' << full_prefix << expr;
+  }
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (!cache_key.empty())
+    user_expression_sp = target->GetCachedUserExpression(cache_key, exe_ctx);
+  const bool is_cached = user_expression_sp != nullptr;
+  if (is_cached)
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Reusing parsed expression ==");
+  else
+    user_expression_sp = target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error);
   if (error.Fail()) {
     LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
              error.AsCString());
@@ -278,8 +311,11 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      is_cached ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
+  if (parse_success && !is_cached && !cache_key.empty())
+    target->CacheUserExpression(cache_key, user_expression_sp);
 
   // Calculate the fixed expression always, since we need it for errors.
   std::string tmp_fixed_expression;
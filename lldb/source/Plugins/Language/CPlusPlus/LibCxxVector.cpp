@@ -10,8 +10,10 @@
 
 #include "lldb/Core/ValueObject.h"
 #include "lldb/DataFormatters/FormattersHelpers.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Utility/ConstString.h"
 #include <optional>
+#include <vector>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -36,10 +38,16 @@ public:
   size_t GetIndexOfChildWithName(ConstString name) override;
 
 private:
+  void PrefetchElements(lldb::addr_t element_addr);
+
   ValueObject *m_start = nullptr;
   ValueObject *m_finish = nullptr;
   CompilerType m_element_type;
   uint32_t m_element_size = 0;
+  /// The range of element storage already read into the process memory
+  /// cache by PrefetchElements.
+  lldb::addr_t m_prefetch_begin = LLDB_INVALID_ADDRESS;
+  lldb::addr_t m_prefetch_end = LLDB_INVALID_ADDRESS;
 };
 
 class LibcxxVectorBoolSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
@@ -109,6 +117,7 @@ lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::GetChildAtIndex(
 
   uint64_t offset = idx * m_element_size;
   offset = offset + m_start->GetValueAsUnsigned(0);
+  PrefetchElements(offset);
   StreamString name;
   name.Printf("[%" PRIu64 "]", (uint64_t)idx);
   return CreateValueObjectFromAddress(name.GetString(), offset,
@@ -116,8 +125,42 @@ lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::GetChildAtIndex(
                                       m_element_type);
 }
 
+void lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::
+    PrefetchElements(lldb::addr_t element_addr) {
+  if (m_prefetch_begin != LLDB_INVALID_ADDRESS &&
+      element_addr >= m_prefetch_begin &&
+      element_addr + m_element_size <= m_prefetch_end)
+    return;
+
+  // Printing a vector reads each element separately, which over a remote
+  // connection costs a round trip per cache line. Read the elements from this
+  // one on with a single larger read instead; the process memory cache then
+  // answers the per element reads.
+  static constexpr uint64_t g_max_prefetch_bytes = 32 * 1024;
+  uint64_t finish_val = m_finish->GetValueAsUnsigned(0);
+  if (element_addr >= finish_val)
+    return;
+  uint64_t num_bytes =
+      std::min(finish_val - element_addr, g_max_prefetch_bytes);
+  num_bytes -= num_bytes % m_element_size;
+  if (num_bytes <= m_element_size)
+    return;
+
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp)
+    return;
+  std::vector<uint8_t> buffer(num_bytes);
+  Status error;
+  process_sp->ReadMemory(element_addr, buffer.data(), num_bytes, error);
+  // Don't retry a failed read for every element; the element reads report
+  // their own errors.
+  m_prefetch_begin = element_addr;
+  m_prefetch_end = element_addr + num_bytes;
+}
+
 bool lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::Update() {
   m_start = m_finish = nullptr;
+  m_prefetch_begin = m_prefetch_end = LLDB_INVALID_ADDRESS;
   ValueObjectSP data_type_finder_sp(
       m_backend.GetChildMemberWithName("__end_cap_"));
   if (!data_type_finder_sp)
@@ -594,22 +594,28 @@ MinidumpFileBuilder::AddMemoryList(const lldb::ProcessSP &process_sp) {
     const addr_t size = range_info.GetRange().GetByteSize();
     if (size == 0)
       continue;
-    auto data_up = std::make_unique<DataBufferHeap>(size, 0);
-    const size_t bytes_read =
-        process_sp->ReadMemory(addr, data_up->GetBytes(), size, error);
+    const auto rva =
+        static_cast<llvm::support::ulittle32_t>(GetCurrentDataEndOffset());
+    // Read the region straight into the end of the data buffer rather than
+    // through a temporary copy. The data is very likely never read again, so
+    // bypass the process memory cache too, which would otherwise keep a copy
+    // of every region in its L1 cache.
+    const lldb::offset_t data_size = m_data.GetByteSize();
+    m_data.SetByteSize(data_size + size);
+    const size_t bytes_read = process_sp->ReadMemoryFromInferior(
+        addr, m_data.GetBytes() + data_size, size, error);
+    m_data.SetByteSize(data_size + bytes_read);
     if (bytes_read == 0)
       continue;
     // We have a good memory region with valid bytes to store.
     LocationDescriptor memory_dump;
     memory_dump.DataSize = static_cast<llvm::support::ulittle32_t>(bytes_read);
-    memory_dump.RVA =
-        static_cast<llvm::support::ulittle32_t>(GetCurrentDataEndOffset());
+    memory_dump.RVA = rva;
     MemoryDescriptor memory_desc;
     memory_desc.StartOfMemoryRange =
         static_cast<llvm::support::ulittle64_t>(addr);
     memory_desc.Memory = memory_dump;
     mem_descriptors.push_back(memory_desc);
-    m_data.AppendData(data_up->GetBytes(), bytes_read);
   }
 
   AddDirectory(StreamType::MemoryList,
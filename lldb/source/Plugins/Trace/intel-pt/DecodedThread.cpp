@@ -195,6 +195,52 @@ void DecodedThread::AppendCustomError(StringRef err, bool fatal) {
   m_error_stats.RecordError(fatal);
 }
 
+void DecodedThread::AppendDecodedThread(const DecodedThread &other) {
+  auto tsc_it = other.m_tscs.begin();
+  auto cpu_it = other.m_cpus.begin();
+  for (uint64_t i = 0; i < other.GetItemsCount(); i++) {
+    // TSCs, CPU changes and sync points each come with the event that
+    // announced them, so notify them again instead of copying that event.
+    if (tsc_it != other.m_tscs.end() && tsc_it->first == i) {
+      NotifyTsc(tsc_it->second.tsc);
+      ++tsc_it;
+      continue;
+    }
+    if (cpu_it != other.m_cpus.end() && cpu_it->first == i) {
+      NotifyCPU(cpu_it->second);
+      ++cpu_it;
+      continue;
+    }
+    auto psb_it = other.m_psb_offsets.find(i);
+    if (psb_it != other.m_psb_offsets.end()) {
+      NotifySyncPoint(psb_it->second);
+      continue;
+    }
+
+    switch (other.GetItemKindByIndex(i)) {
+    case lldb::eTraceItemKindInstruction:
+      CreateNewTraceItem(lldb::eTraceItemKindInstruction).load_address =
+          other.GetInstructionLoadAddress(i);
+      m_insn_count++;
+      break;
+    case lldb::eTraceItemKindEvent:
+      AppendEvent(other.GetEventByIndex(i));
+      break;
+    case lldb::eTraceItemKindError:
+      // The error statistics are merged below, as the kind of each error
+      // isn't stored with the item.
+      CreateNewTraceItem(lldb::eTraceItemKindError).error =
+          other.GetErrorByIndex(i).str();
+      break;
+    }
+  }
+
+  m_error_stats.other_errors += other.m_error_stats.other_errors;
+  m_error_stats.fatal_errors += other.m_error_stats.fatal_errors;
+  for (const auto &[kind, count] : other.m_error_stats.libipt_errors)
+    m_error_stats.libipt_errors[kind] += count;
+}
+
 lldb::TraceEvent DecodedThread::GetEventByIndex(int item_index) const {
   return m_item_data[item_index].event;
 }
@@ -260,6 +260,12 @@ public:
   /// Append an instruction.
   void AppendInstruction(const pt_insn &insn);
 
+  /// Append all the items of \p other, as if they had been decoded directly
+  /// into this object. This is used to merge PSB blocks that were decoded in
+  /// parallel, so \p other must hold the trace that immediately follows the
+  /// trace of this object.
+  void AppendDecodedThread(const DecodedThread &other);
+
 private:
   /// When adding new members to this class, make sure
   /// to update \a CalculateApproximateMemoryUsage() accordingly.
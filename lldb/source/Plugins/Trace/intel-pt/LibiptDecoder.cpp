@@ -7,7 +7,11 @@
 
 #include "LibiptDecoder.h"
 #include "TraceIntelPT.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Target/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include <condition_variable>
+#include <mutex>
 #include <optional>
 
 using namespace lldb;
@@ -558,6 +562,115 @@ private:
   std::optional<DecodedThread::TSC> m_tsc_upper_bound;
 };
 
+/// The arguments needed to decode a single PSB block with \a PSBBlockDecoder.
+struct PSBBlockDecodingRequest {
+  const PSBBlock &psb_block;
+  ArrayRef<uint8_t> buffer;
+  std::optional<lldb::addr_t> next_block_ip;
+  std::optional<DecodedThread::TSC> tsc_upper_bound;
+};
+
+/// Decodes PSB blocks on the debugger's thread pool, each one into its own \a
+/// DecodedThread, and appends them in order to the thread being decoded. As
+/// each block stops decoding at the starting ip of the next one, this gives
+/// the same trace as decoding the blocks one after another.
+///
+/// Blocks are scheduled at most a few per pool thread ahead of the next block
+/// to append, and each one is freed as soon as it has been appended, so the
+/// memory used beyond the final trace doesn't grow with the size of the trace.
+class ParallelPSBBlockDecoder {
+public:
+  ParallelPSBBlockDecoder(TraceIntelPT &trace_intel_pt,
+                          DecodedThread &decoded_thread,
+                          ArrayRef<PSBBlockDecodingRequest> requests)
+      : m_trace_intel_pt(trace_intel_pt), m_decoded_thread(decoded_thread),
+        m_requests(requests), m_blocks(requests.size()),
+        m_task_group(Debugger::GetThreadPool()) {
+    // Waiting for a block from a pool thread could starve the pool, so decode
+    // inline in that case.
+    llvm::ThreadPool &pool = Debugger::GetThreadPool();
+    if (trace_intel_pt.GetGlobalProperties().GetParallelDecoding() &&
+        !pool.isWorkerThread())
+      m_max_blocks_ahead = 2 * pool.getThreadCount();
+  }
+
+  ~ParallelPSBBlockDecoder() { m_task_group.wait(); }
+
+  /// Decode the next block, if that hasn't happened yet, and append it to the
+  /// thread being decoded.
+  Error AppendNextBlock() {
+    assert(m_num_appended < m_requests.size() && "no blocks left");
+    while (m_num_scheduled < m_requests.size() &&
+           m_num_scheduled <= m_num_appended + m_max_blocks_ahead) {
+      if (Error err = ScheduleNextBlock())
+        return err;
+    }
+
+    Block &block = m_blocks[m_num_appended++];
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_block_done.wait(lock, [&] { return block.done; });
+    }
+    m_decoded_thread.AppendDecodedThread(*block.decoded_thread);
+    block.decoded_thread.reset();
+    return Error::success();
+  }
+
+private:
+  struct Block {
+    std::unique_ptr<DecodedThread> decoded_thread;
+    std::optional<PSBBlockDecoder> decoder;
+    /// Guarded by \a m_mutex.
+    bool done = false;
+  };
+
+  Error ScheduleNextBlock() {
+    const PSBBlockDecodingRequest &request = m_requests[m_num_scheduled];
+    Block &block = m_blocks[m_num_scheduled++];
+    block.decoded_thread = std::make_unique<DecodedThread>(
+        m_decoded_thread.GetThread(), /*tsc_conversion=*/std::nullopt);
+    // Creating a decoder queries the trace settings and the CPU info, so we do
+    // that on this thread and only run the decoding itself on the pool.
+    Expected<PSBBlockDecoder> decoder = PSBBlockDecoder::Create(
+        m_trace_intel_pt, request.psb_block, request.buffer,
+        *m_decoded_thread.GetThread()->GetProcess(), request.next_block_ip,
+        *block.decoded_thread, request.tsc_upper_bound);
+    if (!decoder)
+      return decoder.takeError();
+    block.decoder.emplace(std::move(*decoder));
+
+    auto decode = [this, &block] {
+      block.decoder->DecodePSBBlock();
+      block.decoder.reset();
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        block.done = true;
+      }
+      m_block_done.notify_all();
+    };
+    if (m_max_blocks_ahead == 0)
+      decode();
+    else
+      m_task_group.async(decode);
+    return Error::success();
+  }
+
+  TraceIntelPT &m_trace_intel_pt;
+  DecodedThread &m_decoded_thread;
+  ArrayRef<PSBBlockDecodingRequest> m_requests;
+  /// One entry per request. The vector is never resized, so the tasks can
+  /// refer to their entries.
+  std::vector<Block> m_blocks;
+  size_t m_num_scheduled = 0;
+  size_t m_num_appended = 0;
+  /// How many blocks may be scheduled beyond the next one to append. Zero
+  /// decodes each block on this thread when it's needed.
+  size_t m_max_blocks_ahead = 0;
+  std::mutex m_mutex;
+  std::condition_variable m_block_done;
+  llvm::ThreadPoolTaskGroup m_task_group;
+};
+
 Error lldb_private::trace_intel_pt::DecodeSingleTraceForThread(
     DecodedThread &decoded_thread, TraceIntelPT &trace_intel_pt,
     ArrayRef<uint8_t> buffer) {
@@ -566,20 +679,21 @@ Error lldb_private::trace_intel_pt::DecodeSingleTraceForThread(
   if (!blocks)
     return blocks.takeError();
 
+  std::vector<PSBBlockDecodingRequest> requests;
   for (size_t i = 0; i < blocks->size(); i++) {
     PSBBlock &block = blocks->at(i);
-
-    Expected<PSBBlockDecoder> decoder = PSBBlockDecoder::Create(
-        trace_intel_pt, block, buffer.slice(block.psb_offset, block.size),
-        *decoded_thread.GetThread()->GetProcess(),
-        i + 1 < blocks->size() ? blocks->at(i + 1).starting_ip : None,
-        decoded_thread, std::nullopt);
-    if (!decoder)
-      return decoder.takeError();
-
-    decoder->DecodePSBBlock();
+    requests.push_back(
+        {block, buffer.slice(block.psb_offset, block.size),
+         i + 1 < blocks->size() ? blocks->at(i + 1).starting_ip : None,
+         std::nullopt});
   }
 
+  ParallelPSBBlockDecoder block_decoder(trace_intel_pt, decoded_thread,
+                                        requests);
+  for (size_t i = 0; i < requests.size(); i++) {
+    if (Error err = block_decoder.AppendNextBlock())
+      return err;
+  }
   return Error::success();
 }
 
@@ -587,6 +701,24 @@ Error lldb_private::trace_intel_pt::DecodeSystemWideTraceForThread(
     DecodedThread &decoded_thread, TraceIntelPT &trace_intel_pt,
     const DenseMap<lldb::cpu_id_t, llvm::ArrayRef<uint8_t>> &buffers,
     const std::vector<IntelPTThreadContinousExecution> &executions) {
+  std::vector<PSBBlockDecodingRequest> requests;
+  for (const IntelPTThreadContinousExecution &execution : executions) {
+    for (size_t j = 0; j < execution.psb_blocks.size(); j++) {
+      const PSBBlock &psb_block = execution.psb_blocks[j];
+      requests.push_back(
+          {psb_block,
+           buffers.lookup(execution.thread_execution.cpu_id)
+               .slice(psb_block.psb_offset, psb_block.size),
+           j + 1 < execution.psb_blocks.size()
+               ? execution.psb_blocks[j + 1].starting_ip
+               : None,
+           execution.thread_execution.GetEndTSC()});
+    }
+  }
+
+  ParallelPSBBlockDecoder block_decoder(trace_intel_pt, decoded_thread,
+                                        requests);
+
   bool has_seen_psbs = false;
   for (size_t i = 0; i < executions.size(); i++) {
     const IntelPTThreadContinousExecution &execution = executions[i];
@@ -631,22 +763,9 @@ Error lldb_private::trace_intel_pt::DecodeSystemWideTraceForThread(
     }
 
     for (size_t j = 0; j < execution.psb_blocks.size(); j++) {
-      const PSBBlock &psb_block = execution.psb_blocks[j];
-
-      Expected<PSBBlockDecoder> decoder = PSBBlockDecoder::Create(
-          trace_intel_pt, psb_block,
-          buffers.lookup(execution.thread_execution.cpu_id)
-              .slice(psb_block.psb_offset, psb_block.size),
-          *decoded_thread.GetThread()->GetProcess(),
-          j + 1 < execution.psb_blocks.size()
-              ? execution.psb_blocks[j + 1].starting_ip
-              : None,
-          decoded_thread, execution.thread_execution.GetEndTSC());
-      if (!decoder)
-        return decoder.takeError();
-
       has_seen_psbs = true;
-      decoder->DecodePSBBlock();
+      if (Error err = block_decoder.AppendNextBlock())
+        return err;
     }
 
     // If we haven't seen a PSB yet, then it's fine not to show errors
@@ -70,6 +70,12 @@ uint64_t TraceIntelPT::PluginProperties::GetExtremelyLargeDecodingThreshold() {
       nullptr, idx, g_traceintelpt_properties[idx].default_uint_value);
 }
 
+bool TraceIntelPT::PluginProperties::GetParallelDecoding() {
+  const uint32_t idx = ePropertyParallelDecoding;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_traceintelpt_properties[idx].default_uint_value != 0);
+}
+
 TraceIntelPT::PluginProperties &TraceIntelPT::GetGlobalProperties() {
   static TraceIntelPT::PluginProperties g_settings;
   return g_settings;
@@ -35,6 +35,8 @@ public:
     uint64_t GetInfiniteDecodingLoopVerificationThreshold();
 
     uint64_t GetExtremelyLargeDecodingThreshold();
+
+    bool GetParallelDecoding();
   };
 
   /// Return the global properties for this trace plug-in.
@@ -65,6 +65,7 @@
 
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 #include <mutex>
@@ -1648,6 +1649,18 @@ void Target::NotifyModulesRemoved(lldb_private::ModuleList &module_list) {
 void Target::ModulesDidLoad(ModuleList &module_list) {
   const size_t num_images = module_list.GetSize();
   if (m_valid && num_images) {
+    // Parsing the symbol table and indexing the debug info of one module
+    // doesn't depend on any other module, so do it for the whole batch on the
+    // shared thread pool before the notifications below, which still run in
+    // load order.
+    if (GetPreloadSymbols()) {
+      llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+      for (size_t idx = 0; idx < num_images; ++idx) {
+        ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
+        task_group.async([module_sp] { module_sp->PreloadSymbols(); });
+      }
+      task_group.wait();
+    }
     for (size_t idx = 0; idx < num_images; ++idx) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
@@ -1657,6 +1670,10 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
     if (m_process_sp) {
       m_process_sp->ModulesDidLoad(module_list);
     }
+    {
+      std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+      m_user_expression_cache.clear();
+    }
     BroadcastEvent(eBroadcastBitModulesLoaded,
                    new TargetEventData(this->shared_from_this(), module_list));
   }
@@ -1679,6 +1696,10 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
+    {
+      std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+      m_user_expression_cache.clear();
+    }
     UnloadModuleSections(module_list);
     BroadcastEvent(eBroadcastBitModulesUnloaded,
                    new TargetEventData(this->shared_from_this(), module_list));
@@ -2233,8 +2254,10 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
         }
 
         // Preload symbols outside of any lock, so hopefully we can do this for
-        // each library in parallel.
-        if (GetPreloadSymbols())
+        // each library in parallel. Callers that don't notify add the module
+        // as part of a batch and report it through ModulesDidLoad, which
+        // preloads the whole batch at once.
+        if (notify && GetPreloadSymbols())
           module_sp->PreloadSymbols();
 
         llvm::SmallVector<ModuleSP, 1> replaced_modules;
@@ -2455,6 +2478,29 @@ UserExpression *Target::GetUserExpressionForLanguage(
   return user_expr;
 }
 
+lldb::UserExpressionSP
+Target::GetCachedUserExpression(llvm::StringRef key,
+                                ExecutionContext &exe_ctx) {
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  auto pos = m_user_expression_cache.find(key);
+  if (pos == m_user_expression_cache.end())
+    return {};
+  if (!pos->second->MatchesContext(exe_ctx))
+    return {};
+  return pos->second;
+}
+
+void Target::CacheUserExpression(llvm::StringRef key,
+                                 lldb::UserExpressionSP user_expression_sp) {
+  // Expressions are only reused at the code address they were parsed for, so
+  // keep a bounded number of them rather than every one ever evaluated.
+  const size_t max_cached_expressions = 64;
+  std::lock_guard<std::mutex> guard(m_user_expression_cache_mutex);
+  if (m_user_expression_cache.size() >= max_cached_expressions)
+    m_user_expression_cache.clear();
+  m_user_expression_cache[key] = std::move(user_expression_sp);
+}
+
 FunctionCaller *Target::GetFunctionCallerForLanguage(
     lldb::LanguageType language, const CompilerType &return_type,
     const Address &function_address, const ValueList &arg_value_list,
@@ -0,0 +1,55 @@
+"""
+Test that an expression parsed at a code address is only reused by later
+evaluations with the same options.
+"""
+
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class ReuseParsedExpressionTestCase(TestBase):
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def test_suppress_persistent_result(self):
+        self.build()
+        _, _, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.c")
+        )
+        frame = thread.GetFrameAtIndex(0)
+
+        options = lldb.SBExpressionOptions()
+        value = frame.EvaluateExpression("a + 1", options)
+        self.assertSuccess(value.GetError())
+        self.assertEqual(value.GetValueAsSigned(), 42)
+        self.assertTrue(value.GetName().startswith("$"))
+
+        # The same text at the same address, but without a persistent result.
+        options.SetSuppressPersistentResult(True)
+        value = frame.EvaluateExpression("a + 1", options)
+        self.assertSuccess(value.GetError())
+        self.assertEqual(value.GetValueAsSigned(), 42)
+        self.assertFalse(value.GetName().startswith("$"))
+
+        # And back again.
+        options.SetSuppressPersistentResult(False)
+        value = frame.EvaluateExpression("a + 1", options)
+        self.assertSuccess(value.GetError())
+        self.assertTrue(value.GetName().startswith("$"))
+
+    def test_keep_in_memory(self):
+        self.build()
+        _, _, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.c")
+        )
+        frame = thread.GetFrameAtIndex(0)
+
+        # Evaluating with different options must parse the expression again,
+        # and both evaluations must still produce the right value.
+        for keep_in_memory in (True, False, True):
+            options = lldb.SBExpressionOptions()
+            options.SetKeepInMemory(keep_in_memory)
+            value = frame.EvaluateExpression("a * 2", options)
+            self.assertSuccess(value.GetError())
+            self.assertEqual(value.GetValueAsSigned(), 82)
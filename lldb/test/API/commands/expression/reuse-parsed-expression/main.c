@@ -0,0 +1,4 @@
+int main(void) {
+  int a = 41;
+  return a; // break here
+}
@@ -0,0 +1,52 @@
+import lldb
+from intelpt_testcase import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+from lldbsuite.test.decorators import *
+
+
+class TestTraceParallelDecoding(TraceIntelPTTestCaseBase):
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def dumpAllInstructions(self, trace_description_file_path, parallel):
+        self.runCmd(
+            "settings set plugin.trace.intel-pt.parallel-decoding "
+            + ("true" if parallel else "false")
+        )
+        self.traceLoad(
+            traceDescriptionFilePath=trace_description_file_path, substrs=["intel-pt"]
+        )
+        target = self.dbg.GetSelectedTarget()
+        dumps = []
+        for thread in target.GetProcess().threads:
+            self.runCmd(
+                "thread trace dump instructions %d -t -e -f -c 1000000"
+                % thread.GetIndexID()
+            )
+            dumps.append(self.res.GetOutput())
+        self.dbg.DeleteTarget(target)
+        return dumps
+
+    def checkSameTrace(self, trace_description_file_path):
+        self.addTearDownHook(
+            lambda: self.runCmd(
+                "settings clear plugin.trace.intel-pt.parallel-decoding"
+            )
+        )
+        serial = self.dumpAllInstructions(trace_description_file_path, False)
+        parallel = self.dumpAllInstructions(trace_description_file_path, True)
+        self.assertEqual(len(serial), len(parallel))
+        for serial_dump, parallel_dump in zip(serial, parallel):
+            self.assertEqual(serial_dump, parallel_dump)
+
+    def testSingleThreadTrace(self):
+        self.checkSameTrace(
+            os.path.join(self.getSourceDir(), "intelpt-trace", "trace.json")
+        )
+
+    def testMultiCoreTrace(self):
+        self.checkSameTrace(
+            os.path.join(
+                self.getSourceDir(), "intelpt-multi-core-trace", "trace.json"
+            )
+        )
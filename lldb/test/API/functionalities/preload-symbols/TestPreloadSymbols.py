@@ -0,0 +1,54 @@
+"""
+Test that target.preload-symbols preloads the modules that the dynamic loader
+reports in one batch.
+"""
+
+import json
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class PreloadSymbolsTestCase(TestBase):
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def get_foo_stats(self, preload):
+        self.build()
+        self.runCmd(
+            "settings set target.preload-symbols %s" % ("true" if preload else "false")
+        )
+        target = self.createTestTarget()
+        # Restrict the breakpoint to the executable so that resolving it
+        # doesn't parse the library.
+        bkpt = target.BreakpointCreateByName("main", "a.out")
+        self.assertGreater(bkpt.GetNumLocations(), 0, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, self.get_process_working_directory())
+        self.assertState(process.GetState(), lldb.eStateStopped, PROCESS_STOPPED)
+
+        result = lldb.SBCommandReturnObject()
+        self.ci.HandleCommand("statistics dump", result)
+        self.assertTrue(result.Succeeded(), result.GetError())
+        stats = json.loads(result.GetOutput())
+        lib_name = self.platformContext.shlib_prefix + "foo."
+        for module in stats["modules"]:
+            if lib_name in module["path"]:
+                return module
+        self.fail("%s not in %s" % (lib_name, [m["path"] for m in stats["modules"]]))
+
+    @skipIfRemote
+    @skipIfWindows
+    def test_preload(self):
+        """The library is indexed as soon as it is loaded."""
+        module = self.get_foo_stats(True)
+        self.assertGreater(module["symbolTableIndexTime"], 0.0)
+        self.assertGreater(module["debugInfoIndexTime"], 0.0)
+
+    @skipIfRemote
+    @skipIfWindows
+    def test_no_preload(self):
+        """Without preloading, nothing looked into the library yet."""
+        module = self.get_foo_stats(False)
+        self.assertEqual(module["debugInfoIndexTime"], 0.0)
@@ -0,0 +1,3 @@
+int foo(int x);
+
+int main(int argc, char const *argv[]) { return foo(argc); }
@@ -0,0 +1,91 @@
+//===- Compression.cpp - Benchmark of parallel compression ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Threading.h"
+#include <cstdlib>
+#include <string>
+
+using namespace llvm;
+using namespace llvm::compression;
+
+// Compression ratio against throughput. Set LLVM_COMPRESSION_BENCHMARK_INPUT
+// to a file with real data, e.g. DWARF extracted with
+// `llvm-objcopy --dump-section .debug_info=debug_info.bin a.out`. Otherwise
+// a synthetic input with DWARF-like repetition is used.
+static ArrayRef<uint8_t> getInput() {
+  static std::string Data = [] {
+    if (const char *Path = std::getenv("LLVM_COMPRESSION_BENCHMARK_INPUT"))
+      if (ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
+              MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/false))
+        return (*MB)->getBuffer().str();
+    std::string S;
+    for (uint32_t I = 0; S.size() < (64 << 20); ++I) {
+      S += "DW_TAG_variable DW_AT_name v" + std::to_string(I % 10007);
+      S += " DW_AT_type " + std::to_string(I * 2654435761u % 65521);
+      S += '\0';
+    }
+    return S;
+  }();
+  return arrayRefFromStringRef(Data);
+}
+
+static void reportRatio(benchmark::State &State, size_t CompressedSize) {
+  State.SetBytesProcessed(State.iterations() * getInput().size());
+  State.counters["ratio"] = double(getInput().size()) / CompressedSize;
+}
+
+static void BM_Zlib(benchmark::State &State) {
+  if (!zlib::isAvailable()) {
+    State.SkipWithError("zlib is not available");
+    return;
+  }
+  SmallVector<uint8_t, 0> Out;
+  for (auto _ : State)
+    zlib::compress(getInput(), Out, State.range(0));
+  reportRatio(State, Out.size());
+}
+BENCHMARK(BM_Zlib)
+    ->Arg(zlib::BestSpeedCompression)
+    ->Arg(6)
+    ->Arg(zlib::BestSizeCompression)
+    ->Unit(benchmark::kMillisecond);
+
+// Arguments: level, long distance matching, number of workers (0 means no
+// zstd worker threads, -1 means one per hardware thread).
+static void BM_Zstd(benchmark::State &State) {
+  if (!zstd::isAvailable()) {
+    State.SkipWithError("zstd is not available");
+    return;
+  }
+  unsigned NumWorkers = State.range(2) < 0
+                            ? llvm::hardware_concurrency().compute_thread_count()
+                            : State.range(2);
+  if (NumWorkers && !zstd::supportsMultithreading()) {
+    State.SkipWithError("zstd was built without multithreading");
+    return;
+  }
+  SmallVector<uint8_t, 0> Out;
+  for (auto _ : State)
+    zstd::compress(getInput(), Out, State.range(0), State.range(1),
+                   NumWorkers);
+  reportRatio(State, Out.size());
+}
+BENCHMARK(BM_Zstd)
+    ->ArgsProduct({{zstd::BestSpeedCompression, 3, zstd::DefaultCompression,
+                    9},
+                   {0, 1},
+                   {0, -1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
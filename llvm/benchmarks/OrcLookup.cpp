@@ -0,0 +1,66 @@
+//===- OrcLookup.cpp - Benchmark of concurrent ORC symbol lookups ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/Support/FormatVariadic.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+// A session with two JITDylibs of already-ready absolute symbols, searched
+// in order, as a client looking up function addresses would see it.
+struct LookupState {
+  ExecutionSession ES{std::make_unique<UnsupportedExecutorProcessControl>()};
+  JITDylibSearchOrder SearchOrder;
+  std::vector<SymbolStringPtr> Names;
+
+  LookupState(unsigned NumSymbols) {
+    auto &Main = ES.createBareJITDylib("main");
+    auto &Lib = ES.createBareJITDylib("lib");
+    SymbolMap MainSyms, LibSyms;
+    for (unsigned I = 0; I != NumSymbols; ++I) {
+      auto Name = ES.intern(formatv("sym{0}", I).str());
+      auto &Syms = I % 2 ? LibSyms : MainSyms;
+      Syms[Name] = {ExecutorAddr(0x1000 + I), JITSymbolFlags::Exported};
+      Names.push_back(std::move(Name));
+    }
+    cantFail(Main.define(absoluteSymbols(std::move(MainSyms))));
+    cantFail(Lib.define(absoluteSymbols(std::move(LibSyms))));
+    SearchOrder = makeJITDylibSearchOrder({&Main, &Lib});
+  }
+
+  ~LookupState() { cantFail(ES.endSession()); }
+};
+
+} // namespace
+
+// Lookups of ready symbols from several threads at once. These are answered
+// from the JITDylibs' published symbol tables once each symbol has been
+// looked up once.
+static void BM_ConcurrentReadyLookup(benchmark::State &state) {
+  static std::unique_ptr<LookupState> LS;
+  if (state.thread_index() == 0)
+    LS = std::make_unique<LookupState>(1024);
+  // Google benchmark synchronizes the threads before the timing loop.
+
+  size_t I = state.thread_index();
+  for (auto _ : state) {
+    auto &Name = LS->Names[I++ % LS->Names.size()];
+    benchmark::DoNotOptimize(cantFail(LS->ES.lookup(LS->SearchOrder, Name)));
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0)
+    LS.reset();
+}
+BENCHMARK(BM_ConcurrentReadyLookup)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,61 @@
+//===- Parallel.cpp - Benchmark of the parallel executor ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Parallel.h"
+#include <atomic>
+
+using namespace llvm;
+
+// Many tiny tasks, as spawned by parallelFor over small per-item work. This
+// is dominated by the cost of queueing and dequeueing tasks.
+static void BM_ParallelForFineGrain(benchmark::State &state) {
+  std::vector<uint64_t> data(state.range(0));
+  for (auto _ : state) {
+    parallelFor(0, data.size(), [&](size_t i) { data[i] += i; });
+    benchmark::DoNotOptimize(data.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelForFineGrain)->Range(1 << 10, 1 << 20);
+
+// One task per spawn() call, without parallelFor's chunking.
+static void BM_TaskGroupSpawn(benchmark::State &state) {
+  std::atomic<uint64_t> sum{0};
+  for (auto _ : state) {
+    parallel::TaskGroup tg;
+    for (int64_t i = 0; i != state.range(0); ++i)
+      tg.spawn([&, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+  }
+  benchmark::DoNotOptimize(sum.load());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TaskGroupSpawn)->Range(1 << 8, 1 << 16);
+
+// Tasks that spawn further tasks into the same group from worker threads, as
+// parallelSort does.
+static void spawnTree(parallel::TaskGroup &tg, std::atomic<uint64_t> &count,
+                      unsigned depth) {
+  count.fetch_add(1, std::memory_order_relaxed);
+  if (depth == 0)
+    return;
+  tg.spawn([&, depth] { spawnTree(tg, count, depth - 1); });
+  tg.spawn([&, depth] { spawnTree(tg, count, depth - 1); });
+}
+
+static void BM_TaskGroupRecursiveSpawn(benchmark::State &state) {
+  std::atomic<uint64_t> count{0};
+  for (auto _ : state) {
+    parallel::TaskGroup tg;
+    spawnTree(tg, count, state.range(0));
+  }
+  benchmark::DoNotOptimize(count.load());
+}
+BENCHMARK(BM_TaskGroupRecursiveSpawn)->DenseRange(8, 16, 4);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,282 @@
+//===- ConcurrentStringMap.h ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines ConcurrentStringMap, a string-keyed hash map that can be
+/// searched and inserted into from many threads at once.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_CONCURRENTSTRINGMAP_H
+#define LLVM_ADT_CONCURRENTSTRINGMAP_H
+
+#include "llvm/ADT/StringMapEntry.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "llvm/Support/xxhash.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace llvm {
+
+/// ConcurrentStringMap - a map from strings to values that supports
+/// concurrent find() and try_emplace(). This is meant for interning strings
+/// from parallel code: each key is inserted at most once and entries are
+/// never removed or moved, so the returned StringMapEntry pointers stay valid
+/// for the lifetime of the map.
+///
+/// The map is split into shards selected by the high bits of the hash. Each
+/// shard is an open-addressing table of atomic entry pointers. Lookups and
+/// insertions into a free slot are lock-free; a thread only takes the shard's
+/// mutex to grow the table, or to wait for another thread to finish growing
+/// it. While a table is being grown, the free slots of the old table are
+/// marked as moved so that no insertion can be lost. Every operation registers
+/// itself with the shard, and a replaced table is freed by a later grow once
+/// no other thread is inside the shard.
+///
+/// Entries are allocated from an external allocator, which must be safe to
+/// call from all inserting threads; parallel::PerThreadBumpPtrAllocator is
+/// the intended one. Values are constructed in place by try_emplace() and are
+/// not synchronized by the map: concurrent access to a value is up to the
+/// caller.
+template <typename ValueTy,
+          typename AllocatorTy = parallel::PerThreadBumpPtrAllocator>
+class ConcurrentStringMap {
+public:
+  using EntryTy = StringMapEntry<ValueTy>;
+
+  explicit ConcurrentStringMap(
+      AllocatorTy &Allocator, size_t EstimatedSize = 1024,
+      size_t ThreadsNum = parallel::strategy.compute_thread_count())
+      : Allocator(Allocator) {
+    // Use a few shards per thread so that concurrent growing is unlikely to
+    // make another thread wait.
+    size_t NumShards = PowerOf2Ceil(std::max<size_t>(ThreadsNum * 4, 1));
+    ShardBits = Log2_64(NumShards);
+    Shards = std::make_unique<Shard[]>(NumShards);
+
+    size_t InitialTableSize =
+        PowerOf2Ceil(std::max<size_t>(EstimatedSize * 4 / 3 / NumShards, 16));
+    for (size_t I = 0; I != NumShards; ++I) {
+      Shards[I].Tables.push_back(std::make_unique<Table>(InitialTableSize));
+      Shards[I].Current = Shards[I].Tables.back().get();
+    }
+  }
+
+  ConcurrentStringMap(const ConcurrentStringMap &) = delete;
+  ConcurrentStringMap &operator=(const ConcurrentStringMap &) = delete;
+
+  ~ConcurrentStringMap() {
+    // The memory belongs to the allocator; only run the value destructors.
+    if constexpr (!std::is_trivially_destructible_v<ValueTy>)
+      forEach([](EntryTy &E) { E.~EntryTy(); });
+  }
+
+  /// \returns the entry for \p Key, or nullptr if there is none.
+  EntryTy *find(StringRef Key) const {
+    uint64_t Hash = xxHash64(Key);
+    const Shard &S = getShard(Hash);
+    ReaderGuard Guard(S);
+    while (true) {
+      Table *T = S.Current.load();
+      size_t Mask = T->Size - 1;
+      bool Moved = false;
+      for (size_t I = Hash & Mask, N = 0; N != T->Size;
+           I = (I + 1) & Mask, ++N) {
+        EntryTy *E = T->Slots[I].load(std::memory_order_acquire);
+        if (!E)
+          return nullptr;
+        if (E == getMovedMarker()) {
+          Moved = true;
+          break;
+        }
+        if (E->getKey() == Key)
+          return E;
+      }
+      if (!Moved)
+        return nullptr;
+      waitForGrow(S);
+    }
+  }
+
+  /// Inserts an entry for \p Key whose value is constructed from \p Args,
+  /// unless the map already contains \p Key.
+  ///
+  /// \returns the entry for \p Key and true if it was inserted by this call.
+  /// If another thread inserts the same key at the same time, exactly one of
+  /// them gets true. The loser's entry is destroyed, but its memory is only
+  /// reclaimed together with the allocator.
+  template <typename... ArgsTy>
+  std::pair<EntryTy *, bool> try_emplace(StringRef Key, ArgsTy &&...Args) {
+    uint64_t Hash = xxHash64(Key);
+    Shard &S = getShard(Hash);
+    ReaderGuard Guard(S);
+    EntryTy *NewEntry = nullptr;
+    while (true) {
+      Table *T = S.Current.load();
+      size_t Mask = T->Size - 1;
+      bool Moved = false;
+      for (size_t I = Hash & Mask, N = 0; N != T->Size;
+           I = (I + 1) & Mask, ++N) {
+        EntryTy *E = T->Slots[I].load(std::memory_order_acquire);
+        if (!E) {
+          if (!NewEntry)
+            NewEntry =
+                EntryTy::create(Key, Allocator, std::forward<ArgsTy>(Args)...);
+          if (T->Slots[I].compare_exchange_strong(E, NewEntry,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+            // Grow at a 3/4 load factor.
+            size_t NumEntries = ++S.NumEntries;
+            if (NumEntries * 4 > T->Size * 3)
+              grow(S, T);
+            return {NewEntry, true};
+          }
+          // Somebody else took the slot; E is what they stored.
+        }
+        if (E == getMovedMarker()) {
+          Moved = true;
+          break;
+        }
+        if (E->getKey() == Key) {
+          if (NewEntry)
+            NewEntry->~EntryTy();
+          return {E, false};
+        }
+      }
+      // Either the table is being grown or it filled up before the thread
+      // that crossed the load factor got around to growing it.
+      if (Moved)
+        waitForGrow(S);
+      else
+        grow(S, T);
+    }
+  }
+
+  /// \returns the number of entries. This is exact only if no insertion is in
+  /// progress.
+  size_t size() const {
+    size_t Size = 0;
+    for (size_t I = 0, E = getNumShards(); I != E; ++I)
+      Size += Shards[I].NumEntries.load(std::memory_order_relaxed);
+    return Size;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /// Calls \p Fn for each entry, in no particular order. This must not be
+  /// called concurrently with try_emplace().
+  template <typename FnTy> void forEach(FnTy Fn) const {
+    for (size_t I = 0, E = getNumShards(); I != E; ++I) {
+      Table *T = Shards[I].Current.load(std::memory_order_acquire);
+      for (size_t J = 0; J != T->Size; ++J)
+        if (EntryTy *Entry = T->Slots[J].load(std::memory_order_relaxed))
+          Fn(*Entry);
+    }
+  }
+
+  AllocatorTy &getAllocator() { return Allocator; }
+
+private:
+  struct Table {
+    explicit Table(size_t Size)
+        : Size(Size), Slots(std::make_unique<std::atomic<EntryTy *>[]>(Size)) {}
+
+    size_t Size;
+    std::unique_ptr<std::atomic<EntryTy *>[]> Slots;
+  };
+
+  struct alignas(64) Shard {
+    std::atomic<Table *> Current{nullptr};
+    std::atomic<size_t> NumEntries{0};
+    // The number of threads in find() or try_emplace() on this shard. A thread
+    // registers before it loads Current, so once Current has been replaced and
+    // no other thread is registered, nobody can still be probing a replaced
+    // table.
+    mutable std::atomic<unsigned> NumReaders{0};
+    // Held while growing. Tables is only modified under this mutex. It holds
+    // the current table last, preceded by the replaced tables that may still
+    // be probed.
+    mutable std::mutex GrowMutex;
+    std::vector<std::unique_ptr<Table>> Tables;
+  };
+
+  class ReaderGuard {
+  public:
+    explicit ReaderGuard(const Shard &S) : S(S) { ++S.NumReaders; }
+    ~ReaderGuard() { --S.NumReaders; }
+
+  private:
+    const Shard &S;
+  };
+
+  static EntryTy *getMovedMarker() {
+    return reinterpret_cast<EntryTy *>(uintptr_t(alignof(EntryTy)));
+  }
+
+  size_t getNumShards() const { return size_t(1) << ShardBits; }
+
+  Shard &getShard(uint64_t Hash) const {
+    return Shards[ShardBits ? Hash >> (64 - ShardBits) : 0];
+  }
+
+  // The thread growing a table holds the mutex from before it marks the
+  // first slot as moved until it has published the new table.
+  static void waitForGrow(const Shard &S) {
+    std::lock_guard<std::mutex> Lock(S.GrowMutex);
+  }
+
+  // Replaces \p Old, the current table of \p S, with one twice as large. The
+  // calling thread must hold a ReaderGuard for \p S.
+  void grow(Shard &S, Table *Old) {
+    std::lock_guard<std::mutex> Lock(S.GrowMutex);
+    if (S.Current.load(std::memory_order_relaxed) != Old)
+      return;
+
+    auto New = std::make_unique<Table>(Old->Size * 2);
+    size_t Mask = New->Size - 1;
+    for (size_t I = 0; I != Old->Size; ++I) {
+      // Close a free slot so that nobody inserts into it any more, or pick up
+      // the entry that is already there.
+      EntryTy *E = nullptr;
+      if (Old->Slots[I].compare_exchange_strong(E, getMovedMarker(),
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire))
+        continue;
+      size_t J = xxHash64(E->getKey()) & Mask;
+      while (New->Slots[J].load(std::memory_order_relaxed))
+        J = (J + 1) & Mask;
+      New->Slots[J].store(E, std::memory_order_relaxed);
+    }
+
+    S.Current.store(New.get());
+    S.Tables.push_back(std::move(New));
+
+    // Both the store above and the registration of a reader are sequentially
+    // consistent, so a thread that registers after this load sees the new
+    // table. If the calling thread is the only reader, the replaced tables are
+    // unreachable. Otherwise they are left to a later grow, which keeps their
+    // total size below that of the current table.
+    if (S.NumReaders.load() == 1)
+      S.Tables.erase(S.Tables.begin(), S.Tables.end() - 1);
+  }
+
+  AllocatorTy &Allocator;
+  unsigned ShardBits = 0;
+  std::unique_ptr<Shard[]> Shards;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_CONCURRENTSTRINGMAP_H
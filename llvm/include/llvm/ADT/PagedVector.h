@@ -0,0 +1,90 @@
+//===- llvm/ADT/PagedVector.h - 'Lazily allocated' vectors ------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the PagedVector class, a vector whose storage is only
+/// allocated, a page at a time, when an element is accessed.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_PAGEDVECTOR_H
+#define LLVM_ADT_PAGEDVECTOR_H
+
+#include "llvm/ADT/SmallVector.h"
+#include <cassert>
+#include <memory>
+
+namespace llvm {
+
+/// A vector that is resized in one step but only allocates the memory for
+/// its elements, page by page, when they are first accessed.
+///
+/// This is meant for tables that are sized up front but mostly left
+/// untouched, e.g. the entries of a serialized file that are read on demand.
+/// The elements of a page are value-initialized when the page is allocated;
+/// elements that were never accessed do not occupy any memory beyond one
+/// pointer per page.
+///
+/// Elements never move once their page is allocated, so references to them
+/// stay valid until the vector is cleared, shrunk or destroyed.
+template <typename T, size_t PageSize = 1024 / sizeof(T)> class PagedVector {
+  static_assert(PageSize > 1, "PageSize must be greater than 1; use a plain "
+                              "array of pointers instead");
+
+  /// The allocated pages; null for pages that have not been accessed yet.
+  mutable SmallVector<std::unique_ptr<T[]>, 0> Pages;
+
+  /// The number of elements, which the last page may not be filled up to.
+  size_t Size = 0;
+
+public:
+  using value_type = T;
+
+  /// \returns the element at \p Index, allocating its page if needed.
+  T &operator[](size_t Index) const {
+    assert(Index < Size && "index out of range");
+    std::unique_ptr<T[]> &Page = Pages[Index / PageSize];
+    if (!Page)
+      Page = std::make_unique<T[]>(PageSize);
+    return Page[Index % PageSize];
+  }
+
+  size_t size() const { return Size; }
+  bool empty() const { return Size == 0; }
+
+  /// \returns the number of elements that memory has been allocated for.
+  size_t capacity() const {
+    size_t NumAllocated = 0;
+    for (const std::unique_ptr<T[]> &Page : Pages)
+      if (Page)
+        ++NumAllocated;
+    return NumAllocated * PageSize;
+  }
+
+  /// Changes the number of elements to \p NewSize. Growing the vector does
+  /// not allocate memory for the new elements; shrinking it destroys the
+  /// pages that are no longer needed and resets the unused tail of the last
+  /// page.
+  void resize(size_t NewSize) {
+    if (NewSize < Size && NewSize % PageSize != 0)
+      if (std::unique_ptr<T[]> &Page = Pages[NewSize / PageSize])
+        for (size_t I = NewSize % PageSize; I != PageSize; ++I)
+          Page[I] = T();
+    Pages.resize((NewSize + PageSize - 1) / PageSize);
+    Size = NewSize;
+  }
+
+  void clear() {
+    Pages.clear();
+    Size = 0;
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_PAGEDVECTOR_H
@@ -54,6 +54,7 @@ namespace llvm {
 
 class AnalysisUsage;
 class AtomicCmpXchgInst;
+class BasicAADecompositionCache;
 class BasicBlock;
 class CatchPadInst;
 class CatchReturnInst;
@@ -286,6 +287,20 @@ public:
   ///   store %l, ...
   bool MayBeCrossIteration = false;
 
+  /// Whether the queries are made in batch mode, i.e. the IR does not change
+  /// between them, so that results depending only on the IR may be kept
+  /// across queries.
+  bool IsBatch = false;
+
+  /// Pointer decompositions computed by BasicAA during a batch of queries.
+  /// A batch that compares one pointer against many others only decomposes
+  /// it once. Created by BasicAAResult on first use.
+  struct BasicAADecompositionCacheDeleter {
+    void operator()(BasicAADecompositionCache *Cache) const;
+  };
+  std::unique_ptr<BasicAADecompositionCache, BasicAADecompositionCacheDeleter>
+      BasicAADecompositions;
+
   AAQueryInfo(AAResults &AAR, CaptureInfo *CI) : AAR(AAR), CI(CI) {}
 };
 
@@ -623,8 +638,12 @@ class BatchAAResults {
   SimpleCaptureInfo SimpleCI;
 
 public:
-  BatchAAResults(AAResults &AAR) : AA(AAR), AAQI(AAR, &SimpleCI) {}
-  BatchAAResults(AAResults &AAR, CaptureInfo *CI) : AA(AAR), AAQI(AAR, CI) {}
+  BatchAAResults(AAResults &AAR) : AA(AAR), AAQI(AAR, &SimpleCI) {
+    AAQI.IsBatch = true;
+  }
+  BatchAAResults(AAResults &AAR, CaptureInfo *CI) : AA(AAR), AAQI(AAR, CI) {
+    AAQI.IsBatch = true;
+  }
 
   AliasResult alias(const MemoryLocation &LocA, const MemoryLocation &LocB) {
     return AA.alias(LocA, LocB, AAQI);
@@ -94,6 +94,7 @@ public:
 
 private:
   struct DecomposedGEP;
+  friend class BasicAADecompositionCache;
 
   /// Tracks instructions visited by pointsToConstantMemory.
   SmallPtrSet<const Value *, 16> Visited;
@@ -102,6 +103,11 @@ private:
   DecomposeGEPExpression(const Value *V, const DataLayout &DL,
                          AssumptionCache *AC, DominatorTree *DT);
 
+  /// Returns the decomposition of \p V. In batch mode, reuses the one
+  /// computed by an earlier query in \p AAQI if there is one.
+  DecomposedGEP getDecomposedGEP(const Value *V, const DataLayout &DL,
+                                 AAQueryInfo &AAQI);
+
   /// A Heuristic for aliasGEP that searches for a constant offset
   /// between the variables.
   ///
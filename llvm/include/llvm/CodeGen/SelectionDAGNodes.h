@@ -606,6 +606,11 @@ private:
   /// Unique id per SDNode in the DAG.
   int NodeId = -1;
 
+  /// Scratch state of the DAGCombiner: where the node is on its worklist,
+  /// and whether it has been combined. Only meaningful during a run of the
+  /// DAGCombiner.
+  unsigned CombinerState = 0;
+
   /// The values that are used by this operation.
   SDUse *OperandList = nullptr;
 
@@ -732,6 +737,12 @@ public:
   /// Set unique node id.
   void setNodeId(int Id) { NodeId = Id; }
 
+  /// Return the scratch state of the DAGCombiner.
+  unsigned getCombinerState() const { return CombinerState; }
+
+  /// Set the scratch state of the DAGCombiner.
+  void setCombinerState(unsigned State) { CombinerState = State; }
+
   /// Return the node ordering.
   unsigned getIROrder() const { return IROrder; }
 
@@ -0,0 +1,36 @@
+//===- DWPStreamer.h - Write a DWARF package without buffering --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DWP_DWPSTREAMER_H
+#define LLVM_DWP_DWPSTREAMER_H
+
+#include "llvm/MC/MCStreamer.h"
+#include <memory>
+
+namespace llvm {
+class raw_pwrite_stream;
+
+/// Creates a streamer for write() that does not keep the package in memory.
+///
+/// An MCObjectStreamer holds on to every byte emitted until finish(), so the
+/// memory needed to build a package grows with the package. This streamer
+/// instead appends the contents of each section to a temporary file as they
+/// are emitted, and finish() assembles the temporary files into an ELF
+/// relocatable object in \p OS. It only supports what write() emits: section
+/// contents, without symbols, relocations or alignment directives.
+///
+/// The ELF class and byte order are those of the target of \p Context;
+/// \p EMachine and \p EFlags are copied into the ELF header. Errors are
+/// reported through \p Context.
+std::unique_ptr<MCStreamer> createDWPStreamer(MCContext &Context,
+                                              raw_pwrite_stream &OS,
+                                              uint16_t EMachine,
+                                              uint32_t EFlags);
+} // namespace llvm
+
+#endif // LLVM_DWP_DWPSTREAMER_H
@@ -4,6 +4,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/MC/MCSection.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/StringSaver.h"
 #include <cassert>
 
 namespace llvm {
@@ -33,6 +34,9 @@ class DWPStringPool {
   MCStreamer &Out;
   MCSection *Sec;
   DenseMap<const char *, uint32_t, CStrDenseMapInfo> Pool;
+  // The pool keeps its own copy of the strings so that the input they came
+  // from can be released once it has been processed.
+  BumpPtrAllocator Alloc;
   uint32_t Offset = 0;
 
 public:
@@ -41,14 +45,18 @@ public:
   uint32_t getOffset(const char *Str, unsigned Length) {
     assert(strlen(Str) + 1 == Length && "Ensure length hint is correct");
 
-    auto Pair = Pool.insert(std::make_pair(Str, Offset));
-    if (Pair.second) {
-      Out.switchSection(Sec);
-      Out.emitBytes(StringRef(Str, Length));
-      Offset += Length;
-    }
+    auto It = Pool.find(Str);
+    if (It != Pool.end())
+      return It->second;
 
-    return Pair.first->second;
+    const char *Copy =
+        StringSaver(Alloc).save(StringRef(Str, Length - 1)).data();
+    Pool.insert(std::make_pair(Copy, Offset));
+    Out.switchSection(Sec);
+    Out.emitBytes(StringRef(Str, Length));
+    uint32_t Ret = Offset;
+    Offset += Length;
+    return Ret;
   }
 };
 } // namespace llvm
@@ -53,6 +53,9 @@ class DWARFContext : public DIContext {
   std::unique_ptr<DWARFDebugAbbrev> Abbrev;
   std::unique_ptr<DWARFDebugLoc> Loc;
   std::unique_ptr<DWARFDebugAranges> Aranges;
+  /// The part of the address index that .debug_aranges alone describes. It
+  /// answers lookups until the full index in Aranges is needed.
+  std::unique_ptr<DWARFDebugAranges> SectionAranges;
   std::unique_ptr<DWARFDebugLine> Line;
   std::unique_ptr<DWARFDebugFrame> DebugFrame;
   std::unique_ptr<DWARFDebugFrame> EHFrame;
@@ -291,6 +294,11 @@ public:
   /// Get a pointer to the parsed DebugAranges object.
   const DWARFDebugAranges *getDebugAranges();
 
+  /// Use \p NewAranges, for example one read back with
+  /// DWARFDebugAranges::readCache(), instead of building the address index
+  /// from the debug info.
+  void setDebugAranges(std::unique_ptr<DWARFDebugAranges> NewAranges);
+
   /// Get a pointer to the parsed frame information object.
   Expected<const DWARFDebugFrame *> getDebugFrame();
 
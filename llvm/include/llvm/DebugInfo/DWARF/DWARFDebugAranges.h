@@ -11,19 +11,35 @@
 
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/StringRef.h"
 #include <cstdint>
 #include <vector>
 
 namespace llvm {
 class DWARFDataExtractor;
 class Error;
+class raw_ostream;
 
 class DWARFContext;
 
 class DWARFDebugAranges {
 public:
   void generate(DWARFContext *CTX);
+
+  /// Builds the table from the .debug_aranges section only. This parses no
+  /// unit, but misses the compile units that .debug_aranges does not describe.
+  void generateFromArangesSection(DWARFContext *CTX);
+
   uint64_t findAddress(uint64_t Address) const;
+  bool empty() const { return Aranges.empty(); }
+
+  /// Writes the table in the form that readCache() accepts. \p Key identifies
+  /// the debug info the table was built from.
+  void writeCache(raw_ostream &OS, uint64_t Key) const;
+
+  /// Replaces the table with one written by writeCache() with the same \p Key.
+  /// \returns false, leaving the table empty, if \p Data is not such a table.
+  bool readCache(StringRef Data, uint64_t Key);
 
 private:
   void clear();
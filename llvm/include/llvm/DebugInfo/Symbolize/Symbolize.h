@@ -19,6 +19,7 @@
 #include "llvm/DebugInfo/DIContext.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/BuildID.h"
+#include "llvm/Support/CachePruning.h"
 #include "llvm/Support/Error.h"
 #include <algorithm>
 #include <cstdint>
@@ -57,11 +58,21 @@ public:
     bool RelativeAddresses = false;
     bool UntagAddresses = false;
     bool UseDIA = false;
+    /// Use a GSYM file named "<binary>.gsym" next to the binary instead of
+    /// its DWARF when there is one and its UUID matches the build ID of the
+    /// binary.
+    bool UseGsym = false;
     std::string DefaultArch;
     std::vector<std::string> DsymHints;
     std::string FallbackDebugPath;
     std::string DWPName;
     std::vector<std::string> DebugFileDirectory;
+    /// If not empty, the address index of each DWARF module with a build ID
+    /// and no .debug_aranges is saved in and loaded from this directory, so
+    /// that later processes do not have to rebuild it.
+    std::string IndexCacheDirectory;
+    /// Pruning policy for IndexCacheDirectory.
+    CachePruningPolicy IndexCachePolicy;
     size_t MaxCacheSize =
         sizeof(size_t) == 4
             ? 512 * 1024 * 1024 /* 512 MiB */
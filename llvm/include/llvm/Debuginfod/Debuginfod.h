@@ -54,6 +54,11 @@ Expected<std::string> getDefaultDebuginfodCacheDirectory();
 /// DEBUGINFOD_TIMEOUT environment variable, default is 90 seconds (90000 ms).
 std::chrono::milliseconds getDefaultDebuginfodTimeout();
 
+/// Makes artifact lookups remember, for \p TTL, artifacts that every server
+/// answered with 404 Not Found, and fail repeated lookups of them without
+/// querying the servers. A non-positive TTL, the default, disables this.
+void setDebuginfodMissingArtifactTTL(std::chrono::milliseconds TTL);
+
 /// Fetches a specified source file by searching the default local cache
 /// directory and server URLs.
 Expected<std::string> getCachedOrDownloadSource(object::BuildIDRef ID,
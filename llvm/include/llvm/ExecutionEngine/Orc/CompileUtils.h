@@ -13,16 +13,19 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_COMPILEUTILS_H
 #define LLVM_EXECUTIONENGINE_ORC_COMPILEUTILS_H
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
 #include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
 #include "llvm/ExecutionEngine/Orc/Layer.h"
+#include "llvm/Support/Caching.h"
 #include <memory>
+#include <mutex>
 
 namespace llvm {
 
 class MemoryBuffer;
 class Module;
-class ObjectCache;
 class TargetMachine;
 
 namespace orc {
@@ -93,6 +96,46 @@ private:
   ObjectCache *ObjCache = nullptr;
 };
 
+/// An ObjectCache that keeps the objects in a directory on disk, so that they
+/// survive the process.
+///
+/// Objects are looked up by a hash of the module's bitcode together with the
+/// target triple, CPU, features, optimization level, relocation model and
+/// code model of the JITTargetMachineBuilder that the cache was created for.
+/// Other target options are not part of the key, so they must not change
+/// between processes that share a cache directory. The directory uses the
+/// layout of llvm::localCache and can be pruned with llvm::pruneCache.
+///
+/// The cache can be shared by the compilers of several threads, e.g. a
+/// ConcurrentIRCompiler.
+class LocalObjectCache : public ObjectCache {
+public:
+  static Expected<std::unique_ptr<LocalObjectCache>>
+  Create(const Twine &CacheDir, const JITTargetMachineBuilder &JTMB);
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+private:
+  // A lookup that missed, whose object is stored once it is compiled.
+  struct PendingObject {
+    unsigned Task = 0;
+    AddStreamFn AddStream;
+  };
+
+  LocalObjectCache(std::string TargetID) : TargetID(std::move(TargetID)) {}
+
+  std::string computeKey(const Module &M) const;
+
+  std::string TargetID;
+  FileCache Cache;
+  std::mutex CacheMutex;
+  unsigned NextTask = 0;
+  // Buffers handed back by Cache, by the task that they were looked up for.
+  DenseMap<unsigned, std::unique_ptr<MemoryBuffer>> Found;
+  DenseMap<const Module *, PendingObject> Pending;
+};
+
 } // end namespace orc
 
 } // end namespace llvm
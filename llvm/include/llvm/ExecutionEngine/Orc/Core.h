@@ -30,6 +30,7 @@
 #include <atomic>
 #include <future>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace llvm {
@@ -1239,6 +1240,30 @@ private:
 
   using SymbolTable = DenseMap<SymbolStringPtr, SymbolTableEntry>;
 
+  /// The Ready symbols in this JITDylib, published so that lookups of
+  /// already-emitted symbols can be answered without the session lock.
+  /// Tables are immutable: each one holds the symbols that became ready since
+  /// the previous one, which is kept as Older. Older tables are merged into
+  /// a new one when they are not larger than it, so that there are only
+  /// logarithmically many of them. Complete is set if the tables hold every
+  /// symbol this JITDylib defines and there are no generators, so that a
+  /// name missing from them is known to be undefined here.
+  struct PublishedSymbolTable {
+    SymbolMap Symbols;
+    std::shared_ptr<const PublishedSymbolTable> Older;
+    size_t NumSymbols = 0;
+    bool Complete = false;
+
+    const ExecutorSymbolDef *lookup(const SymbolStringPtr &Name) const {
+      for (auto *T = this; T; T = T->Older.get()) {
+        auto I = T->Symbols.find(Name);
+        if (I != T->Symbols.end())
+          return &I->second;
+      }
+      return nullptr;
+    }
+  };
+
   JITDylib(ExecutionSession &ES, std::string Name);
 
   std::pair<AsynchronousSymbolQuerySet, std::shared_ptr<SymbolDependenceMap>>
@@ -1285,6 +1310,24 @@ private:
                    std::shared_ptr<SymbolDependenceMap>>
       failSymbols(FailedSymbolsWorklist);
 
+  // Note that Name became ready, so that the next refresh publishes it. Must
+  // be called under the session lock.
+  void notePublishableSymbol(const SymbolStringPtr &Name);
+
+  // Note that the published tables are out of date. If symbols were removed
+  // they are withdrawn immediately and rebuilt from scratch, otherwise they
+  // are only marked as no longer complete. Must be called under the session
+  // lock.
+  void invalidatePublishedSymbols(bool SymbolsRemoved);
+
+  // Publish the symbols that became ready since the last refresh. Must be
+  // called under the session lock.
+  void refreshPublishedSymbols();
+
+  std::shared_ptr<const PublishedSymbolTable> getPublishedSymbols() const {
+    return std::atomic_load(&PublishedSymbols);
+  }
+
   ExecutionSession &ES;
   enum { Open, Closing, Closed } State = Open;
   std::mutex GeneratorsMutex;
@@ -1299,6 +1342,12 @@ private:
   DenseMap<ResourceTracker *, SymbolNameVector> TrackerSymbols;
   DenseMap<ResourceTracker *, DenseSet<MaterializationResponsibility *>>
       TrackerMRs;
+
+  // Read with std::atomic_load, replaced under the session lock.
+  std::shared_ptr<const PublishedSymbolTable> PublishedSymbols;
+  SymbolNameVector NewlyReadySymbols;
+  bool PublishedSymbolsStale = true;
+  bool PublishedSymbolsNeedRebuild = false;
 };
 
 /// Platforms set up standard symbols and mediate interactions between dynamic
@@ -1695,6 +1744,13 @@ private:
   void transferResourceTracker(ResourceTracker &DstRT, ResourceTracker &SrcRT);
   void destroyResourceTracker(ResourceTracker &RT);
 
+  /// Try to find Name among the published Ready symbols of the JITDylibs in
+  /// SearchOrder, without taking the session lock. Returns std::nullopt if
+  /// the answer can not be determined that way.
+  std::optional<ExecutorSymbolDef>
+  lookupPublished(const JITDylibSearchOrder &SearchOrder,
+                  const SymbolStringPtr &Name);
+
   // State machine functions for query application..
 
   /// IL_updateCandidatesFor is called to remove already-defined symbols that
@@ -1791,6 +1847,7 @@ GeneratorT &JITDylib::addGenerator(std::unique_ptr<GeneratorT> DefGenerator) {
   ES.runSessionLocked([&] {
     assert(State == Open && "Cannot add generator to closed JITDylib");
     DefGenerators.push_back(std::move(DefGenerator));
+    invalidatePublishedSymbols(false);
   });
   return G;
 }
@@ -81,9 +81,15 @@ public:
 
 class InProcessMemoryMapper : public MemoryMapper {
 public:
-  InProcessMemoryMapper(size_t PageSize);
+  /// If \p HugePageHint is set, reservations ask for transparent huge pages
+  /// where the host supports them. This pays off with a large reservation
+  /// granularity, where the allocations of many graphs share a reservation,
+  /// but protecting parts of a huge page with different permissions splits
+  /// it back up.
+  InProcessMemoryMapper(size_t PageSize, bool HugePageHint = false);
 
-  static Expected<std::unique_ptr<InProcessMemoryMapper>> Create();
+  static Expected<std::unique_ptr<InProcessMemoryMapper>>
+  Create(bool HugePageHint = false);
 
   unsigned int getPageSize() override { return PageSize; }
 
@@ -119,6 +125,7 @@ private:
   AllocationMap Allocations;
 
   size_t PageSize;
+  bool HugePageHint;
 };
 
 class SharedMemoryMapper final : public MemoryMapper {
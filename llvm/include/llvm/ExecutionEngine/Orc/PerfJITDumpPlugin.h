@@ -0,0 +1,85 @@
+//===--- PerfJITDumpPlugin.h -- Tell Linux's perf about JIT'd code -*- C++ -*-//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectLinkingLayer plugin that writes the functions of linked graphs to
+// a jitdump file, which perf inject --jit reads to attribute samples.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_PERFJITDUMPPLUGIN_H
+#define LLVM_EXECUTIONENGINE_ORC_PERFJITDUMPPLUGIN_H
+
+#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace llvm {
+namespace orc {
+
+/// Writes a JIT_CODE_LOAD record to a jitdump file for every function that
+/// the ObjectLinkingLayer links.
+///
+/// The records are built once a graph is fixed up and written by a
+/// background thread, so that linking does not wait for the file. They are
+/// timestamped when built, which is before the code can run. Line tables are
+/// not written.
+///
+/// Linux only. The code must be linked into this process, since the file
+/// describes the addresses of the process that writes it.
+class PerfJITDumpPlugin : public ObjectLinkingLayer::Plugin {
+public:
+  /// Creates the file jit-<pid>.dump in \p OutputDir and maps it so that perf
+  /// record notices it. \p TT is the triple of the JIT'd code.
+  static Expected<std::unique_ptr<PerfJITDumpPlugin>>
+  Create(const Triple &TT, StringRef OutputDir);
+
+  ~PerfJITDumpPlugin() override;
+
+  void modifyPassConfig(MaterializationResponsibility &MR,
+                        jitlink::LinkGraph &G,
+                        jitlink::PassConfiguration &Config) override;
+
+  Error notifyFailed(MaterializationResponsibility &MR) override {
+    return Error::success();
+  }
+
+  Error notifyRemovingResources(JITDylib &JD, ResourceKey K) override {
+    return Error::success();
+  }
+
+  void notifyTransferringResources(JITDylib &JD, ResourceKey DstKey,
+                                   ResourceKey SrcKey) override {}
+
+private:
+  PerfJITDumpPlugin(int FD, void *Marker);
+
+  Error recordFunctions(jitlink::LinkGraph &G);
+  void writeRecords();
+
+  int FD;
+  void *Marker;
+  raw_fd_ostream OS;
+
+  std::mutex QueueMutex;
+  std::condition_variable QueueChanged;
+  std::deque<std::string> Queue;
+  uint64_t NextCodeIndex = 0;
+  bool ShuttingDown = false;
+#if LLVM_ENABLE_THREADS
+  std::thread Writer;
+#endif
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_PERFJITDUMPPLUGIN_H
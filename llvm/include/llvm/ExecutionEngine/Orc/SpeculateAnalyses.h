@@ -13,10 +13,13 @@
 #ifndef LLVM_EXECUTIONENGINE_ORC_SPECULATEANALYSES_H
 #define LLVM_EXECUTIONENGINE_ORC_SPECULATEANALYSES_H
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 #include "llvm/ExecutionEngine/Orc/Speculation.h"
 
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace llvm {
@@ -78,6 +81,28 @@ public:
   ResultTy operator()(Function &F);
 };
 
+// Functions that were entered after a function in an earlier run are
+// speculated for, in the order recorded by Speculator::getEntryOrder.
+//
+// Functions that are not part of the trace are still instrumented, with no
+// likely callees, so that the Speculator records them for the next run.
+class TraceQuery : public SpeculateQuery {
+  struct TraceInfo {
+    std::vector<std::string> Trace;
+    StringMap<size_t> FirstEntry;
+  };
+
+  std::shared_ptr<const TraceInfo> Info;
+  size_t Lookahead;
+
+public:
+  // Trace holds IR function names, i.e. the recorded names without the
+  // global prefix of the target.
+  TraceQuery(std::vector<std::string> Trace, size_t Lookahead = 4);
+
+  ResultTy operator()(Function &F);
+};
+
 } // namespace orc
 } // namespace llvm
 
@@ -64,10 +64,11 @@ public:
   using StubAddrLikelies = DenseMap<TargetFAddr, SymbolNameSet>;
 
 private:
-  void registerSymbolsWithAddr(TargetFAddr ImplAddr,
+  void registerSymbolsWithAddr(TargetFAddr ImplAddr, SymbolStringPtr Target,
                                SymbolNameSet likelySymbols) {
     std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
     GlobalSpecMap.insert({ImplAddr, std::move(likelySymbols)});
+    ImplSymbols.insert({ImplAddr, std::move(Target)});
   }
 
   void launchCompile(ExecutorAddr FAddr) {
@@ -79,6 +80,10 @@ private:
       auto It = GlobalSpecMap.find(FAddr);
       if (It == GlobalSpecMap.end())
         return;
+      // Instrumented functions only call in here on their first entry.
+      auto SymIt = ImplSymbols.find(FAddr);
+      if (SymIt != ImplSymbols.end())
+        EntryOrder.push_back(SymIt->second);
       CandidateSet = It->getSecond();
     }
 
@@ -145,7 +150,8 @@ public:
                            this](Expected<SymbolMap> ReadySymbol) {
         if (ReadySymbol) {
           auto RDef = (*ReadySymbol)[Target];
-          registerSymbolsWithAddr(RDef.getAddress(), std::move(Likely));
+          registerSymbolsWithAddr(RDef.getAddress(), Target,
+                                  std::move(Likely));
         } else
           this->getES().reportError(ReadySymbol.takeError());
       };
@@ -158,6 +164,14 @@ public:
     }
   }
 
+  /// Returns the instrumented functions in the order in which they were
+  /// first entered so far. A later run can pass this, by IR name, to a
+  /// TraceQuery to compile the functions ahead of their first call.
+  std::vector<SymbolStringPtr> getEntryOrder() {
+    std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
+    return EntryOrder;
+  }
+
   ExecutionSession &getES() { return ES; }
 
 private:
@@ -166,6 +180,8 @@ private:
   ImplSymbolMap &AliaseeImplTable;
   ExecutionSession &ES;
   StubAddrLikelies GlobalSpecMap;
+  DenseMap<TargetFAddr, SymbolStringPtr> ImplSymbols;
+  std::vector<SymbolStringPtr> EntryOrder;
 };
 
 class IRSpeculationLayer : public IRLayer {
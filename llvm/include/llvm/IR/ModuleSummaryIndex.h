@@ -1800,6 +1800,12 @@ public:
   void collectDefinedFunctionsForModule(StringRef ModulePath,
                                         GVSummaryMapTy &GVSummaryMap) const;
 
+  /// Collect for the given module the list of Summaries it defines (GUID ->
+  /// Summary). This is cheaper than collectDefinedGVSummariesPerModule() when
+  /// only one module is of interest, e.g. in a distributed ThinLTO backend.
+  void collectDefinedGVSummariesForModule(StringRef ModulePath,
+                                          GVSummaryMapTy &GVSummaryMap) const;
+
   /// Collect for each module the list of Summaries it defines (GUID ->
   /// Summary).
   template <class Map>
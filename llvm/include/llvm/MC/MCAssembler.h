@@ -196,14 +196,17 @@ private:
   bool fragmentNeedsRelaxation(const MCRelaxableFragment *IF,
                                const MCAsmLayout &Layout) const;
 
-  /// Perform one layout iteration and return true if any offsets
-  /// were adjusted.
-  bool layoutOnce(MCAsmLayout &Layout);
+  /// Perform one layout iteration of \p SectionsToRelax and return true if
+  /// any offsets were adjusted.
+  bool layoutOnce(MCAsmLayout &Layout, ArrayRef<MCSection *> SectionsToRelax);
 
   /// Perform one layout iteration of the given section and return true
   /// if any offsets were adjusted.
   bool layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec);
 
+  /// Check whether relaxFragment can change the size of \p F.
+  static bool mayNeedRelaxation(const MCFragment &F);
+
   /// Perform relaxation on a single fragment - returns true if the fragment
   /// changes as a result of relaxation.
   bool relaxFragment(MCAsmLayout &Layout, MCFragment &F);
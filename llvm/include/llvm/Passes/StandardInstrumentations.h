@@ -457,6 +457,28 @@ private:
   void runAfterPass();
 };
 
+/// This class implements -report-slow-passes for new pass manager. It reports
+/// every pass run that takes at least the given time, together with the IR
+/// unit it ran on and how many instructions that unit had before and after, to
+/// find the functions behind compile-time outliers.
+class SlowPassReporter {
+  struct PassRun {
+    std::string IRName;
+    unsigned NumInstrsBefore;
+    std::chrono::steady_clock::time_point Start;
+  };
+
+  /// The pass runs in progress, innermost last.
+  SmallVector<PassRun, 4> Runs;
+
+public:
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  void runBeforePass(StringRef PassID, Any IR);
+  void runAfterPass(StringRef PassID, const Any *IR);
+};
+
 // Class that holds transitions between basic blocks.  The transitions
 // are contained in a map of values to names of basic blocks.
 class DCData {
@@ -558,6 +580,7 @@ class StandardInstrumentations {
   PrintPassInstrumentation PrintPass;
   TimePassesHandler TimePasses;
   TimeProfilingPassesHandler TimeProfilingPasses;
+  SlowPassReporter SlowPasses;
   OptNoneInstrumentation OptNone;
   OptPassGateInstrumentation OptPassGate;
   PreservedCFGCheckerInstrumentation PreservedCFGChecker;
@@ -61,9 +61,19 @@ constexpr int BestSizeCompression = 12;
 
 bool isAvailable();
 
+// Returns true if zstd was built with ZSTD_MULTITHREAD, in which case
+// compress() can spread the work over NumWorkers threads.
+bool supportsMultithreading();
+
+// Compress Input into a single zstd frame. EnableLdm enables long distance
+// matching, which finds repetitions beyond the regular match window at some
+// cost in speed. If NumWorkers is non-zero and multithreading is supported,
+// the input is compressed by that many zstd worker threads; the output does
+// not depend on the number of workers.
 void compress(ArrayRef<uint8_t> Input,
               SmallVectorImpl<uint8_t> &CompressedBuffer,
-              int Level = DefaultCompression);
+              int Level = DefaultCompression, bool EnableLdm = false,
+              unsigned NumWorkers = 0);
 
 Error decompress(ArrayRef<uint8_t> Input, uint8_t *Output,
                  size_t &UncompressedSize);
@@ -34,6 +34,10 @@ public:
     /// Don't use mmap and instead write an in-memory buffer to a file when this
     /// buffer is closed.
     F_no_mmap = 2,
+
+    /// Request huge pages for an in-memory buffer. This is only a hint and has
+    /// no effect on a buffer that is mmap'ed to the output file.
+    F_huge_pages = 4,
   };
 
   /// Factory method to create an OutputBuffer object which manages a read/write
@@ -1299,6 +1299,7 @@ private:
 
   void unmapImpl();
   void dontNeedImpl();
+  void willNeedImpl();
 
   std::error_code init(sys::fs::file_t FD, uint64_t Offset, mapmode Mode);
 
@@ -1329,6 +1330,9 @@ public:
     copyFrom(mapped_file_region());
   }
   void dontNeed() { dontNeedImpl(); }
+  /// Hint that the whole mapping will be accessed soon, so that the kernel
+  /// can start reading it in asynchronously.
+  void willNeed() { willNeedImpl(); }
 
   size_t size() const;
   char *data() const;
@@ -44,7 +44,8 @@ public:
 private:
   bool matchOne(ArrayRef<BitVector> Pat, StringRef S) const;
 
-  // Parsed glob pattern.
+  // Parsed glob pattern, following the literal TokensPrefix.
+  StringRef TokensPrefix;
   std::vector<BitVector> Tokens;
 
   // The following members are for optimization.
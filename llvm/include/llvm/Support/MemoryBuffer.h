@@ -82,6 +82,12 @@ public:
   /// function should not be called on a writable buffer.
   virtual void dontNeedIfMmap() {}
 
+  /// For MemoryBuffer_MMap, hint that the whole buffer will be read soon so
+  /// the kernel can start paging it in asynchronously instead of faulting the
+  /// pages in one at a time. This calls madvise(MADV_WILLNEED) on *NIX
+  /// systems.
+  virtual void willNeedIfMmap() {}
+
   /// Open the specified file as a MemoryBuffer, returning a new MemoryBuffer
   /// if successful, otherwise returning null.
   ///
@@ -18,7 +18,9 @@
 #include <algorithm>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace llvm {
 
@@ -38,20 +40,31 @@ extern ThreadPoolStrategy strategy;
          "ThreadPoolExecutor");                                                \
   return threadIndex;
 
+#define GET_THREAD_INDEX_OR_MAX_IMPL                                           \
+  if (parallel::strategy.ThreadsRequested == 1)                                \
+    return 0;                                                                  \
+  return threadIndex;
+
 #ifdef _WIN32
 // Direct access to thread_local variables from a different DLL isn't
 // possible with Windows Native TLS.
 unsigned getThreadIndex();
+unsigned getThreadIndexOrMax();
 #else
 // Don't access this directly, use the getThreadIndex wrapper.
 extern thread_local unsigned threadIndex;
 
 inline unsigned getThreadIndex() { GET_THREAD_INDEX_IMPL; }
+
+// Like getThreadIndex(), but returns UINT_MAX instead of asserting when called
+// from a thread that was not created by ThreadPoolExecutor.
+inline unsigned getThreadIndexOrMax() { GET_THREAD_INDEX_OR_MAX_IMPL; }
 #endif
 
 size_t getThreadCount();
 #else
 inline unsigned getThreadIndex() { return 0; }
+inline unsigned getThreadIndexOrMax() { return 0; }
 inline size_t getThreadCount() { return 1; }
 #endif
 
@@ -89,6 +102,14 @@ public:
 class TaskGroup {
   detail::Latch L;
   bool Parallel;
+  // Set for a TaskGroup created on an executor thread. Its tasks are spawned
+  // onto that thread's queue, where idle threads can steal them, and sync()
+  // runs the ones that were not stolen inline.
+  bool Nested;
+
+  struct NestedTask;
+  std::mutex NestedMutex;
+  std::vector<std::shared_ptr<NestedTask>> NestedTasks;
 
 public:
   TaskGroup();
@@ -101,7 +122,7 @@ public:
   // threads, but strictly in sequential order.
   void spawn(std::function<void()> f, bool Sequential = false);
 
-  void sync() const { L.sync(); }
+  void sync();
 
   bool isParallel() const { return Parallel; }
 };
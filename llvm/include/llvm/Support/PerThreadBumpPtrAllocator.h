@@ -12,15 +12,22 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Parallel.h"
 
+#include <mutex>
+
 namespace llvm {
 namespace parallel {
 
 /// PerThreadAllocator is used in conjunction with ThreadPoolExecutor to allow
 /// per-thread allocations. It wraps a possibly thread-unsafe allocator,
-/// e.g. BumpPtrAllocator. PerThreadAllocator must be used with only main thread
-/// or threads created by ThreadPoolExecutor, as it utilizes getThreadIndex,
-/// which is set by ThreadPoolExecutor. To work properly, ThreadPoolExecutor
-/// should be initialized before PerThreadAllocator is created.
+/// e.g. BumpPtrAllocator. Every thread created by ThreadPoolExecutor gets its
+/// own allocator, selected by getThreadIndex(), so allocating from parallel
+/// tasks takes no lock. All other threads, e.g. the main thread, share one
+/// more allocator, which Allocate() and Deallocate() guard with a mutex. To
+/// work properly, ThreadPoolExecutor should be initialized before
+/// PerThreadAllocator is created.
+///
+/// Memory is owned by the PerThreadAllocator and released only by Reset() or
+/// its destructor, regardless of which thread allocated it.
 /// TODO: The same approach might be implemented for ThreadPool.
 
 template <typename AllocatorTy>
@@ -28,9 +35,20 @@ class PerThreadAllocator
     : public AllocatorBase<PerThreadAllocator<AllocatorTy>> {
 public:
   PerThreadAllocator()
-      : NumOfAllocators(parallel::getThreadCount()),
+      : NumOfAllocators(parallel::getThreadCount() + 1),
         Allocators(std::make_unique<AllocatorTy[]>(NumOfAllocators)) {}
 
+  // The mutex is not movable, so the moves are spelled out.
+  PerThreadAllocator(PerThreadAllocator &&Other)
+      : NumOfAllocators(Other.NumOfAllocators),
+        Allocators(std::move(Other.Allocators)) {}
+
+  PerThreadAllocator &operator=(PerThreadAllocator &&Other) {
+    NumOfAllocators = Other.NumOfAllocators;
+    Allocators = std::move(Other.Allocators);
+    return *this;
+  }
+
   /// \defgroup Methods which could be called asynchronously:
   ///
   /// @{
@@ -41,20 +59,27 @@ public:
 
   /// Allocate \a Size bytes of \a Alignment aligned memory.
   void *Allocate(size_t Size, size_t Alignment) {
-    assert(getThreadIndex() < NumOfAllocators);
-    return Allocators[getThreadIndex()].Allocate(Size, Alignment);
+    if (LLVM_UNLIKELY(isSharedAllocatorThread())) {
+      std::lock_guard<std::mutex> Lock(SharedAllocatorMutex);
+      return getSharedAllocator().Allocate(Size, Alignment);
+    }
+    return getThreadLocalAllocator().Allocate(Size, Alignment);
   }
 
   /// Deallocate \a Ptr to \a Size bytes of memory allocated by this
   /// allocator.
   void Deallocate(const void *Ptr, size_t Size, size_t Alignment) {
-    assert(getThreadIndex() < NumOfAllocators);
-    return Allocators[getThreadIndex()].Deallocate(Ptr, Size, Alignment);
+    if (LLVM_UNLIKELY(isSharedAllocatorThread())) {
+      std::lock_guard<std::mutex> Lock(SharedAllocatorMutex);
+      return getSharedAllocator().Deallocate(Ptr, Size, Alignment);
+    }
+    return getThreadLocalAllocator().Deallocate(Ptr, Size, Alignment);
   }
 
-  /// Return allocator corresponding to the current thread.
+  /// Return allocator corresponding to the current thread. Must be called from
+  /// a thread created by ThreadPoolExecutor.
   AllocatorTy &getThreadLocalAllocator() {
-    assert(getThreadIndex() < NumOfAllocators);
+    assert(getThreadIndex() < NumOfAllocators - 1);
     return Allocators[getThreadIndex()];
   }
 
@@ -108,8 +133,17 @@ public:
   /// @}
 
 protected:
+  /// Return true if the current thread was not created by ThreadPoolExecutor.
+  bool isSharedAllocatorThread() const {
+    return getThreadIndexOrMax() >= NumOfAllocators - 1;
+  }
+
+  /// Return the allocator shared by threads not owned by ThreadPoolExecutor.
+  AllocatorTy &getSharedAllocator() { return Allocators[NumOfAllocators - 1]; }
+
   size_t NumOfAllocators;
   std::unique_ptr<AllocatorTy[]> Allocators;
+  std::mutex SharedAllocatorMutex;
 };
 
 using PerThreadBumpPtrAllocator = PerThreadAllocator<BumpPtrAllocator>;
@@ -16,6 +16,7 @@
 
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/Support/Chrono.h"
@@ -28,6 +29,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stack>
 #include <string>
@@ -458,6 +460,48 @@ private:
   virtual void anchor();
 };
 
+/// A file system that caches the results of \c status() calls, including
+/// failed lookups, of an underlying file system.
+///
+/// This is useful when the underlying file system is slow to query, e.g. a
+/// network file system, and the same paths are looked up many times, as header
+/// search does. Paths are cached by their absolute path. Files opened for read
+/// are not cached, but opening a path that is known not to exist fails without
+/// querying the underlying file system. The cache assumes that the underlying
+/// file system doesn't change; call \c invalidate() if it may have.
+///
+/// It is safe to use from several threads at the same time provided the
+/// underlying file system is.
+class CachingFileSystem : public ProxyFileSystem {
+public:
+  explicit CachingFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
+      : ProxyFileSystem(std::move(FS)) {}
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+  llvm::ErrorOr<std::unique_ptr<File>>
+  openFileForRead(const Twine &Path) override;
+
+  /// Forget all cached entries.
+  void invalidate();
+
+  /// \returns the number of \c status() calls answered from the cache.
+  unsigned getNumCacheHits() const;
+
+protected:
+  void printImpl(raw_ostream &OS, PrintType Type,
+                 unsigned IndentLevel) const override;
+
+private:
+  /// \returns the cached result for \p AbsPath, if any.
+  std::optional<llvm::ErrorOr<Status>> lookup(StringRef AbsPath);
+
+  mutable std::mutex CacheLock;
+  llvm::StringMap<llvm::ErrorOr<Status>> StatusCache;
+  unsigned NumCacheHits = 0;
+
+  void anchor() override;
+};
+
 namespace detail {
 
 class InMemoryDirectory;
@@ -44,6 +44,13 @@
 namespace llvm {
 uint64_t xxHash64(llvm::StringRef Data);
 uint64_t xxHash64(llvm::ArrayRef<uint8_t> Data);
+
+/// XXH3 64-bit with the default secret and a zero seed. This is considerably
+/// faster than xxHash64 on long inputs and on very short ones.
+uint64_t xxh3_64bits(ArrayRef<uint8_t> data);
+inline uint64_t xxh3_64bits(StringRef data) {
+  return xxh3_64bits(ArrayRef(data.bytes_begin(), data.size()));
+}
 }
 
 #endif
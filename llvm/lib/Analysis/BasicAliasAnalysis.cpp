@@ -47,6 +47,7 @@
 #include "llvm/IR/Type.h"
 #include "llvm/IR/User.h"
 #include "llvm/IR/Value.h"
+#include "llvm/IR/ValueHandle.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Pass.h"
 #include "llvm/Support/Casting.h"
@@ -692,6 +693,39 @@ BasicAAResult::DecomposeGEPExpression(const Value *V, const DataLayout &DL,
   return Decomposed;
 }
 
+/// The decompositions computed by BasicAA during a batch of queries.
+class llvm::BasicAADecompositionCache {
+public:
+  struct Entry {
+    /// Becomes null when the value is deleted, so that the decomposition is
+    /// not used for a new value that is allocated at the same address.
+    WeakVH Handle;
+    BasicAAResult::DecomposedGEP Decomposed;
+  };
+  SmallDenseMap<const Value *, Entry, 4> Map;
+};
+
+void AAQueryInfo::BasicAADecompositionCacheDeleter::operator()(
+    BasicAADecompositionCache *Cache) const {
+  delete Cache;
+}
+
+BasicAAResult::DecomposedGEP
+BasicAAResult::getDecomposedGEP(const Value *V, const DataLayout &DL,
+                                AAQueryInfo &AAQI) {
+  if (!AAQI.IsBatch)
+    return DecomposeGEPExpression(V, DL, &AC, DT);
+  if (!AAQI.BasicAADecompositions)
+    AAQI.BasicAADecompositions.reset(new BasicAADecompositionCache());
+  auto &Cache = AAQI.BasicAADecompositions->Map;
+  auto It = Cache.find(V);
+  if (It != Cache.end() && It->second.Handle == V)
+    return It->second.Decomposed;
+  DecomposedGEP Decomposed = DecomposeGEPExpression(V, DL, &AC, DT);
+  Cache[V] = {WeakVH(const_cast<Value *>(V)), Decomposed};
+  return Decomposed;
+}
+
 ModRefInfo BasicAAResult::getModRefInfoMask(const MemoryLocation &Loc,
                                             AAQueryInfo &AAQI,
                                             bool IgnoreLocals) {
@@ -1042,8 +1076,8 @@ AliasResult BasicAAResult::aliasGEP(
                                              : AliasResult::MayAlias;
   }
 
-  DecomposedGEP DecompGEP1 = DecomposeGEPExpression(GEP1, DL, &AC, DT);
-  DecomposedGEP DecompGEP2 = DecomposeGEPExpression(V2, DL, &AC, DT);
+  DecomposedGEP DecompGEP1 = getDecomposedGEP(GEP1, DL, AAQI);
+  DecomposedGEP DecompGEP2 = getDecomposedGEP(V2, DL, AAQI);
 
   // Bail if we were not able to decompose anything.
   if (DecompGEP1.Base == GEP1 && DecompGEP2.Base == V2)
@@ -14,6 +14,7 @@
 #include "llvm/ADT/APInt.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Instruction.h"
@@ -490,319 +491,405 @@ lltok::Kind LLLexer::LexIdentifier() {
   --StartChar;
   StringRef Keyword(StartChar, CurPtr - StartChar);
 
+  // Keywords and instruction names are looked up in a table that is built once;
+  // comparing against each of them in turn dominated lexing time. Earlier
+  // entries take precedence over later ones with the same spelling.
+  struct KeywordInfo {
+    lltok::Kind Kind;
+    /// The opcode for instruction keywords, zero otherwise.
+    unsigned Opcode;
+  };
+  static const StringMap<KeywordInfo> Keywords = [] {
+    StringMap<KeywordInfo> Table;
 #define KEYWORD(STR)                                                           \
   do {                                                                         \
-    if (Keyword == #STR)                                                       \
-      return lltok::kw_##STR;                                                  \
+    Table.try_emplace(#STR, KeywordInfo{lltok::kw_##STR, 0});                  \
   } while (false)
 
-  KEYWORD(true);    KEYWORD(false);
-  KEYWORD(declare); KEYWORD(define);
-  KEYWORD(global);  KEYWORD(constant);
-
-  KEYWORD(dso_local);
-  KEYWORD(dso_preemptable);
-
-  KEYWORD(private);
-  KEYWORD(internal);
-  KEYWORD(available_externally);
-  KEYWORD(linkonce);
-  KEYWORD(linkonce_odr);
-  KEYWORD(weak); // Use as a linkage, and a modifier for "cmpxchg".
-  KEYWORD(weak_odr);
-  KEYWORD(appending);
-  KEYWORD(dllimport);
-  KEYWORD(dllexport);
-  KEYWORD(common);
-  KEYWORD(default);
-  KEYWORD(hidden);
-  KEYWORD(protected);
-  KEYWORD(unnamed_addr);
-  KEYWORD(local_unnamed_addr);
-  KEYWORD(externally_initialized);
-  KEYWORD(extern_weak);
-  KEYWORD(external);
-  KEYWORD(thread_local);
-  KEYWORD(localdynamic);
-  KEYWORD(initialexec);
-  KEYWORD(localexec);
-  KEYWORD(zeroinitializer);
-  KEYWORD(undef);
-  KEYWORD(null);
-  KEYWORD(none);
-  KEYWORD(poison);
-  KEYWORD(to);
-  KEYWORD(caller);
-  KEYWORD(within);
-  KEYWORD(from);
-  KEYWORD(tail);
-  KEYWORD(musttail);
-  KEYWORD(notail);
-  KEYWORD(target);
-  KEYWORD(triple);
-  KEYWORD(source_filename);
-  KEYWORD(unwind);
-  KEYWORD(datalayout);
-  KEYWORD(volatile);
-  KEYWORD(atomic);
-  KEYWORD(unordered);
-  KEYWORD(monotonic);
-  KEYWORD(acquire);
-  KEYWORD(release);
-  KEYWORD(acq_rel);
-  KEYWORD(seq_cst);
-  KEYWORD(syncscope);
-
-  KEYWORD(nnan);
-  KEYWORD(ninf);
-  KEYWORD(nsz);
-  KEYWORD(arcp);
-  KEYWORD(contract);
-  KEYWORD(reassoc);
-  KEYWORD(afn);
-  KEYWORD(fast);
-  KEYWORD(nuw);
-  KEYWORD(nsw);
-  KEYWORD(exact);
-  KEYWORD(inbounds);
-  KEYWORD(inrange);
-  KEYWORD(addrspace);
-  KEYWORD(section);
-  KEYWORD(partition);
-  KEYWORD(alias);
-  KEYWORD(ifunc);
-  KEYWORD(module);
-  KEYWORD(asm);
-  KEYWORD(sideeffect);
-  KEYWORD(inteldialect);
-  KEYWORD(gc);
-  KEYWORD(prefix);
-  KEYWORD(prologue);
-
-  KEYWORD(no_sanitize_address);
-  KEYWORD(no_sanitize_hwaddress);
-  KEYWORD(sanitize_address_dyninit);
-
-  KEYWORD(ccc);
-  KEYWORD(fastcc);
-  KEYWORD(coldcc);
-  KEYWORD(cfguard_checkcc);
-  KEYWORD(x86_stdcallcc);
-  KEYWORD(x86_fastcallcc);
-  KEYWORD(x86_thiscallcc);
-  KEYWORD(x86_vectorcallcc);
-  KEYWORD(arm_apcscc);
-  KEYWORD(arm_aapcscc);
-  KEYWORD(arm_aapcs_vfpcc);
-  KEYWORD(aarch64_vector_pcs);
-  KEYWORD(aarch64_sve_vector_pcs);
-  KEYWORD(aarch64_sme_preservemost_from_x0);
-  KEYWORD(aarch64_sme_preservemost_from_x2);
-  KEYWORD(msp430_intrcc);
-  KEYWORD(avr_intrcc);
-  KEYWORD(avr_signalcc);
-  KEYWORD(ptx_kernel);
-  KEYWORD(ptx_device);
-  KEYWORD(spir_kernel);
-  KEYWORD(spir_func);
-  KEYWORD(intel_ocl_bicc);
-  KEYWORD(x86_64_sysvcc);
-  KEYWORD(win64cc);
-  KEYWORD(x86_regcallcc);
-  KEYWORD(webkit_jscc);
-  KEYWORD(swiftcc);
-  KEYWORD(swifttailcc);
-  KEYWORD(anyregcc);
-  KEYWORD(preserve_mostcc);
-  KEYWORD(preserve_allcc);
-  KEYWORD(ghccc);
-  KEYWORD(x86_intrcc);
-  KEYWORD(hhvmcc);
-  KEYWORD(hhvm_ccc);
-  KEYWORD(cxx_fast_tlscc);
-  KEYWORD(amdgpu_vs);
-  KEYWORD(amdgpu_ls);
-  KEYWORD(amdgpu_hs);
-  KEYWORD(amdgpu_es);
-  KEYWORD(amdgpu_gs);
-  KEYWORD(amdgpu_ps);
-  KEYWORD(amdgpu_cs);
-  KEYWORD(amdgpu_cs_chain);
-  KEYWORD(amdgpu_cs_chain_preserve);
-  KEYWORD(amdgpu_kernel);
-  KEYWORD(amdgpu_gfx);
-  KEYWORD(tailcc);
-
-  KEYWORD(cc);
-  KEYWORD(c);
-
-  KEYWORD(attributes);
-  KEYWORD(sync);
-  KEYWORD(async);
+    KEYWORD(true);    KEYWORD(false);
+    KEYWORD(declare); KEYWORD(define);
+    KEYWORD(global);  KEYWORD(constant);
+
+    KEYWORD(dso_local);
+    KEYWORD(dso_preemptable);
+
+    KEYWORD(private);
+    KEYWORD(internal);
+    KEYWORD(available_externally);
+    KEYWORD(linkonce);
+    KEYWORD(linkonce_odr);
+    KEYWORD(weak); // Use as a linkage, and a modifier for "cmpxchg".
+    KEYWORD(weak_odr);
+    KEYWORD(appending);
+    KEYWORD(dllimport);
+    KEYWORD(dllexport);
+    KEYWORD(common);
+    KEYWORD(default);
+    KEYWORD(hidden);
+    KEYWORD(protected);
+    KEYWORD(unnamed_addr);
+    KEYWORD(local_unnamed_addr);
+    KEYWORD(externally_initialized);
+    KEYWORD(extern_weak);
+    KEYWORD(external);
+    KEYWORD(thread_local);
+    KEYWORD(localdynamic);
+    KEYWORD(initialexec);
+    KEYWORD(localexec);
+    KEYWORD(zeroinitializer);
+    KEYWORD(undef);
+    KEYWORD(null);
+    KEYWORD(none);
+    KEYWORD(poison);
+    KEYWORD(to);
+    KEYWORD(caller);
+    KEYWORD(within);
+    KEYWORD(from);
+    KEYWORD(tail);
+    KEYWORD(musttail);
+    KEYWORD(notail);
+    KEYWORD(target);
+    KEYWORD(triple);
+    KEYWORD(source_filename);
+    KEYWORD(unwind);
+    KEYWORD(datalayout);
+    KEYWORD(volatile);
+    KEYWORD(atomic);
+    KEYWORD(unordered);
+    KEYWORD(monotonic);
+    KEYWORD(acquire);
+    KEYWORD(release);
+    KEYWORD(acq_rel);
+    KEYWORD(seq_cst);
+    KEYWORD(syncscope);
+
+    KEYWORD(nnan);
+    KEYWORD(ninf);
+    KEYWORD(nsz);
+    KEYWORD(arcp);
+    KEYWORD(contract);
+    KEYWORD(reassoc);
+    KEYWORD(afn);
+    KEYWORD(fast);
+    KEYWORD(nuw);
+    KEYWORD(nsw);
+    KEYWORD(exact);
+    KEYWORD(inbounds);
+    KEYWORD(inrange);
+    KEYWORD(addrspace);
+    KEYWORD(section);
+    KEYWORD(partition);
+    KEYWORD(alias);
+    KEYWORD(ifunc);
+    KEYWORD(module);
+    KEYWORD(asm);
+    KEYWORD(sideeffect);
+    KEYWORD(inteldialect);
+    KEYWORD(gc);
+    KEYWORD(prefix);
+    KEYWORD(prologue);
+
+    KEYWORD(no_sanitize_address);
+    KEYWORD(no_sanitize_hwaddress);
+    KEYWORD(sanitize_address_dyninit);
+
+    KEYWORD(ccc);
+    KEYWORD(fastcc);
+    KEYWORD(coldcc);
+    KEYWORD(cfguard_checkcc);
+    KEYWORD(x86_stdcallcc);
+    KEYWORD(x86_fastcallcc);
+    KEYWORD(x86_thiscallcc);
+    KEYWORD(x86_vectorcallcc);
+    KEYWORD(arm_apcscc);
+    KEYWORD(arm_aapcscc);
+    KEYWORD(arm_aapcs_vfpcc);
+    KEYWORD(aarch64_vector_pcs);
+    KEYWORD(aarch64_sve_vector_pcs);
+    KEYWORD(aarch64_sme_preservemost_from_x0);
+    KEYWORD(aarch64_sme_preservemost_from_x2);
+    KEYWORD(msp430_intrcc);
+    KEYWORD(avr_intrcc);
+    KEYWORD(avr_signalcc);
+    KEYWORD(ptx_kernel);
+    KEYWORD(ptx_device);
+    KEYWORD(spir_kernel);
+    KEYWORD(spir_func);
+    KEYWORD(intel_ocl_bicc);
+    KEYWORD(x86_64_sysvcc);
+    KEYWORD(win64cc);
+    KEYWORD(x86_regcallcc);
+    KEYWORD(webkit_jscc);
+    KEYWORD(swiftcc);
+    KEYWORD(swifttailcc);
+    KEYWORD(anyregcc);
+    KEYWORD(preserve_mostcc);
+    KEYWORD(preserve_allcc);
+    KEYWORD(ghccc);
+    KEYWORD(x86_intrcc);
+    KEYWORD(hhvmcc);
+    KEYWORD(hhvm_ccc);
+    KEYWORD(cxx_fast_tlscc);
+    KEYWORD(amdgpu_vs);
+    KEYWORD(amdgpu_ls);
+    KEYWORD(amdgpu_hs);
+    KEYWORD(amdgpu_es);
+    KEYWORD(amdgpu_gs);
+    KEYWORD(amdgpu_ps);
+    KEYWORD(amdgpu_cs);
+    KEYWORD(amdgpu_cs_chain);
+    KEYWORD(amdgpu_cs_chain_preserve);
+    KEYWORD(amdgpu_kernel);
+    KEYWORD(amdgpu_gfx);
+    KEYWORD(tailcc);
+
+    KEYWORD(cc);
+    KEYWORD(c);
+
+    KEYWORD(attributes);
+    KEYWORD(sync);
+    KEYWORD(async);
 
 #define GET_ATTR_NAMES
 #define ATTRIBUTE_ENUM(ENUM_NAME, DISPLAY_NAME) \
-  KEYWORD(DISPLAY_NAME);
+    KEYWORD(DISPLAY_NAME);
 #include "llvm/IR/Attributes.inc"
 
-  KEYWORD(read);
-  KEYWORD(write);
-  KEYWORD(readwrite);
-  KEYWORD(argmem);
-  KEYWORD(inaccessiblemem);
-  KEYWORD(argmemonly);
-  KEYWORD(inaccessiblememonly);
-  KEYWORD(inaccessiblemem_or_argmemonly);
-
-  // nofpclass attribute
-  KEYWORD(all);
-  KEYWORD(nan);
-  KEYWORD(snan);
-  KEYWORD(qnan);
-  KEYWORD(inf);
-  // ninf already a keyword
-  KEYWORD(pinf);
-  KEYWORD(norm);
-  KEYWORD(nnorm);
-  KEYWORD(pnorm);
-  // sub already a keyword
-  KEYWORD(nsub);
-  KEYWORD(psub);
-  KEYWORD(zero);
-  KEYWORD(nzero);
-  KEYWORD(pzero);
-
-  KEYWORD(type);
-  KEYWORD(opaque);
-
-  KEYWORD(comdat);
-
-  // Comdat types
-  KEYWORD(any);
-  KEYWORD(exactmatch);
-  KEYWORD(largest);
-  KEYWORD(nodeduplicate);
-  KEYWORD(samesize);
-
-  KEYWORD(eq); KEYWORD(ne); KEYWORD(slt); KEYWORD(sgt); KEYWORD(sle);
-  KEYWORD(sge); KEYWORD(ult); KEYWORD(ugt); KEYWORD(ule); KEYWORD(uge);
-  KEYWORD(oeq); KEYWORD(one); KEYWORD(olt); KEYWORD(ogt); KEYWORD(ole);
-  KEYWORD(oge); KEYWORD(ord); KEYWORD(uno); KEYWORD(ueq); KEYWORD(une);
-
-  KEYWORD(xchg); KEYWORD(nand); KEYWORD(max); KEYWORD(min); KEYWORD(umax);
-  KEYWORD(umin); KEYWORD(fmax); KEYWORD(fmin);
-  KEYWORD(uinc_wrap);
-  KEYWORD(udec_wrap);
-
-  KEYWORD(vscale);
-  KEYWORD(x);
-  KEYWORD(blockaddress);
-  KEYWORD(dso_local_equivalent);
-  KEYWORD(no_cfi);
-
-  // Metadata types.
-  KEYWORD(distinct);
-
-  // Use-list order directives.
-  KEYWORD(uselistorder);
-  KEYWORD(uselistorder_bb);
-
-  KEYWORD(personality);
-  KEYWORD(cleanup);
-  KEYWORD(catch);
-  KEYWORD(filter);
-
-  // Summary index keywords.
-  KEYWORD(path);
-  KEYWORD(hash);
-  KEYWORD(gv);
-  KEYWORD(guid);
-  KEYWORD(name);
-  KEYWORD(summaries);
-  KEYWORD(flags);
-  KEYWORD(blockcount);
-  KEYWORD(linkage);
-  KEYWORD(visibility);
-  KEYWORD(notEligibleToImport);
-  KEYWORD(live);
-  KEYWORD(dsoLocal);
-  KEYWORD(canAutoHide);
-  KEYWORD(function);
-  KEYWORD(insts);
-  KEYWORD(funcFlags);
-  KEYWORD(readNone);
-  KEYWORD(readOnly);
-  KEYWORD(noRecurse);
-  KEYWORD(returnDoesNotAlias);
-  KEYWORD(noInline);
-  KEYWORD(alwaysInline);
-  KEYWORD(noUnwind);
-  KEYWORD(mayThrow);
-  KEYWORD(hasUnknownCall);
-  KEYWORD(mustBeUnreachable);
-  KEYWORD(calls);
-  KEYWORD(callee);
-  KEYWORD(params);
-  KEYWORD(param);
-  KEYWORD(hotness);
-  KEYWORD(unknown);
-  KEYWORD(critical);
-  KEYWORD(relbf);
-  KEYWORD(variable);
-  KEYWORD(vTableFuncs);
-  KEYWORD(virtFunc);
-  KEYWORD(aliasee);
-  KEYWORD(refs);
-  KEYWORD(typeIdInfo);
-  KEYWORD(typeTests);
-  KEYWORD(typeTestAssumeVCalls);
-  KEYWORD(typeCheckedLoadVCalls);
-  KEYWORD(typeTestAssumeConstVCalls);
-  KEYWORD(typeCheckedLoadConstVCalls);
-  KEYWORD(vFuncId);
-  KEYWORD(offset);
-  KEYWORD(args);
-  KEYWORD(typeid);
-  KEYWORD(typeidCompatibleVTable);
-  KEYWORD(summary);
-  KEYWORD(typeTestRes);
-  KEYWORD(kind);
-  KEYWORD(unsat);
-  KEYWORD(byteArray);
-  KEYWORD(inline);
-  KEYWORD(single);
-  KEYWORD(allOnes);
-  KEYWORD(sizeM1BitWidth);
-  KEYWORD(alignLog2);
-  KEYWORD(sizeM1);
-  KEYWORD(bitMask);
-  KEYWORD(inlineBits);
-  KEYWORD(vcall_visibility);
-  KEYWORD(wpdResolutions);
-  KEYWORD(wpdRes);
-  KEYWORD(indir);
-  KEYWORD(singleImpl);
-  KEYWORD(branchFunnel);
-  KEYWORD(singleImplName);
-  KEYWORD(resByArg);
-  KEYWORD(byArg);
-  KEYWORD(uniformRetVal);
-  KEYWORD(uniqueRetVal);
-  KEYWORD(virtualConstProp);
-  KEYWORD(info);
-  KEYWORD(byte);
-  KEYWORD(bit);
-  KEYWORD(varFlags);
-  KEYWORD(callsites);
-  KEYWORD(clones);
-  KEYWORD(stackIds);
-  KEYWORD(allocs);
-  KEYWORD(versions);
-  KEYWORD(memProf);
-  KEYWORD(notcold);
+    KEYWORD(read);
+    KEYWORD(write);
+    KEYWORD(readwrite);
+    KEYWORD(argmem);
+    KEYWORD(inaccessiblemem);
+    KEYWORD(argmemonly);
+    KEYWORD(inaccessiblememonly);
+    KEYWORD(inaccessiblemem_or_argmemonly);
+
+    // nofpclass attribute
+    KEYWORD(all);
+    KEYWORD(nan);
+    KEYWORD(snan);
+    KEYWORD(qnan);
+    KEYWORD(inf);
+    // ninf already a keyword
+    KEYWORD(pinf);
+    KEYWORD(norm);
+    KEYWORD(nnorm);
+    KEYWORD(pnorm);
+    // sub already a keyword
+    KEYWORD(nsub);
+    KEYWORD(psub);
+    KEYWORD(zero);
+    KEYWORD(nzero);
+    KEYWORD(pzero);
+
+    KEYWORD(type);
+    KEYWORD(opaque);
+
+    KEYWORD(comdat);
+
+    // Comdat types
+    KEYWORD(any);
+    KEYWORD(exactmatch);
+    KEYWORD(largest);
+    KEYWORD(nodeduplicate);
+    KEYWORD(samesize);
+
+    KEYWORD(eq); KEYWORD(ne); KEYWORD(slt); KEYWORD(sgt); KEYWORD(sle);
+    KEYWORD(sge); KEYWORD(ult); KEYWORD(ugt); KEYWORD(ule); KEYWORD(uge);
+    KEYWORD(oeq); KEYWORD(one); KEYWORD(olt); KEYWORD(ogt); KEYWORD(ole);
+    KEYWORD(oge); KEYWORD(ord); KEYWORD(uno); KEYWORD(ueq); KEYWORD(une);
+
+    KEYWORD(xchg); KEYWORD(nand); KEYWORD(max); KEYWORD(min); KEYWORD(umax);
+    KEYWORD(umin); KEYWORD(fmax); KEYWORD(fmin);
+    KEYWORD(uinc_wrap);
+    KEYWORD(udec_wrap);
+
+    KEYWORD(vscale);
+    KEYWORD(x);
+    KEYWORD(blockaddress);
+    KEYWORD(dso_local_equivalent);
+    KEYWORD(no_cfi);
+
+    // Metadata types.
+    KEYWORD(distinct);
+
+    // Use-list order directives.
+    KEYWORD(uselistorder);
+    KEYWORD(uselistorder_bb);
+
+    KEYWORD(personality);
+    KEYWORD(cleanup);
+    KEYWORD(catch);
+    KEYWORD(filter);
+
+    // Summary index keywords.
+    KEYWORD(path);
+    KEYWORD(hash);
+    KEYWORD(gv);
+    KEYWORD(guid);
+    KEYWORD(name);
+    KEYWORD(summaries);
+    KEYWORD(flags);
+    KEYWORD(blockcount);
+    KEYWORD(linkage);
+    KEYWORD(visibility);
+    KEYWORD(notEligibleToImport);
+    KEYWORD(live);
+    KEYWORD(dsoLocal);
+    KEYWORD(canAutoHide);
+    KEYWORD(function);
+    KEYWORD(insts);
+    KEYWORD(funcFlags);
+    KEYWORD(readNone);
+    KEYWORD(readOnly);
+    KEYWORD(noRecurse);
+    KEYWORD(returnDoesNotAlias);
+    KEYWORD(noInline);
+    KEYWORD(alwaysInline);
+    KEYWORD(noUnwind);
+    KEYWORD(mayThrow);
+    KEYWORD(hasUnknownCall);
+    KEYWORD(mustBeUnreachable);
+    KEYWORD(calls);
+    KEYWORD(callee);
+    KEYWORD(params);
+    KEYWORD(param);
+    KEYWORD(hotness);
+    KEYWORD(unknown);
+    KEYWORD(critical);
+    KEYWORD(relbf);
+    KEYWORD(variable);
+    KEYWORD(vTableFuncs);
+    KEYWORD(virtFunc);
+    KEYWORD(aliasee);
+    KEYWORD(refs);
+    KEYWORD(typeIdInfo);
+    KEYWORD(typeTests);
+    KEYWORD(typeTestAssumeVCalls);
+    KEYWORD(typeCheckedLoadVCalls);
+    KEYWORD(typeTestAssumeConstVCalls);
+    KEYWORD(typeCheckedLoadConstVCalls);
+    KEYWORD(vFuncId);
+    KEYWORD(offset);
+    KEYWORD(args);
+    KEYWORD(typeid);
+    KEYWORD(typeidCompatibleVTable);
+    KEYWORD(summary);
+    KEYWORD(typeTestRes);
+    KEYWORD(kind);
+    KEYWORD(unsat);
+    KEYWORD(byteArray);
+    KEYWORD(inline);
+    KEYWORD(single);
+    KEYWORD(allOnes);
+    KEYWORD(sizeM1BitWidth);
+    KEYWORD(alignLog2);
+    KEYWORD(sizeM1);
+    KEYWORD(bitMask);
+    KEYWORD(inlineBits);
+    KEYWORD(vcall_visibility);
+    KEYWORD(wpdResolutions);
+    KEYWORD(wpdRes);
+    KEYWORD(indir);
+    KEYWORD(singleImpl);
+    KEYWORD(branchFunnel);
+    KEYWORD(singleImplName);
+    KEYWORD(resByArg);
+    KEYWORD(byArg);
+    KEYWORD(uniformRetVal);
+    KEYWORD(uniqueRetVal);
+    KEYWORD(virtualConstProp);
+    KEYWORD(info);
+    KEYWORD(byte);
+    KEYWORD(bit);
+    KEYWORD(varFlags);
+    KEYWORD(callsites);
+    KEYWORD(clones);
+    KEYWORD(stackIds);
+    KEYWORD(allocs);
+    KEYWORD(versions);
+    KEYWORD(memProf);
+    KEYWORD(notcold);
 
 #undef KEYWORD
 
+    // Keywords for instructions.
+#define INSTKEYWORD(STR, Enum)                                                 \
+  do {                                                                         \
+    Table.try_emplace(#STR, KeywordInfo{lltok::kw_##STR, Instruction::Enum});  \
+  } while (false)
+
+    INSTKEYWORD(fneg,  FNeg);
+
+    INSTKEYWORD(add,   Add);  INSTKEYWORD(fadd,   FAdd);
+    INSTKEYWORD(sub,   Sub);  INSTKEYWORD(fsub,   FSub);
+    INSTKEYWORD(mul,   Mul);  INSTKEYWORD(fmul,   FMul);
+    INSTKEYWORD(udiv,  UDiv); INSTKEYWORD(sdiv,  SDiv); INSTKEYWORD(fdiv,  FDiv);
+    INSTKEYWORD(urem,  URem); INSTKEYWORD(srem,  SRem); INSTKEYWORD(frem,  FRem);
+    INSTKEYWORD(shl,   Shl);  INSTKEYWORD(lshr,  LShr); INSTKEYWORD(ashr,  AShr);
+    INSTKEYWORD(and,   And);  INSTKEYWORD(or,    Or);   INSTKEYWORD(xor,   Xor);
+    INSTKEYWORD(icmp,  ICmp); INSTKEYWORD(fcmp,  FCmp);
+
+    INSTKEYWORD(phi,         PHI);
+    INSTKEYWORD(call,        Call);
+    INSTKEYWORD(trunc,       Trunc);
+    INSTKEYWORD(zext,        ZExt);
+    INSTKEYWORD(sext,        SExt);
+    INSTKEYWORD(fptrunc,     FPTrunc);
+    INSTKEYWORD(fpext,       FPExt);
+    INSTKEYWORD(uitofp,      UIToFP);
+    INSTKEYWORD(sitofp,      SIToFP);
+    INSTKEYWORD(fptoui,      FPToUI);
+    INSTKEYWORD(fptosi,      FPToSI);
+    INSTKEYWORD(inttoptr,    IntToPtr);
+    INSTKEYWORD(ptrtoint,    PtrToInt);
+    INSTKEYWORD(bitcast,     BitCast);
+    INSTKEYWORD(addrspacecast, AddrSpaceCast);
+    INSTKEYWORD(select,      Select);
+    INSTKEYWORD(va_arg,      VAArg);
+    INSTKEYWORD(ret,         Ret);
+    INSTKEYWORD(br,          Br);
+    INSTKEYWORD(switch,      Switch);
+    INSTKEYWORD(indirectbr,  IndirectBr);
+    INSTKEYWORD(invoke,      Invoke);
+    INSTKEYWORD(resume,      Resume);
+    INSTKEYWORD(unreachable, Unreachable);
+    INSTKEYWORD(callbr,      CallBr);
+
+    INSTKEYWORD(alloca,      Alloca);
+    INSTKEYWORD(load,        Load);
+    INSTKEYWORD(store,       Store);
+    INSTKEYWORD(cmpxchg,     AtomicCmpXchg);
+    INSTKEYWORD(atomicrmw,   AtomicRMW);
+    INSTKEYWORD(fence,       Fence);
+    INSTKEYWORD(getelementptr, GetElementPtr);
+
+    INSTKEYWORD(extractelement, ExtractElement);
+    INSTKEYWORD(insertelement,  InsertElement);
+    INSTKEYWORD(shufflevector,  ShuffleVector);
+    INSTKEYWORD(extractvalue,   ExtractValue);
+    INSTKEYWORD(insertvalue,    InsertValue);
+    INSTKEYWORD(landingpad,     LandingPad);
+    INSTKEYWORD(cleanupret,     CleanupRet);
+    INSTKEYWORD(catchret,       CatchRet);
+    INSTKEYWORD(catchswitch,  CatchSwitch);
+    INSTKEYWORD(catchpad,     CatchPad);
+    INSTKEYWORD(cleanuppad,   CleanupPad);
+
+    INSTKEYWORD(freeze,       Freeze);
+
+#undef INSTKEYWORD
+
+    return Table;
+  }();
+
+  auto KW = Keywords.find(Keyword);
+  if (KW != Keywords.end()) {
+    if (KW->second.Opcode)
+      UIntVal = KW->second.Opcode;
+    return KW->second.Kind;
+  }
+
   // Keywords for types.
 #define TYPEKEYWORD(STR, LLVMTY)                                               \
   do {                                                                         \
@@ -837,76 +924,6 @@ lltok::Kind LLLexer::LexIdentifier() {
 
 #undef TYPEKEYWORD
 
-  // Keywords for instructions.
-#define INSTKEYWORD(STR, Enum)                                                 \
-  do {                                                                         \
-    if (Keyword == #STR) {                                                     \
-      UIntVal = Instruction::Enum;                                             \
-      return lltok::kw_##STR;                                                  \
-    }                                                                          \
-  } while (false)
-
-  INSTKEYWORD(fneg,  FNeg);
-
-  INSTKEYWORD(add,   Add);  INSTKEYWORD(fadd,   FAdd);
-  INSTKEYWORD(sub,   Sub);  INSTKEYWORD(fsub,   FSub);
-  INSTKEYWORD(mul,   Mul);  INSTKEYWORD(fmul,   FMul);
-  INSTKEYWORD(udiv,  UDiv); INSTKEYWORD(sdiv,  SDiv); INSTKEYWORD(fdiv,  FDiv);
-  INSTKEYWORD(urem,  URem); INSTKEYWORD(srem,  SRem); INSTKEYWORD(frem,  FRem);
-  INSTKEYWORD(shl,   Shl);  INSTKEYWORD(lshr,  LShr); INSTKEYWORD(ashr,  AShr);
-  INSTKEYWORD(and,   And);  INSTKEYWORD(or,    Or);   INSTKEYWORD(xor,   Xor);
-  INSTKEYWORD(icmp,  ICmp); INSTKEYWORD(fcmp,  FCmp);
-
-  INSTKEYWORD(phi,         PHI);
-  INSTKEYWORD(call,        Call);
-  INSTKEYWORD(trunc,       Trunc);
-  INSTKEYWORD(zext,        ZExt);
-  INSTKEYWORD(sext,        SExt);
-  INSTKEYWORD(fptrunc,     FPTrunc);
-  INSTKEYWORD(fpext,       FPExt);
-  INSTKEYWORD(uitofp,      UIToFP);
-  INSTKEYWORD(sitofp,      SIToFP);
-  INSTKEYWORD(fptoui,      FPToUI);
-  INSTKEYWORD(fptosi,      FPToSI);
-  INSTKEYWORD(inttoptr,    IntToPtr);
-  INSTKEYWORD(ptrtoint,    PtrToInt);
-  INSTKEYWORD(bitcast,     BitCast);
-  INSTKEYWORD(addrspacecast, AddrSpaceCast);
-  INSTKEYWORD(select,      Select);
-  INSTKEYWORD(va_arg,      VAArg);
-  INSTKEYWORD(ret,         Ret);
-  INSTKEYWORD(br,          Br);
-  INSTKEYWORD(switch,      Switch);
-  INSTKEYWORD(indirectbr,  IndirectBr);
-  INSTKEYWORD(invoke,      Invoke);
-  INSTKEYWORD(resume,      Resume);
-  INSTKEYWORD(unreachable, Unreachable);
-  INSTKEYWORD(callbr,      CallBr);
-
-  INSTKEYWORD(alloca,      Alloca);
-  INSTKEYWORD(load,        Load);
-  INSTKEYWORD(store,       Store);
-  INSTKEYWORD(cmpxchg,     AtomicCmpXchg);
-  INSTKEYWORD(atomicrmw,   AtomicRMW);
-  INSTKEYWORD(fence,       Fence);
-  INSTKEYWORD(getelementptr, GetElementPtr);
-
-  INSTKEYWORD(extractelement, ExtractElement);
-  INSTKEYWORD(insertelement,  InsertElement);
-  INSTKEYWORD(shufflevector,  ShuffleVector);
-  INSTKEYWORD(extractvalue,   ExtractValue);
-  INSTKEYWORD(insertvalue,    InsertValue);
-  INSTKEYWORD(landingpad,     LandingPad);
-  INSTKEYWORD(cleanupret,     CleanupRet);
-  INSTKEYWORD(catchret,       CatchRet);
-  INSTKEYWORD(catchswitch,  CatchSwitch);
-  INSTKEYWORD(catchpad,     CatchPad);
-  INSTKEYWORD(cleanuppad,   CleanupPad);
-
-  INSTKEYWORD(freeze,       Freeze);
-
-#undef INSTKEYWORD
-
 #define DWKEYWORD(TYPE, TOKEN)                                                 \
   do {                                                                         \
     if (Keyword.startswith("DW_" #TYPE "_")) {                                 \
@@ -118,17 +118,21 @@ bool Combiner::combineMachineInstrs(MachineFunction &MF,
   bool Changed;
   MachineIRBuilder &B = *Builder;
 
+  // The work list and the observers are only set up once, so that the
+  // storage of the work list is reused by every iteration below.
+  GISelWorkList<512> WorkList;
+  WorkListMaintainer Observer(WorkList);
+  GISelObserverWrapper WrapperObserver(&Observer);
+  if (CSEInfo)
+    WrapperObserver.addObserver(CSEInfo);
+  RAIIDelegateInstaller DelInstall(MF, &WrapperObserver);
   do {
     // Collect all instructions. Do a post order traversal for basic blocks and
     // insert with list bottom up, so while we pop_back_val, we'll traverse top
     // down RPOT.
     Changed = false;
-    GISelWorkList<512> WorkList;
-    WorkListMaintainer Observer(WorkList);
-    GISelObserverWrapper WrapperObserver(&Observer);
-    if (CSEInfo)
-      WrapperObserver.addObserver(CSEInfo);
-    RAIIDelegateInstaller DelInstall(MF, &WrapperObserver);
+    // Drop the entries the previous iteration nulled out.
+    WorkList.clear();
     for (MachineBasicBlock *MBB : post_order(&MF)) {
       for (MachineInstr &CurMI :
            llvm::make_early_inc_range(llvm::reverse(*MBB))) {
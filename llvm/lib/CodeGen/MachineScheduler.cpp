@@ -74,6 +74,8 @@ using namespace llvm;
 #define DEBUG_TYPE "machine-scheduler"
 
 STATISTIC(NumClustered, "Number of load/store pairs clustered");
+STATISTIC(NumSplitRegions,
+          "Number of scheduling regions split because they were too large");
 
 namespace llvm {
 
@@ -132,6 +134,14 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+/// Bound the time spent building the DAG of unusually large basic blocks by
+/// splitting their scheduling regions. The instruction at each split point
+/// stays in place, like a scheduling boundary.
+static cl::opt<unsigned> MaxRegionInstrs(
+    "misched-max-region-instrs", cl::Hidden,
+    cl::desc("Split scheduling regions after N instructions (0 = no limit)"),
+    cl::init(10000));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -543,6 +553,12 @@ getSchedRegions(MachineBasicBlock *MBB,
       if (isSchedBoundary(&MI, &*MBB, MF, TII))
         break;
       if (!MI.isDebugOrPseudoInstr()) {
+        // Leave MI out of this region and the next one, which makes it a
+        // boundary between them.
+        if (MaxRegionInstrs && NumRegionInstrs == MaxRegionInstrs) {
+          ++NumSplitRegions;
+          break;
+        }
         // MBB::size() uses instr_iterator to count. Here we need a bundle to
         // count as a single instruction.
         ++NumRegionInstrs;
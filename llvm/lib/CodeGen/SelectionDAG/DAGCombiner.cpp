@@ -165,24 +165,38 @@ namespace {
     /// due to nodes being deleted from the underlying DAG.
     SmallVector<SDNode *, 64> Worklist;
 
-    /// Mapping from an SDNode to its position on the worklist.
+    /// The position of a node on the worklist, and whether it has been
+    /// combined (at least once), are kept in the node itself rather than in
+    /// maps, see SDNode::getCombinerState(). The low bit is set once the node
+    /// has been combined; the other bits hold the position on the worklist
+    /// plus one, or zero if the node is not on the worklist.
     ///
-    /// This is used to find and remove nodes from the worklist (by nulling
-    /// them) when they are deleted from the underlying DAG. It relies on
-    /// stable indices of nodes within the worklist.
-    DenseMap<SDNode *, unsigned> WorklistMap;
+    /// The position is used to find and remove nodes from the worklist (by
+    /// nulling them) when they are deleted from the underlying DAG. It relies
+    /// on stable indices of nodes within the worklist.
+    ///
+    /// Whether a node has been combined is used to allow us to reliably add
+    /// any operands of a DAG node which have not yet been combined to the
+    /// worklist.
+    static int getWorklistIndex(const SDNode *N) {
+      return int(N->getCombinerState() >> 1) - 1;
+    }
+    static void setWorklistIndex(SDNode *N, int Index) {
+      N->setCombinerState(unsigned(Index + 1) << 1 |
+                          (N->getCombinerState() & 1));
+    }
+    static bool wasCombined(const SDNode *N) {
+      return N->getCombinerState() & 1;
+    }
+    static void setCombined(SDNode *N) {
+      N->setCombinerState(N->getCombinerState() | 1);
+    }
 
     /// This records all nodes attempted to be added to the worklist since we
     /// considered a new worklist entry. As we keep do not add duplicate nodes
     /// in the worklist, this is different from the tail of the worklist.
     SmallSetVector<SDNode *, 32> PruningList;
 
-    /// Set of nodes which have been combined (at least once).
-    ///
-    /// This is used to allow us to reliably add any operands of a DAG node
-    /// which have not yet been combined to the worklist.
-    SmallPtrSet<SDNode *, 32> CombinedNodes;
-
     /// Map from candidate StoreNode to the pair of RootNode and count.
     /// The count is used to track how many times we have seen the StoreNode
     /// with the same RootNode bail out in dependence check. If we have seen
@@ -230,10 +244,9 @@ namespace {
       }
 
       if (N) {
-        bool GoodWorklistEntry = WorklistMap.erase(N);
-        (void)GoodWorklistEntry;
-        assert(GoodWorklistEntry &&
-               "Found a worklist entry without a corresponding map entry!");
+        assert(getWorklistIndex(N) == int(Worklist.size()) &&
+               "Found a worklist entry with a wrong position!");
+        setWorklistIndex(N, -1);
       }
       return N;
     }
@@ -277,23 +290,24 @@ namespace {
       if (IsCandidateForPruning)
         ConsiderForPruning(N);
 
-      if (WorklistMap.insert(std::make_pair(N, Worklist.size())).second)
+      if (getWorklistIndex(N) < 0) {
+        setWorklistIndex(N, Worklist.size());
         Worklist.push_back(N);
+      }
     }
 
     /// Remove all instances of N from the worklist.
     void removeFromWorklist(SDNode *N) {
-      CombinedNodes.erase(N);
       PruningList.remove(N);
       StoreRootCountMap.erase(N);
 
-      auto It = WorklistMap.find(N);
-      if (It == WorklistMap.end())
+      int Index = getWorklistIndex(N);
+      N->setCombinerState(0);
+      if (Index < 0)
         return; // Not in the worklist.
 
       // Null out the entry rather than erasing it to avoid a linear operation.
-      Worklist[It->second] = nullptr;
-      WorklistMap.erase(It);
+      Worklist[Index] = nullptr;
     }
 
     void deleteAndRecombine(SDNode *N);
@@ -1781,8 +1795,11 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
   // nodes which can be deleted are those which have no uses and all other nodes
   // which would otherwise be added to the worklist by the first call to
   // getNextWorklistEntry are already present in it.
-  for (SDNode &Node : DAG.allnodes())
+  for (SDNode &Node : DAG.allnodes()) {
+    // Forget the state left behind by an earlier run on the same DAG.
+    Node.setCombinerState(0);
     AddToWorklist(&Node, /* IsCandidateForPruning */ Node.use_empty());
+  }
 
   // Create a dummy node (which is not added to allnodes), that adds a reference
   // to the root node, preventing it from being deleted, and tracking any
@@ -1818,10 +1835,10 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
     // worklist as well. Because the worklist uniques things already, this
     // won't repeatedly process the same operand.
     for (const SDValue &ChildN : N->op_values())
-      if (!CombinedNodes.count(ChildN.getNode()))
+      if (!wasCombined(ChildN.getNode()))
         AddToWorklist(ChildN.getNode());
 
-    CombinedNodes.insert(N);
+    setCombined(N);
     SDValue RV = combine(N);
 
     if (!RV.getNode())
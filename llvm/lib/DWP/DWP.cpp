@@ -20,6 +20,7 @@
 #include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
 
 using namespace llvm;
@@ -513,19 +514,13 @@ Error buildDuplicateError(const std::pair<uint64_t, UnitIndexEntry> &PrevE,
       " and " + buildDWODescription(ID.Name, DWPName, ID.DWOName));
 }
 
-Error handleSection(
-    const StringMap<std::pair<MCSection *, DWARFSectionKind>> &KnownSections,
-    const MCSection *StrSection, const MCSection *StrOffsetSection,
-    const MCSection *TypesSection, const MCSection *CUIndexSection,
-    const MCSection *TUIndexSection, const MCSection *InfoSection,
-    const SectionRef &Section, MCStreamer &Out,
-    std::deque<SmallString<32>> &UncompressedSections,
-    uint32_t (&ContributionOffsets)[8], UnitIndexEntry &CurEntry,
-    StringRef &CurStrSection, StringRef &CurStrOffsetSection,
-    std::vector<StringRef> &CurTypesSection,
-    std::vector<StringRef> &CurInfoSection, StringRef &AbbrevSection,
-    StringRef &CurCUIndexSection, StringRef &CurTUIndexSection,
-    std::vector<std::pair<DWARFSectionKind, uint32_t>> &SectionLength) {
+} // namespace llvm
+
+// Reads the name and contents of \p Section, decompressing the contents if
+// necessary. \p Name is left empty for sections without contents.
+static Error readSection(const SectionRef &Section,
+                         std::deque<SmallString<32>> &UncompressedSections,
+                         StringRef &Name, StringRef &Contents) {
   if (Section.isBSS())
     return Error::success();
 
@@ -535,17 +530,33 @@ Error handleSection(
   Expected<StringRef> NameOrErr = Section.getName();
   if (!NameOrErr)
     return NameOrErr.takeError();
-  StringRef Name = *NameOrErr;
 
   Expected<StringRef> ContentsOrErr = Section.getContents();
   if (!ContentsOrErr)
     return ContentsOrErr.takeError();
-  StringRef Contents = *ContentsOrErr;
+  Contents = *ContentsOrErr;
 
-  if (auto Err = handleCompressedSection(UncompressedSections, Section, Name,
-                                         Contents))
+  if (auto Err = handleCompressedSection(UncompressedSections, Section,
+                                         *NameOrErr, Contents))
     return Err;
+  Name = *NameOrErr;
+  return Error::success();
+}
 
+// Files the contents of a section named \p Name, which has already been
+// decompressed, as part of the current input.
+static Error handleSectionContents(
+    const StringMap<std::pair<MCSection *, DWARFSectionKind>> &KnownSections,
+    const MCSection *StrSection, const MCSection *StrOffsetSection,
+    const MCSection *TypesSection, const MCSection *CUIndexSection,
+    const MCSection *TUIndexSection, const MCSection *InfoSection,
+    StringRef Name, StringRef Contents, MCStreamer &Out,
+    uint32_t (&ContributionOffsets)[8], UnitIndexEntry &CurEntry,
+    StringRef &CurStrSection, StringRef &CurStrOffsetSection,
+    std::vector<StringRef> &CurTypesSection,
+    std::vector<StringRef> &CurInfoSection, StringRef &AbbrevSection,
+    StringRef &CurCUIndexSection, StringRef &CurTUIndexSection,
+    std::vector<std::pair<DWARFSectionKind, uint32_t>> &SectionLength) {
   Name = Name.substr(Name.find_first_not_of("._"));
 
   auto SectionPair = KnownSections.find(Name);
@@ -582,6 +593,66 @@ Error handleSection(
   return Error::success();
 }
 
+namespace {
+// An input file whose sections have been read and, if compressed,
+// decompressed.
+struct LoadedInput {
+  StringRef Path;
+  OwningBinary<object::ObjectFile> Obj;
+  std::deque<SmallString<32>> UncompressedSections;
+  // The name and contents of each section with contents, in section order.
+  SmallVector<std::pair<StringRef, StringRef>, 0> Sections;
+};
+} // namespace
+
+static Error loadInput(LoadedInput &L) {
+  auto ErrOrObj = object::ObjectFile::createObjectFile(L.Path);
+  if (!ErrOrObj) {
+    return handleErrors(ErrOrObj.takeError(),
+                        [&](std::unique_ptr<ECError> EC) -> Error {
+                          return createFileError(L.Path, Error(std::move(EC)));
+                        });
+  }
+  L.Obj = std::move(*ErrOrObj);
+
+  for (const auto &Section : L.Obj.getBinary()->sections()) {
+    StringRef Name, Contents;
+    if (Error Err =
+            readSection(Section, L.UncompressedSections, Name, Contents))
+      return Err;
+    if (!Name.empty())
+      L.Sections.emplace_back(Name, Contents);
+  }
+  return Error::success();
+}
+
+namespace llvm {
+Error handleSection(
+    const StringMap<std::pair<MCSection *, DWARFSectionKind>> &KnownSections,
+    const MCSection *StrSection, const MCSection *StrOffsetSection,
+    const MCSection *TypesSection, const MCSection *CUIndexSection,
+    const MCSection *TUIndexSection, const MCSection *InfoSection,
+    const SectionRef &Section, MCStreamer &Out,
+    std::deque<SmallString<32>> &UncompressedSections,
+    uint32_t (&ContributionOffsets)[8], UnitIndexEntry &CurEntry,
+    StringRef &CurStrSection, StringRef &CurStrOffsetSection,
+    std::vector<StringRef> &CurTypesSection,
+    std::vector<StringRef> &CurInfoSection, StringRef &AbbrevSection,
+    StringRef &CurCUIndexSection, StringRef &CurTUIndexSection,
+    std::vector<std::pair<DWARFSectionKind, uint32_t>> &SectionLength) {
+  StringRef Name, Contents;
+  if (Error Err = readSection(Section, UncompressedSections, Name, Contents))
+    return Err;
+  if (Name.empty())
+    return Error::success();
+  return handleSectionContents(
+      KnownSections, StrSection, StrOffsetSection, TypesSection, CUIndexSection,
+      TUIndexSection, InfoSection, Name, Contents, Out, ContributionOffsets,
+      CurEntry, CurStrSection, CurStrOffsetSection, CurTypesSection,
+      CurInfoSection, AbbrevSection, CurCUIndexSection, CurTUIndexSection,
+      SectionLength);
+}
+
 Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
             bool ContinueOnCuIndexOverflow) {
   const auto &MCOFI = *Out.getContext().getObjectFileInfo();
@@ -616,22 +687,24 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
-
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
-    if (!ErrOrObj) {
-      return handleErrors(ErrOrObj.takeError(),
-                          [&](std::unique_ptr<ECError> EC) -> Error {
-                            return createFileError(Input, Error(std::move(EC)));
-                          });
+  // The inputs are read and decompressed in parallel, a batch at a time, and
+  // then merged in order. Only the current batch is kept in memory: the
+  // string pool and the index entries own copies of what they refer to.
+  const size_t BatchSize = parallel::strategy.compute_thread_count() * 4;
+  SmallVector<LoadedInput, 0> Batch;
+
+  for (size_t InputIndex = 0; InputIndex != Inputs.size(); ++InputIndex) {
+    const std::string &Input = Inputs[InputIndex];
+    if (InputIndex % BatchSize == 0) {
+      Batch.clear();
+      Batch.resize(std::min(BatchSize, Inputs.size() - InputIndex));
+      for (size_t I = 0; I != Batch.size(); ++I)
+        Batch[I].Path = Inputs[InputIndex + I];
+      if (Error Err = parallelForEachError(Batch, loadInput))
+        return Err;
     }
-
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    LoadedInput &Loaded = Batch[InputIndex % BatchSize];
+    auto &Obj = *Loaded.Obj.getBinary();
 
     UnitIndexEntry CurEntry = {};
 
@@ -648,14 +721,14 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
     // i.e. offset and length, of each compile/type unit to a section.
     std::vector<std::pair<DWARFSectionKind, uint32_t>> SectionLength;
 
-    for (const auto &Section : Obj.sections())
-      if (auto Err = handleSection(
+    for (auto [Name, Contents] : Loaded.Sections)
+      if (auto Err = handleSectionContents(
               KnownSections, StrSection, StrOffsetSection, TypesSection,
-              CUIndexSection, TUIndexSection, InfoSection, Section, Out,
-              UncompressedSections, ContributionOffsets, CurEntry,
-              CurStrSection, CurStrOffsetSection, CurTypesSection,
-              CurInfoSection, AbbrevSection, CurCUIndexSection,
-              CurTUIndexSection, SectionLength))
+              CUIndexSection, TUIndexSection, InfoSection, Name, Contents, Out,
+              ContributionOffsets, CurEntry, CurStrSection,
+              CurStrOffsetSection, CurTypesSection, CurInfoSection,
+              AbbrevSection, CurCUIndexSection, CurTUIndexSection,
+              SectionLength))
         return Err;
 
     if (CurInfoSection.empty())
@@ -0,0 +1,260 @@
+//===- DWPStreamer.cpp - Write a DWARF package without buffering ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DWP/DWPStreamer.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/BinaryFormat/ELF.h"
+#include "llvm/MC/MCAsmInfo.h"
+#include "llvm/MC/MCContext.h"
+#include "llvm/MC/MCSectionELF.h"
+#include "llvm/Support/Casting.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include <optional>
+
+using namespace llvm;
+
+namespace {
+class DWPStreamer final : public MCStreamer {
+public:
+  DWPStreamer(MCContext &Context, raw_pwrite_stream &OS, uint16_t EMachine,
+              uint32_t EFlags)
+      : MCStreamer(Context), OS(OS), EMachine(EMachine), EFlags(EFlags) {}
+
+  ~DWPStreamer() override {
+    for (Spool &S : Spools) {
+      // Whatever went wrong has been reported already.
+      S.Data->flush();
+      S.Data->clear_error();
+      S.Data.reset();
+      consumeError(S.File->discard());
+    }
+  }
+
+  bool emitSymbolAttribute(MCSymbol *Symbol, MCSymbolAttr Attribute) override {
+    return false;
+  }
+
+  void emitCommonSymbol(MCSymbol *Symbol, uint64_t Size,
+                        Align ByteAlignment) override {
+    llvm_unreachable("a DWARF package has no common symbols");
+  }
+
+  void emitZerofill(MCSection *Section, MCSymbol *Symbol = nullptr,
+                    uint64_t Size = 0, Align ByteAlignment = Align(1),
+                    SMLoc Loc = SMLoc()) override {
+    llvm_unreachable("a DWARF package has no zero-filled sections");
+  }
+
+  void changeSection(MCSection *Section, const MCExpr *Subsection) override;
+  void emitBytes(StringRef Data) override;
+  void finishImpl() override;
+
+private:
+  // The contents of an output section, spooled to a temporary file.
+  struct Spool {
+    const MCSectionELF *Section;
+    std::optional<sys::fs::TempFile> File;
+    std::unique_ptr<raw_fd_ostream> Data;
+    uint64_t Offset = 0;
+  };
+
+  void reportError(const Twine &Msg) {
+    getContext().reportError(SMLoc(), "DWARF package streamer: " + Msg);
+  }
+
+  Error copySpool(Spool &S);
+  void writeObject();
+
+  raw_pwrite_stream &OS;
+  uint16_t EMachine;
+  uint32_t EFlags;
+  // The spools in the order their sections were first switched to, which is
+  // the order of the sections in the output.
+  std::vector<Spool> Spools;
+  DenseMap<const MCSection *, size_t> SpoolIndex;
+  Spool *Current = nullptr;
+};
+} // namespace
+
+void DWPStreamer::changeSection(MCSection *Section, const MCExpr *Subsection) {
+  auto [It, Inserted] = SpoolIndex.try_emplace(Section, Spools.size());
+  if (!Inserted) {
+    Current = It->second == ~size_t(0) ? nullptr : &Spools[It->second];
+    return;
+  }
+
+  Current = nullptr;
+  SmallString<128> Model;
+  sys::path::system_temp_directory(/*ErasedOnReboot=*/true, Model);
+  sys::path::append(Model, "llvm-dwp-%%%%%%%%.tmp");
+  Expected<sys::fs::TempFile> File = sys::fs::TempFile::create(Model);
+  if (!File) {
+    reportError("cannot create a temporary file for " + Section->getName() +
+                ": " + toString(File.takeError()));
+    It->second = ~size_t(0);
+    return;
+  }
+
+  Spool &S = Spools.emplace_back();
+  S.Section = cast<MCSectionELF>(Section);
+  S.File.emplace(std::move(*File));
+  S.Data = std::make_unique<raw_fd_ostream>(S.File->FD,
+                                            /*shouldClose=*/false);
+  Current = &S;
+}
+
+void DWPStreamer::emitBytes(StringRef Data) {
+  if (Current)
+    *Current->Data << Data;
+}
+
+// Appends the contents of \p S to the output.
+Error DWPStreamer::copySpool(Spool &S) {
+  S.Data->flush();
+  if (std::error_code EC = S.Data->error()) {
+    S.Data->clear_error();
+    return createFileError(S.File->TmpName, EC);
+  }
+
+  std::vector<char> Buf(1 << 20);
+  sys::fs::file_t FD = sys::fs::convertFDToNativeFile(S.File->FD);
+  for (uint64_t Off = 0, Size = S.Data->tell(); Off < Size;) {
+    size_t Len = std::min<uint64_t>(Buf.size(), Size - Off);
+    Expected<size_t> Read = sys::fs::readNativeFileSlice(
+        FD, MutableArrayRef<char>(Buf.data(), Len), Off);
+    if (!Read)
+      return createFileError(S.File->TmpName, Read.takeError());
+    if (*Read == 0)
+      return createFileError(S.File->TmpName,
+                             make_error_code(std::errc::io_error));
+    OS.write(Buf.data(), *Read);
+    Off += *Read;
+  }
+  return Error::success();
+}
+
+void DWPStreamer::finishImpl() {
+  if (getContext().hadError())
+    return;
+  writeObject();
+}
+
+void DWPStreamer::writeObject() {
+  const bool Is64 = getContext().getTargetTriple().isArch64Bit();
+  const support::endianness Endian =
+      getContext().getAsmInfo()->isLittleEndian() ? support::little
+                                                  : support::big;
+  support::endian::Writer W(OS, Endian);
+  auto WriteWord = [&](uint64_t V) {
+    if (Is64)
+      W.write<uint64_t>(V);
+    else
+      W.write<uint32_t>(V);
+  };
+
+  // The section header string table starts with the empty name of the null
+  // section and ends with its own name.
+  SmallString<256> ShStrTab;
+  ShStrTab.push_back('\0');
+  SmallVector<uint32_t, 16> NameOffsets;
+  for (const Spool &S : Spools) {
+    NameOffsets.push_back(ShStrTab.size());
+    ShStrTab += S.Section->getName();
+    ShStrTab.push_back('\0');
+  }
+  uint32_t ShStrTabName = ShStrTab.size();
+  ShStrTab += ".shstrtab";
+  ShStrTab.push_back('\0');
+
+  const uint64_t EhdrSize = Is64 ? sizeof(ELF::Elf64_Ehdr)
+                                 : sizeof(ELF::Elf32_Ehdr);
+  const uint64_t ShdrSize = Is64 ? sizeof(ELF::Elf64_Shdr)
+                                 : sizeof(ELF::Elf32_Shdr);
+  uint64_t Offset = EhdrSize;
+  for (Spool &S : Spools) {
+    Offset = alignTo(Offset, S.Section->getAlign());
+    S.Offset = Offset;
+    Offset += S.Data->tell();
+  }
+  const uint64_t ShStrTabOffset = Offset;
+  const uint64_t ShOff = alignTo(ShStrTabOffset + ShStrTab.size(),
+                                 Is64 ? 8 : 4);
+  // The null section, the spooled sections and .shstrtab.
+  const uint32_t ShNum = Spools.size() + 2;
+
+  // ELF header.
+  OS << ELF::ElfMagic;
+  OS << char(Is64 ? ELF::ELFCLASS64 : ELF::ELFCLASS32);
+  OS << char(Endian == support::little ? ELF::ELFDATA2LSB : ELF::ELFDATA2MSB);
+  OS << char(ELF::EV_CURRENT);
+  OS << char(ELF::ELFOSABI_NONE);
+  OS << char(0); // e_ident[EI_ABIVERSION]
+  OS.write_zeros(ELF::EI_NIDENT - ELF::EI_PAD);
+  W.write<uint16_t>(ELF::ET_REL);
+  W.write<uint16_t>(EMachine);
+  W.write<uint32_t>(ELF::EV_CURRENT);
+  WriteWord(0); // e_entry
+  WriteWord(0); // e_phoff
+  WriteWord(ShOff);
+  W.write<uint32_t>(EFlags);
+  W.write<uint16_t>(EhdrSize);
+  W.write<uint16_t>(0); // e_phentsize
+  W.write<uint16_t>(0); // e_phnum
+  W.write<uint16_t>(ShdrSize);
+  W.write<uint16_t>(ShNum);
+  W.write<uint16_t>(ShNum - 1); // e_shstrndx
+
+  // Section contents.
+  uint64_t Pos = EhdrSize;
+  for (Spool &S : Spools) {
+    OS.write_zeros(S.Offset - Pos);
+    if (Error Err = copySpool(S)) {
+      reportError(toString(std::move(Err)));
+      return;
+    }
+    Pos = S.Offset + S.Data->tell();
+  }
+  OS << ShStrTab;
+  OS.write_zeros(ShOff - ShStrTabOffset - ShStrTab.size());
+
+  // Section headers.
+  auto WriteShdr = [&](uint32_t Name, uint32_t Type, uint64_t Flags,
+                       uint64_t Off, uint64_t Size, uint64_t AddrAlign,
+                       uint64_t EntSize) {
+    W.write<uint32_t>(Name);
+    W.write<uint32_t>(Type);
+    WriteWord(Flags);
+    WriteWord(0); // sh_addr
+    WriteWord(Off);
+    WriteWord(Size);
+    W.write<uint32_t>(0); // sh_link
+    W.write<uint32_t>(0); // sh_info
+    WriteWord(AddrAlign);
+    WriteWord(EntSize);
+  };
+  WriteShdr(0, ELF::SHT_NULL, 0, 0, 0, 0, 0);
+  for (size_t I = 0, E = Spools.size(); I != E; ++I) {
+    const Spool &S = Spools[I];
+    WriteShdr(NameOffsets[I], S.Section->getType(), S.Section->getFlags(),
+              S.Offset, S.Data->tell(), S.Section->getAlign().value(),
+              S.Section->getEntrySize());
+  }
+  WriteShdr(ShStrTabName, ELF::SHT_STRTAB, 0, ShStrTabOffset, ShStrTab.size(),
+            1, 0);
+}
+
+std::unique_ptr<MCStreamer> llvm::createDWPStreamer(MCContext &Context,
+                                                    raw_pwrite_stream &OS,
+                                                    uint16_t EMachine,
+                                                    uint32_t EFlags) {
+  return std::make_unique<DWPStreamer>(Context, OS, EMachine, EFlags);
+}
@@ -971,9 +971,16 @@ const DWARFDebugAranges *DWARFContext::getDebugAranges() {
 
   Aranges.reset(new DWARFDebugAranges());
   Aranges->generate(this);
+  SectionAranges.reset();
   return Aranges.get();
 }
 
+void DWARFContext::setDebugAranges(
+    std::unique_ptr<DWARFDebugAranges> NewAranges) {
+  Aranges = std::move(NewAranges);
+  SectionAranges.reset();
+}
+
 Expected<const DWARFDebugFrame *> DWARFContext::getDebugFrame() {
   if (DebugFrame)
     return DebugFrame.get();
@@ -1167,6 +1174,19 @@ DWARFCompileUnit *DWARFContext::getCompileUnitForOffset(uint64_t Offset) {
 }
 
 DWARFCompileUnit *DWARFContext::getCompileUnitForCodeAddress(uint64_t Address) {
+  // Building the full address index reads the unit DIE, and possibly the range
+  // list, of every compile unit that .debug_aranges does not describe. Answer
+  // from .debug_aranges alone while it covers the addresses looked up.
+  if (!Aranges && !DObj->getArangesSection().empty()) {
+    if (!SectionAranges) {
+      SectionAranges = std::make_unique<DWARFDebugAranges>();
+      SectionAranges->generateFromArangesSection(this);
+    }
+    uint64_t CUOffset = SectionAranges->findAddress(Address);
+    if (CUOffset != -1ULL)
+      if (DWARFCompileUnit *CU = getCompileUnitForOffset(CUOffset))
+        return CU;
+  }
   uint64_t CUOffset = getDebugAranges()->findAddress(Address);
   return getCompileUnitForOffset(CUOffset);
 }
@@ -13,6 +13,9 @@
 #include "llvm/DebugInfo/DWARF/DWARFDebugArangeSet.h"
 #include "llvm/DebugInfo/DWARF/DWARFObject.h"
 #include "llvm/DebugInfo/DWARF/DWARFUnit.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
@@ -73,6 +76,68 @@ void DWARFDebugAranges::generate(DWARFContext *CTX) {
   construct();
 }
 
+void DWARFDebugAranges::generateFromArangesSection(DWARFContext *CTX) {
+  clear();
+  if (!CTX)
+    return;
+
+  DWARFDataExtractor ArangesData(CTX->getDWARFObj().getArangesSection(),
+                                 CTX->isLittleEndian(), 0);
+  extract(ArangesData, CTX->getRecoverableErrorHandler(),
+          CTX->getWarningHandler());
+  construct();
+}
+
+// The cache is a header followed by the ranges, all little-endian:
+//   char     Magic[8]
+//   uint64_t Key
+//   uint64_t NumRanges
+//   { uint64_t LowPC, Length, CUOffset } Ranges[NumRanges]
+static constexpr char CacheMagic[] = "LLVMARNG";
+
+void DWARFDebugAranges::writeCache(raw_ostream &OS, uint64_t Key) const {
+  support::endian::Writer W(OS, support::little);
+  OS.write(CacheMagic, sizeof(CacheMagic) - 1);
+  W.write<uint64_t>(Key);
+  W.write<uint64_t>(Aranges.size());
+  for (const Range &R : Aranges) {
+    W.write<uint64_t>(R.LowPC);
+    W.write<uint64_t>(R.Length);
+    W.write<uint64_t>(R.CUOffset);
+  }
+}
+
+bool DWARFDebugAranges::readCache(StringRef Data, uint64_t Key) {
+  using namespace support;
+  clear();
+  const size_t MagicSize = sizeof(CacheMagic) - 1;
+  const size_t HeaderSize = MagicSize + 16;
+  if (Data.size() < HeaderSize || !Data.starts_with(CacheMagic))
+    return false;
+  const char *P = Data.data() + MagicSize;
+  if (endian::read64le(P) != Key)
+    return false;
+  uint64_t NumRanges = endian::read64le(P + 8);
+  if ((Data.size() - HeaderSize) / 24 != NumRanges ||
+      (Data.size() - HeaderSize) % 24 != 0)
+    return false;
+
+  Aranges.reserve(NumRanges);
+  for (P = Data.data() + HeaderSize; P != Data.end(); P += 24) {
+    uint64_t LowPC = endian::read64le(P);
+    uint64_t Length = endian::read64le(P + 8);
+    uint64_t CUOffset = endian::read64le(P + 16);
+    // findAddress() relies on the ranges being sorted and disjoint.
+    if (!Aranges.empty() && Aranges.back().HighPC() > LowPC) {
+      Aranges.clear();
+      return false;
+    }
+    Aranges.emplace_back(LowPC, LowPC, CUOffset);
+    Aranges.back().Length = Length;
+  }
+  return true;
+}
+
 void DWARFDebugAranges::clear() {
   Endpoints.clear();
   Aranges.clear();
@@ -362,6 +362,9 @@ unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
         verifyUnitContents(*Unit, UnitLocalReferences, CrossUnitReferences);
     NumDebugInfoErrors += verifyDebugInfoReferences(
         UnitLocalReferences, [&](uint64_t Offset) { return Unit.get(); });
+    // Drop the parsed DIEs of this unit so that memory use doesn't grow with
+    // the number of units. Later checks re-extract them on demand.
+    Unit->clearDIEs(/*KeepCUDie=*/true);
     ++Index;
   }
 
@@ -451,6 +451,13 @@ Error DwarfTransformer::convert(uint32_t NumThreads) {
       DWARFDie Die = getDie(*CU);
       CUInfo CUI(DICtx, dyn_cast<DWARFCompileUnit>(CU.get()));
       handleDie(Log, CUI, Die);
+      // Release the line table and DIEs of this unit now that we are done
+      // with it, so peak memory doesn't grow with the size of the binary.
+      // They are re-parsed on demand if another unit refers into this one.
+      DICtx.clearLineTableForUnit(CU.get());
+      CU->clearDIEs(/*KeepCUDie=*/true);
+      if (DWARFUnit *DieCU = Die.getDwarfUnit(); DieCU && DieCU != CU.get())
+        DieCU->clearDIEs(/*KeepCUDie=*/true);
     }
   } else {
     // LLVM Dwarf parser is not thread-safe and we need to parse all DWARF up
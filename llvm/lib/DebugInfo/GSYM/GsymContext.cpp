@@ -0,0 +1,102 @@
+//===- GsymContext.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
+#include "llvm/DebugInfo/GSYM/LookupResult.h"
+#include <algorithm>
+
+using namespace llvm;
+using namespace llvm::gsym;
+
+GsymContext::~GsymContext() = default;
+GsymContext::GsymContext(std::unique_ptr<GsymReader> Reader)
+    : DIContext(CK_GSYM), Reader(std::move(Reader)) {}
+
+void GsymContext::dump(raw_ostream &OS, DIDumpOptions DumpOpts) {
+  Reader->dump(OS);
+}
+
+static DILineInfo getLineInfo(const LookupResult &Result, size_t Index,
+                              DILineInfoSpecifier Specifier) {
+  DILineInfo LineInfo;
+  if (Specifier.FNKind != DINameKind::None)
+    LineInfo.FunctionName = Result.FuncName.str();
+  // A function without a line table has no source locations, only a name.
+  if (Index >= Result.Locations.size())
+    return LineInfo;
+
+  const SourceLocation &Location = Result.Locations[Index];
+  if (Specifier.FNKind != DINameKind::None)
+    LineInfo.FunctionName = Location.Name.str();
+  switch (Specifier.FLIKind) {
+  case DILineInfoSpecifier::FileLineInfoKind::None:
+    break;
+  case DILineInfoSpecifier::FileLineInfoKind::BaseNameOnly:
+    LineInfo.FileName = Location.Base.str();
+    break;
+  case DILineInfoSpecifier::FileLineInfoKind::RawValue:
+  case DILineInfoSpecifier::FileLineInfoKind::RelativeFilePath:
+  case DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath:
+    LineInfo.FileName = Result.getSourceFile(Index);
+    break;
+  }
+  LineInfo.Line = Location.Line;
+  // The concrete function is the last location; only it has a known start.
+  if (Index + 1 == Result.Locations.size())
+    LineInfo.StartAddress = Result.FuncRange.start();
+  return LineInfo;
+}
+
+DILineInfo GsymContext::getLineInfoForAddress(object::SectionedAddress Address,
+                                              DILineInfoSpecifier Specifier) {
+  Expected<LookupResult> Result = Reader->lookup(Address.Address);
+  if (!Result) {
+    consumeError(Result.takeError());
+    return DILineInfo();
+  }
+  // The deepest inlined location comes first.
+  return getLineInfo(*Result, 0, Specifier);
+}
+
+DILineInfo
+GsymContext::getLineInfoForDataAddress(object::SectionedAddress Address) {
+  // GSYM files only describe code.
+  return DILineInfo();
+}
+
+DILineInfoTable
+GsymContext::getLineInfoForAddressRange(object::SectionedAddress Address,
+                                        uint64_t Size,
+                                        DILineInfoSpecifier Specifier) {
+  // GSYM lookups answer for one address at a time; there is no way to walk
+  // the line table of an arbitrary range without decoding each function.
+  return DILineInfoTable();
+}
+
+DIInliningInfo
+GsymContext::getInliningInfoForAddress(object::SectionedAddress Address,
+                                       DILineInfoSpecifier Specifier) {
+  DIInliningInfo InlineInfo;
+  Expected<LookupResult> Result = Reader->lookup(Address.Address);
+  if (!Result) {
+    consumeError(Result.takeError());
+    return InlineInfo;
+  }
+  // A function without a line table still gets a frame with its name.
+  size_t NumFrames = std::max<size_t>(Result->Locations.size(), 1);
+  for (size_t I = 0; I != NumFrames; ++I)
+    InlineInfo.addFrame(getLineInfo(*Result, I, Specifier));
+  return InlineInfo;
+}
+
+std::vector<DILocal>
+GsymContext::getLocalsForAddress(object::SectionedAddress Address) {
+  // GSYM files don't record variables.
+  return {};
+}
@@ -14,6 +14,9 @@
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/DWARF/DWARFDebugAranges.h"
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
 #include "llvm/DebugInfo/PDB/PDBContext.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableObjectFile.h"
@@ -24,12 +27,15 @@
 #include "llvm/Object/MachO.h"
 #include "llvm/Object/MachOUniversal.h"
 #include "llvm/Support/CRC.h"
+#include "llvm/Support/CachePruning.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <algorithm>
 #include <cassert>
 #include <cstring>
@@ -550,6 +556,89 @@ LLVMSymbolizer::createModuleInfo(const ObjectFile *Obj,
   return InsertResult.first->second.get();
 }
 
+// Loads the address index of Ctx from CacheDir, or builds it and saves it
+// there. The cache is best effort: any failure just leaves Ctx to build the
+// index itself.
+static void useAddressIndexCache(DWARFContext &Ctx, const ObjectFile &Obj,
+                                 StringRef CacheDir) {
+  // With .debug_aranges, lookups are answered from that section without
+  // building the full index, so there is nothing worth caching.
+  if (!Ctx.getDWARFObj().getArangesSection().empty())
+    return;
+
+  object::BuildIDRef BuildID = object::getBuildID(&Obj);
+  if (BuildID.empty())
+    return;
+
+  // Also key the index on the size of the debug info, so that a rebuilt binary
+  // that kept its build ID is not matched with a stale index.
+  uint64_t InfoSize = 0;
+  Ctx.getDWARFObj().forEachInfoSections(
+      [&](const DWARFSection &S) { InfoSize += S.Data.size(); });
+  uint64_t Key = xxHash64(BuildID) ^ InfoSize;
+
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, "llvmcache-" + toHex(BuildID, /*LowerCase=*/true) +
+                              ".aranges");
+  if (ErrorOr<std::unique_ptr<MemoryBuffer>> Buf =
+          MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                /*RequiresNullTerminator=*/false)) {
+    auto Aranges = std::make_unique<DWARFDebugAranges>();
+    if (Aranges->readCache((*Buf)->getBuffer(), Key)) {
+      Ctx.setDebugAranges(std::move(Aranges));
+      return;
+    }
+  }
+
+  // Write to a temporary file and rename it so that concurrent processes never
+  // see a partial index.
+  const DWARFDebugAranges *Aranges = Ctx.getDebugAranges();
+  if (sys::fs::create_directories(CacheDir))
+    return;
+  Expected<sys::fs::TempFile> Temp =
+      sys::fs::TempFile::create(Path + ".tmp%%%%%%");
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    Aranges->writeCache(OS, Key);
+    OS.flush();
+    if (OS.has_error()) {
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return;
+    }
+  }
+  consumeError(Temp->keep(Path));
+}
+
+// Returns a context for the GSYM file next to \p BinaryName, if there is one
+// whose UUID matches the build ID of \p Obj. GSYM lookups are a binary search over a sorted address
+// table and don't need the DWARF to be parsed at all.
+static std::unique_ptr<DIContext> createGsymContext(StringRef BinaryName,
+                                                    const ObjectFile &Obj) {
+  std::string GsymPath = (BinaryName + ".gsym").str();
+  if (!sys::fs::exists(GsymPath))
+    return nullptr;
+  Expected<gsym::GsymReader> ReaderOrErr =
+      gsym::GsymReader::openFile(GsymPath);
+  if (!ReaderOrErr) {
+    consumeError(ReaderOrErr.takeError());
+    return nullptr;
+  }
+  // Only trust a GSYM file that was made for this build of the binary. If
+  // either side has no UUID, there is no way to tell.
+  const gsym::Header &Hdr = ReaderOrErr->getHeader();
+  BuildIDRef BuildID = getBuildID(&Obj);
+  if (!Hdr.UUIDSize || BuildID.empty() ||
+      ArrayRef<uint8_t>(Hdr.UUID, Hdr.UUIDSize) != BuildID)
+    return nullptr;
+  return std::make_unique<gsym::GsymContext>(
+      std::make_unique<gsym::GsymReader>(std::move(*ReaderOrErr)));
+}
+
 Expected<SymbolizableModule *>
 LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   std::string BinaryName = ModuleName;
@@ -600,10 +689,18 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
       Context.reset(new PDBContext(*CoffObject, std::move(Session)));
     }
   }
-  if (!Context)
-    Context = DWARFContext::create(
+  if (!Context && Opts.UseGsym)
+    Context = createGsymContext(BinaryName, *Objects.first);
+  if (!Context) {
+    std::unique_ptr<DWARFContext> DICtx = DWARFContext::create(
         *Objects.second, DWARFContext::ProcessDebugRelocations::Process,
         nullptr, Opts.DWPName);
+    if (!Opts.IndexCacheDirectory.empty()) {
+      useAddressIndexCache(*DICtx, *Objects.second, Opts.IndexCacheDirectory);
+      llvm::pruneCache(Opts.IndexCacheDirectory, Opts.IndexCachePolicy);
+    }
+    Context = std::move(DICtx);
+  }
   auto ModuleOrErr =
       createModuleInfo(Objects.first, std::move(Context), ModuleName);
   if (ModuleOrErr) {
@@ -23,6 +23,7 @@
 
 #include "llvm/Debuginfod/Debuginfod.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
@@ -41,6 +42,7 @@
 #include "llvm/Support/xxhash.h"
 
 #include <atomic>
+#include <mutex>
 #include <thread>
 
 namespace llvm {
@@ -209,6 +211,30 @@ static SmallVector<std::string, 0> getHeaders() {
   return Headers;
 }
 
+// Artifacts that every server answered with 404 Not Found, keyed by the
+// artifact key and the list of servers queried, with the time at which the
+// entry expires. Clients such as llvm-symbolizer may ask for the same missing
+// build ID many times. This is off unless a client sets a TTL, since in a
+// long-running process an artifact may be uploaded after the first miss.
+static std::mutex MissingArtifactsMutex;
+static StringMap<std::chrono::steady_clock::time_point> MissingArtifacts;
+static std::chrono::milliseconds MissingArtifactTTL(0);
+
+void setDebuginfodMissingArtifactTTL(std::chrono::milliseconds TTL) {
+  std::lock_guard<std::mutex> Guard(MissingArtifactsMutex);
+  MissingArtifactTTL = TTL;
+  if (TTL.count() <= 0)
+    MissingArtifacts.clear();
+}
+
+static std::string missingArtifactKey(StringRef UniqueKey,
+                                      ArrayRef<StringRef> DebuginfodUrls) {
+  std::string Key(UniqueKey);
+  for (StringRef ServerUrl : DebuginfodUrls)
+    (Key += ' ') += ServerUrl;
+  return Key;
+}
+
 Expected<std::string> getCachedOrDownloadArtifact(
     StringRef UniqueKey, StringRef UrlPath, StringRef CacheDirectoryPath,
     ArrayRef<StringRef> DebuginfodUrls, std::chrono::milliseconds Timeout) {
@@ -230,6 +256,21 @@ Expected<std::string> getCachedOrDownloadArtifact(
   AddStreamFn &CacheAddStream = *CacheAddStreamOrErr;
   if (!CacheAddStream)
     return std::string(AbsCachedArtifactPath);
+
+  const std::string MissingKey =
+      missingArtifactKey(UniqueKey, DebuginfodUrls);
+  {
+    std::lock_guard<std::mutex> Guard(MissingArtifactsMutex);
+    auto It = MissingArtifacts.find(MissingKey);
+    if (It != MissingArtifacts.end()) {
+      if (MissingArtifactTTL.count() > 0 &&
+          std::chrono::steady_clock::now() < It->second)
+        return createStringError(errc::argument_out_of_domain,
+                                 "build id not found");
+      MissingArtifacts.erase(It);
+    }
+  }
+
   // The artifact was not found in the local cache, query the debuginfod
   // servers.
   if (!HTTPClient::isAvailable())
@@ -245,6 +286,9 @@ Expected<std::string> getCachedOrDownloadArtifact(
 
   HTTPClient Client;
   Client.setTimeout(Timeout);
+  // Only a definite 404 from every server marks the artifact as missing;
+  // other errors such as 429 or 5xx may be transient.
+  bool AllNotFound = !DebuginfodUrls.empty();
   for (StringRef ServerUrl : DebuginfodUrls) {
     SmallString<64> ArtifactUrl;
     sys::path::append(ArtifactUrl, sys::path::Style::posix, ServerUrl, UrlPath);
@@ -261,8 +305,11 @@ Expected<std::string> getCachedOrDownloadArtifact(
         return std::move(Err);
 
       unsigned Code = Client.responseCode();
-      if (Code && Code != 200)
+      if (Code && Code != 200) {
+        if (Code != 404)
+          AllNotFound = false;
         continue;
+      }
     }
 
     Expected<CachePruningPolicy> PruningPolicyOrErr =
@@ -275,6 +322,12 @@ Expected<std::string> getCachedOrDownloadArtifact(
     return std::string(AbsCachedArtifactPath);
   }
 
+  if (AllNotFound) {
+    std::lock_guard<std::mutex> Guard(MissingArtifactsMutex);
+    if (MissingArtifactTTL.count() > 0)
+      MissingArtifacts[MissingKey] =
+          std::chrono::steady_clock::now() + MissingArtifactTTL;
+  }
   return createStringError(errc::argument_out_of_domain, "build id not found");
 }
 
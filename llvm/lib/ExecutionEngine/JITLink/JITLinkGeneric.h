@@ -15,6 +15,9 @@
 
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+
+#include <optional>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -123,15 +126,13 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    std::vector<Block *> Blocks;
+    size_t NumEdges = 0;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection =
           Sec.getMemLifetimePolicy() == orc::MemLifetimePolicy::NoAlloc;
 
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
         assert((!B->isZeroFill() || all_of(B->edges(),
                                            [](const Edge &E) {
                                              return E.getKind() ==
@@ -145,30 +146,68 @@ private:
         if (NoAllocSection)
           (void)B->getMutableContent(G);
 
-        for (auto &E : B->edges()) {
-
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
-
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert(
-              (NoAllocSection || !E.getTarget().isDefined() ||
-               E.getTarget().getBlock().getSection().getMemLifetimePolicy() !=
-                   orc::MemLifetimePolicy::NoAlloc) &&
-              "Block in allocated section has edge pointing to no-alloc "
-              "section");
-
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
+        Blocks.push_back(B);
+        NumEdges += B->edges_size();
+      }
+    }
+
+    // Fixups only write to the content of their own block, so blocks can be
+    // fixed up concurrently once the graph is large enough to pay for it.
+    // Debug output stays sequential so that it remains readable.
+    bool FixUpConcurrently = NumEdges >= MinEdgesToFixUpConcurrently;
+    LLVM_DEBUG(FixUpConcurrently = false);
+    if (!FixUpConcurrently) {
+      for (auto *B : Blocks) {
+        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
+        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+        if (auto Err = fixUpBlock(G, *B))
+          return Err;
       }
+      return Error::success();
+    }
+
+    // Each result is constructed in place so that no unchecked
+    // Error::success() is ever overwritten.
+    std::vector<std::optional<Error>> Errs(Blocks.size());
+    parallelFor(0, Blocks.size(),
+                [&](size_t I) { Errs[I].emplace(fixUpBlock(G, *Blocks[I])); });
+
+    Error Err = Error::success();
+    for (auto &E : Errs)
+      Err = joinErrors(std::move(Err), std::move(*E));
+    return Err;
+  }
+
+  Error fixUpBlock(LinkGraph &G, Block &B) const {
+    bool NoAllocSection = B.getSection().getMemLifetimePolicy() ==
+                          orc::MemLifetimePolicy::NoAlloc;
+    (void)NoAllocSection;
+
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // If B is a block in a Standard or Finalize section then make sure
+      // that no edges point to symbols in NoAlloc sections.
+      assert((NoAllocSection || !E.getTarget().isDefined() ||
+              E.getTarget().getBlock().getSection().getMemLifetimePolicy() !=
+                  orc::MemLifetimePolicy::NoAlloc) &&
+             "Block in allocated section has edge pointing to no-alloc "
+             "section");
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
     }
 
     return Error::success();
   }
+
+  // The number of edges in a graph from which its blocks are fixed up
+  // concurrently.
+  static constexpr size_t MinEdgesToFixUpConcurrently = 1 << 16;
 };
 
 /// Removes dead symbols/blocks/addressables.
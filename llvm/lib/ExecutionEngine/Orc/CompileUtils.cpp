@@ -9,7 +9,8 @@
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 
 #include "llvm/ADT/SmallVector.h"
-#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/MC/MCContext.h"
@@ -17,6 +18,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Target/TargetMachine.h"
 
@@ -92,5 +94,101 @@ ConcurrentIRCompiler::operator()(Module &M) {
   return C(M);
 }
 
+Expected<std::unique_ptr<LocalObjectCache>>
+LocalObjectCache::Create(const Twine &CacheDir,
+                         const JITTargetMachineBuilder &JTMB) {
+  std::string TargetID;
+  raw_string_ostream OS(TargetID);
+  OS << JTMB.getTargetTriple().str() << '\0' << JTMB.getCPU() << '\0'
+     << JTMB.getFeatures().getString() << '\0'
+     << static_cast<int>(JTMB.getCodeGenOptLevel()) << '\0';
+  if (const auto &RM = JTMB.getRelocationModel())
+    OS << static_cast<int>(*RM);
+  OS << '\0';
+  if (const auto &CM = JTMB.getCodeModel())
+    OS << static_cast<int>(*CM);
+  OS.flush();
+
+  std::unique_ptr<LocalObjectCache> ObjCache(
+      new LocalObjectCache(std::move(TargetID)));
+  LocalObjectCache *Self = ObjCache.get();
+  auto Cache = localCache(
+      "ORCObjectCache", "orc-object", CacheDir,
+      [Self](unsigned Task, const Twine &ModuleName,
+             std::unique_ptr<MemoryBuffer> MB) {
+        std::lock_guard<std::mutex> Lock(Self->CacheMutex);
+        Self->Found[Task] = std::move(MB);
+      });
+  if (!Cache)
+    return Cache.takeError();
+  ObjCache->Cache = std::move(*Cache);
+  return std::move(ObjCache);
+}
+
+std::string LocalObjectCache::computeKey(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS);
+
+  SHA1 Hasher;
+  Hasher.update(TargetID);
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+  return toHex(Hasher.result());
+}
+
+std::unique_ptr<MemoryBuffer> LocalObjectCache::getObject(const Module *M) {
+  std::string Key = computeKey(*M);
+  unsigned Task;
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    Task = NextTask++;
+  }
+
+  // The cache is only an optimization: if it cannot be read, the module is
+  // compiled as if it had not been cached.
+  Expected<AddStreamFn> AddStream =
+      Cache(Task, Key, M->getModuleIdentifier());
+  if (!AddStream) {
+    consumeError(AddStream.takeError());
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> Lock(CacheMutex);
+  if (!*AddStream) {
+    auto I = Found.find(Task);
+    if (I == Found.end())
+      return nullptr;
+    std::unique_ptr<MemoryBuffer> Obj = std::move(I->second);
+    Found.erase(I);
+    return Obj;
+  }
+  Pending[M] = {Task, std::move(*AddStream)};
+  return nullptr;
+}
+
+void LocalObjectCache::notifyObjectCompiled(const Module *M,
+                                            MemoryBufferRef Obj) {
+  PendingObject P;
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    auto I = Pending.find(M);
+    if (I == Pending.end())
+      return;
+    P = std::move(I->second);
+    Pending.erase(I);
+  }
+
+  // Like a failed lookup, a failure to store the object is not an error.
+  if (auto Stream = P.AddStream(P.Task, M->getModuleIdentifier()))
+    *(*Stream)->OS << Obj.getBuffer();
+  else
+    consumeError(Stream.takeError());
+
+  // The stream hands the stored object back once it is committed, but the
+  // compiler already has its own copy.
+  std::lock_guard<std::mutex> Lock(CacheMutex);
+  Found.erase(P.Task);
+}
+
 } // end namespace orc
 } // end namespace llvm
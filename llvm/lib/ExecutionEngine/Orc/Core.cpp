@@ -685,6 +685,7 @@ void JITDylib::removeGenerator(DefinitionGenerator &G) {
                            });
     assert(I != DefGenerators.end() && "Generator not found");
     DefGenerators.erase(I);
+    invalidatePublishedSymbols(false);
   });
 }
 
@@ -734,6 +735,7 @@ JITDylib::defineMaterializing(SymbolFlagsMap SymbolFlags) {
       RejectedWeakDefs.pop_back();
     }
 
+    invalidatePublishedSymbols(false);
     return SymbolFlags;
   });
 }
@@ -1090,6 +1092,7 @@ Error JITDylib::emit(MaterializationResponsibility &MR,
           // Update its state and continue.
           if (MII == MaterializingInfos.end()) {
             SymEntry.setState(SymbolState::Ready);
+            notePublishableSymbol(Name);
             continue;
           }
 
@@ -1143,6 +1146,7 @@ Error JITDylib::emit(MaterializationResponsibility &MR,
                 // MaterializingInfo and update its materializing state.
                 DependantSymEntry.setState(SymbolState::Ready);
                 DependantJDReadySymbols.push_back(DependantName);
+                DependantJD.notePublishableSymbol(DependantName);
 
                 for (auto &Q :
                      DependantMI.takeQueriesMeeting(SymbolState::Ready)) {
@@ -1162,6 +1166,7 @@ Error JITDylib::emit(MaterializationResponsibility &MR,
           if (MI.UnemittedDependencies.empty()) {
             SymI->second.setState(SymbolState::Ready);
             ThisJDReadySymbols.push_back(Name);
+            notePublishableSymbol(Name);
             for (auto &Q : MI.takeQueriesMeeting(SymbolState::Ready)) {
               Q->notifySymbolMetRequiredState(Name, SymI->second.getSymbol());
               if (Q->isComplete())
@@ -1424,6 +1429,7 @@ Error JITDylib::remove(const SymbolNameSet &Names) {
       Symbols.erase(SymI);
     }
 
+    invalidatePublishedSymbols(true);
     return Error::success();
   });
 }
@@ -1602,6 +1608,7 @@ JITDylib::removeTracker(ResourceTracker &RT) {
     Symbols.erase(I);
   }
 
+  invalidatePublishedSymbols(true);
   return Result;
 }
 
@@ -1680,6 +1687,87 @@ void JITDylib::transferTracker(ResourceTracker &DstRT, ResourceTracker &SrcRT) {
   TrackerSymbols.erase(SI);
 }
 
+void JITDylib::notePublishableSymbol(const SymbolStringPtr &Name) {
+  // Note: Should be called under the session lock.
+  if (!PublishedSymbolsNeedRebuild)
+    NewlyReadySymbols.push_back(Name);
+  PublishedSymbolsStale = true;
+}
+
+void JITDylib::invalidatePublishedSymbols(bool SymbolsRemoved) {
+  // Note: Should be called under the session lock.
+  PublishedSymbolsStale = true;
+
+  // Any table could return a removed symbol, so drop them all and rebuild
+  // from the symbol table on the next refresh.
+  if (SymbolsRemoved) {
+    std::atomic_store(&PublishedSymbols,
+                      std::shared_ptr<const PublishedSymbolTable>());
+    NewlyReadySymbols.clear();
+    PublishedSymbolsNeedRebuild = true;
+    return;
+  }
+
+  // Anything found in the tables is still there as symbols are added, but a
+  // complete table would wrongly say that a newly defined symbol is missing.
+  // Shadow it with an empty table that is not complete.
+  if (PublishedSymbols && PublishedSymbols->Complete) {
+    auto Table = std::make_shared<PublishedSymbolTable>();
+    Table->NumSymbols = PublishedSymbols->NumSymbols;
+    Table->Older = PublishedSymbols;
+    std::atomic_store(&PublishedSymbols,
+                      std::shared_ptr<const PublishedSymbolTable>(
+                          std::move(Table)));
+  }
+}
+
+void JITDylib::refreshPublishedSymbols() {
+  // Note: Should be called under the session lock.
+  if (State != Open || !PublishedSymbolsStale)
+    return;
+
+  auto IsPublishable = [](const SymbolTableEntry &SymEntry) {
+    return SymEntry.getState() == SymbolState::Ready &&
+           !SymEntry.getFlags().hasError() &&
+           !SymEntry.getFlags().hasMaterializationSideEffectsOnly();
+  };
+
+  auto Table = std::make_shared<PublishedSymbolTable>();
+  std::shared_ptr<const PublishedSymbolTable> Older;
+  if (PublishedSymbolsNeedRebuild) {
+    for (auto &KV : Symbols)
+      if (IsPublishable(KV.second))
+        Table->Symbols[KV.first] = KV.second.getSymbol();
+    PublishedSymbolsNeedRebuild = false;
+  } else {
+    for (auto &Name : NewlyReadySymbols) {
+      auto I = Symbols.find(Name);
+      if (I != Symbols.end() && IsPublishable(I->second))
+        Table->Symbols[Name] = I->second.getSymbol();
+    }
+
+    // Merge the older tables that are not larger than the new one, like the
+    // carries of a binary counter, so that each symbol is only copied a
+    // logarithmic number of times.
+    Older = PublishedSymbols;
+    while (Older && Older->Symbols.size() <= Table->Symbols.size()) {
+      Table->Symbols.insert(Older->Symbols.begin(), Older->Symbols.end());
+      Older = Older->Older;
+    }
+  }
+  NewlyReadySymbols.clear();
+
+  Table->NumSymbols = Table->Symbols.size() + (Older ? Older->NumSymbols : 0);
+  Table->Older = std::move(Older);
+  Table->Complete =
+      DefGenerators.empty() && Table->NumSymbols == Symbols.size();
+
+  std::atomic_store(&PublishedSymbols,
+                    std::shared_ptr<const PublishedSymbolTable>(
+                        std::move(Table)));
+  PublishedSymbolsStale = false;
+}
+
 Error JITDylib::defineImpl(MaterializationUnit &MU) {
 
   LLVM_DEBUG({ dbgs() << "  " << MU.getSymbols() << "\n"; });
@@ -1744,6 +1832,7 @@ Error JITDylib::defineImpl(MaterializationUnit &MU) {
     SymEntry.setMaterializerAttached(true);
   }
 
+  invalidatePublishedSymbols(false);
   return Error::success();
 }
 
@@ -2179,12 +2268,25 @@ ExecutionSession::lookup(const JITDylibSearchOrder &SearchOrder,
 Expected<ExecutorSymbolDef>
 ExecutionSession::lookup(const JITDylibSearchOrder &SearchOrder,
                          SymbolStringPtr Name, SymbolState RequiredState) {
+  // Symbols that are already ready can be found without the session lock.
+  if (auto Sym = lookupPublished(SearchOrder, Name))
+    return *Sym;
+
   SymbolLookupSet Names({Name});
 
   if (auto ResultMap = lookup(SearchOrder, std::move(Names), LookupKind::Static,
                               RequiredState, NoDependenciesToRegister)) {
     assert(ResultMap->size() == 1 && "Unexpected number of results");
     assert(ResultMap->count(Name) && "Missing result for symbol");
+
+    // Publish what has become ready since the last slow lookup so that the
+    // next lookup of it can take the fast path.
+    if (RequiredState == SymbolState::Ready)
+      runSessionLocked([&]() {
+        for (auto &KV : SearchOrder)
+          KV.first->refreshPublishedSymbols();
+      });
+
     return std::move(ResultMap->begin()->second);
   } else
     return ResultMap.takeError();
@@ -2261,6 +2363,27 @@ void ExecutionSession::dump(raw_ostream &OS) {
   });
 }
 
+std::optional<ExecutorSymbolDef>
+ExecutionSession::lookupPublished(const JITDylibSearchOrder &SearchOrder,
+                                  const SymbolStringPtr &Name) {
+  for (auto &KV : SearchOrder) {
+    auto Table = KV.first->getPublishedSymbols();
+    if (!Table)
+      return std::nullopt;
+
+    auto *Sym = Table->lookup(Name);
+    if (Sym && (KV.second == JITDylibLookupFlags::MatchAllSymbols ||
+                Sym->getFlags().isExported()))
+      return *Sym;
+
+    // Only move on to the next JITDylib if this one is known not to define
+    // (or generate) a matching symbol that is not yet ready.
+    if (!Sym && !Table->Complete)
+      return std::nullopt;
+  }
+  return std::nullopt;
+}
+
 void ExecutionSession::dispatchOutstandingMUs() {
   LLVM_DEBUG(dbgs() << "Dispatching MaterializationUnits...\n");
   while (true) {
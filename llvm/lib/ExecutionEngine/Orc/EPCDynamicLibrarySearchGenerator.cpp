@@ -39,6 +39,10 @@ Error EPCDynamicLibrarySearchGenerator::tryToGenerate(
     LookupSymbols.add(KV.first, SymbolLookupFlags::WeaklyReferencedSymbol);
   }
 
+  // Skip the round trip to the executor if the filter rejected everything.
+  if (LookupSymbols.empty())
+    return Error::success();
+
   SymbolMap NewSymbols;
 
   ExecutorProcessControl::LookupRequest Request(H, LookupSymbols);
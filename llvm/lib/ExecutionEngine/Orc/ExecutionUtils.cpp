@@ -240,6 +240,9 @@ Error DynamicLibrarySearchGenerator::tryToGenerate(
 
   bool HasGlobalPrefix = (GlobalPrefix != '\0');
 
+  // Reused for every symbol; the names handed to dlsym must be
+  // null-terminated.
+  std::string Tmp;
   for (auto &KV : Symbols) {
     auto &Name = KV.first;
 
@@ -252,8 +255,8 @@ Error DynamicLibrarySearchGenerator::tryToGenerate(
     if (HasGlobalPrefix && (*Name).front() != GlobalPrefix)
       continue;
 
-    std::string Tmp((*Name).data() + HasGlobalPrefix,
-                    (*Name).size() - HasGlobalPrefix);
+    Tmp.assign((*Name).data() + HasGlobalPrefix,
+               (*Name).size() - HasGlobalPrefix);
     if (void *P = Dylib.getAddressOfSymbol(Tmp.c_str()))
       NewSymbols[Name] = {ExecutorAddr::fromPtr(P), JITSymbolFlags::Exported};
   }
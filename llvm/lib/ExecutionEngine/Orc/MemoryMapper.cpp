@@ -26,22 +26,25 @@ namespace orc {
 
 MemoryMapper::~MemoryMapper() {}
 
-InProcessMemoryMapper::InProcessMemoryMapper(size_t PageSize)
-    : PageSize(PageSize) {}
+InProcessMemoryMapper::InProcessMemoryMapper(size_t PageSize,
+                                             bool HugePageHint)
+    : PageSize(PageSize), HugePageHint(HugePageHint) {}
 
 Expected<std::unique_ptr<InProcessMemoryMapper>>
-InProcessMemoryMapper::Create() {
+InProcessMemoryMapper::Create(bool HugePageHint) {
   auto PageSize = sys::Process::getPageSize();
   if (!PageSize)
     return PageSize.takeError();
-  return std::make_unique<InProcessMemoryMapper>(*PageSize);
+  return std::make_unique<InProcessMemoryMapper>(*PageSize, HugePageHint);
 }
 
 void InProcessMemoryMapper::reserve(size_t NumBytes,
                                     OnReservedFunction OnReserved) {
   std::error_code EC;
-  auto MB = sys::Memory::allocateMappedMemory(
-      NumBytes, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
+  unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+  if (HugePageHint)
+    Flags |= sys::Memory::MF_HUGE_HINT;
+  auto MB = sys::Memory::allocateMappedMemory(NumBytes, nullptr, Flags, EC);
 
   if (EC)
     return OnReserved(errorCodeToError(EC));
@@ -64,6 +67,22 @@ void InProcessMemoryMapper::initialize(MemoryMapper::AllocInfo &AI,
   ExecutorAddr MinAddr(~0ULL);
   ExecutorAddr MaxAddr(0);
 
+  // Adjacent segments with the same protections, e.g. the standard and
+  // finalize lifetime parts of a group, are protected with a single call.
+  ExecutorAddr ProtBase, ProtEnd;
+  MemProt Prot = MemProt::None;
+  auto FlushProtections = [&]() -> Error {
+    if (ProtBase == ProtEnd)
+      return Error::success();
+    size_t Size = ProtEnd - ProtBase;
+    if (auto EC = sys::Memory::protectMappedMemory(
+            {ProtBase.toPtr<void *>(), Size}, toSysMemoryProtectionFlags(Prot)))
+      return errorCodeToError(EC);
+    if ((Prot & MemProt::Exec) == MemProt::Exec)
+      sys::Memory::InvalidateInstructionCache(ProtBase.toPtr<void *>(), Size);
+    return Error::success();
+  };
+
   // FIXME: Release finalize lifetime segments.
   for (auto &Segment : AI.Segments) {
     auto Base = AI.MappingBase + Segment.Offset;
@@ -78,14 +97,17 @@ void InProcessMemoryMapper::initialize(MemoryMapper::AllocInfo &AI,
     std::memset((Base + Segment.ContentSize).toPtr<void *>(), 0,
                 Segment.ZeroFillSize);
 
-    if (auto EC = sys::Memory::protectMappedMemory(
-            {Base.toPtr<void *>(), Size},
-            toSysMemoryProtectionFlags(Segment.AG.getMemProt()))) {
-      return OnInitialized(errorCodeToError(EC));
+    if (Segment.AG.getMemProt() != Prot || Base < ProtBase ||
+        Base > ExecutorAddr(alignTo(ProtEnd.getValue(), PageSize))) {
+      if (auto Err = FlushProtections())
+        return OnInitialized(std::move(Err));
+      ProtBase = Base;
+      Prot = Segment.AG.getMemProt();
     }
-    if ((Segment.AG.getMemProt() & MemProt::Exec) == MemProt::Exec)
-      sys::Memory::InvalidateInstructionCache(Base.toPtr<void *>(), Size);
+    ProtEnd = std::max(ProtEnd, Base + Size);
   }
+  if (auto Err = FlushProtections())
+    return OnInitialized(std::move(Err));
 
   auto DeinitializeActions = shared::runFinalizeActions(AI.Actions);
   if (!DeinitializeActions)
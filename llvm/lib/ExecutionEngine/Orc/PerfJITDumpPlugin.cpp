@@ -0,0 +1,257 @@
+//===--- PerfJITDumpPlugin.cpp -- Tell Linux's perf about JIT'd code ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The file format is described in tools/perf/Documentation/
+// jitdump-specification.txt of the Linux sources; see also
+// PerfJITEventListener, which does the same for RuntimeDyld.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PerfJITDumpPlugin.h"
+
+#include "llvm/BinaryFormat/ELF.h"
+#include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/Threading.h"
+
+#ifdef __linux__
+#include <sys/mman.h> // mmap()
+#include <time.h>     // clock_gettime()
+#include <unistd.h>   // close()
+#endif
+
+#include <cstddef>
+
+#define DEBUG_TYPE "orc"
+
+using namespace llvm;
+using namespace llvm::jitlink;
+using namespace llvm::orc;
+
+namespace {
+
+// The following are POD struct definitions from the perf jit specification.
+
+constexpr uint32_t JITDumpMagic = 0x4A695444; // "JiTD"
+constexpr uint32_t JITDumpVersion = 1;
+constexpr uint32_t JITCodeLoad = 0;
+
+struct JITDumpHeader {
+  uint32_t Magic;
+  uint32_t Version;
+  uint32_t TotalSize;
+  uint32_t ElfMach;
+  uint32_t Pad1;
+  uint32_t Pid;
+  uint64_t Timestamp;
+  uint64_t Flags;
+};
+
+struct JITDumpCodeLoad {
+  uint32_t Id;
+  uint32_t TotalSize;
+  uint64_t Timestamp;
+  uint32_t Pid;
+  uint32_t Tid;
+  uint64_t Vma;
+  uint64_t CodeAddr;
+  uint64_t CodeSize;
+  uint64_t CodeIndex;
+  // Followed by the null-terminated name and the code.
+};
+
+uint64_t getTimestamp() {
+#ifdef __linux__
+  // perf expects CLOCK_MONOTONIC unless the header says otherwise.
+  struct timespec TS;
+  if (clock_gettime(CLOCK_MONOTONIC, &TS))
+    return 0;
+  return uint64_t(TS.tv_sec) * 1000000000 + TS.tv_nsec;
+#else
+  return 0;
+#endif
+}
+
+uint32_t getELFMachine(const Triple &TT) {
+  switch (TT.getArch()) {
+  case Triple::aarch64:
+    return ELF::EM_AARCH64;
+  case Triple::arm:
+  case Triple::thumb:
+    return ELF::EM_ARM;
+  case Triple::loongarch64:
+    return ELF::EM_LOONGARCH;
+  case Triple::ppc64:
+  case Triple::ppc64le:
+    return ELF::EM_PPC64;
+  case Triple::riscv32:
+  case Triple::riscv64:
+    return ELF::EM_RISCV;
+  case Triple::x86:
+    return ELF::EM_386;
+  case Triple::x86_64:
+    return ELF::EM_X86_64;
+  default:
+    return ELF::EM_NONE;
+  }
+}
+
+} // namespace
+
+Expected<std::unique_ptr<PerfJITDumpPlugin>>
+PerfJITDumpPlugin::Create(const Triple &TT, StringRef OutputDir) {
+#ifdef __linux__
+  uint32_t ElfMach = getELFMachine(TT);
+  if (ElfMach == ELF::EM_NONE)
+    return make_error<StringError>("jitdump: unsupported architecture " +
+                                       TT.getArchName(),
+                                   inconvertibleErrorCode());
+  if (!getTimestamp())
+    return make_error<StringError>("jitdump: CLOCK_MONOTONIC is not supported",
+                                   inconvertibleErrorCode());
+
+  auto Pid = sys::Process::getProcessId();
+  SmallString<128> Path(OutputDir);
+  sys::path::append(Path, "jit-" + Twine(Pid) + ".dump");
+  int FD;
+  if (auto EC = sys::fs::openFileForReadWrite(Path, FD, sys::fs::CD_CreateNew,
+                                              sys::fs::OF_None))
+    return createFileError(Path, EC);
+
+  // perf notices the jitdump through this mapping, which must be executable
+  // to be recorded.
+  void *Marker = ::mmap(nullptr, sys::Process::getPageSizeEstimate(),
+                        PROT_READ | PROT_EXEC, MAP_PRIVATE, FD, 0);
+  if (Marker == MAP_FAILED) {
+    std::error_code EC(errno, std::generic_category());
+    ::close(FD);
+    return createFileError(Path, EC);
+  }
+
+  std::unique_ptr<PerfJITDumpPlugin> P(new PerfJITDumpPlugin(FD, Marker));
+  JITDumpHeader Header = {JITDumpMagic,   JITDumpVersion,
+                          sizeof(Header), ElfMach,
+                          0,              static_cast<uint32_t>(Pid),
+                          getTimestamp(), 0};
+  P->OS.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+  P->OS.flush();
+  if (auto EC = P->OS.error()) {
+    P->OS.clear_error();
+    return createFileError(Path, EC);
+  }
+  return std::move(P);
+#else
+  return make_error<StringError>("jitdump is only supported on Linux",
+                                 inconvertibleErrorCode());
+#endif
+}
+
+PerfJITDumpPlugin::PerfJITDumpPlugin(int FD, void *Marker)
+    : FD(FD), Marker(Marker), OS(FD, /*shouldClose=*/true) {
+#if LLVM_ENABLE_THREADS
+  Writer = std::thread([this]() { writeRecords(); });
+#endif
+}
+
+PerfJITDumpPlugin::~PerfJITDumpPlugin() {
+  {
+    std::lock_guard<std::mutex> Lock(QueueMutex);
+    ShuttingDown = true;
+  }
+  QueueChanged.notify_one();
+#if LLVM_ENABLE_THREADS
+  Writer.join();
+#endif
+#ifdef __linux__
+  ::munmap(Marker, sys::Process::getPageSizeEstimate());
+#endif
+  // Nothing to report the error to from here.
+  OS.clear_error();
+}
+
+void PerfJITDumpPlugin::modifyPassConfig(MaterializationResponsibility &MR,
+                                         LinkGraph &G,
+                                         PassConfiguration &Config) {
+  Config.PostFixupPasses.push_back(
+      [this](LinkGraph &G) { return recordFunctions(G); });
+}
+
+Error PerfJITDumpPlugin::recordFunctions(LinkGraph &G) {
+  uint32_t Pid = sys::Process::getProcessId();
+  uint32_t Tid = get_threadid();
+
+  std::vector<std::string> Records;
+  for (auto *Sym : G.defined_symbols()) {
+    if (!Sym->isCallable() || !Sym->hasName() || Sym->getSize() == 0 ||
+        Sym->getBlock().isZeroFill() ||
+        (Sym->getBlock().getSection().getMemProt() & MemProt::Exec) !=
+            MemProt::Exec)
+      continue;
+
+    ArrayRef<char> Code = Sym->getSymbolContent();
+    StringRef Name = Sym->getName();
+    JITDumpCodeLoad Rec;
+    Rec.Id = JITCodeLoad;
+    Rec.TotalSize = sizeof(Rec) + Name.size() + 1 + Code.size();
+    Rec.Timestamp = getTimestamp();
+    Rec.Pid = Pid;
+    Rec.Tid = Tid;
+    Rec.Vma = Rec.CodeAddr = Sym->getAddress().getValue();
+    Rec.CodeSize = Code.size();
+    Rec.CodeIndex = 0; // Set when the record is queued.
+
+    std::string &Bytes = Records.emplace_back();
+    Bytes.reserve(Rec.TotalSize);
+    Bytes.append(reinterpret_cast<const char *>(&Rec), sizeof(Rec));
+    Bytes.append(Name.data(), Name.size());
+    Bytes.push_back('\0');
+    Bytes.append(Code.data(), Code.size());
+  }
+
+  if (Records.empty())
+    return Error::success();
+
+  {
+    std::lock_guard<std::mutex> Lock(QueueMutex);
+    for (std::string &Bytes : Records) {
+      uint64_t CodeIndex = NextCodeIndex++;
+      memcpy(&Bytes[offsetof(JITDumpCodeLoad, CodeIndex)], &CodeIndex,
+             sizeof(CodeIndex));
+      Queue.push_back(std::move(Bytes));
+    }
+  }
+#if LLVM_ENABLE_THREADS
+  QueueChanged.notify_one();
+#else
+  writeRecords();
+#endif
+  return Error::success();
+}
+
+void PerfJITDumpPlugin::writeRecords() {
+  std::unique_lock<std::mutex> Lock(QueueMutex);
+  while (true) {
+#if LLVM_ENABLE_THREADS
+    QueueChanged.wait(Lock, [this]() { return ShuttingDown || !Queue.empty(); });
+#endif
+    std::deque<std::string> Pending;
+    Pending.swap(Queue);
+    bool Done = ShuttingDown || !LLVM_ENABLE_THREADS;
+    Lock.unlock();
+
+    for (const std::string &Bytes : Pending)
+      OS << Bytes;
+    OS.flush();
+
+    if (Done)
+      return;
+    Lock.lock();
+  }
+}
@@ -302,5 +302,32 @@ SpeculateQuery::ResultTy SequenceBBQuery::operator()(Function &F) {
   return CallerAndCalles;
 }
 
+// TraceQuery Implementation
+TraceQuery::TraceQuery(std::vector<std::string> Trace, size_t Lookahead)
+    : Lookahead(Lookahead) {
+  auto NewInfo = std::make_shared<TraceInfo>();
+  NewInfo->Trace = std::move(Trace);
+  for (size_t I = 0, E = NewInfo->Trace.size(); I != E; ++I)
+    NewInfo->FirstEntry.try_emplace(NewInfo->Trace[I], I);
+  Info = std::move(NewInfo);
+}
+
+TraceQuery::ResultTy TraceQuery::operator()(Function &F) {
+  DenseMap<StringRef, DenseSet<StringRef>> CallerAndCalles;
+  DenseSet<StringRef> Calles;
+
+  auto It = Info->FirstEntry.find(F.getName());
+  if (It != Info->FirstEntry.end()) {
+    const auto &Trace = Info->Trace;
+    for (size_t I = It->second + 1, E = Trace.size();
+         I != E && Calles.size() < Lookahead; ++I)
+      if (Trace[I] != F.getName())
+        Calles.insert(Trace[I]);
+  }
+
+  CallerAndCalles.insert({F.getName(), std::move(Calles)});
+  return CallerAndCalles;
+}
+
 } // namespace orc
 } // namespace llvm
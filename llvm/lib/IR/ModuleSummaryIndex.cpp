@@ -172,6 +172,14 @@ void ModuleSummaryIndex::collectDefinedFunctionsForModule(
   }
 }
 
+void ModuleSummaryIndex::collectDefinedGVSummariesForModule(
+    StringRef ModulePath, GVSummaryMapTy &GVSummaryMap) const {
+  for (auto &GlobalList : *this)
+    for (auto &Summary : GlobalList.second.SummaryList)
+      if (Summary->modulePath() == ModulePath)
+        GVSummaryMap[GlobalList.first] = Summary.get();
+}
+
 GlobalValueSummary *
 ModuleSummaryIndex::getGlobalValueSummary(uint64_t ValueGUID,
                                           bool PerModuleIndex) const {
@@ -822,18 +822,27 @@ void MCAssembler::layout(MCAsmLayout &Layout) {
     Sec.setOrdinal(SectionIndex++);
   }
 
-  // Assign layout order indices to sections and fragments.
+  // Assign layout order indices to sections and fragments. Sections without
+  // any fragment that can change size, such as most data sections, are left
+  // out of relaxation so that the fixed-point iteration below does not walk
+  // their fragments over and over again.
+  SmallVector<MCSection *, 0> SectionsToRelax;
   for (unsigned i = 0, e = Layout.getSectionOrder().size(); i != e; ++i) {
     MCSection *Sec = Layout.getSectionOrder()[i];
     Sec->setLayoutOrder(i);
 
     unsigned FragmentIndex = 0;
-    for (MCFragment &Frag : *Sec)
+    bool HasRelaxableFragments = false;
+    for (MCFragment &Frag : *Sec) {
       Frag.setLayoutOrder(FragmentIndex++);
+      HasRelaxableFragments |= mayNeedRelaxation(Frag);
+    }
+    if (HasRelaxableFragments)
+      SectionsToRelax.push_back(Sec);
   }
 
   // Layout until everything fits.
-  while (layoutOnce(Layout)) {
+  while (layoutOnce(Layout, SectionsToRelax)) {
     if (getContext().hadError())
       return;
     // Size of fragments in one section can depend on the size of fragments in
@@ -1159,6 +1168,23 @@ bool MCAssembler::relaxPseudoProbeAddr(MCAsmLayout &Layout,
   return OldSize != Data.size();
 }
 
+bool MCAssembler::mayNeedRelaxation(const MCFragment &F) {
+  // These must match the fragment kinds handled by relaxFragment.
+  switch (F.getKind()) {
+  default:
+    return false;
+  case MCFragment::FT_Relaxable:
+  case MCFragment::FT_Dwarf:
+  case MCFragment::FT_DwarfFrame:
+  case MCFragment::FT_LEB:
+  case MCFragment::FT_BoundaryAlign:
+  case MCFragment::FT_CVInlineLines:
+  case MCFragment::FT_CVDefRange:
+  case MCFragment::FT_PseudoProbe:
+    return true;
+  }
+}
+
 bool MCAssembler::relaxFragment(MCAsmLayout &Layout, MCFragment &F) {
   switch(F.getKind()) {
   default:
@@ -1206,12 +1232,13 @@ bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
   return false;
 }
 
-bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
+bool MCAssembler::layoutOnce(MCAsmLayout &Layout,
+                             ArrayRef<MCSection *> SectionsToRelax) {
   ++stats::RelaxationSteps;
 
   bool WasRelaxed = false;
-  for (MCSection &Sec : *this) {
-    while (layoutSectionOnce(Layout, Sec))
+  for (MCSection *Sec : SectionsToRelax) {
+    while (layoutSectionOnce(Layout, *Sec))
       WasRelaxed = true;
   }
 
@@ -14,6 +14,7 @@
 #include "llvm/BinaryFormat/COFF.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <cstddef>
@@ -90,19 +91,14 @@ static int charTailAt(StringPair *P, size_t Pos) {
   return (unsigned char)S[S.size() - Pos - 1];
 }
 
-// Three-way radix quicksort. This is much faster than std::sort with strcmp
-// because it does not compare characters that we already know the same.
-static void multikeySort(MutableArrayRef<StringPair *> Vec, int Pos) {
-tailcall:
-  if (Vec.size() <= 1)
-    return;
-
-  // Partition items so that items in [0, I) are greater than the pivot,
-  // [I, J) are the same as the pivot, and [J, Vec.size()) are less than
-  // the pivot.
+// Partitions Vec by the character at Pos from the end of each string so that
+// items in [0, I) are greater than the returned pivot, [I, J) are the same as
+// the pivot, and [J, Vec.size()) are less than the pivot.
+static int partitionTailAt(MutableArrayRef<StringPair *> Vec, int Pos,
+                           size_t &I, size_t &J) {
   int Pivot = charTailAt(Vec[0], Pos);
-  size_t I = 0;
-  size_t J = Vec.size();
+  I = 0;
+  J = Vec.size();
   for (size_t K = 1; K < J;) {
     int C = charTailAt(Vec[K], Pos);
     if (C > Pivot)
@@ -112,6 +108,18 @@ tailcall:
     else
       K++;
   }
+  return Pivot;
+}
+
+// Three-way radix quicksort. This is much faster than std::sort with strcmp
+// because it does not compare characters that we already know the same.
+static void multikeySort(MutableArrayRef<StringPair *> Vec, int Pos) {
+tailcall:
+  if (Vec.size() <= 1)
+    return;
+
+  size_t I, J;
+  int Pivot = partitionTailAt(Vec, Pos, I, J);
 
   multikeySort(Vec.slice(0, I), Pos);
   multikeySort(Vec.slice(J), Pos);
@@ -125,6 +133,34 @@ tailcall:
   }
 }
 
+// Partitions smaller than this are not worth a task of their own.
+static constexpr size_t MinParallelSortSize = 1 << 14;
+
+// Like multikeySort, but sorts large partitions in parallel. The strings are
+// distinct, so they are totally ordered and the result does not depend on how
+// the work is scheduled.
+static void parallelMultikeySort(MutableArrayRef<StringPair *> Vec, int Pos,
+                                 parallel::TaskGroup &TG) {
+  auto Sort = [&TG](MutableArrayRef<StringPair *> Part, int PartPos) {
+    if (Part.size() < MinParallelSortSize)
+      multikeySort(Part, PartPos);
+    else
+      TG.spawn([=, &TG] { parallelMultikeySort(Part, PartPos, TG); });
+  };
+
+  while (Vec.size() >= MinParallelSortSize) {
+    size_t I, J;
+    int Pivot = partitionTailAt(Vec, Pos, I, J);
+    Sort(Vec.slice(0, I), Pos);
+    Sort(Vec.slice(J), Pos);
+    if (Pivot == -1)
+      return;
+    Vec = Vec.slice(I, J - I);
+    ++Pos;
+  }
+  multikeySort(Vec, Pos);
+}
+
 void StringTableBuilder::finalize() {
   assert(K != DWARF);
   finalizeStringTable(/*Optimize=*/true);
@@ -143,7 +179,12 @@ void StringTableBuilder::finalizeStringTable(bool Optimize) {
     for (StringPair &P : StringIndexMap)
       Strings.push_back(&P);
 
-    multikeySort(Strings, 0);
+    if (Strings.size() >= MinParallelSortSize) {
+      parallel::TaskGroup TG;
+      parallelMultikeySort(Strings, 0, TG);
+    } else {
+      multikeySort(Strings, 0);
+    }
     initSize();
 
     StringRef Previous;
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -39,6 +40,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -513,11 +515,28 @@ static Error replaceAndRemoveSections(const CommonConfig &Config,
     return E;
 
   if (Config.CompressionType != DebugCompressionType::None) {
+    // Compression dominates the run time for objects with large debug info.
+    // The sections are independent, so compress them all in parallel first
+    // and only add them to the object, which is not thread-safe, afterwards.
+    SmallVector<const SectionBase *, 13> ToCompress;
+    for (const SectionBase &Sec : Obj.sections())
+      if (isCompressable(Sec))
+        ToCompress.push_back(&Sec);
+    SmallVector<std::optional<CompressedSection>, 0> Compressed(
+        ToCompress.size());
+    parallelFor(0, ToCompress.size(), [&](size_t I) {
+      Compressed[I].emplace(*ToCompress[I], Config.CompressionType,
+                            Obj.Is64Bits);
+    });
+
+    // replaceDebugSections visits the sections in the same order.
+    size_t Next = 0;
     if (Error Err = replaceDebugSections(
             Obj, isCompressable,
-            [&Config, &Obj](const SectionBase *S) -> Expected<SectionBase *> {
+            [&](const SectionBase *S) -> Expected<SectionBase *> {
+              assert(ToCompress[Next] == S && "section order changed");
               return &Obj.addSection<CompressedSection>(
-                  CompressedSection(*S, Config.CompressionType, Obj.Is64Bits));
+                  std::move(*Compressed[Next++]));
             }))
       return Err;
   } else if (Config.DecompressDebugSections) {
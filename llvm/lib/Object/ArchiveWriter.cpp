@@ -30,12 +30,14 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <cerrno>
 #include <map>
+#include <optional>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -629,14 +631,26 @@ static bool isECObject(object::SymbolicFile &Obj) {
   return false;
 }
 
-static Expected<std::vector<unsigned>>
-getSymbols(MemoryBufferRef Buf, uint16_t Index, raw_ostream &SymNames,
-           SymMap *SymMap, bool &HasObject) {
+namespace {
+/// The archive symbols defined by one member, in symbol table order.
+struct MemberSymbols {
+  /// Whether the member is a symbolic file at all.
+  bool IsSymbolic = false;
+  /// Whether the member goes into the EC symbol map of a COFF archive.
+  bool IsEC = false;
+  std::vector<std::string> Names;
+};
+} // namespace
+
+/// Parses \p Buf and returns the names of the symbols it defines. This only
+/// depends on the member itself, so it can run concurrently for all members.
+static Expected<MemberSymbols> readMemberSymbols(MemoryBufferRef Buf,
+                                                 bool NeedECFlag) {
   // In the scenario when LLVMContext is populated SymbolicFile will contain a
   // reference to it, thus SymbolicFile should be destroyed first.
   LLVMContext Context;
 
-  std::vector<unsigned> Ret;
+  MemberSymbols Ret;
   Expected<std::unique_ptr<SymbolicFile>> ObjOrErr =
       getSymbolicFile(Buf, Context);
   if (!ObjOrErr)
@@ -648,18 +662,35 @@ getSymbols(MemoryBufferRef Buf, uint16_t Index, raw_ostream &SymNames,
 
   std::unique_ptr<object::SymbolicFile> Obj = std::move(*ObjOrErr);
 
-  std::map<std::string, uint16_t> *Map = nullptr;
-  if (SymMap)
-    Map = SymMap->UseECMap && isECObject(*Obj) ? &SymMap->ECMap : &SymMap->Map;
-  HasObject = true;
+  Ret.IsSymbolic = true;
+  Ret.IsEC = NeedECFlag && isECObject(*Obj);
   for (const object::BasicSymbolRef &S : Obj->symbols()) {
     if (!isArchiveSymbol(S))
       continue;
+    std::string Name;
+    raw_string_ostream NameStream(Name);
+    if (Error E = S.printName(NameStream))
+      return std::move(E);
+    Ret.Names.push_back(std::move(Name));
+  }
+  return Ret;
+}
+
+/// Adds the symbols of member \p Index to the symbol table and returns their
+/// offsets in \p SymNames.
+static std::vector<unsigned> addSymbols(const MemberSymbols &Syms,
+                                        uint16_t Index, raw_ostream &SymNames,
+                                        SymMap *SymMap, bool &HasObject) {
+  std::vector<unsigned> Ret;
+  if (!Syms.IsSymbolic)
+    return Ret;
+
+  std::map<std::string, uint16_t> *Map = nullptr;
+  if (SymMap)
+    Map = SymMap->UseECMap && Syms.IsEC ? &SymMap->ECMap : &SymMap->Map;
+  HasObject = true;
+  for (const std::string &Name : Syms.Names) {
     if (Map) {
-      std::string Name;
-      raw_string_ostream NameStream(Name);
-      if (Error E = S.printName(NameStream))
-        return std::move(E);
       if (Map->find(Name) != Map->end())
         continue; // ignore duplicated symbol
       (*Map)[Name] = Index;
@@ -669,14 +700,22 @@ getSymbols(MemoryBufferRef Buf, uint16_t Index, raw_ostream &SymNames,
       }
     } else {
       Ret.push_back(SymNames.tell());
-      if (Error E = S.printName(SymNames))
-        return std::move(E);
-      SymNames << '\0';
+      SymNames << Name << '\0';
     }
   }
   return Ret;
 }
 
+static Expected<std::vector<unsigned>>
+getSymbols(MemoryBufferRef Buf, uint16_t Index, raw_ostream &SymNames,
+           SymMap *SymMap, bool &HasObject) {
+  Expected<MemberSymbols> SymsOrErr =
+      readMemberSymbols(Buf, SymMap && SymMap->UseECMap);
+  if (!SymsOrErr)
+    return SymsOrErr.takeError();
+  return addSymbols(*SymsOrErr, Index, SymNames, SymMap, HasObject);
+}
+
 static Expected<std::vector<MemberData>>
 computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                   object::Archive::Kind Kind, bool Thin, bool Deterministic,
@@ -745,6 +784,34 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
+  // Parsing the members dominates the time it takes to write the symbol table
+  // of a large archive. Members are independent, so read their symbols in
+  // parallel first and add them to the symbol table in member order below.
+  std::vector<MemberSymbols> MemberSyms;
+  if (NeedSymbols) {
+    std::vector<std::optional<Expected<MemberSymbols>>> SymsOrErrs(
+        NewMembers.size());
+    const bool NeedECFlag = SymMap && SymMap->UseECMap;
+    parallelFor(0, NewMembers.size(), [&](size_t I) {
+      SymsOrErrs[I].emplace(readMemberSymbols(
+          NewMembers[I].Buf->getMemBufferRef(), NeedECFlag));
+    });
+    Error Err = Error::success();
+    for (auto [M, SymsOrErr] : zip(NewMembers, SymsOrErrs)) {
+      if (!*SymsOrErr) {
+        Error E = SymsOrErr->takeError();
+        if (Err)
+          consumeError(std::move(E));
+        else
+          Err = createFileError(M.MemberName, std::move(E));
+        continue;
+      }
+      MemberSyms.push_back(std::move(**SymsOrErr));
+    }
+    if (Err)
+      return std::move(Err);
+  }
+
   // The big archive format needs to know the offset of the previous member
   // header.
   uint64_t PrevOffset = 0;
@@ -796,13 +863,9 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
     Out.flush();
 
     std::vector<unsigned> Symbols;
-    if (NeedSymbols) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(Buf, Index, SymNames, SymMap, HasObject);
-      if (!SymbolsOrErr)
-        return createFileError(M.MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
-    }
+    if (NeedSymbols)
+      Symbols = addSymbols(MemberSyms[Ret.size()], Index, SymNames, SymMap,
+                           HasObject);
 
     Pos += Header.size() + Data.size() + Padding.size();
     Ret.push_back({std::move(Symbols), std::move(Header), Data, Padding});
@@ -115,6 +115,13 @@ static cl::opt<bool> PrintPassNumbers(
     "print-pass-numbers", cl::init(false), cl::Hidden,
     cl::desc("Print pass names and their ordinals"));
 
+static cl::opt<int> ReportSlowPasses(
+    "report-slow-passes", cl::init(-1), cl::Hidden,
+    cl::value_desc("milliseconds"),
+    cl::desc("Report every pass run that takes at least this many "
+             "milliseconds, with the instruction counts of its IR unit "
+             "(0 reports every pass run)"));
+
 static cl::opt<unsigned>
     PrintAtPassNumber("print-at-pass-number", cl::init(0), cl::Hidden,
                 cl::desc("Print IR at pass with this number as "
@@ -1369,6 +1376,74 @@ void TimeProfilingPassesHandler::runBeforePass(StringRef PassID, Any IR) {
 
 void TimeProfilingPassesHandler::runAfterPass() { timeTraceProfilerEnd(); }
 
+static unsigned getInstructionCount(Any IR) {
+  if (const auto **M = any_cast<const Module *>(&IR))
+    return (*M)->getInstructionCount();
+
+  if (const auto **F = any_cast<const Function *>(&IR))
+    return (*F)->getInstructionCount();
+
+  if (const auto **C = any_cast<const LazyCallGraph::SCC *>(&IR)) {
+    unsigned Count = 0;
+    for (const LazyCallGraph::Node &N : **C)
+      Count += N.getFunction().getInstructionCount();
+    return Count;
+  }
+
+  if (const auto **L = any_cast<const Loop *>(&IR)) {
+    unsigned Count = 0;
+    for (const BasicBlock *BB : (*L)->blocks())
+      Count += BB->size();
+    return Count;
+  }
+
+  llvm_unreachable("Unknown wrapped IR type");
+}
+
+void SlowPassReporter::registerCallbacks(PassInstrumentationCallbacks &PIC) {
+  if (ReportSlowPasses < 0)
+    return;
+  // Like TimeProfilingPassesHandler, come last before and first after a pass
+  // so that the other callbacks are not included in the time.
+  PIC.registerBeforeNonSkippedPassCallback(
+      [this](StringRef P, Any IR) { this->runBeforePass(P, IR); });
+  PIC.registerAfterPassCallback(
+      [this](StringRef P, Any IR, const PreservedAnalyses &) {
+        this->runAfterPass(P, &IR);
+      },
+      true);
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef P, const PreservedAnalyses &) {
+        this->runAfterPass(P, nullptr);
+      },
+      true);
+}
+
+void SlowPassReporter::runBeforePass(StringRef PassID, Any IR) {
+  if (isSpecialPass(PassID, {"PassManager", "PassAdaptor"}))
+    return;
+  Runs.push_back(
+      {getIRName(IR), getInstructionCount(IR), std::chrono::steady_clock::now()});
+}
+
+void SlowPassReporter::runAfterPass(StringRef PassID, const Any *IR) {
+  if (isSpecialPass(PassID, {"PassManager", "PassAdaptor"}))
+    return;
+  auto End = std::chrono::steady_clock::now();
+  assert(!Runs.empty() && "pass finished without having started");
+  PassRun Run = Runs.pop_back_val();
+  std::chrono::duration<double, std::milli> Elapsed = End - Run.Start;
+  if (Elapsed.count() < ReportSlowPasses)
+    return;
+
+  // The IR unit is gone if the pass invalidated it.
+  errs() << formatv("Slow pass: {0} on {1} took {2:F1} ms, instructions: {3} "
+                    "-> {4}\n",
+                    PassID, Run.IRName, Elapsed.count(), Run.NumInstrsBefore,
+                    IR ? std::to_string(getInstructionCount(*IR))
+                       : std::string("(invalidated)"));
+}
+
 namespace {
 
 class DisplayNode;
@@ -2309,6 +2384,7 @@ void StandardInstrumentations::registerCallbacks(
   // Its 'AfterPassCallback' is put at the front of all the
   // AfterCallbacks by its `registerCallbacks`. This is necessary
   // to ensure that other callbacks are not included in the timings.
+  SlowPasses.registerCallbacks(PIC);
   TimeProfilingPasses.registerCallbacks(PIC);
 }
 
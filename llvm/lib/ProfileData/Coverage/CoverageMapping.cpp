@@ -271,6 +271,17 @@ Error CoverageMapping::loadFunctionRecord(
       Record.MappingRegions[0].Count.isZero() && Counts[0] > 0)
     return Error::success();
 
+  // Don't create records for (filenames, function) pairs we've already seen.
+  // Check this before evaluating the regions: with many TUs sharing inline
+  // functions and templates most records are duplicates.
+  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
+                                          Record.Filenames.end());
+  const auto FuncNameHash = hash_value(OrigFuncName);
+  auto ProvenanceIt = RecordProvenance.find(FilenamesHash);
+  if (ProvenanceIt != RecordProvenance.end() &&
+      ProvenanceIt->second.contains(FuncNameHash))
+    return Error::success();
+
   FunctionRecord Function(OrigFuncName, Record.Filenames);
   for (const auto &Region : Record.MappingRegions) {
     Expected<int64_t> ExecutionCount = Ctx.evaluate(Region.Count);
@@ -286,12 +297,7 @@ Error CoverageMapping::loadFunctionRecord(
     Function.pushRegion(Region, *ExecutionCount, *AltExecutionCount);
   }
 
-  // Don't create records for (filenames, function) pairs we've already seen.
-  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
-                                          Record.Filenames.end());
-  if (!RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName)).second)
-    return Error::success();
-
+  RecordProvenance[FilenamesHash].insert(FuncNameHash);
   Functions.push_back(std::move(Function));
 
   // Performance optimization: keep track of the indices of the function records
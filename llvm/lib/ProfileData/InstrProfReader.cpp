@@ -67,9 +67,12 @@ static InstrProfKind getProfileKindFromVersion(uint64_t Version) {
 }
 
 static Expected<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS) {
-  auto BufferOrErr = Filename.str() == "-" ? MemoryBuffer::getSTDIN()
-                                           : FS.getBufferForFile(Filename);
+setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS,
+                  bool RequiresNullTerminator = true) {
+  auto BufferOrErr = Filename.str() == "-"
+                         ? MemoryBuffer::getSTDIN()
+                         : FS.getBufferForFile(Filename, /*FileSize=*/-1,
+                                               RequiresNullTerminator);
   if (std::error_code EC = BufferOrErr.getError())
     return errorCodeToError(EC);
   return std::move(BufferOrErr.get());
@@ -203,8 +206,13 @@ InstrProfReader::create(std::unique_ptr<MemoryBuffer> Buffer,
 Expected<std::unique_ptr<IndexedInstrProfReader>>
 IndexedInstrProfReader::create(const Twine &Path, vfs::FileSystem &FS,
                                const Twine &RemappingPath) {
-  // Set up the buffer to read.
-  auto BufferOrError = setupMemoryBuffer(Path, FS);
+  // Set up the buffer to read. The indexed format is binary and does not need
+  // a null terminator; not asking for one lets the file always be mapped so
+  // that only the pages of the records that are looked up are read, rather
+  // than copying the whole profile when its size is a multiple of the page
+  // size.
+  auto BufferOrError =
+      setupMemoryBuffer(Path, FS, /*RequiresNullTerminator=*/false);
   if (Error E = BufferOrError.takeError())
     return std::move(E);
 
@@ -348,9 +348,14 @@ void InstrProfWriter::addTemporalProfileTraces(
 
 void InstrProfWriter::mergeRecordsFromWriter(InstrProfWriter &&IPW,
                                              function_ref<void(Error)> Warn) {
-  for (auto &I : IPW.FunctionData)
+  for (auto &I : IPW.FunctionData) {
     for (auto &Func : I.getValue())
       addRecord(I.getKey(), Func.first, std::move(Func.second), 1, Warn);
+    // Records that were merged into existing ones still own their counters.
+    // Free them as we go so that the two writers do not hold a full copy of
+    // the profile each until IPW is destroyed.
+    I.getValue().clear();
+  }
 
   BinaryIds.reserve(BinaryIds.size() + IPW.BinaryIds.size());
   for (auto &I : IPW.BinaryIds)
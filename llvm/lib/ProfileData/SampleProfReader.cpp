@@ -866,6 +866,15 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
         for (auto Name : FuncsToUse)
           FuncGuidsToUse.insert(Function::getGUID(Name));
       }
+      // This is called for every context in the profile, so parse MD5 names
+      // in place instead of through a temporary std::string.
+      auto IsFuncToUse = [&](StringRef FName) {
+        if (useMD5()) {
+          uint64_t GUID;
+          return !FName.getAsInteger(10, GUID) && FuncGuidsToUse.count(GUID);
+        }
+        return FuncsToUse.count(FName) || (Remapper && Remapper->exist(FName));
+      };
 
       // For each function in current module, load all context profiles for
       // the function as well as their callee contexts which can help profile
@@ -881,9 +890,7 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
         // For function in the current module, keep its farthest ancestor
         // context. This can be used to load itself and its child and
         // sibling contexts.
-        if ((useMD5() && FuncGuidsToUse.count(std::stoull(FName.data()))) ||
-            (!useMD5() && (FuncsToUse.count(FName) ||
-                           (Remapper && Remapper->exist(FName))))) {
+        if (IsFuncToUse(FName)) {
           if (!CommonContext || !CommonContext->IsPrefixOf(FContext))
             CommonContext = &FContext;
         }
@@ -163,13 +163,37 @@ Error zlib::decompress(ArrayRef<uint8_t> Input,
 
 bool zstd::isAvailable() { return true; }
 
+bool zstd::supportsMultithreading() {
+  ZSTD_bounds Bounds = ::ZSTD_cParam_getBounds(ZSTD_c_nbWorkers);
+  return !ZSTD_isError(Bounds.error) && Bounds.upperBound > 0;
+}
+
 void zstd::compress(ArrayRef<uint8_t> Input,
-                    SmallVectorImpl<uint8_t> &CompressedBuffer, int Level) {
+                    SmallVectorImpl<uint8_t> &CompressedBuffer, int Level,
+                    bool EnableLdm, unsigned NumWorkers) {
   unsigned long CompressedBufferSize = ::ZSTD_compressBound(Input.size());
   CompressedBuffer.resize_for_overwrite(CompressedBufferSize);
-  unsigned long CompressedSize =
-      ::ZSTD_compress((char *)CompressedBuffer.data(), CompressedBufferSize,
-                      (const char *)Input.data(), Input.size(), Level);
+  unsigned long CompressedSize;
+  if (!EnableLdm && !NumWorkers) {
+    CompressedSize =
+        ::ZSTD_compress((char *)CompressedBuffer.data(), CompressedBufferSize,
+                        (const char *)Input.data(), Input.size(), Level);
+  } else {
+    ZSTD_CCtx *Cctx = ::ZSTD_createCCtx();
+    if (!Cctx)
+      report_bad_alloc_error("Allocation failed");
+    ::ZSTD_CCtx_setParameter(Cctx, ZSTD_c_compressionLevel, Level);
+    if (EnableLdm)
+      ::ZSTD_CCtx_setParameter(Cctx, ZSTD_c_enableLongDistanceMatching, 1);
+    // This fails, leaving the compression single-threaded, if zstd was built
+    // without ZSTD_MULTITHREAD.
+    if (NumWorkers)
+      (void)::ZSTD_CCtx_setParameter(Cctx, ZSTD_c_nbWorkers, NumWorkers);
+    CompressedSize =
+        ::ZSTD_compress2(Cctx, CompressedBuffer.data(), CompressedBufferSize,
+                         Input.data(), Input.size());
+    ::ZSTD_freeCCtx(Cctx);
+  }
   if (ZSTD_isError(CompressedSize))
     report_bad_alloc_error("Allocation failed");
   // Tell MemorySanitizer that zstd output buffer is fully initialized.
@@ -204,8 +228,10 @@ Error zstd::decompress(ArrayRef<uint8_t> Input,
 
 #else
 bool zstd::isAvailable() { return false; }
+bool zstd::supportsMultithreading() { return false; }
 void zstd::compress(ArrayRef<uint8_t> Input,
-                    SmallVectorImpl<uint8_t> &CompressedBuffer, int Level) {
+                    SmallVectorImpl<uint8_t> &CompressedBuffer, int Level,
+                    bool EnableLdm, unsigned NumWorkers) {
   llvm_unreachable("zstd::compress is unavailable");
 }
 Error zstd::decompress(ArrayRef<uint8_t> Input, uint8_t *Output,
@@ -112,17 +112,21 @@ private:
 } // namespace
 
 static Expected<std::unique_ptr<InMemoryBuffer>>
-createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode) {
+createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode,
+                     unsigned Flags = 0) {
   std::error_code EC;
-  MemoryBlock MB = Memory::allocateMappedMemory(
-      Size, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
+  unsigned MemFlags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+  if (Flags & FileOutputBuffer::F_huge_pages)
+    MemFlags |= sys::Memory::MF_HUGE_HINT;
+  MemoryBlock MB = Memory::allocateMappedMemory(Size, nullptr, MemFlags, EC);
   if (EC)
     return errorCodeToError(EC);
   return std::make_unique<InMemoryBuffer>(Path, MB, Size, Mode);
 }
 
 static Expected<std::unique_ptr<FileOutputBuffer>>
-createOnDiskBuffer(StringRef Path, size_t Size, unsigned Mode) {
+createOnDiskBuffer(StringRef Path, size_t Size, unsigned Mode,
+                   unsigned Flags) {
   Expected<fs::TempFile> FileOrErr =
       fs::TempFile::create(Path + ".tmp%%%%%%%", Mode);
   if (!FileOrErr)
@@ -144,7 +148,7 @@ createOnDiskBuffer(StringRef Path, size_t Size, unsigned Mode) {
   // If that happens, we fall back to in-memory buffer as the last resort.
   if (EC) {
     consumeError(File.discard());
-    return createInMemoryBuffer(Path, Size, Mode);
+    return createInMemoryBuffer(Path, Size, Mode, Flags);
   }
 
   return std::make_unique<OnDiskBuffer>(Path, std::move(File),
@@ -156,7 +160,7 @@ Expected<std::unique_ptr<FileOutputBuffer>>
 FileOutputBuffer::create(StringRef Path, size_t Size, unsigned Flags) {
   // Handle "-" as stdout just like llvm::raw_ostream does.
   if (Path == "-")
-    return createInMemoryBuffer("-", Size, /*Mode=*/0);
+    return createInMemoryBuffer("-", Size, /*Mode=*/0, Flags);
 
   unsigned Mode = fs::all_read | fs::all_write;
   if (Flags & F_executable)
@@ -184,10 +188,10 @@ FileOutputBuffer::create(StringRef Path, size_t Size, unsigned Flags) {
   case fs::file_type::file_not_found:
   case fs::file_type::status_error:
     if (Flags & F_no_mmap)
-      return createInMemoryBuffer(Path, Size, Mode);
+      return createInMemoryBuffer(Path, Size, Mode, Flags);
     else
-      return createOnDiskBuffer(Path, Size, Mode);
+      return createOnDiskBuffer(Path, Size, Mode, Flags);
   default:
-    return createInMemoryBuffer(Path, Size, Mode);
+    return createInMemoryBuffer(Path, Size, Mode, Flags);
   }
 }
@@ -127,9 +127,13 @@ Expected<GlobPattern> GlobPattern::create(StringRef S) {
     return Pat;
   }
 
-  // Otherwise, we need to do real glob pattern matching.
-  // Parse the pattern now.
+  // Otherwise, we need to do real glob pattern matching. The characters before
+  // the first metacharacter are compared directly, which rejects most
+  // candidates early. Parse the rest of the pattern now.
   StringRef Original = S;
+  size_t PrefixSize = S.find_first_of("?*[\\");
+  Pat.TokensPrefix = S.take_front(PrefixSize);
+  S = S.drop_front(PrefixSize);
   while (!S.empty()) {
     Expected<BitVector> BV = scan(S, Original);
     if (!BV)
@@ -146,32 +150,41 @@ bool GlobPattern::match(StringRef S) const {
     return S.startswith(*Prefix);
   if (Suffix)
     return S.endswith(*Suffix);
+  if (!S.consume_front(TokensPrefix))
+    return false;
   return matchOne(Tokens, S);
 }
 
 // Runs glob pattern Pats against string S.
+//
+// Every token other than '*' consumes exactly one character, so when a match
+// attempt fails it is enough to backtrack to the most recent '*' and let it
+// absorb one more character: anything an earlier '*' could absorb, the later
+// one can as well. This keeps matching O(|Pats| * |S|) instead of exponential
+// in the number of '*'s.
 bool GlobPattern::matchOne(ArrayRef<BitVector> Pats, StringRef S) const {
-  for (;;) {
-    if (Pats.empty())
-      return S.empty();
-
-    // If Pats[0] is '*', try to match Pats[1..] against all possible
-    // tail strings of S to see at least one pattern succeeds.
-    if (Pats[0].size() == 0) {
-      Pats = Pats.slice(1);
-      if (Pats.empty())
-        // Fast path. If a pattern is '*', it matches anything.
-        return true;
-      for (size_t I = 0, E = S.size(); I < E; ++I)
-        if (matchOne(Pats, S.substr(I)))
-          return true;
-      return false;
+  size_t P = 0, I = 0;
+  // Pattern and string positions just after the most recent '*'.
+  std::optional<size_t> StarP;
+  size_t StarI = 0;
+  while (I < S.size()) {
+    if (P < Pats.size() && Pats[P].size() == 0) {
+      StarP = ++P;
+      StarI = I;
+      continue;
     }
-
-    // If Pats[0] is not '*', it must consume one character.
-    if (S.empty() || !Pats[0][(uint8_t)S[0]])
+    if (P < Pats.size() && Pats[P][(uint8_t)S[I]]) {
+      ++P;
+      ++I;
+      continue;
+    }
+    if (!StarP)
       return false;
-    Pats = Pats.slice(1);
-    S = S.substr(1);
+    P = *StarP;
+    I = ++StarI;
   }
+  // The string is exhausted; only '*'s may remain in the pattern.
+  while (P < Pats.size() && Pats[P].size() == 0)
+    ++P;
+  return P == Pats.size();
 }
@@ -14,6 +14,7 @@
 #include <atomic>
 #include <deque>
 #include <future>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -27,6 +28,7 @@ namespace parallel {
 static thread_local unsigned threadIndex = UINT_MAX;
 
 unsigned getThreadIndex() { GET_THREAD_INDEX_IMPL; }
+unsigned getThreadIndexOrMax() { GET_THREAD_INDEX_OR_MAX_IMPL; }
 #else
 thread_local unsigned threadIndex = UINT_MAX;
 #endif
@@ -45,12 +47,22 @@ public:
   static Executor *getDefaultExecutor();
 };
 
-/// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+/// An implementation of an Executor that runs closures on a thread pool.
+///
+/// Every worker owns a queue. Tasks spawned from a worker go to the back of
+/// its own queue, which the worker pops in filo order. Tasks spawned from any
+/// other thread are distributed round-robin. A worker whose queue is empty
+/// steals from the front of the other queues, so a busy pool does not
+/// serialize on a single lock. Only workers that have nothing to do touch the
+/// shared mutex, to go to sleep.
+///
+/// Sequential tasks are kept in a separate shared queue and are run one at a
+/// time in the order they were spawned.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(ThreadPoolStrategy S = hardware_concurrency()) {
     ThreadCount = S.compute_thread_count();
+    Queues = std::make_unique<WorkQueue[]>(ThreadCount);
     // Spawn all but one of the threads in another thread as spawning threads
     // can take a while.
     Threads.reserve(ThreadCount);
@@ -99,54 +111,114 @@ public:
   };
 
   void add(std::function<void()> F, bool Sequential = false) override {
-    {
-      std::lock_guard<std::mutex> Lock(Mutex);
-      if (Sequential)
+    if (Sequential) {
+      {
+        std::lock_guard<std::mutex> Lock(Mutex);
         WorkQueueSequential.emplace_front(std::move(F));
-      else
-        WorkQueue.emplace_back(std::move(F));
+        ++NumSequentialTasks;
+      }
+      Cond.notify_one();
+      return;
+    }
+
+    unsigned Index = threadIndex < ThreadCount
+                         ? threadIndex
+                         : NextQueue.fetch_add(1, std::memory_order_relaxed) %
+                               ThreadCount;
+    ++NumTasks;
+    {
+      WorkQueue &Q = Queues[Index];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      Q.Tasks.emplace_back(std::move(F));
+    }
+
+    // A worker increments NumSleeping before it checks NumTasks, so either it
+    // sees the new task or we see it sleeping. Taking the mutex makes sure it
+    // is already waiting when we notify it.
+    if (NumSleeping > 0) {
+      { std::lock_guard<std::mutex> Lock(Mutex); }
+      Cond.notify_one();
     }
-    Cond.notify_one();
   }
 
   size_t getThreadCount() const override { return ThreadCount; }
 
 private:
+  struct alignas(64) WorkQueue {
+    std::mutex Mutex;
+    std::deque<std::function<void()>> Tasks;
+  };
+
   bool hasSequentialTasks() const {
     return !WorkQueueSequential.empty() && !SequentialQueueIsLocked;
   }
 
-  bool hasGeneralTasks() const { return !WorkQueue.empty(); }
+  bool runSequentialTask() {
+    if (NumSequentialTasks == 0)
+      return false;
+    std::unique_lock<std::mutex> Lock(Mutex);
+    if (!hasSequentialTasks())
+      return false;
+    SequentialQueueIsLocked = true;
+    auto Task = std::move(WorkQueueSequential.back());
+    WorkQueueSequential.pop_back();
+    --NumSequentialTasks;
+    Lock.unlock();
+    Task();
+    SequentialQueueIsLocked = false;
+    return true;
+  }
+
+  // Pops a task from the back of our own queue or, failing that, steals one
+  // from the front of another worker's queue.
+  std::function<void()> takeTask(unsigned ThreadID) {
+    if (NumTasks == 0)
+      return nullptr;
+    for (unsigned I = 0; I != ThreadCount; ++I) {
+      WorkQueue &Q = Queues[(ThreadID + I) % ThreadCount];
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      if (Q.Tasks.empty())
+        continue;
+      std::function<void()> Task;
+      if (I == 0) {
+        Task = std::move(Q.Tasks.back());
+        Q.Tasks.pop_back();
+      } else {
+        Task = std::move(Q.Tasks.front());
+        Q.Tasks.pop_front();
+      }
+      --NumTasks;
+      return Task;
+    }
+    return nullptr;
+  }
 
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
     S.apply_thread_strategy(ThreadID);
-    while (true) {
+    while (!Stop) {
+      if (runSequentialTask())
+        continue;
+      if (std::function<void()> Task = takeTask(ThreadID)) {
+        Task();
+        continue;
+      }
+
       std::unique_lock<std::mutex> Lock(Mutex);
-      Cond.wait(Lock, [&] {
-        return Stop || hasGeneralTasks() || hasSequentialTasks();
-      });
-      if (Stop)
-        break;
-      bool Sequential = hasSequentialTasks();
-      if (Sequential)
-        SequentialQueueIsLocked = true;
-      else
-        assert(hasGeneralTasks());
-
-      auto &Queue = Sequential ? WorkQueueSequential : WorkQueue;
-      auto Task = std::move(Queue.back());
-      Queue.pop_back();
-      Lock.unlock();
-      Task();
-      if (Sequential)
-        SequentialQueueIsLocked = false;
+      ++NumSleeping;
+      Cond.wait(Lock,
+                [&] { return Stop || NumTasks > 0 || hasSequentialTasks(); });
+      --NumSleeping;
     }
   }
 
   std::atomic<bool> Stop{false};
   std::atomic<bool> SequentialQueueIsLocked{false};
-  std::deque<std::function<void()>> WorkQueue;
+  std::atomic<size_t> NumTasks{0};
+  std::atomic<size_t> NumSequentialTasks{0};
+  std::atomic<unsigned> NumSleeping{0};
+  std::atomic<unsigned> NextQueue{0};
+  std::unique_ptr<WorkQueue[]> Queues;
   std::deque<std::function<void()>> WorkQueueSequential;
   std::mutex Mutex;
   std::condition_variable Cond;
@@ -190,19 +262,29 @@ size_t getThreadCount() {
 
 // Latch::sync() called by the dtor may cause one thread to block. If is a dead
 // lock if all threads in the default executor are blocked. To prevent the dead
-// lock, only allow the root TaskGroup to run tasks parallelly. In the scenario
-// of nested parallel_for_each(), only the outermost one runs parallelly.
+// lock, a nested TaskGroup, which is created on an executor thread, spawns its
+// tasks onto the executor so that idle threads can steal them, but its thread
+// runs every task that was not stolen itself before it waits. It therefore
+// only waits for tasks that are already running on other threads, and never
+// runs tasks of another TaskGroup while it waits.
+struct TaskGroup::NestedTask {
+  std::atomic<bool> Claimed{false};
+  std::function<void()> F;
+};
+
 TaskGroup::TaskGroup()
 #if LLVM_ENABLE_THREADS
     : Parallel((parallel::strategy.ThreadsRequested != 1) &&
-               (threadIndex == UINT_MAX)) {}
+               (threadIndex == UINT_MAX)),
+      Nested((parallel::strategy.ThreadsRequested != 1) &&
+             (threadIndex != UINT_MAX)) {}
 #else
-    : Parallel(false) {}
+    : Parallel(false), Nested(false) {}
 #endif
 TaskGroup::~TaskGroup() {
   // We must ensure that all the workloads have finished before decrementing the
   // instances count.
-  L.sync();
+  sync();
 }
 
 void TaskGroup::spawn(std::function<void()> F, bool Sequential) {
@@ -217,10 +299,50 @@ void TaskGroup::spawn(std::function<void()> F, bool Sequential) {
         Sequential);
     return;
   }
+  if (Nested && !Sequential) {
+    // Whichever of the executor and sync() claims the task first runs it. The
+    // executor may only get to it after this TaskGroup is gone, so the task is
+    // shared and `this` is only used by the one that claims it.
+    auto Task = std::make_shared<NestedTask>();
+    Task->F = std::move(F);
+    L.inc();
+    {
+      std::lock_guard<std::mutex> Lock(NestedMutex);
+      NestedTasks.push_back(Task);
+    }
+    detail::Executor::getDefaultExecutor()->add([this, Task] {
+      if (!Task->Claimed.exchange(true)) {
+        Task->F();
+        L.dec();
+      }
+    });
+    return;
+  }
 #endif
   F();
 }
 
+void TaskGroup::sync() {
+  // Run the nested tasks that have not been stolen, newest first, as the
+  // executor would pop them from this thread's queue. Tasks may spawn more
+  // tasks into this TaskGroup while we do so.
+  while (Nested) {
+    std::shared_ptr<NestedTask> Task;
+    {
+      std::lock_guard<std::mutex> Lock(NestedMutex);
+      if (NestedTasks.empty())
+        break;
+      Task = std::move(NestedTasks.back());
+      NestedTasks.pop_back();
+    }
+    if (!Task->Claimed.exchange(true)) {
+      Task->F();
+      L.dec();
+    }
+  }
+  L.sync();
+}
+
 } // namespace parallel
 } // namespace llvm
 
@@ -586,6 +586,78 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
 
 void ProxyFileSystem::anchor() {}
 
+std::optional<llvm::ErrorOr<Status>>
+CachingFileSystem::lookup(StringRef AbsPath) {
+  std::lock_guard<std::mutex> Lock(CacheLock);
+  auto It = StatusCache.find(AbsPath);
+  if (It == StatusCache.end())
+    return std::nullopt;
+  ++NumCacheHits;
+  return It->second;
+}
+
+llvm::ErrorOr<Status> CachingFileSystem::status(const Twine &Path) {
+  SmallString<256> AbsPath;
+  Path.toVector(AbsPath);
+  if (std::error_code EC = makeAbsolute(AbsPath))
+    return EC;
+  // A relative path shares its entry with the absolute one, so report the
+  // status under the name the caller asked for. Other spellings, such as
+  // "a/../b" for "b", get entries of their own: removing ".." is only correct
+  // once symlinks are resolved.
+  auto Rename = [&](const llvm::ErrorOr<Status> &S) -> llvm::ErrorOr<Status> {
+    if (!S)
+      return S.getError();
+    return Status::copyWithNewName(*S, Path);
+  };
+  if (std::optional<llvm::ErrorOr<Status>> Cached = lookup(AbsPath))
+    return Rename(*Cached);
+
+  // Query outside of the lock so that lookups of different paths can proceed
+  // in parallel. If two threads race on the same path the first result wins.
+  llvm::ErrorOr<Status> Result = getUnderlyingFS().status(Path);
+  std::lock_guard<std::mutex> Lock(CacheLock);
+  return Rename(
+      StatusCache.try_emplace(AbsPath, std::move(Result)).first->second);
+}
+
+llvm::ErrorOr<std::unique_ptr<File>>
+CachingFileSystem::openFileForRead(const Twine &Path) {
+  SmallString<256> AbsPath;
+  Path.toVector(AbsPath);
+  if (std::error_code EC = makeAbsolute(AbsPath))
+    return EC;
+  // Avoid querying the underlying file system for paths we know are missing.
+  if (std::optional<llvm::ErrorOr<Status>> Cached = lookup(AbsPath))
+    if (!*Cached)
+      return Cached->getError();
+  return getUnderlyingFS().openFileForRead(Path);
+}
+
+void CachingFileSystem::invalidate() {
+  std::lock_guard<std::mutex> Lock(CacheLock);
+  StatusCache.clear();
+}
+
+unsigned CachingFileSystem::getNumCacheHits() const {
+  std::lock_guard<std::mutex> Lock(CacheLock);
+  return NumCacheHits;
+}
+
+void CachingFileSystem::printImpl(raw_ostream &OS, PrintType Type,
+                                  unsigned IndentLevel) const {
+  printIndent(OS, IndentLevel);
+  OS << "CachingFileSystem\n";
+  if (Type == PrintType::Summary)
+    return;
+
+  if (Type == PrintType::Contents)
+    Type = PrintType::Summary;
+  getUnderlyingFS().print(OS, Type, IndentLevel + 1);
+}
+
+void CachingFileSystem::anchor() {}
+
 namespace llvm {
 namespace vfs {
 
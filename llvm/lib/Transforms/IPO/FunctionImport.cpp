@@ -38,12 +38,14 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <set>
@@ -84,6 +86,11 @@ static cl::opt<bool>
     ForceImportAll("force-import-all", cl::init(false), cl::Hidden,
                    cl::desc("Import functions with noinline attribute"));
 
+static cl::opt<bool> ParallelImportComputation(
+    "parallel-import-computation", cl::init(true), cl::Hidden,
+    cl::desc("Compute the imports of the modules of a ThinLTO link in "
+             "parallel"));
+
 static cl::opt<float>
     ImportInstrFactor("import-instr-evolution-factor", cl::init(0.7),
                       cl::Hidden, cl::value_desc("x"),
@@ -406,13 +413,15 @@ static void computeImportForFunction(
     StringMap<FunctionImporter::ExportSetTy> *ExportLists,
     FunctionImporter::ImportThresholdsTy &ImportThresholds) {
   GVImporter.onImportingSummary(Summary);
-  static int ImportCount = 0;
+  // Modules may be processed concurrently, see ComputeCrossModuleImport.
+  static std::atomic<int> ImportCount = 0;
   for (const auto &Edge : Summary.calls()) {
     ValueInfo VI = Edge.first;
     LLVM_DEBUG(dbgs() << " edge -> " << VI << " Threshold:" << Threshold
                       << "\n");
 
-    if (ImportCutoff >= 0 && ImportCount >= ImportCutoff) {
+    if (ImportCutoff >= 0 &&
+        ImportCount.load(std::memory_order_relaxed) >= ImportCutoff) {
       LLVM_DEBUG(dbgs() << "ignored! import-cutoff value of " << ImportCutoff
                         << " reached.\n");
       continue;
@@ -560,7 +569,7 @@ static void computeImportForFunction(
 
     const auto AdjThreshold = GetAdjustedThreshold(Threshold, IsHotCallsite);
 
-    ImportCount++;
+    ImportCount.fetch_add(1, std::memory_order_relaxed);
 
     // Insert the newly imported function to the worklist.
     Worklist.emplace_back(ResolvedCalleeSummary, AdjThreshold);
@@ -718,24 +727,57 @@ void llvm::ComputeCrossModuleImport(
     StringMap<FunctionImporter::ImportMapTy> &ImportLists,
     StringMap<FunctionImporter::ExportSetTy> &ExportLists) {
   // For each module that has function defined, compute the import/export lists.
+  // The modules only read the index, so their imports are computed in
+  // parallel, each into its own export lists. The export lists are merged in
+  // module order afterwards so that the result does not depend on the
+  // scheduling. The debug output, -print-import-failures and -import-cutoff
+  // are only meaningful when the modules are processed one after the other.
+  bool Sequential =
+      !ParallelImportComputation || ImportCutoff >= 0 || PrintImportFailures;
+  DEBUG_WITH_TYPE(DEBUG_TYPE, Sequential = true);
+  std::vector<const StringMapEntry<GVSummaryMapTy> *> Modules;
+  std::vector<FunctionImporter::ImportMapTy *> ModuleImportLists;
   for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
-    auto &ImportList = ImportLists[DefinedGVSummaries.first()];
+    Modules.push_back(&DefinedGVSummaries);
+    ModuleImportLists.push_back(&ImportLists[DefinedGVSummaries.first()]);
+  }
+  std::vector<StringMap<FunctionImporter::ExportSetTy>> ModuleExportLists(
+      Sequential ? 0 : Modules.size());
+  auto ComputeForModule = [&](size_t I) {
     LLVM_DEBUG(dbgs() << "Computing import for Module '"
-                      << DefinedGVSummaries.first() << "'\n");
-    ComputeImportForModule(DefinedGVSummaries.second, isPrevailing, Index,
-                           DefinedGVSummaries.first(), ImportList,
-                           &ExportLists);
+                      << Modules[I]->first() << "'\n");
+    ComputeImportForModule(Modules[I]->second, isPrevailing, Index,
+                           Modules[I]->first(), *ModuleImportLists[I],
+                           Sequential ? &ExportLists : &ModuleExportLists[I]);
+  };
+  if (Sequential) {
+    for (size_t I = 0, E = Modules.size(); I != E; ++I)
+      ComputeForModule(I);
+  } else {
+    parallelFor(0, Modules.size(), ComputeForModule);
+    for (StringMap<FunctionImporter::ExportSetTy> &ModuleExports :
+         ModuleExportLists)
+      for (auto &ELI : ModuleExports)
+        ExportLists[ELI.first()].insert(ELI.second.begin(), ELI.second.end());
   }
 
   // When computing imports we only added the variables and functions being
   // imported to the export list. We also need to mark any references and calls
   // they make as exported as well. We do this here, as it is more efficient
   // since we may import the same values multiple times into different modules
-  // during the import computation.
-  for (auto &ELI : ExportLists) {
+  // during the import computation. Each exporting module only updates its own
+  // list, so this is done in parallel as well.
+  std::vector<StringMapEntry<FunctionImporter::ExportSetTy> *> Exporters;
+  for (auto &ELI : ExportLists)
+    Exporters.push_back(&ELI);
+  const GVSummaryMapTy NoSummaries;
+  auto ExportReferences = [&](size_t I) {
+    StringMapEntry<FunctionImporter::ExportSetTy> &ELI = *Exporters[I];
     FunctionImporter::ExportSetTy NewExports;
-    const auto &DefinedGVSummaries =
-        ModuleToDefinedGVSummaries.lookup(ELI.first());
+    auto DefinedIt = ModuleToDefinedGVSummaries.find(ELI.first());
+    const GVSummaryMapTy &DefinedGVSummaries =
+        DefinedIt == ModuleToDefinedGVSummaries.end() ? NoSummaries
+                                                      : DefinedIt->second;
     for (auto &EI : ELI.second) {
       // Find the copy defined in the exporting module so that we can mark the
       // values it references in that specific definition as exported.
@@ -776,6 +818,12 @@ void llvm::ComputeCrossModuleImport(
         ++EI;
     }
     ELI.second.insert(NewExports.begin(), NewExports.end());
+  };
+  if (Sequential) {
+    for (size_t I = 0, E = Exporters.size(); I != E; ++I)
+      ExportReferences(I);
+  } else {
+    parallelFor(0, Exporters.size(), ExportReferences);
   }
 
   assert(checkVariableImport(Index, ImportLists, ExportLists));
@@ -90,6 +90,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/TargetParser/Triple.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/FunctionAttrs.h"
@@ -2405,27 +2406,35 @@ void DevirtIndex::run() {
     }
   }
 
-  std::set<ValueInfo> DevirtTargets;
-  // For each (type, offset) pair:
-  for (auto &S : CallSlots) {
-    // Search each of the members of the type identifier for the virtual
-    // function implementation at offset S.first.ByteOffset, and add to
-    // TargetsForSlot.
-    std::vector<ValueInfo> TargetsForSlot;
-    auto TidSummary = ExportSummary.getTypeIdCompatibleVtableSummary(S.first.TypeID);
+  // For each (type, offset) pair, search each of the members of the type
+  // identifier for the virtual function implementation at offset
+  // S.first.ByteOffset, and add to TargetsForSlots. This only reads the
+  // summary, so it is done for all slots in parallel. FoundTargets is a byte
+  // per slot rather than a std::vector<bool> so that slots can be written
+  // concurrently.
+  std::vector<std::vector<ValueInfo>> TargetsForSlots(CallSlots.size());
+  std::vector<uint8_t> FoundTargets(CallSlots.size());
+  parallelFor(0, CallSlots.size(), [&](size_t I) {
+    const VTableSlotSummary &Slot = (CallSlots.begin() + I)->first;
+    auto TidSummary = ExportSummary.getTypeIdCompatibleVtableSummary(Slot.TypeID);
     assert(TidSummary);
+    FoundTargets[I] = tryFindVirtualCallTargets(TargetsForSlots[I],
+                                                *TidSummary, Slot.ByteOffset);
+  });
+
+  // Resolve the slots in order to keep the summary deterministic.
+  std::set<ValueInfo> DevirtTargets;
+  for (size_t I = 0, E = CallSlots.size(); I != E; ++I) {
+    auto &S = *(CallSlots.begin() + I);
     // The type id summary would have been created while building the NameByGUID
-    // map earlier.
+    // map earlier. The resolution entry is created for every slot, whether or
+    // not its targets could be found.
     WholeProgramDevirtResolution *Res =
         &ExportSummary.getTypeIdSummary(S.first.TypeID)
              ->WPDRes[S.first.ByteOffset];
-    if (tryFindVirtualCallTargets(TargetsForSlot, *TidSummary,
-                                  S.first.ByteOffset)) {
-
-      if (!trySingleImplDevirt(TargetsForSlot, S.first, S.second, Res,
-                               DevirtTargets))
-        continue;
-    }
+    if (FoundTargets[I])
+      trySingleImplDevirt(TargetsForSlots[I], S.first, S.second, Res,
+                          DevirtTargets);
   }
 
   // Optionally have the thin link print message for each devirtualized
@@ -27,6 +27,7 @@
 #include "llvm/ADT/Twine.h"
 #include "llvm/Analysis/GlobalsModRef.h"
 #include "llvm/Analysis/MemoryBuiltins.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/Analysis/StackSafetyAnalysis.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/ValueTracking.h"
@@ -433,6 +434,13 @@ static cl::opt<AsanDtorKind> ClOverrideDestructorKind(
                           "Use global destructors")),
     cl::init(AsanDtorKind::Invalid), cl::Hidden);
 
+static cl::opt<int> ClHotPercentileCutoff(
+    "asan-percentile-cutoff-hot",
+    cl::desc("Do not check memory accesses in functions whose entry count is "
+             "in this hot percentile of the profile (in units of 1/1000000); "
+             "0 checks all functions"),
+    cl::Hidden, cl::init(0));
+
 // Debug flags.
 
 static cl::opt<int> ClDebug("asan-debug", cl::desc("debug"), cl::Hidden,
@@ -456,6 +464,8 @@ STATISTIC(NumOptimizedAccessesToGlobalVar,
           "Number of optimized accesses to global vars");
 STATISTIC(NumOptimizedAccessesToStackVar,
           "Number of optimized accesses to stack vars");
+STATISTIC(NumSkippedHotFunctions,
+          "Number of hot functions without memory access checks");
 
 namespace {
 
@@ -711,7 +721,8 @@ struct AddressSanitizer {
   void instrumentMemIntrinsic(MemIntrinsic *MI);
   Value *memToShadow(Value *Shadow, IRBuilder<> &IRB);
   bool suppressInstrumentationSiteForDebug(int &Instrumented);
-  bool instrumentFunction(Function &F, const TargetLibraryInfo *TLI);
+  bool instrumentFunction(Function &F, const TargetLibraryInfo *TLI,
+                          const ProfileSummaryInfo *PSI);
   bool maybeInsertAsanInitAtFunctionEntry(Function &F);
   bool maybeInsertDynamicShadowAtFunctionEntry(Function &F);
   void markEscapedLocalAllocas(Function &F);
@@ -1160,12 +1171,15 @@ PreservedAnalyses AddressSanitizerPass::run(Module &M,
   auto &FAM = MAM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager();
   const StackSafetyGlobalInfo *const SSGI =
       ClUseStackSafety ? &MAM.getResult<StackSafetyGlobalAnalysis>(M) : nullptr;
+  const ProfileSummaryInfo *PSI =
+      ClHotPercentileCutoff > 0 ? &MAM.getResult<ProfileSummaryAnalysis>(M)
+                                : nullptr;
   for (Function &F : M) {
     AddressSanitizer FunctionSanitizer(M, SSGI, Options.CompileKernel,
                                        Options.Recover, Options.UseAfterScope,
                                        Options.UseAfterReturn);
     const TargetLibraryInfo &TLI = FAM.getResult<TargetLibraryAnalysis>(F);
-    Modified |= FunctionSanitizer.instrumentFunction(F, &TLI);
+    Modified |= FunctionSanitizer.instrumentFunction(F, &TLI, PSI);
   }
   Modified |= ModuleSanitizer.instrumentModule(M);
   if (!Modified)
@@ -2768,7 +2782,8 @@ bool AddressSanitizer::suppressInstrumentationSiteForDebug(int &Instrumented) {
 }
 
 bool AddressSanitizer::instrumentFunction(Function &F,
-                                          const TargetLibraryInfo *TLI) {
+                                          const TargetLibraryInfo *TLI,
+                                          const ProfileSummaryInfo *PSI) {
   if (F.empty())
     return false;
   if (F.getLinkage() == GlobalValue::AvailableExternallyLinkage) return false;
@@ -2872,6 +2887,19 @@ bool AddressSanitizer::instrumentFunction(Function &F,
   ObjSizeOpts.RoundToAlign = true;
   ObjectSizeOffsetVisitor ObjSizeVis(DL, TLI, F.getContext(), ObjSizeOpts);
 
+  // Checks in the hottest functions account for most of the runtime cost.
+  // When asked, trade their coverage for overhead. Stack and global redzones
+  // are still set up, so bad accesses from other functions are caught.
+  if (PSI && PSI->hasProfileSummary()) {
+    std::optional<Function::ProfileCount> EntryCount = F.getEntryCount();
+    if (EntryCount && PSI->isHotCountNthPercentile(ClHotPercentileCutoff,
+                                                   EntryCount->getCount())) {
+      OperandsToInstrument.clear();
+      IntrinToInstrument.clear();
+      ++NumSkippedHotFunctions;
+    }
+  }
+
   // Instrument.
   int NumInstrumented = 0;
   for (auto &Operand : OperandsToInstrument) {
@@ -15,6 +15,7 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/GlobalsModRef.h"
@@ -61,6 +62,10 @@ using namespace llvm;
 
 #define DEBUG_TYPE "hwasan"
 
+STATISTIC(NumInstrumentedAccesses, "Number of instrumented memory accesses");
+STATISTIC(NumRedundantChecks,
+          "Number of memory access checks removed as redundant");
+
 const char kHwasanModuleCtorName[] = "hwasan.module_ctor";
 const char kHwasanNoteName[] = "hwasan.note";
 const char kHwasanInitName[] = "__hwasan_init";
@@ -223,6 +228,14 @@ static cl::opt<bool> ClInlineAllChecks("hwasan-inline-all-checks",
                                        cl::desc("inline all checks"),
                                        cl::Hidden, cl::init(false));
 
+// This is an experiment to reduce the check count on hot paths: an access
+// through a pointer that was already checked earlier in the same basic block,
+// with no intervening call, for at least as many bytes needs no new check.
+static cl::opt<bool> ClOptSamePtr(
+    "hwasan-opt-same-ptr",
+    cl::desc("skip checks of pointers already checked in the same basic block"),
+    cl::Hidden, cl::init(true));
+
 // Enabled from clang by "-fsanitize-hwaddress-experimental-aliasing".
 static cl::opt<bool> ClUsePageAliases("hwasan-experimental-use-page-aliases",
                                       cl::desc("Use page aliasing in HWASan"),
@@ -1036,6 +1049,7 @@ bool HWAddressSanitizer::instrumentMemAccess(InterestingMemoryOperand &O) {
     }
   }
   untagPointerOperand(O.getInsn(), Addr);
+  ++NumInstrumentedAccesses;
 
   return true;
 }
@@ -1460,9 +1474,29 @@ void HWAddressSanitizer::sanitizeFunction(Function &F,
   LLVM_DEBUG(dbgs() << "Function: " << F.getName() << "\n");
 
   SmallVector<InterestingMemoryOperand, 16> OperandsToInstrument;
+  SmallVector<InterestingMemoryOperand, 16> RedundantOperands;
   SmallVector<MemIntrinsic *, 16> IntrinToInstrument;
   SmallVector<Instruction *, 8> LandingPadVec;
 
+  // Largest access size, in bits, already checked for each pointer in the
+  // current basic block. Reset at block boundaries and at calls, which may
+  // free or retag the memory.
+  SmallDenseMap<Value *, uint64_t, 16> CheckedPtrs;
+  BasicBlock *CurBB = nullptr;
+  auto IsRedundantCheck = [&](const InterestingMemoryOperand &O) {
+    if (!ClOptSamePtr || O.MaybeMask || O.TypeStoreSize.isScalable() ||
+        isa<CallBase>(O.getInsn()))
+      return false;
+    uint64_t Size = O.TypeStoreSize.getFixedValue();
+    auto [It, Inserted] = CheckedPtrs.try_emplace(O.getPtr(), Size);
+    if (Inserted)
+      return false;
+    if (It->second >= Size)
+      return true;
+    It->second = Size;
+    return false;
+  };
+
   memtag::StackInfoBuilder SIB(SSI);
   for (auto &Inst : instructions(F)) {
     if (InstrumentStack) {
@@ -1472,7 +1506,20 @@ void HWAddressSanitizer::sanitizeFunction(Function &F,
     if (InstrumentLandingPads && isa<LandingPadInst>(Inst))
       LandingPadVec.push_back(&Inst);
 
-    getInterestingMemoryOperands(&Inst, OperandsToInstrument);
+    if (Inst.getParent() != CurBB) {
+      CurBB = Inst.getParent();
+      CheckedPtrs.clear();
+    }
+    SmallVector<InterestingMemoryOperand, 1> InstOperands;
+    getInterestingMemoryOperands(&Inst, InstOperands);
+    for (auto &O : InstOperands) {
+      if (IsRedundantCheck(O))
+        RedundantOperands.push_back(O);
+      else
+        OperandsToInstrument.push_back(O);
+    }
+    if (isa<CallBase>(Inst) && !isa<DbgInfoIntrinsic>(Inst))
+      CheckedPtrs.clear();
 
     if (MemIntrinsic *MI = dyn_cast<MemIntrinsic>(&Inst))
       if (!ignoreMemIntrinsic(MI))
@@ -1530,6 +1577,10 @@ void HWAddressSanitizer::sanitizeFunction(Function &F,
 
   for (auto &Operand : OperandsToInstrument)
     instrumentMemAccess(Operand);
+  for (auto &Operand : RedundantOperands) {
+    untagPointerOperand(Operand.getInsn(), Operand.getPtr());
+    ++NumRedundantChecks;
+  }
 
   if (ClInstrumentMemIntrinsics && !IntrinToInstrument.empty()) {
     for (auto *Inst : IntrinToInstrument)
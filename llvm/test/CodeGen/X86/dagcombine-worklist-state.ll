@@ -0,0 +1,62 @@
+; NOTE: Assertions have been autogenerated by utils/update_llc_test_checks.py
+; RUN: llc < %s -mtriple=x86_64-unknown-unknown | FileCheck %s
+
+; The DAGCombiner keeps the worklist position and the combined flag of each
+; node in the node itself. These combines delete and create nodes while the
+; worklist is processed, and the combiner runs several times on each DAG, so
+; stale state from a deleted node or an earlier run would show up here.
+
+define i32 @fold_chain(i32 %x) {
+; CHECK-LABEL: fold_chain:
+; CHECK:       # %bb.0:
+; CHECK-NEXT:    # kill: def $edi killed $edi def $rdi
+; CHECK-NEXT:    leal (,%rdi,8), %eax
+; CHECK-NEXT:    retq
+  %a = add i32 %x, 1
+  %b = add i32 %a, 2
+  %c = add i32 %b, 3
+  %d = sub i32 %c, 6
+  %e = mul i32 %d, 4
+  %f = shl i32 %e, 1
+  ret i32 %f
+}
+
+define void @merge_stores(ptr %p) {
+; CHECK-LABEL: merge_stores:
+; CHECK:       # %bb.0:
+; CHECK-NEXT:    movl $67305985, (%rdi) # imm = 0x4030201
+; CHECK-NEXT:    retq
+  %p1 = getelementptr i8, ptr %p, i64 1
+  %p2 = getelementptr i8, ptr %p, i64 2
+  %p3 = getelementptr i8, ptr %p, i64 3
+  store i8 1, ptr %p
+  store i8 2, ptr %p1
+  store i8 3, ptr %p2
+  store i8 4, ptr %p3
+  ret void
+}
+
+define i32 @load_bytes(ptr %p) {
+; CHECK-LABEL: load_bytes:
+; CHECK:       # %bb.0:
+; CHECK-NEXT:    movl (%rdi), %eax
+; CHECK-NEXT:    retq
+  %p1 = getelementptr i8, ptr %p, i64 1
+  %p2 = getelementptr i8, ptr %p, i64 2
+  %p3 = getelementptr i8, ptr %p, i64 3
+  %b0 = load i8, ptr %p
+  %b1 = load i8, ptr %p1
+  %b2 = load i8, ptr %p2
+  %b3 = load i8, ptr %p3
+  %z0 = zext i8 %b0 to i32
+  %z1 = zext i8 %b1 to i32
+  %z2 = zext i8 %b2 to i32
+  %z3 = zext i8 %b3 to i32
+  %s1 = shl i32 %z1, 8
+  %s2 = shl i32 %z2, 16
+  %s3 = shl i32 %z3, 24
+  %o1 = or i32 %z0, %s1
+  %o2 = or i32 %o1, %s2
+  %o3 = or i32 %o2, %s3
+  ret i32 %o3
+}
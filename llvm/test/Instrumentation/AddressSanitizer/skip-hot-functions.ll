@@ -0,0 +1,64 @@
+; Test -asan-percentile-cutoff-hot: functions whose entry count is in the hot
+; percentile of the profile get no access checks; colder ones keep them.
+
+; RUN: opt < %s -passes=asan -asan-instrumentation-with-call-threshold=0 -S \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,ALL
+; RUN: opt < %s -passes=asan -asan-instrumentation-with-call-threshold=0 -S \
+; RUN:   -asan-percentile-cutoff-hot=990000 \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,HOT
+; RUN: opt < %s -passes=asan -asan-instrumentation-with-call-threshold=0 -S \
+; RUN:   -asan-percentile-cutoff-hot=999999 \
+; RUN:   | FileCheck %s --check-prefixes=CHECK,NONE
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @hot(ptr %p) sanitize_address !prof !20 {
+; CHECK-LABEL: @hot(
+; ALL:         call void @__asan_load4
+; HOT-NOT:     call void @__asan_load4
+; NONE-NOT:    call void @__asan_load4
+; CHECK:       ret i32
+entry:
+  %v = load i32, ptr %p, align 4
+  ret i32 %v
+}
+
+define i32 @cold(ptr %p) sanitize_address !prof !21 {
+; CHECK-LABEL: @cold(
+; ALL:         call void @__asan_load4
+; HOT:         call void @__asan_load4
+; NONE-NOT:    call void @__asan_load4
+; CHECK:       ret i32
+entry:
+  %v = load i32, ptr %p, align 4
+  ret i32 %v
+}
+
+; Without an entry count, the function is always instrumented.
+define i32 @noprof(ptr %p) sanitize_address {
+; CHECK-LABEL: @noprof(
+; CHECK:       call void @__asan_load4
+; CHECK:       ret i32
+entry:
+  %v = load i32, ptr %p, align 4
+  ret i32 %v
+}
+
+!llvm.module.flags = !{!1}
+!1 = !{i32 1, !"ProfileSummary", !2}
+!2 = !{!3, !4, !5, !6, !7, !8, !9, !10}
+!3 = !{!"ProfileFormat", !"InstrProf"}
+!4 = !{!"TotalCount", i64 10000}
+!5 = !{!"MaxCount", i64 10}
+!6 = !{!"MaxInternalCount", i64 1}
+!7 = !{!"MaxFunctionCount", i64 1000}
+!8 = !{!"NumCounts", i64 3}
+!9 = !{!"NumFunctions", i64 3}
+!10 = !{!"DetailedSummary", !11}
+!11 = !{!12, !13, !14}
+!12 = !{i32 10000, i64 100, i32 1}
+!13 = !{i32 999000, i64 100, i32 1}
+!14 = !{i32 999999, i64 1, i32 2}
+!20 = !{!"function_entry_count", i64 1000}
+!21 = !{!"function_entry_count", i64 1}
@@ -0,0 +1,84 @@
+; Test that an access through a pointer that was already checked for at least
+; as many bytes earlier in the same basic block, with no call in between, is
+; not checked again.
+;
+; RUN: opt < %s -passes=hwasan -hwasan-instrument-with-calls -S | FileCheck %s
+; RUN: opt < %s -passes=hwasan -hwasan-instrument-with-calls -hwasan-opt-same-ptr=0 -S | FileCheck %s --check-prefix=NOOPT
+
+target datalayout = "e-m:e-i8:8:32-i16:16:32-i64:64-i128:128-n32:64-S128"
+target triple = "aarch64--linux-android10000"
+
+declare void @g()
+
+define i32 @load_load_store(ptr %p) sanitize_hwaddress {
+; CHECK-LABEL: @load_load_store(
+; CHECK:         call void @__hwasan_load4(
+; CHECK-NEXT:    %a = load i32, ptr %p
+; CHECK-NOT:     call void @__hwasan_
+; CHECK:         ret i32
+;
+; NOOPT-LABEL: @load_load_store(
+; NOOPT:         call void @__hwasan_load4(
+; NOOPT-NEXT:    %a = load i32, ptr %p
+; NOOPT:         call void @__hwasan_load4(
+; NOOPT-NEXT:    %b = load i32, ptr %p
+; NOOPT:         call void @__hwasan_store4(
+; NOOPT-NEXT:    store i32 %a, ptr %p
+;
+  %a = load i32, ptr %p
+  %b = load i32, ptr %p
+  store i32 %a, ptr %p
+  %s = add i32 %a, %b
+  ret i32 %s
+}
+
+; A wider access is checked again, a narrower one is not.
+define i8 @narrow_wide_narrow(ptr %p) sanitize_hwaddress {
+; CHECK-LABEL: @narrow_wide_narrow(
+; CHECK:         call void @__hwasan_load1(
+; CHECK-NEXT:    %a = load i8, ptr %p
+; CHECK:         call void @__hwasan_load8(
+; CHECK-NEXT:    %b = load i64, ptr %p
+; CHECK-NOT:     call void @__hwasan_
+; CHECK:         ret i8
+;
+  %a = load i8, ptr %p
+  %b = load i64, ptr %p
+  %c = load i8, ptr %p
+  ret i8 %c
+}
+
+; A call may free or retag the memory.
+define i32 @call_between(ptr %p) sanitize_hwaddress {
+; CHECK-LABEL: @call_between(
+; CHECK:         call void @__hwasan_load4(
+; CHECK-NEXT:    %a = load i32, ptr %p
+; CHECK-NEXT:    call void @g()
+; CHECK:         call void @__hwasan_load4(
+; CHECK-NEXT:    %b = load i32, ptr %p
+;
+  %a = load i32, ptr %p
+  call void @g()
+  %b = load i32, ptr %p
+  %s = add i32 %a, %b
+  ret i32 %s
+}
+
+; Checks are only reused within a basic block.
+define i32 @other_block(ptr %p) sanitize_hwaddress {
+; CHECK-LABEL: @other_block(
+; CHECK:         call void @__hwasan_load4(
+; CHECK-NEXT:    %a = load i32, ptr %p
+; CHECK:       next:
+; CHECK:         call void @__hwasan_load4(
+; CHECK-NEXT:    %b = load i32, ptr %p
+;
+entry:
+  %a = load i32, ptr %p
+  br label %next
+
+next:
+  %b = load i32, ptr %p
+  %s = add i32 %a, %b
+  ret i32 %s
+}
@@ -0,0 +1,34 @@
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t
+# RUN: llvm-objdump -d %t | FileCheck %s --check-prefix=TEXT
+# RUN: llvm-objdump -s -j .data -j .rodata %t | FileCheck %s
+
+## Only sections with a fragment that may change size are relaxed. The size of
+## .data depends on the relaxation of .text, although .data itself holds no
+## relaxable fragment, and .rodata holds one outside of .text.
+
+# TEXT:      0: e9 82 00 00 00 jmp
+# TEXT:     87: c3             retq
+
+# CHECK:      Contents of section .data:
+# CHECK-NEXT:  0000 87000000 00000000 aaaaaaaa aaaaaaaa
+# CHECK-NEXT:  0010 aaaaaaaa aaaaaabb
+# CHECK-NEXT: Contents of section .rodata:
+# CHECK-NEXT:  0000 8701cc
+
+.text
+.Lstart:
+  jmp .Lend
+  .fill .Lsize, 1, 0x90
+.Lend:
+  ret
+
+.data
+  .quad .Lend - .Lstart
+  .fill .Lend - .Lstart - 120, 1, 0xaa
+  .byte 0xbb
+
+.section .rodata,"a"
+  .uleb128 .Lend - .Lstart
+  .byte 0xcc
+
+.set .Lsize, 130
@@ -0,0 +1,22 @@
+; RUN: opt -disable-output -passes='globaldce,instcombine' \
+; RUN:   -report-slow-passes=0 %s 2>&1 | FileCheck %s
+; RUN: opt -disable-output -passes='globaldce,instcombine' \
+; RUN:   -report-slow-passes=1000000 %s 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=NONE --allow-empty
+; RUN: opt -disable-output -passes='globaldce,instcombine' %s 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=NONE --allow-empty
+
+;; With a threshold of 0 every pass run is reported, but pass managers and
+;; adaptors are not.
+; CHECK-NOT:  Slow pass: {{.*(PassManager|PassAdaptor)}}
+; CHECK:      Slow pass: GlobalDCEPass on [module] took {{[0-9]+\.[0-9]}} ms, instructions: 2 -> 2
+; CHECK-NOT:  Slow pass: {{.*(PassManager|PassAdaptor)}}
+; CHECK:      Slow pass: InstCombinePass on f took {{[0-9]+\.[0-9]}} ms, instructions: 2 -> 1
+; CHECK-NOT:  Slow pass: {{.*(PassManager|PassAdaptor)}}
+
+; NONE-NOT:   Slow pass:
+
+define i32 @f(i32 %x) {
+  %a = add i32 %x, 0
+  ret i32 %a
+}
@@ -0,0 +1,46 @@
+; REQUIRES: x86-registered-target
+
+; A call slot whose targets cannot be determined, here because the vtable has
+; public LTO visibility, still gets a resolution entry in the combined
+; summary, with the default indirect kind.
+
+; RUN: opt -thinlto-bc -o %t.o %s
+; RUN: llvm-lto2 run %t.o -save-temps -o %t2 \
+; RUN:   -r=%t.o,test,px \
+; RUN:   -r=%t.o,_ZN1A1fEi,p \
+; RUN:   -r=%t.o,_ZN1A1nEi,p \
+; RUN:   -r=%t.o,_ZTV1A,px
+; RUN: llvm-dis %t2.index.bc -o - | FileCheck %s
+
+; CHECK: typeid: (name: "_ZTS1A", summary: (typeTestRes: (kind: {{[a-zA-Z]+}}, sizeM1BitWidth: {{[0-9]+}}), wpdResolutions: ((offset: 8, wpdRes: (kind: indir)))))
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-grtev4-linux-gnu"
+
+%struct.A = type { ptr }
+
+@_ZTV1A = constant { [4 x ptr] } { [4 x ptr] [ptr null, ptr undef, ptr @_ZN1A1fEi, ptr @_ZN1A1nEi] }, !type !0
+
+define i32 @_ZN1A1fEi(ptr %this, i32 %a) {
+   ret i32 0
+}
+
+define i32 @_ZN1A1nEi(ptr %this, i32 %a) {
+   ret i32 0
+}
+
+define i32 @test(ptr %obj, i32 %a) {
+entry:
+  %vtable = load ptr, ptr %obj
+  %p = call i1 @llvm.type.test(ptr %vtable, metadata !"_ZTS1A")
+  call void @llvm.assume(i1 %p)
+  %fptrptr = getelementptr ptr, ptr %vtable, i32 1
+  %fptr1 = load ptr, ptr %fptrptr, align 8
+  %call = tail call i32 %fptr1(ptr nonnull %obj, i32 %a)
+  ret i32 %call
+}
+
+declare i1 @llvm.type.test(ptr, metadata)
+declare void @llvm.assume(i1)
+
+!0 = !{i64 16, !"_ZTS1A"}
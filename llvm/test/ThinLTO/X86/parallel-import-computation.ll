@@ -0,0 +1,83 @@
+; REQUIRES: x86-registered-target
+
+; The imports of the modules are computed in parallel. The import and export
+; lists, and thus the distributed indexes, must be the same as when the
+; modules are processed one after the other.
+
+; RUN: rm -rf %t && split-file %s %t
+; RUN: opt -module-summary %t/main.ll -o %t/main.bc
+; RUN: opt -module-summary %t/foo.ll -o %t/foo.bc
+; RUN: opt -module-summary %t/bar.ll -o %t/bar.bc
+
+; RUN: llvm-lto2 run %t/main.bc %t/foo.bc %t/bar.bc -o %t/seq \
+; RUN:   -thinlto-distributed-indexes -thinlto-emit-imports \
+; RUN:   -parallel-import-computation=false \
+; RUN:   -r=%t/main.bc,main,px -r=%t/main.bc,foo, -r=%t/main.bc,bar, \
+; RUN:   -r=%t/foo.bc,foo,p -r=%t/foo.bc,bar, -r=%t/bar.bc,bar,p
+; RUN: mkdir %t/seq.out
+; RUN: mv %t/main.bc.thinlto.bc %t/main.bc.imports %t/seq.out
+; RUN: mv %t/foo.bc.thinlto.bc %t/foo.bc.imports %t/seq.out
+; RUN: mv %t/bar.bc.thinlto.bc %t/bar.bc.imports %t/seq.out
+
+; RUN: llvm-lto2 run %t/main.bc %t/foo.bc %t/bar.bc -o %t/par \
+; RUN:   -thinlto-distributed-indexes -thinlto-emit-imports \
+; RUN:   -r=%t/main.bc,main,px -r=%t/main.bc,foo, -r=%t/main.bc,bar, \
+; RUN:   -r=%t/foo.bc,foo,p -r=%t/foo.bc,bar, -r=%t/bar.bc,bar,p
+; RUN: cmp %t/main.bc.thinlto.bc %t/seq.out/main.bc.thinlto.bc
+; RUN: cmp %t/foo.bc.thinlto.bc %t/seq.out/foo.bc.thinlto.bc
+; RUN: cmp %t/bar.bc.thinlto.bc %t/seq.out/bar.bc.thinlto.bc
+; RUN: cmp %t/main.bc.imports %t/seq.out/main.bc.imports
+; RUN: cmp %t/foo.bc.imports %t/seq.out/foo.bc.imports
+; RUN: cmp %t/bar.bc.imports %t/seq.out/bar.bc.imports
+
+; main imports foo and bar, foo imports bar, and bar imports nothing.
+; RUN: FileCheck %s --check-prefix=MAIN < %t/main.bc.imports
+; RUN: FileCheck %s --check-prefix=FOO < %t/foo.bc.imports
+; RUN: count 0 < %t/bar.bc.imports
+; MAIN-DAG: foo.bc
+; MAIN-DAG: bar.bc
+; FOO-NOT:  main.bc
+; FOO:      bar.bc
+; FOO-NOT:  main.bc
+
+; foo references the local @g, so the index of main also has its summary.
+; RUN: llvm-dis %t/main.bc.thinlto.bc -o - | FileCheck %s --check-prefix=INDEX
+; INDEX: ^1 = module: (path: "{{.*}}foo.bc"
+; INDEX: gv: (guid: {{[0-9]+}}, summaries: (variable: (module: ^1,
+
+;--- main.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i32 @foo()
+declare i32 @bar()
+
+define i32 @main() {
+  %a = call i32 @foo()
+  %b = call i32 @bar()
+  %c = add i32 %a, %b
+  ret i32 %c
+}
+
+;--- foo.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+@g = internal global i32 1
+
+declare i32 @bar()
+
+define i32 @foo() {
+  %a = call i32 @bar()
+  %b = load i32, ptr @g
+  %c = add i32 %a, %b
+  ret i32 %c
+}
+
+;--- bar.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @bar() {
+  ret i32 1
+}
@@ -0,0 +1,90 @@
+;; Test behavior of -optimize-hot-cold-new and -optimize-existing-hot-cold-new
+;; on calls that already pass a __hot_cold_t hint.
+
+; RUN: opt < %s -passes=instcombine -S | FileCheck %s --check-prefix=OFF
+; RUN: opt < %s -passes=instcombine -optimize-hot-cold-new -S \
+; RUN:   | FileCheck %s --check-prefix=OFF
+; RUN: opt < %s -passes=instcombine -optimize-existing-hot-cold-new -S \
+; RUN:   | FileCheck %s --check-prefix=OFF
+; RUN: opt < %s -passes=instcombine -optimize-hot-cold-new \
+; RUN:   -optimize-existing-hot-cold-new -S | FileCheck %s --check-prefix=ON
+
+;; Without -optimize-existing-hot-cold-new, the existing hint is kept. With it,
+;; the hint is replaced by the one matching the memprof attribute.
+; OFF-LABEL: @new_hot_cold()
+; ON-LABEL: @new_hot_cold()
+define void @new_hot_cold() {
+  ;; Attribute cold.
+  ; OFF: @_Znwm12__hot_cold_t(i64 10, i8 7)
+  ; ON: @_Znwm12__hot_cold_t(i64 10, i8 1)
+  %call = call ptr @_Znwm12__hot_cold_t(i64 10, i8 7) #0
+  call void @dummy(ptr %call)
+  ;; Attribute hot.
+  ; OFF: @_Znwm12__hot_cold_t(i64 10, i8 7)
+  ; ON: @_Znwm12__hot_cold_t(i64 10, i8 -2)
+  %call1 = call ptr @_Znwm12__hot_cold_t(i64 10, i8 7) #1
+  call void @dummy(ptr %call1)
+  ;; No memprof attribute, the hint is always kept.
+  ; OFF: @_Znwm12__hot_cold_t(i64 10, i8 7)
+  ; ON: @_Znwm12__hot_cold_t(i64 10, i8 7)
+  %call2 = call ptr @_Znwm12__hot_cold_t(i64 10, i8 7) #2
+  call void @dummy(ptr %call2)
+  ret void
+}
+
+; OFF-LABEL: @new_align_nothrow_hot_cold()
+; ON-LABEL: @new_align_nothrow_hot_cold()
+define void @new_align_nothrow_hot_cold() {
+  %nt = alloca i8
+  ; OFF: @_ZnwmRKSt9nothrow_t12__hot_cold_t(i64 10, ptr {{.*}}%nt, i8 7)
+  ; ON: @_ZnwmRKSt9nothrow_t12__hot_cold_t(i64 10, ptr {{.*}}%nt, i8 1)
+  %call = call ptr @_ZnwmRKSt9nothrow_t12__hot_cold_t(i64 10, ptr %nt, i8 7) #0
+  call void @dummy(ptr %call)
+  ; OFF: @_ZnwmSt11align_val_t12__hot_cold_t(i64 10, i64 8, i8 7)
+  ; ON: @_ZnwmSt11align_val_t12__hot_cold_t(i64 10, i64 8, i8 1)
+  %call1 = call ptr @_ZnwmSt11align_val_t12__hot_cold_t(i64 10, i64 8, i8 7) #0
+  call void @dummy(ptr %call1)
+  ; OFF: @_ZnwmSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64 10, i64 8, ptr {{.*}}%nt, i8 7)
+  ; ON: @_ZnwmSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64 10, i64 8, ptr {{.*}}%nt, i8 1)
+  %call2 = call ptr @_ZnwmSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64 10, i64 8, ptr %nt, i8 7) #0
+  call void @dummy(ptr %call2)
+  ret void
+}
+
+; OFF-LABEL: @new_array_hot_cold()
+; ON-LABEL: @new_array_hot_cold()
+define void @new_array_hot_cold() {
+  %nt = alloca i8
+  ; OFF: @_Znam12__hot_cold_t(i64 10, i8 7)
+  ; ON: @_Znam12__hot_cold_t(i64 10, i8 -2)
+  %call = call ptr @_Znam12__hot_cold_t(i64 10, i8 7) #1
+  call void @dummy(ptr %call)
+  ; OFF: @_ZnamRKSt9nothrow_t12__hot_cold_t(i64 10, ptr {{.*}}%nt, i8 7)
+  ; ON: @_ZnamRKSt9nothrow_t12__hot_cold_t(i64 10, ptr {{.*}}%nt, i8 -2)
+  %call1 = call ptr @_ZnamRKSt9nothrow_t12__hot_cold_t(i64 10, ptr %nt, i8 7) #1
+  call void @dummy(ptr %call1)
+  ; OFF: @_ZnamSt11align_val_t12__hot_cold_t(i64 10, i64 8, i8 7)
+  ; ON: @_ZnamSt11align_val_t12__hot_cold_t(i64 10, i64 8, i8 -2)
+  %call2 = call ptr @_ZnamSt11align_val_t12__hot_cold_t(i64 10, i64 8, i8 7) #1
+  call void @dummy(ptr %call2)
+  ; OFF: @_ZnamSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64 10, i64 8, ptr {{.*}}%nt, i8 7)
+  ; ON: @_ZnamSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64 10, i64 8, ptr {{.*}}%nt, i8 -2)
+  %call3 = call ptr @_ZnamSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64 10, i64 8, ptr %nt, i8 7) #1
+  call void @dummy(ptr %call3)
+  ret void
+}
+
+declare void @dummy(ptr)
+
+declare ptr @_Znwm12__hot_cold_t(i64, i8)
+declare ptr @_ZnwmRKSt9nothrow_t12__hot_cold_t(i64, ptr, i8)
+declare ptr @_ZnwmSt11align_val_t12__hot_cold_t(i64, i64, i8)
+declare ptr @_ZnwmSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64, i64, ptr, i8)
+declare ptr @_Znam12__hot_cold_t(i64, i8)
+declare ptr @_ZnamRKSt9nothrow_t12__hot_cold_t(i64, ptr, i8)
+declare ptr @_ZnamSt11align_val_t12__hot_cold_t(i64, i64, i8)
+declare ptr @_ZnamSt11align_val_tRKSt9nothrow_t12__hot_cold_t(i64, i64, ptr, i8)
+
+attributes #0 = { builtin "memprof"="cold" }
+attributes #1 = { builtin "memprof"="hot" }
+attributes #2 = { builtin }
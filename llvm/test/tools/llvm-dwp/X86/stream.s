@@ -0,0 +1,124 @@
+# REQUIRES: x86-registered-target
+## --stream writes the package through temporary files instead of buffering it
+## in memory. The symbol table is omitted, but the contents of the sections
+## must be identical to the ones written through the object streamer.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+
+# RUN: llvm-dwp a.o b.o -o out.dwp
+# RUN: llvm-dwp --stream a.o b.o -o stream.dwp
+# RUN: llvm-readelf -x .debug_abbrev.dwo -x .debug_info.dwo \
+# RUN:   -x .debug_str.dwo -x .debug_str_offsets.dwo -x .debug_cu_index \
+# RUN:   out.dwp > out.txt
+# RUN: llvm-readelf -x .debug_abbrev.dwo -x .debug_info.dwo \
+# RUN:   -x .debug_str.dwo -x .debug_str_offsets.dwo -x .debug_cu_index \
+# RUN:   stream.dwp > stream.txt
+# RUN: cmp out.txt stream.txt
+
+## The output does not depend on the number of threads.
+# RUN: llvm-dwp --stream -j 1 a.o b.o -o stream1.dwp
+# RUN: cmp stream.dwp stream1.dwp
+# RUN: llvm-dwp -j 1 a.o b.o -o out1.dwp
+# RUN: cmp out.dwp out1.dwp
+
+# RUN: llvm-readelf -S stream.dwp | FileCheck %s --check-prefix=SECTIONS
+# RUN: llvm-dwarfdump -v stream.dwp | FileCheck %s
+
+# SECTIONS:      [ 0]  NULL
+# SECTIONS-NEXT: [ 1] .debug_abbrev.dwo
+# SECTIONS-NEXT: [ 2] .debug_str.dwo
+# SECTIONS-NEXT: [ 3] .debug_str_offsets.dwo
+# SECTIONS-NEXT: [ 4] .debug_info.dwo
+# SECTIONS-NEXT: [ 5] .debug_cu_index
+# SECTIONS-NEXT: [ 6] .shstrtab
+# SECTIONS-NOT:  .symtab
+
+# CHECK:      .debug_info.dwo contents:
+# CHECK:      DWO_id = 0x0000000000001111
+# CHECK:        DW_AT_name [DW_FORM_strx1] (indexed (00000000) string = "a.c")
+# CHECK-NEXT:   DW_AT_dwo_name [DW_FORM_strx1] (indexed (00000001) string = "a.dwo")
+# CHECK:      DWO_id = 0x0000000000002222
+# CHECK:        DW_AT_name [DW_FORM_strx1] (indexed (00000000) string = "b.c")
+# CHECK-NEXT:   DW_AT_dwo_name [DW_FORM_strx1] (indexed (00000001) string = "a.dwo")
+
+# CHECK:      .debug_cu_index contents:
+# CHECK-NEXT: version = 5, units = 2, slots = 4
+# CHECK:      0x0000000000001111 [0x00000000, 0x00000017) [0x00000000, 0x0000000a) [0x00000000, 0x00000010)
+# CHECK:      0x0000000000002222 [0x00000017, 0x0000002e) [0x0000000a, 0x00000014) [0x00000010, 0x00000020)
+
+## Strings shared by the inputs are emitted once.
+# CHECK:      .debug_str.dwo contents:
+# CHECK-NEXT: 0x00000000: "a.c"
+# CHECK-NEXT: 0x00000004: "a.dwo"
+# CHECK-NEXT: 0x0000000a: "b.c"
+# CHECK-EMPTY:
+
+#--- a.s
+.section .debug_abbrev.dwo,"e",@progbits
+  .byte 1, 0x11, 0           # DW_TAG_compile_unit, DW_CHILDREN_no
+  .byte 0x03, 0x25           # DW_AT_name, DW_FORM_strx1
+  .byte 0x76, 0x25           # DW_AT_dwo_name, DW_FORM_strx1
+  .byte 0, 0
+  .byte 0
+
+.section .debug_info.dwo,"e",@progbits
+  .long .Linfo_end - .Linfo_start
+.Linfo_start:
+  .short 5                   # Version
+  .byte 5                    # DW_UT_split_compile
+  .byte 8                    # Address size
+  .long 0                    # Abbrev offset
+  .quad 0x1111               # DWO id
+  .byte 1                    # DW_TAG_compile_unit
+  .byte 0                    # DW_AT_name
+  .byte 1                    # DW_AT_dwo_name
+.Linfo_end:
+
+.section .debug_str_offsets.dwo,"e",@progbits
+  .long 12                   # Length
+  .short 5                   # Version
+  .short 0                   # Padding
+  .long .Lname - .Lname
+  .long .Ldwo - .Lname
+
+.section .debug_str.dwo,"eMS",@progbits,1
+.Lname:
+  .asciz "a.c"
+.Ldwo:
+  .asciz "a.dwo"
+
+#--- b.s
+.section .debug_abbrev.dwo,"e",@progbits
+  .byte 1, 0x11, 0           # DW_TAG_compile_unit, DW_CHILDREN_no
+  .byte 0x03, 0x25           # DW_AT_name, DW_FORM_strx1
+  .byte 0x76, 0x25           # DW_AT_dwo_name, DW_FORM_strx1
+  .byte 0, 0
+  .byte 0
+
+.section .debug_info.dwo,"e",@progbits
+  .long .Linfo_end - .Linfo_start
+.Linfo_start:
+  .short 5                   # Version
+  .byte 5                    # DW_UT_split_compile
+  .byte 8                    # Address size
+  .long 0                    # Abbrev offset
+  .quad 0x2222               # DWO id
+  .byte 1                    # DW_TAG_compile_unit
+  .byte 0                    # DW_AT_name
+  .byte 1                    # DW_AT_dwo_name
+.Linfo_end:
+
+.section .debug_str_offsets.dwo,"e",@progbits
+  .long 12                   # Length
+  .short 5                   # Version
+  .short 0                   # Padding
+  .long .Lname - .Lname
+  .long .Ldwo - .Lname
+
+.section .debug_str.dwo,"eMS",@progbits,1
+.Lname:
+  .asciz "b.c"
+.Ldwo:
+  .asciz "a.dwo"
@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 #include "llvm/DWP/DWP.h"
 #include "llvm/DWP/DWPError.h"
+#include "llvm/DWP/DWPStreamer.h"
 #include "llvm/DWP/DWPStringPool.h"
 #include "llvm/MC/MCAsmBackend.h"
 #include "llvm/MC/MCAsmInfo.h"
@@ -23,10 +24,12 @@
 #include "llvm/MC/MCSubtargetInfo.h"
 #include "llvm/MC/MCTargetOptionsCommandFlags.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include <optional>
@@ -57,6 +60,23 @@ static cl::opt<bool> ContinueOnCuIndexOverflow(
              "overfolws into a warning."),
     cl::cat(DwpCategory));
 
+static cl::opt<bool> Stream(
+    "stream",
+    cl::desc("Write the contents of each input to the output as it is "
+             "processed, instead of building the whole package in memory. "
+             "Only the index and the string table are kept in memory."),
+    cl::cat(DwpCategory));
+
+static cl::opt<unsigned>
+    NumThreads("num-threads",
+               cl::desc("Number of threads used to read and decompress the "
+                        "inputs. The default is the number of hardware "
+                        "threads."),
+               cl::cat(DwpCategory));
+static cl::alias NumThreadsAlias("j", cl::desc("Alias for --num-threads"),
+                                 cl::aliasopt(NumThreads),
+                                 cl::cat(DwpCategory));
+
 static Expected<SmallVector<std::string, 16>>
 getDWOFilenames(StringRef ExecFilename) {
   auto ErrOrObj = object::ObjectFile::createObjectFile(ExecFilename);
@@ -103,6 +123,21 @@ static Expected<Triple> readTargetTriple(StringRef FileName) {
   return ErrOrObj->getBinary()->makeTriple();
 }
 
+// Returns the e_machine and e_flags of the ELF file FileName, for the header
+// of the package written by --stream.
+static Expected<std::pair<uint16_t, uint32_t>>
+readELFMachine(StringRef FileName) {
+  auto ErrOrObj = object::ObjectFile::createObjectFile(FileName);
+  if (!ErrOrObj)
+    return ErrOrObj.takeError();
+
+  auto *Obj = dyn_cast<ELFObjectFileBase>(ErrOrObj->getBinary());
+  if (!Obj)
+    return createStringError(inconvertibleErrorCode(),
+                             "--stream only supports ELF inputs");
+  return std::make_pair(Obj->getEMachine(), Obj->getPlatformFlags());
+}
+
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
 
@@ -114,6 +149,9 @@ int main(int argc, char **argv) {
   llvm::InitializeAllTargets();
   llvm::InitializeAllAsmPrinters();
 
+  if (NumThreads)
+    parallel::strategy = hardware_concurrency(NumThreads);
+
   std::vector<std::string> DWOFilenames = InputFiles;
   for (const auto &ExecFilename : ExecFilenames) {
     auto DWOs = getDWOFilenames(ExecFilename);
@@ -205,11 +243,25 @@ int main(int argc, char **argv) {
     OS = &*BOS;
   }
 
-  std::unique_ptr<MCStreamer> MS(TheTarget->createMCObjectStreamer(
-      *ErrOrTriple, MC, std::unique_ptr<MCAsmBackend>(MAB),
-      MAB->createObjectWriter(*OS), std::unique_ptr<MCCodeEmitter>(MCE), *MSTI,
-      MCOptions.MCRelaxAll, MCOptions.MCIncrementalLinkerCompatible,
-      /*DWARFMustBeAtTheEnd*/ false));
+  std::unique_ptr<MCStreamer> MS;
+  if (Stream) {
+    std::unique_ptr<MCAsmBackend> AsmBackend(MAB);
+    std::unique_ptr<MCCodeEmitter> CodeEmitter(MCE);
+    auto ErrOrMachine = readELFMachine(DWOFilenames.front());
+    if (!ErrOrMachine) {
+      logAllUnhandledErrors(
+          createFileError(DWOFilenames.front(), ErrOrMachine.takeError()),
+          WithColor::error());
+      return 1;
+    }
+    MS = createDWPStreamer(MC, *OS, ErrOrMachine->first, ErrOrMachine->second);
+  } else {
+    MS.reset(TheTarget->createMCObjectStreamer(
+        *ErrOrTriple, MC, std::unique_ptr<MCAsmBackend>(MAB),
+        MAB->createObjectWriter(*OS), std::unique_ptr<MCCodeEmitter>(MCE),
+        *MSTI, MCOptions.MCRelaxAll, MCOptions.MCIncrementalLinkerCompatible,
+        /*DWARFMustBeAtTheEnd*/ false));
+  }
   if (!MS)
     return error("no object streamer for target " + TripleName, Context);
 
@@ -219,6 +271,8 @@ int main(int argc, char **argv) {
   }
 
   MS->finish();
+  if (MC.hadError())
+    return 1;
   OutFile.keep();
   return 0;
 }
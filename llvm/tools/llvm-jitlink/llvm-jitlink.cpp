@@ -207,6 +207,11 @@ static cl::opt<uint64_t> SlabPageSize(
     cl::desc("Set page size for slab (requires -slab-allocate and -noexec)"),
     cl::init(0), cl::cat(JITLinkCategory));
 
+static cl::opt<bool> SlabHugePages(
+    "slab-huge-pages",
+    cl::desc("Ask for transparent huge pages for the in-process slab"),
+    cl::init(false), cl::cat(JITLinkCategory));
+
 static cl::opt<bool> ShowRelocatedSectionContents(
     "show-relocated-section-contents",
     cl::desc("show section contents after fixups have been applied"),
@@ -593,7 +598,7 @@ static std::unique_ptr<JITLinkMemoryManager> createInProcessMemoryManager() {
   // Otherwise use the standard in-process mapper.
   return ExitOnErr(
       MapperJITLinkMemoryManager::CreateWithMapper<InProcessMemoryMapper>(
-          SlabSize));
+          SlabSize, SlabHugePages));
 }
 
 Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
@@ -9,6 +9,7 @@
 #include "ProfileGenerator.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Process.h"
 
 #define DEBUG_TYPE "perf-reader"
@@ -479,11 +480,68 @@ static std::string getContextKeyStr(ContextKey *K,
   }
 }
 
+void VirtualUnwinder::mergeStats(const VirtualUnwinder &Other) {
+  NumTotalBranches += Other.NumTotalBranches;
+  NumExtCallBranch += Other.NumExtCallBranch;
+  NumMissingExternalFrame += Other.NumMissingExternalFrame;
+  NumMismatchedProEpiBranch += Other.NumMismatchedProEpiBranch;
+  NumMismatchedExtCallBranch += Other.NumMismatchedExtCallBranch;
+  NumUnpairedExtAddr += Other.NumUnpairedExtAddr;
+  NumPairedExtAddr += Other.NumPairedExtAddr;
+  UntrackedCallsites.insert(Other.UntrackedCallsites.begin(),
+                            Other.UntrackedCallsites.end());
+}
+
 void HybridPerfReader::unwindSamples() {
   VirtualUnwinder Unwinder(&SampleCounters, Binary);
-  for (const auto &Item : AggregatedSamples) {
-    const PerfSample *Sample = Item.first.getPtr();
-    Unwinder.unwind(Sample, Item.second);
+  if (!Binary->usePseudoProbes()) {
+    // Without pseudo probes, unwinding symbolizes addresses through caches in
+    // the binary that are filled on demand, so it has to stay on one thread.
+    for (const auto &Item : AggregatedSamples) {
+      const PerfSample *Sample = Item.first.getPtr();
+      Unwinder.unwind(Sample, Item.second);
+    }
+  } else {
+    // With pseudo probes, unwinding only reads the binary. Unwind chunks of
+    // samples in parallel into counters of their own and merge them in chunk
+    // order. The chunks are independent of the number of threads, which keeps
+    // the result deterministic, and are processed a round at a time to bound
+    // the memory held by the per-chunk counters.
+    constexpr size_t ChunkSize = 1024;
+    constexpr size_t ChunksPerRound = 64;
+    std::vector<const AggregatedCounter::value_type *> Samples;
+    Samples.reserve(AggregatedSamples.size());
+    for (const auto &Item : AggregatedSamples)
+      Samples.push_back(&Item);
+
+    for (size_t Begin = 0; Begin < Samples.size();
+         Begin += ChunkSize * ChunksPerRound) {
+      size_t NumChunks = std::min<size_t>(
+          ChunksPerRound, divideCeil(Samples.size() - Begin, ChunkSize));
+      std::vector<ContextSampleCounterMap> Counters(NumChunks);
+      std::vector<VirtualUnwinder> Unwinders;
+      Unwinders.reserve(NumChunks);
+      for (ContextSampleCounterMap &Counter : Counters)
+        Unwinders.emplace_back(&Counter, Binary);
+
+      parallelFor(0, NumChunks, [&](size_t Chunk) {
+        size_t ChunkBegin = Begin + Chunk * ChunkSize;
+        size_t ChunkEnd = std::min(ChunkBegin + ChunkSize, Samples.size());
+        for (size_t I = ChunkBegin; I != ChunkEnd; ++I)
+          Unwinders[Chunk].unwind(Samples[I]->first.getPtr(),
+                                  Samples[I]->second);
+      });
+
+      for (size_t Chunk = 0; Chunk != NumChunks; ++Chunk) {
+        for (auto &Item : Counters[Chunk]) {
+          auto Ret = SampleCounters.try_emplace(Item.first,
+                                                std::move(Item.second));
+          if (!Ret.second)
+            Ret.first->second.merge(Item.second);
+        }
+        Unwinder.mergeStats(Unwinders[Chunk]);
+      }
+    }
   }
 
   // Warn about untracked frames due to missing probes.
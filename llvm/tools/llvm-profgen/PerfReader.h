@@ -408,6 +408,12 @@ struct SampleCounter {
   void recordBranchCount(uint64_t Source, uint64_t Target, uint64_t Repeat) {
     BranchCounter[{Source, Target}] += Repeat;
   }
+  void merge(const SampleCounter &Other) {
+    for (const auto &I : Other.RangeCounter)
+      RangeCounter[I.first] += I.second;
+    for (const auto &I : Other.BranchCounter)
+      BranchCounter[I.first] += I.second;
+  }
 };
 
 // Sample counter with context to support context-sensitive profile
@@ -476,6 +482,8 @@ public:
       : CtxCounterMap(Counter), Binary(B) {}
   bool unwind(const PerfSample *Sample, uint64_t Repeat);
   std::set<uint64_t> &getUntrackedCallsites() { return UntrackedCallsites; }
+  // Add the statistics of another unwinder to this one.
+  void mergeStats(const VirtualUnwinder &Other);
 
   uint64_t NumTotalBranches = 0;
   uint64_t NumExtCallBranch = 0;
@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm-c/Remarks.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Remarks/Remark.h"
 #include "llvm/Remarks/RemarkFormat.h"
@@ -42,6 +43,9 @@ static cl::SubCommand
     AnnotationCount("annotation-count",
                     "Collect count information from annotation remarks (uses "
                     "AnnotationRemarksPass)");
+static cl::SubCommand
+    Count("count", "Count remarks per pass, remark name or function across "
+                   "one or more remark files");
 } // namespace subopts
 
 // Keep input + output help + names consistent across the various modes via a
@@ -101,6 +105,28 @@ INPUT_OUTPUT_COMMAND_LINE_OPTIONS(subopts::AnnotationCount)
 DEBUG_LOC_INFO_COMMAND_LINE_OPTIONS(subopts::AnnotationCount)
 } // namespace annotationcount
 
+namespace count {
+enum class GroupBy { Pass, Remark, Function };
+INPUT_FORMAT_COMMAND_LINE_OPTIONS(subopts::Count)
+static cl::list<std::string> InputFileNames(cl::Positional, cl::OneOrMore,
+                                            cl::cat(RemarkUtilCategory),
+                                            cl::desc("<input files>"),
+                                            cl::sub(subopts::Count));
+static cl::opt<std::string> OutputFileName("o", cl::init("-"),
+                                           cl::cat(RemarkUtilCategory),
+                                           cl::desc("Output"),
+                                           cl::value_desc("filename"),
+                                           cl::sub(subopts::Count));
+static cl::opt<GroupBy> GroupByOpt(
+    "group-by", cl::desc("Key to aggregate remark counts by"),
+    cl::init(GroupBy::Remark),
+    cl::values(clEnumValN(GroupBy::Pass, "pass", "Pass name"),
+               clEnumValN(GroupBy::Remark, "remark", "Pass and remark name"),
+               clEnumValN(GroupBy::Function, "function",
+                          "Pass, remark and function name")),
+    cl::sub(subopts::Count));
+} // namespace count
+
 /// \returns A MemoryBuffer for the input file on success, and an Error
 /// otherwise.
 static Expected<std::unique_ptr<MemoryBuffer>>
@@ -350,6 +376,83 @@ static Error tryAnnotationCount() {
 }
 
 } // namespace annotationcount
+
+namespace count {
+/// \returns \p Field as a CSV field, quoted if it contains a separator, a
+/// quote or a line break.
+static std::string escapeCSVField(StringRef Field) {
+  if (Field.find_first_of(",\"\r\n") == StringRef::npos)
+    return Field.str();
+  std::string Escaped = "\"";
+  for (char C : Field) {
+    if (C == '"')
+      Escaped += '"';
+    Escaped += C;
+  }
+  Escaped += '"';
+  return Escaped;
+}
+
+/// \returns the CSV key for \p Remark according to the grouping option.
+static std::string getGroupKey(const Remark &Remark) {
+  std::string Key = escapeCSVField(Remark.PassName);
+  if (GroupByOpt >= GroupBy::Remark)
+    Key += "," + escapeCSVField(Remark.RemarkName);
+  if (GroupByOpt >= GroupBy::Function)
+    Key += "," + escapeCSVField(Remark.FunctionName);
+  return Key;
+}
+
+/// Streams the remarks of every input file and outputs the number of remarks
+/// per group as a CSV. Remarks are discarded as soon as they are counted, so
+/// memory use only depends on the number of distinct groups.
+/// \returns Error::success() on success, and an Error otherwise.
+static Error tryCount() {
+  StringMap<uint64_t> Counts;
+  for (const std::string &InputFileName : InputFileNames) {
+    auto MaybeBuf = getInputMemoryBuffer(InputFileName);
+    if (!MaybeBuf)
+      return MaybeBuf.takeError();
+    auto MaybeParser =
+        createRemarkParser(InputFormat, (*MaybeBuf)->getBuffer());
+    if (!MaybeParser)
+      return MaybeParser.takeError();
+    auto &Parser = **MaybeParser;
+    auto MaybeRemark = Parser.next();
+    for (; MaybeRemark; MaybeRemark = Parser.next())
+      ++Counts[getGroupKey(**MaybeRemark)];
+    auto E = MaybeRemark.takeError();
+    if (!E.isA<EndOfFileError>())
+      return E;
+    consumeError(std::move(E));
+  }
+
+  auto MaybeOF = getOutputFileWithFlags(OutputFileName,
+                                        /*Flags = */ sys::fs::OF_TextWithCRLF);
+  if (!MaybeOF)
+    return MaybeOF.takeError();
+  auto OF = std::move(*MaybeOF);
+  // Emit CSV header.
+  OF->os() << "Pass,";
+  if (GroupByOpt >= GroupBy::Remark)
+    OF->os() << "Remark,";
+  if (GroupByOpt >= GroupBy::Function)
+    OF->os() << "Function,";
+  OF->os() << "Count\n";
+  // Sort the groups so that the output doesn't depend on hashing.
+  std::vector<const StringMapEntry<uint64_t> *> Entries;
+  for (const auto &Entry : Counts)
+    Entries.push_back(&Entry);
+  llvm::sort(Entries, [](const auto *LHS, const auto *RHS) {
+    return LHS->getKey() < RHS->getKey();
+  });
+  for (const auto *Entry : Entries)
+    OF->os() << Entry->getKey() << "," << Entry->getValue() << "\n";
+  OF->keep();
+  return Error::success();
+}
+} // namespace count
+
 /// Handle user-specified suboptions (e.g. yaml2bitstream, bitstream2yaml).
 /// \returns An Error if the specified suboption fails or if no suboption was
 /// specified. Otherwise, Error::success().
@@ -362,6 +465,8 @@ static Error handleSuboptions() {
     return instructioncount::tryInstructionCount();
   if (subopts::AnnotationCount)
     return annotationcount::tryAnnotationCount();
+  if (subopts::Count)
+    return count::tryCount();
 
   return make_error<StringError>(
       "Please specify a subcommand. (See -help for options)",
@@ -133,6 +133,9 @@ static void enableDebuginfod(LLVMSymbolizer &Symbolizer,
       Args.getAllArgValues(OPT_debug_file_directory_EQ)));
   // The HTTPClient must be initialized for use by the debuginfod client.
   HTTPClient::initialize();
+  // Addresses of one missing binary are often symbolized many times; only ask
+  // the servers about it again after a while.
+  setDebuginfodMissingArtifactTTL(std::chrono::minutes(5));
 }
 
 static bool parseCommand(StringRef BinaryName, bool IsAddr2Line,
@@ -413,6 +416,18 @@ int main(int argc, char **argv) {
   Opts.DWPName = Args.getLastArgValue(OPT_dwp_EQ).str();
   Opts.FallbackDebugPath =
       Args.getLastArgValue(OPT_fallback_debug_path_EQ).str();
+  Opts.IndexCacheDirectory =
+      Args.getLastArgValue(OPT_index_cache_dir_EQ).str();
+  if (const opt::Arg *A = Args.getLastArg(OPT_index_cache_policy_EQ)) {
+    Expected<CachePruningPolicy> Policy =
+        parseCachePruningPolicy(A->getValue());
+    if (!Policy) {
+      errs() << A->getSpelling() << ": invalid cache policy: "
+             << toString(Policy.takeError()) << '\n';
+      exit(1);
+    }
+    Opts.IndexCachePolicy = *Policy;
+  }
   Opts.PrintFunctions = decideHowToPrintFunctions(Args, IsAddr2Line);
   parseIntArg(Args, OPT_print_source_context_lines_EQ,
               Config.SourceContextLines);
@@ -420,6 +435,7 @@ int main(int argc, char **argv) {
   Opts.UntagAddresses =
       Args.hasFlag(OPT_untag_addresses, OPT_no_untag_addresses, !IsAddr2Line);
   Opts.UseDIA = Args.hasArg(OPT_use_dia);
+  Opts.UseGsym = Args.hasFlag(OPT_gsym, OPT_no_gsym, false);
 #if !defined(LLVM_ENABLE_DIA_SDK)
   if (Opts.UseDIA) {
     WithColor::warning() << "DIA not available; using native PDB reader\n";
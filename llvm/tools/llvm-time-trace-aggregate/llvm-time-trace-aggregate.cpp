@@ -0,0 +1,360 @@
+//===-- llvm-time-trace-aggregate.cpp - Merge -ftime-trace profiles ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This utility merges the time trace profiles written by -ftime-trace for many
+// compilations and reports where the time went across all of them, e.g. which
+// headers were parsed most often or which templates were instantiated at the
+// highest total cost.
+//
+// Events are keyed by their name and detail, e.g. "InstantiateClass" and the
+// name of the class template specialization. For each key the tool records
+// how often it occurred, in how many traces, its inclusive time and its
+// exclusive time, which excludes the time of the events nested in it.
+//
+// The merged result can be written as a summary with -o. Summaries are
+// accepted as inputs as well, so traces can be merged in stages.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static cl::OptionCategory AggregateCategory("Aggregation Options");
+
+static cl::list<std::string> InputFiles(cl::Positional, cl::OneOrMore,
+                                        cl::desc("<time trace files>"),
+                                        cl::cat(AggregateCategory));
+
+static cl::opt<std::string>
+    OutputFile("o", cl::desc("Write the merged summary to <file>"),
+               cl::value_desc("file"), cl::cat(AggregateCategory));
+
+static cl::opt<unsigned>
+    TopN("top", cl::desc("Number of entries to report per event name"),
+         cl::init(10), cl::cat(AggregateCategory));
+
+enum class SortKind { Inclusive, Exclusive, Count };
+
+static cl::opt<SortKind> SortBy(
+    "sort", cl::desc("Order of the reported entries"),
+    cl::values(clEnumValN(SortKind::Inclusive, "incl", "inclusive time"),
+               clEnumValN(SortKind::Exclusive, "excl", "exclusive time"),
+               clEnumValN(SortKind::Count, "count", "number of occurrences")),
+    cl::init(SortKind::Inclusive), cl::cat(AggregateCategory));
+
+static cl::list<std::string>
+    OnlyNames("name",
+              cl::desc("Only report events with this name (can be repeated)"),
+              cl::cat(AggregateCategory));
+
+static cl::opt<bool> NoReport("no-report",
+                              cl::desc("Do not print the report"),
+                              cl::cat(AggregateCategory));
+
+namespace {
+/// The accumulated cost of one (name, detail) key.
+struct Stats {
+  uint64_t Count = 0;
+  uint64_t Files = 0;
+  // In microseconds, like the trace itself.
+  uint64_t Inclusive = 0;
+  uint64_t Exclusive = 0;
+
+  void merge(const Stats &Other) {
+    Count += Other.Count;
+    Files += Other.Files;
+    Inclusive += Other.Inclusive;
+    Exclusive += Other.Exclusive;
+  }
+};
+
+/// A map from "<name>\0<detail>" to the stats of that key.
+using StatsMap = StringMap<Stats>;
+
+struct Event {
+  StringRef Name;
+  StringRef Detail;
+  int64_t Tid;
+  int64_t Start;
+  int64_t Duration;
+  int64_t Children = 0;
+};
+} // namespace
+
+static std::string makeKey(StringRef Name, StringRef Detail) {
+  return (Name + Twine('\0') + Detail).str();
+}
+
+static std::pair<StringRef, StringRef> splitKey(StringRef Key) {
+  return Key.split('\0');
+}
+
+/// Adds the complete events of a -ftime-trace profile to \p Result.
+static Error readTrace(const json::Array &TraceEvents, StatsMap &Result) {
+  std::vector<Event> Events;
+  for (const json::Value &V : TraceEvents) {
+    const json::Object *O = V.getAsObject();
+    if (!O)
+      return createStringError(inconvertibleErrorCode(),
+                               "trace event is not an object");
+    std::optional<StringRef> Ph = O->getString("ph");
+    if (!Ph || *Ph != "X")
+      continue;
+    std::optional<StringRef> Name = O->getString("name");
+    std::optional<int64_t> Ts = O->getInteger("ts");
+    std::optional<int64_t> Dur = O->getInteger("dur");
+    if (!Name || !Ts || !Dur)
+      return createStringError(inconvertibleErrorCode(),
+                               "complete event without name, ts or dur");
+    // The per-name totals at the end of the trace repeat the other events.
+    if (Name->startswith("Total "))
+      continue;
+    Event E;
+    E.Name = *Name;
+    if (const json::Object *Args = O->getObject("args"))
+      E.Detail = Args->getString("detail").value_or("");
+    E.Tid = O->getInteger("tid").value_or(0);
+    E.Start = *Ts;
+    E.Duration = *Dur;
+    Events.push_back(E);
+  }
+
+  // Within a thread events nest properly; an enclosing event starts no later
+  // and lasts no shorter than the events inside it.
+  llvm::stable_sort(Events, [](const Event &A, const Event &B) {
+    if (A.Tid != B.Tid)
+      return A.Tid < B.Tid;
+    if (A.Start != B.Start)
+      return A.Start < B.Start;
+    return A.Duration > B.Duration;
+  });
+  SmallVector<Event *, 32> Open;
+  for (Event &E : Events) {
+    while (!Open.empty() &&
+           (Open.back()->Tid != E.Tid ||
+            Open.back()->Start + Open.back()->Duration <= E.Start))
+      Open.pop_back();
+    if (!Open.empty())
+      Open.back()->Children += E.Duration;
+    Open.push_back(&E);
+  }
+
+  StringMap<bool> Seen;
+  for (const Event &E : Events) {
+    std::string Key = makeKey(E.Name, E.Detail);
+    Stats &S = Result[Key];
+    ++S.Count;
+    if (Seen.try_emplace(Key, true).second)
+      ++S.Files;
+    S.Inclusive += E.Duration;
+    S.Exclusive += std::max<int64_t>(E.Duration - E.Children, 0);
+  }
+  return Error::success();
+}
+
+/// Adds the entries of a summary written by this tool to \p Result.
+static Error readSummary(const json::Array &Entries, StatsMap &Result) {
+  for (const json::Value &V : Entries) {
+    const json::Object *O = V.getAsObject();
+    std::optional<StringRef> Name = O ? O->getString("name") : std::nullopt;
+    if (!Name)
+      return createStringError(inconvertibleErrorCode(),
+                               "summary entry without a name");
+    Stats S;
+    S.Count = O->getInteger("count").value_or(0);
+    S.Files = O->getInteger("files").value_or(0);
+    S.Inclusive = O->getInteger("incl").value_or(0);
+    S.Exclusive = O->getInteger("excl").value_or(0);
+    Result[makeKey(*Name, O->getString("detail").value_or(""))].merge(S);
+  }
+  return Error::success();
+}
+
+/// Adds the contents of the trace or summary at \p Path to \p Result and sets
+/// \p NumFiles to the number of traces it stands for.
+static Error readFile(StringRef Path, StatsMap &Result, uint64_t &NumFiles) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buf =
+      MemoryBuffer::getFileOrSTDIN(Path);
+  if (!Buf)
+    return createFileError(Path, Buf.getError());
+  Expected<json::Value> Root = json::parse((*Buf)->getBuffer());
+  if (!Root)
+    return createFileError(Path, Root.takeError());
+  Error Err = Error::success();
+  const json::Object *O = Root->getAsObject();
+  if (const json::Array *Events = O ? O->getArray("traceEvents") : nullptr) {
+    NumFiles = 1;
+    Err = readTrace(*Events, Result);
+  } else if (const json::Array *Entries = O ? O->getArray("entries")
+                                            : nullptr) {
+    NumFiles = O->getInteger("files").value_or(0);
+    Err = readSummary(*Entries, Result);
+  } else {
+    Err = createStringError(inconvertibleErrorCode(),
+                            "neither a time trace nor a summary");
+  }
+  if (Err)
+    return createFileError(Path, std::move(Err));
+  return Error::success();
+}
+
+static void writeSummary(raw_ostream &OS, const StatsMap &Result,
+                         uint64_t NumFiles) {
+  std::vector<const StatsMap::value_type *> Sorted;
+  for (const StatsMap::value_type &KV : Result)
+    Sorted.push_back(&KV);
+  // Sort by key so that the output does not depend on the input order.
+  llvm::sort(Sorted, [](const StatsMap::value_type *A,
+                        const StatsMap::value_type *B) {
+    return A->getKey() < B->getKey();
+  });
+
+  json::OStream J(OS, 2);
+  J.object([&] {
+    J.attribute("version", 1);
+    J.attribute("files", int64_t(NumFiles));
+    J.attributeArray("entries", [&] {
+      for (const StatsMap::value_type *KV : Sorted) {
+        auto [Name, Detail] = splitKey(KV->getKey());
+        const Stats &S = KV->getValue();
+        J.object([&] {
+          J.attribute("name", Name);
+          if (!Detail.empty())
+            J.attribute("detail", Detail);
+          J.attribute("count", int64_t(S.Count));
+          J.attribute("files", int64_t(S.Files));
+          J.attribute("incl", int64_t(S.Inclusive));
+          J.attribute("excl", int64_t(S.Exclusive));
+        });
+      }
+    });
+  });
+  OS << '\n';
+}
+
+static uint64_t getSortValue(const Stats &S) {
+  switch (SortBy) {
+  case SortKind::Inclusive:
+    return S.Inclusive;
+  case SortKind::Exclusive:
+    return S.Exclusive;
+  case SortKind::Count:
+    return S.Count;
+  }
+  llvm_unreachable("unknown sort kind");
+}
+
+static void printReport(raw_ostream &OS, const StatsMap &Result,
+                        uint64_t NumFiles) {
+  // Group the entries by event name, and order the groups by their total
+  // inclusive time.
+  StringMap<std::vector<const StatsMap::value_type *>> Groups;
+  StringMap<uint64_t> GroupTime;
+  for (const StatsMap::value_type &KV : Result) {
+    StringRef Name = splitKey(KV.getKey()).first;
+    if (!OnlyNames.empty() && !llvm::is_contained(OnlyNames, Name))
+      continue;
+    Groups[Name].push_back(&KV);
+    GroupTime[Name] += KV.getValue().Inclusive;
+  }
+  std::vector<StringRef> Names;
+  for (const auto &G : Groups)
+    Names.push_back(G.getKey());
+  llvm::sort(Names, [&](StringRef A, StringRef B) {
+    uint64_t TA = GroupTime[A], TB = GroupTime[B];
+    return TA != TB ? TA > TB : A < B;
+  });
+
+  OS << "Merged " << NumFiles << " time trace file(s)\n";
+  for (StringRef Name : Names) {
+    std::vector<const StatsMap::value_type *> &Entries = Groups[Name];
+    llvm::sort(Entries, [](const StatsMap::value_type *A,
+                           const StatsMap::value_type *B) {
+      uint64_t VA = getSortValue(A->getValue()), VB = getSortValue(B->getValue());
+      return VA != VB ? VA > VB : A->getKey() < B->getKey();
+    });
+    OS << "\n=== " << Name << " (" << Entries.size() << " distinct, "
+       << format("%.3f", GroupTime[Name] / 1e6) << " s total) ===\n";
+    OS << "   incl (ms)    excl (ms)      count    files  detail\n";
+    for (const StatsMap::value_type *KV :
+         ArrayRef(Entries).take_front(TopN)) {
+      const Stats &S = KV->getValue();
+      OS << format("%12.1f %12.1f %10llu %8llu  ", S.Inclusive / 1e3,
+                   S.Exclusive / 1e3, (unsigned long long)S.Count,
+                   (unsigned long long)S.Files)
+         << splitKey(KV->getKey()).second << '\n';
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  InitLLVM X(argc, argv);
+
+  cl::HideUnrelatedOptions({&AggregateCategory, &getColorCategory()});
+  cl::ParseCommandLineOptions(
+      argc, argv,
+      "llvm-time-trace-aggregate - merge -ftime-trace profiles\n\n"
+      "  Inputs may be time trace files or summaries written with -o.\n"
+      "  Use @<file> to read the list of inputs from a response file.\n");
+
+  // Each file is read into its own map, which is merged into the result as
+  // soon as it is done, so that at most one trace per thread is in memory.
+  StatsMap Result;
+  uint64_t NumFiles = 0;
+  std::mutex ResultMutex;
+  std::atomic<bool> HadError{false};
+  parallelFor(0, InputFiles.size(), [&](size_t I) {
+    StatsMap Local;
+    uint64_t LocalFiles = 0;
+    if (Error Err = readFile(InputFiles[I], Local, LocalFiles)) {
+      std::lock_guard<std::mutex> Lock(ResultMutex);
+      WithColor::error() << toString(std::move(Err)) << '\n';
+      HadError = true;
+      return;
+    }
+    std::lock_guard<std::mutex> Lock(ResultMutex);
+    NumFiles += LocalFiles;
+    for (const StatsMap::value_type &KV : Local)
+      Result[KV.getKey()].merge(KV.getValue());
+  });
+  if (HadError)
+    return 1;
+
+  if (!OutputFile.empty()) {
+    std::error_code EC;
+    ToolOutputFile Out(OutputFile, EC, sys::fs::OF_TextWithCRLF);
+    if (EC) {
+      WithColor::error() << OutputFile << ": " << EC.message() << '\n';
+      return 1;
+    }
+    writeSummary(Out.os(), Result, NumFiles);
+    Out.keep();
+  }
+
+  if (!NoReport)
+    printReport(outs(), Result, NumFiles);
+  return 0;
+}
@@ -0,0 +1,114 @@
+//===- ConcurrentStringMapTest.cpp ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/ConcurrentStringMap.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <string>
+using namespace llvm;
+using namespace parallel;
+
+namespace {
+
+TEST(ConcurrentStringMapTest, InsertAndFind) {
+  BumpPtrAllocator Allocator;
+  ConcurrentStringMap<int, BumpPtrAllocator> Map(Allocator, 10, 1);
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(nullptr, Map.find("a"));
+
+  auto [A, InsertedA] = Map.try_emplace("a", 1);
+  EXPECT_TRUE(InsertedA);
+  EXPECT_EQ("a", A->getKey());
+  EXPECT_EQ(1, A->getValue());
+
+  auto [B, InsertedB] = Map.try_emplace("b", 2);
+  EXPECT_TRUE(InsertedB);
+  EXPECT_NE(A, B);
+
+  // A duplicate returns the existing entry and keeps its value.
+  auto [A2, InsertedA2] = Map.try_emplace("a", 3);
+  EXPECT_FALSE(InsertedA2);
+  EXPECT_EQ(A, A2);
+  EXPECT_EQ(1, A2->getValue());
+
+  EXPECT_EQ(A, Map.find("a"));
+  EXPECT_EQ(B, Map.find("b"));
+  EXPECT_EQ(nullptr, Map.find("c"));
+  EXPECT_EQ(2u, Map.size());
+
+  // The empty string is a valid key.
+  EXPECT_TRUE(Map.try_emplace("", 0).second);
+  EXPECT_EQ(0, Map.find("")->getValue());
+}
+
+TEST(ConcurrentStringMapTest, Grow) {
+  BumpPtrAllocator Allocator;
+  // Start far too small so that every shard is grown several times.
+  ConcurrentStringMap<unsigned, BumpPtrAllocator> Map(Allocator, 1, 1);
+  const unsigned NumElements = 20000;
+  for (unsigned I = 0; I < NumElements; ++I)
+    EXPECT_TRUE(Map.try_emplace(formatv("{0}", I).str(), I).second);
+  EXPECT_EQ(NumElements, Map.size());
+
+  for (unsigned I = 0; I < NumElements; ++I) {
+    auto *E = Map.find(formatv("{0}", I).str());
+    ASSERT_NE(nullptr, E);
+    EXPECT_EQ(I, E->getValue());
+  }
+
+  size_t Count = 0;
+  Map.forEach([&](StringMapEntry<unsigned> &E) {
+    EXPECT_EQ(formatv("{0}", E.getValue()).str(), E.getKey());
+    ++Count;
+  });
+  EXPECT_EQ(NumElements, Count);
+}
+
+TEST(ConcurrentStringMapTest, DestroysValues) {
+  BumpPtrAllocator Allocator;
+  auto Value = std::make_shared<int>(0);
+  {
+    ConcurrentStringMap<std::shared_ptr<int>, BumpPtrAllocator> Map(Allocator,
+                                                                     10, 1);
+    Map.try_emplace("a", Value);
+    Map.try_emplace("b", Value);
+    // The value of a rejected duplicate is destroyed right away.
+    Map.try_emplace("a", Value);
+    EXPECT_EQ(3, Value.use_count());
+  }
+  EXPECT_EQ(1, Value.use_count());
+}
+
+TEST(ConcurrentStringMapTest, ConcurrentInsert) {
+  PerThreadBumpPtrAllocator Allocator;
+  ConcurrentStringMap<unsigned> Map(Allocator, 16);
+  const unsigned NumElements = 10000;
+  std::atomic<unsigned> NumInserted{0};
+
+  // Every key is inserted by several tasks; exactly one of them must win.
+  parallelFor(0, NumElements * 4, [&](size_t I) {
+    unsigned Key = I % NumElements;
+    auto [E, Inserted] = Map.try_emplace(formatv("{0}", Key).str(), Key);
+    EXPECT_EQ(Key, E->getValue());
+    if (Inserted)
+      ++NumInserted;
+  });
+  EXPECT_EQ(NumElements, NumInserted);
+  EXPECT_EQ(NumElements, Map.size());
+
+  parallelFor(0, NumElements, [&](size_t I) {
+    auto *E = Map.find(formatv("{0}", I).str());
+    ASSERT_NE(nullptr, E);
+    EXPECT_EQ(I, E->getValue());
+  });
+}
+
+} // end anonymous namespace
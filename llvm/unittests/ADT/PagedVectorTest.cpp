@@ -0,0 +1,77 @@
+//===- llvm/unittest/ADT/PagedVectorTest.cpp - PagedVector tests ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/PagedVector.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(PagedVectorTest, Empty) {
+  PagedVector<int, 10> V;
+  EXPECT_TRUE(V.empty());
+  EXPECT_EQ(V.size(), 0u);
+  EXPECT_EQ(V.capacity(), 0u);
+}
+
+TEST(PagedVectorTest, AllocatesOnAccess) {
+  PagedVector<int, 10> V;
+  V.resize(100);
+  EXPECT_EQ(V.size(), 100u);
+  EXPECT_EQ(V.capacity(), 0u);
+
+  // Elements of a new page are value-initialized.
+  EXPECT_EQ(V[42], 0);
+  EXPECT_EQ(V.capacity(), 10u);
+  V[42] = 7;
+  V[49] = 8;
+  EXPECT_EQ(V.capacity(), 10u);
+  V[99] = 9;
+  EXPECT_EQ(V.capacity(), 20u);
+
+  EXPECT_EQ(V[42], 7);
+  EXPECT_EQ(V[49], 8);
+  EXPECT_EQ(V[99], 9);
+}
+
+TEST(PagedVectorTest, ReferencesAreStable) {
+  PagedVector<int, 4> V;
+  V.resize(8);
+  int &First = V[1];
+  First = 1;
+  V.resize(1000);
+  V[999] = 2;
+  EXPECT_EQ(&First, &V[1]);
+  EXPECT_EQ(V[1], 1);
+}
+
+TEST(PagedVectorTest, Shrink) {
+  PagedVector<int, 4> V;
+  V.resize(10);
+  for (int I = 0; I != 10; ++I)
+    V[I] = I + 1;
+  EXPECT_EQ(V.capacity(), 12u);
+
+  V.resize(5);
+  EXPECT_EQ(V.size(), 5u);
+  EXPECT_EQ(V.capacity(), 8u);
+  EXPECT_EQ(V[4], 5);
+
+  // Growing again exposes fresh elements, not the ones that were dropped.
+  V.resize(10);
+  EXPECT_EQ(V[5], 0);
+  EXPECT_EQ(V[7], 0);
+  EXPECT_EQ(V[9], 0);
+
+  V.clear();
+  EXPECT_TRUE(V.empty());
+  EXPECT_EQ(V.capacity(), 0u);
+}
+
+} // namespace
@@ -205,3 +205,34 @@ TEST_F(BasicAATest, PartialAliasOffsetSelect) {
       MemoryLocation(Select, LocationSize::precise(1)), AAQI, nullptr);
   ASSERT_EQ(AR.getOffset(), 1);
 }
+
+// Check that a batch does not reuse the decomposition of an erased GEP for a
+// new GEP, which may be allocated at the same address.
+TEST_F(BasicAATest, BatchDecompositionOfErasedGEP) {
+  F = Function::Create(FunctionType::get(B.getVoidTy(), {B.getPtrTy()}, false),
+                       GlobalValue::ExternalLinkage, "F", &M);
+
+  Value *Ptr = F->arg_begin();
+
+  BasicBlock *Entry(BasicBlock::Create(C, "", F));
+  B.SetInsertPoint(Entry);
+  auto *Ret = B.CreateRetVoid();
+  B.SetInsertPoint(Ret);
+  auto *Ptr4 =
+      cast<GetElementPtrInst>(B.CreateGEP(B.getInt8Ty(), Ptr, B.getInt64(4)));
+
+  auto &AllAnalyses = setupAnalyses();
+  BatchAAResults BatchAA(AllAnalyses.AAR);
+  ASSERT_EQ(BatchAA.alias(MemoryLocation(Ptr4, LocationSize::precise(4)),
+                          MemoryLocation(Ptr, LocationSize::precise(4))),
+            AliasResult::NoAlias);
+
+  Ptr4->eraseFromParent();
+  auto *Ptr0 =
+      cast<GetElementPtrInst>(B.CreateGEP(B.getInt8Ty(), Ptr, B.getInt64(0)));
+  // Use a different size, so that the result is not taken from the alias
+  // cache either if Ptr0 reuses the address of Ptr4.
+  EXPECT_NE(BatchAA.alias(MemoryLocation(Ptr0, LocationSize::precise(8)),
+                          MemoryLocation(Ptr, LocationSize::precise(4))),
+            AliasResult::NoAlias);
+}
@@ -0,0 +1,87 @@
+//===- llvm/unittest/DebugInfo/DWARFDebugArangesTest.cpp ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DebugInfo/DWARF/DWARFDebugAranges.h"
+#include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+// Two address range tables: [0x1000, 0x1100) for the compile unit at 0 and
+// [0x2000, 0x2010) for the one at 0x40.
+static const char DebugArangesSecRaw[] =
+    "\x2c\x00\x00\x00"                 // Length
+    "\x02\x00"                         // Version
+    "\x00\x00\x00\x00"                 // Debug Info Offset
+    "\x08"                             // Address Size
+    "\x00"                             // Segment Selector Size
+    "\x00\x00\x00\x00"                 // Padding
+    "\x00\x10\x00\x00\x00\x00\x00\x00" // Address
+    "\x00\x01\x00\x00\x00\x00\x00\x00" // Length
+    "\x00\x00\x00\x00\x00\x00\x00\x00" // Termination tuple
+    "\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x2c\x00\x00\x00"                 // Length
+    "\x02\x00"                         // Version
+    "\x40\x00\x00\x00"                 // Debug Info Offset
+    "\x08"                             // Address Size
+    "\x00"                             // Segment Selector Size
+    "\x00\x00\x00\x00"                 // Padding
+    "\x00\x20\x00\x00\x00\x00\x00\x00" // Address
+    "\x10\x00\x00\x00\x00\x00\x00\x00" // Length
+    "\x00\x00\x00\x00\x00\x00\x00\x00" // Termination tuple
+    "\x00\x00\x00\x00\x00\x00\x00\x00";
+
+static std::unique_ptr<DWARFContext> createContext() {
+  StringMap<std::unique_ptr<MemoryBuffer>> Sections;
+  Sections.insert(std::make_pair(
+      "debug_aranges",
+      MemoryBuffer::getMemBuffer(
+          StringRef(DebugArangesSecRaw, sizeof(DebugArangesSecRaw) - 1))));
+  return DWARFContext::create(Sections, /* AddrSize = */ 8,
+                              /* isLittleEndian = */ true);
+}
+
+TEST(DWARFDebugAranges, GenerateFromArangesSection) {
+  std::unique_ptr<DWARFContext> Context = createContext();
+  DWARFDebugAranges Aranges;
+  Aranges.generateFromArangesSection(Context.get());
+  EXPECT_EQ(0u, Aranges.findAddress(0x1000));
+  EXPECT_EQ(0u, Aranges.findAddress(0x10ff));
+  EXPECT_EQ(-1ULL, Aranges.findAddress(0x1100));
+  EXPECT_EQ(0x40u, Aranges.findAddress(0x2008));
+  EXPECT_EQ(-1ULL, Aranges.findAddress(0x2010));
+}
+
+TEST(DWARFDebugAranges, CacheRoundTrip) {
+  std::unique_ptr<DWARFContext> Context = createContext();
+  DWARFDebugAranges Aranges;
+  Aranges.generateFromArangesSection(Context.get());
+
+  std::string Cache;
+  raw_string_ostream OS(Cache);
+  Aranges.writeCache(OS, /*Key=*/42);
+  OS.flush();
+
+  DWARFDebugAranges Loaded;
+  ASSERT_TRUE(Loaded.readCache(Cache, /*Key=*/42));
+  EXPECT_EQ(0u, Loaded.findAddress(0x1080));
+  EXPECT_EQ(0x40u, Loaded.findAddress(0x2000));
+  EXPECT_EQ(-1ULL, Loaded.findAddress(0x3000));
+
+  // A cache for different debug info, or a damaged one, is rejected.
+  EXPECT_FALSE(Loaded.readCache(Cache, /*Key=*/43));
+  EXPECT_TRUE(Loaded.empty());
+  EXPECT_FALSE(Loaded.readCache(StringRef(Cache).drop_back(), /*Key=*/42));
+  EXPECT_FALSE(Loaded.readCache("", /*Key=*/42));
+}
+
+} // end anonymous namespace
@@ -14,6 +14,7 @@
 #include "llvm/DebugInfo/GSYM/FileEntry.h"
 #include "llvm/DebugInfo/GSYM/FileWriter.h"
 #include "llvm/DebugInfo/GSYM/FunctionInfo.h"
+#include "llvm/DebugInfo/GSYM/GsymContext.h"
 #include "llvm/DebugInfo/GSYM/GsymCreator.h"
 #include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/GSYM/Header.h"
@@ -2651,3 +2652,41 @@ TEST(GSYMTest, TestGsymSegmenting) {
     ASSERT_THAT_EXPECTED(GR4000->lookup(0x3000), Failed());
   }
 }
+
+TEST(GSYMTest, TestGsymContext) {
+  // Verify that a GsymContext turns lookups into the same line and inlining
+  // information that a DWARF context would give the symbolizer.
+  GsymCreator GC;
+  AddFunctionInfo(GC, "main", 0x1000, "/tmp/main.c", "/tmp/main.h");
+  Expected<GsymReader> GR = FinalizeEncodeAndDecode(GC);
+  ASSERT_THAT_EXPECTED(GR, Succeeded());
+  GsymContext Context(std::make_unique<GsymReader>(std::move(*GR)));
+  DILineInfoSpecifier Specifier(
+      DILineInfoSpecifier::FileLineInfoKind::BaseNameOnly,
+      DILineInfoSpecifier::FunctionNameKind::LinkageName);
+
+  DILineInfo LineInfo = Context.getLineInfoForAddress(
+      {0x1012, object::SectionedAddress::UndefSection}, Specifier);
+  EXPECT_EQ(LineInfo.FunctionName, "main2");
+  EXPECT_EQ(LineInfo.FileName, "main.h");
+  EXPECT_EQ(LineInfo.Line, 20u);
+
+  DIInliningInfo InlineInfo = Context.getInliningInfoForAddress(
+      {0x1012, object::SectionedAddress::UndefSection}, Specifier);
+  ASSERT_EQ(InlineInfo.getNumberOfFrames(), 3u);
+  EXPECT_EQ(InlineInfo.getFrame(0).FunctionName, "main2");
+  EXPECT_EQ(InlineInfo.getFrame(0).Line, 20u);
+  EXPECT_EQ(InlineInfo.getFrame(1).FunctionName, "main1");
+  EXPECT_EQ(InlineInfo.getFrame(1).FileName, "main.h");
+  EXPECT_EQ(InlineInfo.getFrame(1).Line, 33u);
+  EXPECT_EQ(InlineInfo.getFrame(2).FunctionName, "main");
+  EXPECT_EQ(InlineInfo.getFrame(2).FileName, "main.c");
+  EXPECT_EQ(InlineInfo.getFrame(2).Line, 6u);
+  EXPECT_EQ(InlineInfo.getFrame(2).StartAddress, 0x1000u);
+
+  // Addresses outside of any function have no information.
+  LineInfo = Context.getLineInfoForAddress(
+      {0x3000, object::SectionedAddress::UndefSection}, Specifier);
+  EXPECT_EQ(LineInfo.FunctionName, DILineInfo::BadString);
+  EXPECT_EQ(LineInfo.Line, 0u);
+}
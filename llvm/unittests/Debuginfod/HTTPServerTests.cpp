@@ -6,9 +6,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/Debuginfod/Debuginfod.h"
 #include "llvm/Debuginfod/HTTPClient.h"
 #include "llvm/Debuginfod/HTTPServer.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gmock/gmock.h"
@@ -300,6 +302,60 @@ TEST_F(HTTPClientServerTest, FirstPathMatched) {
   Server.stop();
 }
 
+// Check that only artifacts that every server reports as not found are
+// remembered as missing, and only while a TTL is set.
+TEST_F(HTTPClientServerTest, DebuginfodMissingArtifactTTL) {
+  std::atomic<unsigned> Requests = 0;
+  std::atomic<unsigned> Code = 404;
+  HTTPServer Server;
+  ASSERT_THAT_ERROR(Server.get(UrlPathPattern,
+                               [&](HTTPServerRequest Request) {
+                                 ++Requests;
+                                 Request.setResponse(
+                                     {Code, "text/plain", "missing\n"});
+                               }),
+                    Succeeded());
+  Expected<unsigned> PortOrErr = Server.bind();
+  ASSERT_THAT_EXPECTED(PortOrErr, Succeeded());
+  ThreadPool Pool(hardware_concurrency(1));
+  Pool.async([&]() { EXPECT_THAT_ERROR(Server.listen(), Succeeded()); });
+  std::string Url = "http://localhost:" + utostr(*PortOrErr);
+  StringRef Urls[] = {Url};
+
+  SmallString<32> CacheDir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("debuginfod-ttl", CacheDir));
+  auto Lookup = [&](StringRef Key) {
+    Expected<std::string> PathOrErr = getCachedOrDownloadArtifact(
+        Key, "/buildid/" + Key.str() + "/debuginfo", CacheDir, Urls,
+        std::chrono::milliseconds(10000));
+    EXPECT_THAT_EXPECTED(PathOrErr, Failed());
+  };
+
+  // Without a TTL every lookup goes to the server.
+  Lookup("disabled");
+  Lookup("disabled");
+  EXPECT_EQ(Requests, 2u);
+
+  setDebuginfodMissingArtifactTTL(std::chrono::minutes(1));
+  Lookup("notfound");
+  Lookup("notfound");
+  EXPECT_EQ(Requests, 3u);
+
+  // Server errors may be transient and are not remembered.
+  Code = 503;
+  Lookup("unavailable");
+  Lookup("unavailable");
+  EXPECT_EQ(Requests, 5u);
+
+  // Turning the TTL off forgets the missing artifacts.
+  setDebuginfodMissingArtifactTTL(std::chrono::milliseconds(0));
+  Code = 404;
+  Lookup("notfound");
+  EXPECT_EQ(Requests, 6u);
+
+  Server.stop();
+}
+
 #endif
 
 #else
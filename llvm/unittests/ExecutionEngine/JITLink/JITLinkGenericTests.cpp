@@ -0,0 +1,123 @@
+//===--- JITLinkGenericTests.cpp - Unit tests for the generic link steps --===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/JITLink/ELF_x86_64.h"
+#include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/ExecutionEngine/JITLink/JITLinkMemoryManager.h"
+#include "llvm/ExecutionEngine/JITLink/x86_64.h"
+#include "llvm/Support/Endian.h"
+
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <optional>
+
+using namespace llvm;
+using namespace llvm::jitlink;
+
+namespace {
+
+// The link owns (and destroys) its context, so results are recorded here.
+struct LinkOutcome {
+  std::vector<orc::ExecutorAddr> Addrs;
+  std::function<void()> OnFinalized = [] {};
+  Error Err = Error::success();
+};
+
+class TestJITLinkContext : public JITLinkContext {
+public:
+  TestJITLinkContext(JITLinkMemoryManager &MemMgr, LinkOutcome &Outcome)
+      : JITLinkContext(nullptr), MemMgr(MemMgr), Outcome(Outcome) {}
+
+  JITLinkMemoryManager &getMemoryManager() override { return MemMgr; }
+
+  void notifyFailed(Error Err) override {
+    Outcome.Err = joinErrors(std::move(Outcome.Err), std::move(Err));
+  }
+
+  void lookup(const LookupMap &Symbols,
+              std::unique_ptr<JITLinkAsyncLookupContinuation> LC) override {
+    LC->run(AsyncLookupResult());
+  }
+
+  Error notifyResolved(LinkGraph &G) override {
+    for (auto *Sym : G.defined_symbols())
+      Outcome.Addrs.push_back(Sym->getAddress());
+    return Error::success();
+  }
+
+  void notifyFinalized(JITLinkMemoryManager::FinalizedAlloc Alloc) override {
+    Outcome.OnFinalized();
+    Outcome.Err = joinErrors(std::move(Outcome.Err),
+                             MemMgr.deallocate(std::move(Alloc)));
+  }
+
+private:
+  JITLinkMemoryManager &MemMgr;
+  LinkOutcome &Outcome;
+};
+
+constexpr size_t NumBlocks = 256;
+constexpr size_t EdgesPerBlock = 300;
+constexpr uint32_t TargetAddr = 0x1234;
+
+// Builds a graph with more edges than the concurrent fix-up threshold. The
+// edge at BadEdge, if any, points out of the range of a 32-bit pointer.
+std::unique_ptr<LinkGraph>
+makeLargeGraph(std::optional<size_t> BadEdge = std::nullopt) {
+  auto G = std::make_unique<LinkGraph>(
+      "foo", Triple("x86_64-pc-linux"), 8, support::little,
+      x86_64::getEdgeKindName);
+  auto &Sec =
+      G->createSection("__data", orc::MemProt::Read | orc::MemProt::Write);
+  auto &Target = G->addAbsoluteSymbol("target", orc::ExecutorAddr(TargetAddr),
+                                      0, Linkage::Strong, Scope::Local, true);
+  auto &FarTarget =
+      G->addAbsoluteSymbol("far", orc::ExecutorAddr(0x100000000ULL), 0,
+                           Linkage::Strong, Scope::Local, true);
+  for (size_t I = 0; I != NumBlocks; ++I) {
+    auto &B = G->createMutableContentBlock(Sec, EdgesPerBlock * 4,
+                                           orc::ExecutorAddr(), 4, 0);
+    G->addDefinedSymbol(B, 0, ("data" + Twine(I)).str(), EdgesPerBlock * 4,
+                        Linkage::Strong, Scope::Local, false, true);
+    for (size_t J = 0; J != EdgesPerBlock; ++J) {
+      bool Bad = BadEdge && *BadEdge == I * EdgesPerBlock + J;
+      B.addEdge(x86_64::Pointer32, J * 4, Bad ? FarTarget : Target, J);
+    }
+  }
+  return G;
+}
+
+TEST(JITLinkGenericTest, FixUpLargeGraph) {
+  auto MemMgr = cantFail(InProcessMemoryManager::Create());
+  LinkOutcome Outcome;
+  bool Checked = false;
+  Outcome.OnFinalized = [&] {
+    ASSERT_EQ(Outcome.Addrs.size(), NumBlocks);
+    for (auto Addr : Outcome.Addrs)
+      for (size_t J = 0; J != EdgesPerBlock; ++J)
+        EXPECT_EQ(support::endian::read32le(Addr.toPtr<char *>() + J * 4),
+                  TargetAddr + J);
+    Checked = true;
+  };
+  link_ELF_x86_64(makeLargeGraph(),
+                  std::make_unique<TestJITLinkContext>(*MemMgr, Outcome));
+  EXPECT_THAT_ERROR(std::move(Outcome.Err), Succeeded());
+  EXPECT_TRUE(Checked);
+}
+
+TEST(JITLinkGenericTest, FixUpLargeGraphFailure) {
+  auto MemMgr = cantFail(InProcessMemoryManager::Create());
+  LinkOutcome Outcome;
+  link_ELF_x86_64(makeLargeGraph(NumBlocks * EdgesPerBlock / 2),
+                  std::make_unique<TestJITLinkContext>(*MemMgr, Outcome));
+  EXPECT_THAT_ERROR(std::move(Outcome.Err), Failed());
+}
+
+} // end anonymous namespace
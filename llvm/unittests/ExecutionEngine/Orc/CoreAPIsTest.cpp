@@ -301,6 +301,60 @@ TEST_F(CoreAPIsStandardTest, LookupWithHiddenSymbols) {
       << "Wrong result for \"Bar\"";
 }
 
+TEST_F(CoreAPIsStandardTest, RepeatedLookupOfReadySymbols) {
+  // Test that repeated lookups, which may be answered from the published
+  // table of ready symbols, respect the search order, new definitions and
+  // removals.
+  auto &JD2 = ES.createBareJITDylib("JD2");
+  cantFail(JD2.define(absoluteSymbols({{Foo, BarSym}, {Bar, BarSym}})));
+  auto SearchOrder = makeJITDylibSearchOrder({&JD, &JD2});
+
+  for (int I = 0; I != 2; ++I)
+    EXPECT_EQ(cantFail(ES.lookup(SearchOrder, Foo)).getAddress(),
+              BarSym.getAddress())
+        << "Expected \"Foo\" from JD2";
+
+  // A definition in JD shadows JD2's, even before it is materialized.
+  bool FooMaterialized = false;
+  cantFail(JD.define(std::make_unique<SimpleMaterializationUnit>(
+      SymbolFlagsMap({{Foo, FooSym.getFlags()}}),
+      [&](std::unique_ptr<MaterializationResponsibility> R) {
+        FooMaterialized = true;
+        cantFail(R->notifyResolved({{Foo, FooSym}}));
+        cantFail(R->notifyEmitted());
+      })));
+
+  for (int I = 0; I != 2; ++I)
+    EXPECT_EQ(cantFail(ES.lookup(SearchOrder, Foo)).getAddress(),
+              FooSym.getAddress())
+        << "Expected \"Foo\" from JD";
+  EXPECT_TRUE(FooMaterialized) << "\"Foo\" was not materialized";
+
+  EXPECT_EQ(cantFail(ES.lookup(SearchOrder, Bar)).getAddress(),
+            BarSym.getAddress());
+  cantFail(JD2.remove({Bar}));
+  EXPECT_THAT_EXPECTED(ES.lookup(SearchOrder, Bar), Failed())
+      << "Removed symbol should not be found";
+}
+
+TEST_F(CoreAPIsStandardTest, LookupOfIncrementallyPublishedSymbols) {
+  // Test that symbols published in many small steps, whose tables get merged
+  // along the way, can all still be found.
+  std::vector<SymbolStringPtr> Names;
+  for (unsigned I = 0; I != 20; ++I) {
+    Names.push_back(ES.intern("sym" + std::to_string(I)));
+    ExecutorSymbolDef Sym(ExecutorAddr(0x1000 + I), JITSymbolFlags::Exported);
+    cantFail(JD.define(absoluteSymbols({{Names.back(), Sym}})));
+    EXPECT_EQ(cantFail(ES.lookup({&JD}, Names.back())).getAddress(),
+              ExecutorAddr(0x1000 + I));
+  }
+
+  for (unsigned I = 0; I != Names.size(); ++I)
+    EXPECT_EQ(cantFail(ES.lookup({&JD}, Names[I])).getAddress(),
+              ExecutorAddr(0x1000 + I))
+        << "Wrong result for \"sym" << I << "\"";
+}
+
 TEST_F(CoreAPIsStandardTest, LookupFlagsTest) {
   // Test that lookupFlags works on a predefined symbol, and does not trigger
   // materialization of a lazy symbol. Make the lazy symbol weak to test that
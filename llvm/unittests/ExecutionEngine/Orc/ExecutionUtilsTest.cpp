@@ -0,0 +1,132 @@
+//===---- ExecutionUtilsTest.cpp - Unit tests for the search generators ---===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+#include "llvm/ExecutionEngine/Orc/EPCDynamicLibrarySearchGenerator.h"
+#include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+// Counts the lookup requests sent to the executor, and resolves every symbol
+// to a fixed address.
+class CountingEPC : public UnsupportedExecutorProcessControl {
+public:
+  Expected<std::vector<tpctypes::LookupResult>>
+  lookupSymbols(ArrayRef<LookupRequest> Request) override {
+    std::vector<tpctypes::LookupResult> Result;
+    for (auto &R : Request) {
+      ++NumRequests;
+      Result.push_back(tpctypes::LookupResult(R.Symbols.size(), SymAddr));
+    }
+    return Result;
+  }
+
+  static constexpr ExecutorAddr SymAddr{0x1000};
+  unsigned NumRequests = 0;
+};
+
+SymbolLookupSet weakSymbols(ArrayRef<SymbolStringPtr> Names) {
+  SymbolLookupSet Symbols;
+  for (auto &Name : Names)
+    Symbols.add(Name, SymbolLookupFlags::WeaklyReferencedSymbol);
+  return Symbols;
+}
+
+TEST(DynamicLibrarySearchGeneratorTest, CurrentProcess) {
+  ExecutionSession ES(std::make_unique<UnsupportedExecutorProcessControl>());
+  auto &JD = ES.createBareJITDylib("JD");
+  JD.addGenerator(
+      cantFail(DynamicLibrarySearchGenerator::GetForCurrentProcess('\0')));
+
+  // All the symbols of a lookup are resolved, each with its own address.
+  auto Malloc = ES.intern("malloc");
+  auto Free = ES.intern("free");
+  auto Result = ES.lookup(makeJITDylibSearchOrder(&JD),
+                          SymbolLookupSet({Malloc, Free}));
+  ASSERT_THAT_EXPECTED(Result, Succeeded());
+  ASSERT_EQ(Result->size(), 2U);
+  EXPECT_EQ((*Result)[Malloc].getAddress().toPtr<void *>(),
+            sys::DynamicLibrary::SearchForAddressOfSymbol("malloc"));
+  EXPECT_EQ((*Result)[Free].getAddress().toPtr<void *>(),
+            sys::DynamicLibrary::SearchForAddressOfSymbol("free"));
+
+  cantFail(ES.endSession());
+}
+
+TEST(DynamicLibrarySearchGeneratorTest, GlobalPrefix) {
+  ExecutionSession ES(std::make_unique<UnsupportedExecutorProcessControl>());
+  auto &JD = ES.createBareJITDylib("JD");
+  JD.addGenerator(
+      cantFail(DynamicLibrarySearchGenerator::GetForCurrentProcess('_')));
+
+  // The prefix is stripped before the search, and names without it are
+  // skipped.
+  auto Malloc = ES.intern("_malloc");
+  auto Free = ES.intern("_free");
+  auto Unprefixed = ES.intern("malloc");
+  auto Result = ES.lookup(makeJITDylibSearchOrder(&JD),
+                          weakSymbols({Malloc, Unprefixed, Free}));
+  ASSERT_THAT_EXPECTED(Result, Succeeded());
+  EXPECT_EQ(Result->size(), 2U);
+  EXPECT_EQ((*Result)[Malloc].getAddress().toPtr<void *>(),
+            sys::DynamicLibrary::SearchForAddressOfSymbol("malloc"));
+  EXPECT_EQ((*Result)[Free].getAddress().toPtr<void *>(),
+            sys::DynamicLibrary::SearchForAddressOfSymbol("free"));
+  EXPECT_FALSE(Result->count(Unprefixed));
+
+  cantFail(ES.endSession());
+}
+
+TEST(EPCDynamicLibrarySearchGeneratorTest, OneRequestPerLookup) {
+  auto EPC = std::make_unique<CountingEPC>();
+  auto &Counter = *EPC;
+  ExecutionSession ES(std::move(EPC));
+  auto &JD = ES.createBareJITDylib("JD");
+  JD.addGenerator(
+      std::make_unique<EPCDynamicLibrarySearchGenerator>(ES, ExecutorAddr()));
+
+  auto Foo = ES.intern("foo");
+  auto Bar = ES.intern("bar");
+  auto Result =
+      ES.lookup(makeJITDylibSearchOrder(&JD), SymbolLookupSet({Foo, Bar}));
+  ASSERT_THAT_EXPECTED(Result, Succeeded());
+  EXPECT_EQ(Result->size(), 2U);
+  EXPECT_EQ((*Result)[Foo].getAddress(), CountingEPC::SymAddr);
+  EXPECT_EQ(Counter.NumRequests, 1U);
+
+  cantFail(ES.endSession());
+}
+
+TEST(EPCDynamicLibrarySearchGeneratorTest, FilterRejectsAll) {
+  auto EPC = std::make_unique<CountingEPC>();
+  auto &Counter = *EPC;
+  ExecutionSession ES(std::move(EPC));
+  auto &JD = ES.createBareJITDylib("JD");
+  JD.addGenerator(std::make_unique<EPCDynamicLibrarySearchGenerator>(
+      ES, ExecutorAddr(), [](const SymbolStringPtr &) { return false; }));
+
+  // No request is sent to the executor when the filter leaves nothing to
+  // look up.
+  auto Foo = ES.intern("foo");
+  auto Bar = ES.intern("bar");
+  auto Result =
+      ES.lookup(makeJITDylibSearchOrder(&JD), weakSymbols({Foo, Bar}));
+  ASSERT_THAT_EXPECTED(Result, Succeeded());
+  EXPECT_TRUE(Result->empty());
+  EXPECT_EQ(Counter.NumRequests, 0U);
+
+  cantFail(ES.endSession());
+}
+
+} // namespace
@@ -0,0 +1,51 @@
+//===- LocalObjectCacheTest.cpp - Unit tests for LocalObjectCache ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+TEST(LocalObjectCacheTest, StoreAndReload) {
+  unittest::TempDir CacheDir("orc-object-cache", /*Unique=*/true);
+  JITTargetMachineBuilder JTMB(Triple("x86_64-unknown-linux-gnu"));
+
+  LLVMContext Ctx;
+  Module M("M", Ctx);
+  StringRef Obj = "not really an object";
+
+  {
+    auto ObjCache = LocalObjectCache::Create(CacheDir.path(), JTMB);
+    ASSERT_THAT_EXPECTED(ObjCache, Succeeded());
+    EXPECT_EQ((*ObjCache)->getObject(&M), nullptr);
+    (*ObjCache)->notifyObjectCompiled(&M, MemoryBufferRef(Obj, "M"));
+  }
+
+  // A new cache, as in a later process, finds the object on disk.
+  auto ObjCache = LocalObjectCache::Create(CacheDir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(ObjCache, Succeeded());
+  std::unique_ptr<MemoryBuffer> Cached = (*ObjCache)->getObject(&M);
+  ASSERT_NE(Cached, nullptr);
+  EXPECT_EQ(Cached->getBuffer(), Obj);
+
+  // The object is not used for another CPU.
+  JTMB.setCPU("znver3");
+  auto OtherCache = LocalObjectCache::Create(CacheDir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(OtherCache, Succeeded());
+  EXPECT_EQ((*OtherCache)->getObject(&M), nullptr);
+}
+
+} // namespace
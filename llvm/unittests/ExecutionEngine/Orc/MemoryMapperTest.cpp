@@ -200,4 +200,56 @@ TEST(MemoryMapperTest, InitializeDeinitialize) {
   EXPECT_EQ(DeinitializeCounter, 3);
 }
 
+TEST(MemoryMapperTest, HugePageHintAndAdjacentSegments) {
+  // With the huge page hint, the reservation may be backed by huge pages.
+  // Adjacent segments with the same protections are protected together, and
+  // a segment with other protections in between splits them.
+  std::unique_ptr<MemoryMapper> Mapper =
+      cantFail(InProcessMemoryMapper::Create(/*HugePageHint=*/true));
+
+  auto PageSize = Mapper->getPageSize();
+  auto Mem = reserve(*Mapper, PageSize * 4);
+  ASSERT_THAT_EXPECTED(Mem, Succeeded());
+
+  std::string HW = "Hello, world!";
+  MemProt RW = MemProt::Read | MemProt::Write;
+  MemProt Prots[] = {RW, RW, MemProt::Read, RW};
+
+  MemoryMapper::AllocInfo Alloc;
+  Alloc.MappingBase = Mem->Start;
+  for (size_t I = 0; I != std::size(Prots); ++I) {
+    // Fill the whole page so that the zero fill can be checked.
+    char *WA = Mapper->prepare(Mem->Start + I * PageSize, PageSize);
+    std::memset(WA, 0xff, PageSize);
+    std::strcpy(WA, HW.c_str());
+
+    MemoryMapper::AllocInfo::SegInfo Seg;
+    Seg.Offset = I * PageSize;
+    Seg.ContentSize = HW.size();
+    Seg.ZeroFillSize = PageSize - Seg.ContentSize;
+    Seg.AG = Prots[I];
+    Alloc.Segments.push_back(Seg);
+  }
+
+  auto Init = initialize(*Mapper, Alloc);
+  ASSERT_THAT_EXPECTED(Init, Succeeded());
+
+  for (size_t I = 0; I != std::size(Prots); ++I) {
+    char *Seg = (Mem->Start + I * PageSize).toPtr<char *>();
+    EXPECT_EQ(HW, StringRef(Seg, HW.size()));
+    EXPECT_EQ(Seg[HW.size()], 0);
+    EXPECT_EQ(Seg[PageSize - 1], 0);
+  }
+
+  // The writable segments on both sides of the read-only one stay writable.
+  for (size_t I : {0, 1, 3}) {
+    char *Seg = (Mem->Start + I * PageSize).toPtr<char *>();
+    Seg[PageSize - 1] = 1;
+    EXPECT_EQ(Seg[PageSize - 1], 1);
+  }
+
+  EXPECT_THAT_ERROR(deinitialize(*Mapper, {*Init}), Succeeded());
+  EXPECT_THAT_ERROR(release(*Mapper, {Mem->Start}), Succeeded());
+}
+
 } // namespace
@@ -0,0 +1,112 @@
+//===------ PerfJITDumpPluginTest.cpp - Tests for PerfJITDumpPlugin -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PerfJITDumpPlugin.h"
+#include "llvm/BinaryFormat/ELF.h"
+#include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/ExecutionEngine/JITLink/JITLinkMemoryManager.h"
+#include "llvm/ExecutionEngine/JITLink/x86_64.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::jitlink;
+using namespace llvm::orc;
+using namespace llvm::support::endian;
+
+namespace {
+
+const char CodeBytes[] = {char(0x90), char(0x90), char(0x90), char(0xc3)};
+const char DataBytes[] = {0x01, 0x02, 0x03, 0x04};
+
+TEST(PerfJITDumpPluginTest, WritesCodeLoadRecords) {
+  SmallString<128> Dir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("jitdump", Dir));
+
+  Triple TT("x86_64-unknown-linux-gnu");
+  auto Plugin = PerfJITDumpPlugin::Create(TT, Dir);
+  if (!Plugin) {
+    consumeError(Plugin.takeError());
+    sys::fs::remove_directories(Dir);
+    GTEST_SKIP() << "jitdump is not supported on this host";
+  }
+
+  uint64_t FooAddr = 0;
+  {
+    ExecutionSession ES{std::make_unique<UnsupportedExecutorProcessControl>()};
+    JITDylib &JD = ES.createBareJITDylib("main");
+    ObjectLinkingLayer ObjLinkingLayer{
+        ES, std::make_unique<InProcessMemoryManager>(4096)};
+    ObjLinkingLayer.addPlugin(std::move(*Plugin));
+
+    auto G = std::make_unique<LinkGraph>("foo", TT, 8, support::little,
+                                         x86_64::getEdgeKindName);
+    auto &Text = G->createSection(".text", MemProt::Read | MemProt::Exec);
+    auto &Code = G->createContentBlock(Text, CodeBytes,
+                                       orc::ExecutorAddr(0x1000), 16, 0);
+    G->addDefinedSymbol(Code, 0, "foo", sizeof(CodeBytes), Linkage::Strong,
+                        Scope::Default, /*IsCallable=*/true, /*IsLive=*/false);
+    // Neither data nor unnamed code is recorded.
+    auto &Data = G->createSection(".data", MemProt::Read | MemProt::Write);
+    auto &DataBlock = G->createContentBlock(Data, DataBytes,
+                                            orc::ExecutorAddr(0x2000), 8, 0);
+    G->addDefinedSymbol(DataBlock, 0, "bar", sizeof(DataBytes),
+                        Linkage::Strong, Scope::Default, /*IsCallable=*/false,
+                        /*IsLive=*/false);
+    G->addAnonymousSymbol(Code, 0, sizeof(CodeBytes), /*IsCallable=*/true,
+                          /*IsLive=*/false);
+
+    EXPECT_THAT_ERROR(ObjLinkingLayer.add(JD, std::move(G)), Succeeded());
+    auto Foo = ES.lookup({&JD}, "foo");
+    ASSERT_THAT_EXPECTED(Foo, Succeeded());
+    FooAddr = Foo->getAddress().getValue();
+    EXPECT_THAT_EXPECTED(ES.lookup({&JD}, "bar"), Succeeded());
+
+    EXPECT_THAT_ERROR(ES.endSession(), Succeeded());
+    // Destroying the layer destroys the plugin, which writes the records.
+  }
+
+  SmallString<128> Path(Dir);
+  sys::path::append(Path,
+                    "jit-" + Twine(sys::Process::getProcessId()) + ".dump");
+  auto Buf = MemoryBuffer::getFile(Path);
+  ASSERT_TRUE(!!Buf);
+  const char *P = (*Buf)->getBufferStart();
+  const uint32_t HeaderSize = 40;
+  const uint32_t RecordSize = 56 + sizeof("foo") + sizeof(CodeBytes);
+  ASSERT_EQ((*Buf)->getBufferSize(), HeaderSize + RecordSize);
+
+  // The header.
+  EXPECT_EQ(read32le(P), 0x4A695444U); // "JiTD"
+  EXPECT_EQ(read32le(P + 4), 1U);
+  EXPECT_EQ(read32le(P + 8), HeaderSize);
+  EXPECT_EQ(read32le(P + 12), uint32_t(ELF::EM_X86_64));
+  EXPECT_EQ(read32le(P + 20), uint32_t(sys::Process::getProcessId()));
+
+  // The JIT_CODE_LOAD record of foo.
+  P += HeaderSize;
+  EXPECT_EQ(read32le(P), 0U);
+  EXPECT_EQ(read32le(P + 4), RecordSize);
+  EXPECT_EQ(read32le(P + 16), uint32_t(sys::Process::getProcessId()));
+  EXPECT_EQ(read64le(P + 24), FooAddr);
+  EXPECT_EQ(read64le(P + 32), FooAddr);
+  EXPECT_EQ(read64le(P + 40), sizeof(CodeBytes));
+  EXPECT_EQ(read64le(P + 48), 0U);
+  EXPECT_EQ(StringRef(P + 56), "foo");
+  EXPECT_EQ(StringRef(P + 60, sizeof(CodeBytes)),
+            StringRef(CodeBytes, sizeof(CodeBytes)));
+
+  sys::fs::remove_directories(Dir);
+}
+
+} // end anonymous namespace
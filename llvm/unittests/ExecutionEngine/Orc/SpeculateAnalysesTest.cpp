@@ -0,0 +1,79 @@
+//===------- SpeculateAnalysesTest.cpp - Tests for speculation queries ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/SpeculateAnalyses.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class TraceQueryTest : public testing::Test {
+protected:
+  Function &getFunction(StringRef Name) {
+    auto *FTy = FunctionType::get(Type::getVoidTy(Ctx), false);
+    return *cast<Function>(M.getOrInsertFunction(Name, FTy).getCallee());
+  }
+
+  DenseSet<StringRef> query(TraceQuery &Q, StringRef Name) {
+    auto Result = Q(getFunction(Name));
+    EXPECT_TRUE(Result.has_value());
+    if (!Result)
+      return {};
+    EXPECT_EQ(Result->size(), 1U);
+    auto It = Result->find(Name);
+    EXPECT_NE(It, Result->end());
+    if (It == Result->end())
+      return {};
+    return It->second;
+  }
+
+  LLVMContext Ctx;
+  Module M{"M", Ctx};
+};
+
+TEST_F(TraceQueryTest, SpeculatesTheFollowingFunctions) {
+  TraceQuery Q({"a", "b", "c", "d"}, /*Lookahead=*/2);
+
+  DenseSet<StringRef> A = query(Q, "a");
+  EXPECT_EQ(A.size(), 2U);
+  EXPECT_TRUE(A.contains("b"));
+  EXPECT_TRUE(A.contains("c"));
+
+  // The lookahead stops at the end of the trace.
+  DenseSet<StringRef> C = query(Q, "c");
+  EXPECT_EQ(C.size(), 1U);
+  EXPECT_TRUE(C.contains("d"));
+  EXPECT_TRUE(query(Q, "d").empty());
+}
+
+TEST_F(TraceQueryTest, UsesTheFirstEntry) {
+  // A function is never speculated for itself, and a function that appears
+  // twice in the trace is speculated for once.
+  TraceQuery Q({"a", "b", "a", "b", "c", "d"}, /*Lookahead=*/3);
+
+  DenseSet<StringRef> A = query(Q, "a");
+  EXPECT_EQ(A.size(), 3U);
+  EXPECT_TRUE(A.contains("b"));
+  EXPECT_TRUE(A.contains("c"));
+  EXPECT_TRUE(A.contains("d"));
+}
+
+TEST_F(TraceQueryTest, InstrumentsFunctionsOutsideTheTrace) {
+  // Functions that weren't entered in the earlier run still get an entry, so
+  // that they are instrumented and recorded in this run.
+  TraceQuery Q({"a", "b"});
+  EXPECT_TRUE(query(Q, "e").empty());
+}
+
+} // end anonymous namespace
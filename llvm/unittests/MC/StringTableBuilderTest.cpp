@@ -9,8 +9,10 @@
 #include "llvm/MC/StringTableBuilder.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <string>
+#include <vector>
 
 using namespace llvm;
 
@@ -236,4 +238,41 @@ TEST(StringTableBuilderTest, MachO64LinkedInOrder) {
   EXPECT_EQ(6U, B.getOffset("ba"));
   EXPECT_EQ(9U, B.getOffset("f"));
 }
+
+TEST(StringTableBuilderTest, LargeTailMerge) {
+  // Enough strings for the tail-merge sort to run in parallel. Many of them
+  // are suffixes of others.
+  std::vector<std::string> Strings;
+  for (unsigned I = 0; I != 50000; ++I)
+    Strings.push_back((I % 3 ? "" : "prefix_") + std::to_string(I * 7919));
+
+  auto Build = [&](StringTableBuilder &B) {
+    for (const std::string &S : Strings)
+      B.add(S);
+    B.finalize();
+  };
+
+  StringTableBuilder Parallel(StringTableBuilder::ELF);
+  Build(Parallel);
+
+  ThreadPoolStrategy Saved = parallel::strategy;
+  parallel::strategy = hardware_concurrency(1);
+  StringTableBuilder Sequential(StringTableBuilder::ELF);
+  Build(Sequential);
+  parallel::strategy = Saved;
+
+  SmallString<0> ParallelData, SequentialData;
+  raw_svector_ostream ParallelOS(ParallelData), SequentialOS(SequentialData);
+  Parallel.write(ParallelOS);
+  Sequential.write(SequentialOS);
+  EXPECT_EQ(SequentialData, ParallelData);
+
+  for (const std::string &S : Strings) {
+    size_t Offset = Parallel.getOffset(S);
+    EXPECT_EQ(Sequential.getOffset(S), Offset);
+    ASSERT_LT(Offset + S.size(), ParallelData.size());
+    EXPECT_EQ(S, StringRef(ParallelData.data() + Offset, S.size()));
+    EXPECT_EQ('\0', ParallelData[Offset + S.size()]);
+  }
+}
 }
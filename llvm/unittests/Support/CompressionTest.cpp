@@ -110,5 +110,33 @@ TEST(CompressionTest, Zstd) {
   testZstdCompression(BinaryDataStr, zstd::BestSpeedCompression);
   testZstdCompression(BinaryDataStr, zstd::DefaultCompression);
 }
+
+TEST(CompressionTest, ZstdLdmAndWorkers) {
+  // Large enough to be split between several zstd workers.
+  std::string Input;
+  for (size_t I = 0; Input.size() < (8 << 20); ++I)
+    Input += "line " + std::to_string(I % 4093) + "\n";
+  ArrayRef<uint8_t> InputRef = arrayRefFromStringRef(Input);
+
+  SmallVector<uint8_t, 0> Compressed;
+  SmallVector<uint8_t, 0> Uncompressed;
+  for (bool EnableLdm : {false, true}) {
+    for (unsigned NumWorkers : {0u, 1u, 4u}) {
+      zstd::compress(InputRef, Compressed, zstd::BestSpeedCompression,
+                     EnableLdm, NumWorkers);
+      Error E = zstd::decompress(Compressed, Uncompressed, Input.size());
+      EXPECT_FALSE(std::move(E));
+      EXPECT_EQ(Input, toStringRef(Uncompressed));
+    }
+  }
+
+  // The output does not depend on the number of workers.
+  if (zstd::supportsMultithreading()) {
+    SmallVector<uint8_t, 0> Compressed1, Compressed4;
+    zstd::compress(InputRef, Compressed1, zstd::BestSpeedCompression, true, 1);
+    zstd::compress(InputRef, Compressed4, zstd::BestSpeedCompression, true, 4);
+    EXPECT_EQ(Compressed1, Compressed4);
+  }
+}
 #endif
 }
@@ -134,6 +134,23 @@ TEST_F(GlobPatternTest, ExtSym) {
   EXPECT_TRUE(Pat2->match("\xFF"));
 }
 
+TEST_F(GlobPatternTest, Pathological) {
+  std::string P, S(40, 'a');
+  for (int I = 0; I != 30; ++I)
+    P += "*a";
+  P += "b";
+  Expected<GlobPattern> Pat1 = GlobPattern::create(P);
+  EXPECT_TRUE((bool)Pat1);
+  EXPECT_FALSE(Pat1->match(S));
+  EXPECT_TRUE(Pat1->match(S + "b"));
+
+  Expected<GlobPattern> Pat2 = GlobPattern::create(".text.*hot*[0-9]");
+  EXPECT_TRUE((bool)Pat2);
+  EXPECT_TRUE(Pat2->match(".text.unlikely.hot.foo1"));
+  EXPECT_FALSE(Pat2->match(".text.unlikely.hot.foo"));
+  EXPECT_FALSE(Pat2->match(".data.hot1"));
+}
+
 TEST_F(GlobPatternTest, IsTrivialMatchAll) {
   Expected<GlobPattern> Pat1 = GlobPattern::create("*");
   EXPECT_TRUE((bool)Pat1);
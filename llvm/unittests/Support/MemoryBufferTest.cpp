@@ -435,6 +435,37 @@ TEST_F(MemoryBufferTest, mmapVolatileNoNull) {
   EXPECT_TRUE(MB->getBuffer().startswith("01234567"));
 }
 
+TEST_F(MemoryBufferTest, willNeedIfMmap) {
+  // Readahead is only a hint. Check that it can be issued on both mapped and
+  // non-mapped buffers and leaves the contents intact.
+  int FD;
+  SmallString<64> TestPath;
+  ASSERT_NO_ERROR(sys::fs::createTemporaryFile(
+      "MemoryBufferTest_willNeedIfMmap", "temp", FD, TestPath));
+  FileRemover Cleanup(TestPath);
+  raw_fd_ostream OF(FD, true);
+  // Create a file large enough to mmap. 4 pages should be enough.
+  unsigned PageSize = sys::Process::getPageSizeEstimate();
+  unsigned FileWrites = (PageSize * 4) / 8;
+  for (unsigned i = 0; i < FileWrites; ++i)
+    OF << "01234567";
+  OF.close();
+
+  ErrorOr<OwningBuffer> MB = MemoryBuffer::getFile(
+      TestPath, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  ASSERT_NO_ERROR(MB.getError());
+  EXPECT_EQ((*MB)->getBufferKind(), MemoryBuffer::MemoryBuffer_MMap);
+  (*MB)->willNeedIfMmap();
+  EXPECT_EQ((*MB)->getBufferSize(), std::size_t(FileWrites * 8));
+  EXPECT_TRUE((*MB)->getBuffer().startswith("01234567"));
+  EXPECT_TRUE((*MB)->getBuffer().endswith("01234567"));
+
+  OwningBuffer MemMB = MemoryBuffer::getMemBufferCopy("data");
+  EXPECT_EQ(MemMB->getBufferKind(), MemoryBuffer::MemoryBuffer_Malloc);
+  MemMB->willNeedIfMmap();
+  EXPECT_EQ("data", MemMB->getBuffer());
+}
+
 // Test that SmallVector without a null terminator gets one.
 TEST(SmallVectorMemoryBufferTest, WithoutNullTerminatorRequiresNullTerminator) {
   SmallString<0> Data("some data");
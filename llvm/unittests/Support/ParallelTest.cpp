@@ -15,7 +15,10 @@
 #include "llvm/Support/ThreadPool.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <random>
+#include <thread>
 
 uint32_t array[1024 * 1024];
 
@@ -173,6 +176,46 @@ TEST(Parallel, ParallelNestedTaskGroup) {
   }
   EXPECT_EQ(Count, 12ul);
 }
+
+TEST(Parallel, NestedTaskGroupWorkStealing) {
+  // This test checks that tasks spawned into a nested TaskGroup can be stolen
+  // by idle threads. Each of the two tasks waits for the other one to start,
+  // which only happens in time if they run on different threads.
+  if (parallel::getThreadCount() < 2)
+    GTEST_SKIP() << "needs at least two executor threads";
+
+  std::atomic<unsigned> Started{0};
+  std::atomic<unsigned> MetInTime{0};
+  auto Meet = [&]() {
+    ++Started;
+    auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (Started != 2 && std::chrono::steady_clock::now() < Deadline)
+      std::this_thread::yield();
+    if (Started == 2)
+      ++MetInTime;
+  };
+
+  parallel::TaskGroup tg;
+  tg.spawn([&]() {
+    parallel::TaskGroup nestedTG;
+    EXPECT_FALSE(nestedTG.isParallel());
+    nestedTG.spawn(Meet);
+    nestedTG.spawn(Meet);
+  });
+  tg.sync();
+  EXPECT_EQ(MetInTime, 2u);
+}
+
+TEST(Parallel, NestedParallelFor) {
+  // This test checks that nested parallelFor calls run every iteration exactly
+  // once, whether the inner tasks are stolen or run inline.
+  std::vector<std::atomic<unsigned>> Counts(64 * 64);
+  parallelFor(0, 64, [&](size_t I) {
+    parallelFor(0, 64, [&](size_t J) { ++Counts[I * 64 + J]; });
+  });
+  for (const std::atomic<unsigned> &C : Counts)
+    EXPECT_EQ(C, 1u);
+}
 #endif
 
 #endif
@@ -10,6 +10,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <thread>
 
 using namespace llvm;
 using namespace parallel;
@@ -50,7 +51,52 @@ TEST(PerThreadBumpPtrAllocatorTest, ParallelAllocation) {
   });
 
   EXPECT_EQ(sizeof(uint64_t) * NumAllocations, Allocator.getBytesAllocated());
-  EXPECT_EQ(Allocator.getNumberOfAllocators(), parallel::getThreadCount());
+  // One allocator per executor thread plus one for all other threads.
+  EXPECT_EQ(Allocator.getNumberOfAllocators(), parallel::getThreadCount() + 1);
+}
+
+TEST(PerThreadBumpPtrAllocatorTest, OutsideOfExecutor) {
+  PerThreadBumpPtrAllocator Allocator;
+
+  // The main thread is not owned by ThreadPoolExecutor, but may allocate.
+  uint64_t *Var =
+      (uint64_t *)Allocator.Allocate(sizeof(uint64_t), alignof(uint64_t));
+  *Var = 0xFE;
+
+  parallelFor(0, 100, [&](size_t Idx) {
+    uint64_t *Ptr =
+        (uint64_t *)Allocator.Allocate(sizeof(uint64_t), alignof(uint64_t));
+    *Ptr = Idx;
+  });
+
+  EXPECT_EQ(0xFEul, *Var);
+  EXPECT_EQ(sizeof(uint64_t) * 101, Allocator.getBytesAllocated());
+  EXPECT_TRUE(Allocator.getBytesAllocated() <= Allocator.getTotalMemory());
+
+  Allocator.Reset();
+  EXPECT_EQ(0u, Allocator.getBytesAllocated());
+}
+
+TEST(PerThreadBumpPtrAllocatorTest, ConcurrentOutsideOfExecutor) {
+  PerThreadBumpPtrAllocator Allocator;
+  constexpr size_t NumThreads = 4;
+  constexpr size_t NumAllocations = 1000;
+
+  // Threads not owned by ThreadPoolExecutor share one allocator.
+  std::vector<std::thread> Threads;
+  for (size_t T = 0; T < NumThreads; ++T)
+    Threads.emplace_back([&, T]() {
+      for (size_t Idx = 0; Idx < NumAllocations; ++Idx) {
+        uint64_t *Ptr = (uint64_t *)Allocator.Allocate(sizeof(uint64_t),
+                                                       alignof(uint64_t));
+        *Ptr = T;
+      }
+    });
+  for (std::thread &Thread : Threads)
+    Thread.join();
+
+  EXPECT_EQ(sizeof(uint64_t) * NumThreads * NumAllocations,
+            Allocator.getBytesAllocated());
 }
 
 } // anonymous namespace
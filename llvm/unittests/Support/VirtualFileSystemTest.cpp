@@ -962,6 +962,54 @@ TEST(ProxyFileSystemTest, Basic) {
   EXPECT_FALSE(Local);
 }
 
+namespace {
+class CountingFileSystem : public vfs::InMemoryFileSystem {
+public:
+  unsigned NumStatusCalls = 0;
+
+  ErrorOr<vfs::Status> status(const Twine &Path) override {
+    ++NumStatusCalls;
+    return InMemoryFileSystem::status(Path);
+  }
+};
+} // namespace
+
+TEST(CachingFileSystemTest, Basic) {
+  IntrusiveRefCntPtr<CountingFileSystem> Base(new CountingFileSystem());
+  IntrusiveRefCntPtr<vfs::CachingFileSystem> CFS(
+      new vfs::CachingFileSystem(Base));
+  ASSERT_FALSE(CFS->setCurrentWorkingDirectory("/"));
+
+  Base->addFile("/a", 0, MemoryBuffer::getMemBuffer("test"));
+
+  auto Stat = CFS->status("/a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ("/a", Stat->getName());
+  EXPECT_EQ(1u, Base->NumStatusCalls);
+
+  // A different spelling of the same path is answered from the cache, under
+  // the requested name.
+  Stat = CFS->status("a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ("a", Stat->getName());
+  EXPECT_EQ(1u, Base->NumStatusCalls);
+  EXPECT_EQ(1u, CFS->getNumCacheHits());
+
+  // Failed lookups are cached as well, and opening the path fails without
+  // asking the underlying file system again.
+  EXPECT_EQ(CFS->status("/b").getError(), errc::no_such_file_or_directory);
+  Base->addFile("/b", 0, MemoryBuffer::getMemBuffer("b"));
+  EXPECT_EQ(CFS->status("/b").getError(), errc::no_such_file_or_directory);
+  EXPECT_TRUE(CFS->openFileForRead("/b").getError());
+  EXPECT_EQ(2u, Base->NumStatusCalls);
+
+  CFS->invalidate();
+  EXPECT_FALSE(CFS->status("/b").getError());
+  auto File = CFS->openFileForRead("/b");
+  ASSERT_FALSE(File.getError());
+  EXPECT_EQ("b", (*(*File)->getBuffer("ignored"))->getBuffer());
+}
+
 class InMemoryFileSystemTest : public ::testing::Test {
 protected:
   llvm::vfs::InMemoryFileSystem FS;
@@ -18,3 +18,51 @@ TEST(xxhashTest, Basic) {
   EXPECT_EQ(0x69196c1b3af0bff9U,
             xxHash64("0123456789abcdefghijklmnopqrstuvwxyz"));
 }
+
+TEST(xxhashTest, xxh3) {
+  constexpr size_t size = 2243;
+  uint8_t a[size];
+  uint64_t x = 2654435761;
+  for (size_t i = 0; i < size; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    a[i] = uint8_t(x);
+  }
+
+#define F(len, expected)                                                       \
+  EXPECT_EQ(uint64_t(expected), xxh3_64bits(ArrayRef(a, size_t(len))))
+  F(0, 0x2d06800538d394c2);
+  F(1, 0xc9f42e6c9e93dfff);
+  F(2, 0x54023c605cdf966c);
+  F(3, 0x9f79726330ec276f);
+  F(4, 0x9de030d1b61740fd);
+  F(8, 0xba9a6f96681d0c46);
+  F(9, 0x72234244d970cb12);
+  F(16, 0x41b59f3ef521a7df);
+  F(17, 0x1509e55ab47b8685);
+  F(32, 0x9c5ff3625ffd8164);
+  F(33, 0x3efae34981711f76);
+  F(64, 0xe5fe7d392cccbcb0);
+  F(65, 0xb687b3bc77c8211f);
+  F(96, 0x5d796d536cc891c7);
+  F(97, 0x9e3d4f6680e65213);
+  F(128, 0x477ba9f90193f1bf);
+  F(129, 0x4e54b12fdd9b7091);
+  F(240, 0x448b0e9b8838ee88);
+  F(241, 0xec98dc385d0aa8fc);
+  F(255, 0xbc8b01bc31572285);
+  F(256, 0x3daa06ab2272a3c9);
+  F(320, 0xd310148d36beb7bb);
+  F(321, 0xbe4033acb4e406ef);
+  F(1024, 0xeb16dae3784c611b);
+  F(1025, 0x23ca7d0e04fa774d);
+  F(2048, 0xc08394d0dbcc1bfc);
+  F(2049, 0xedb7341b1f94d9ac);
+  F(2240, 0x1b0a20d846069b56);
+  F(2243, 0x7e84eb8c0983982d);
+#undef F
+
+  EXPECT_EQ(xxh3_64bits(ArrayRef(a, size_t(3))),
+            xxh3_64bits(StringRef(reinterpret_cast<const char *>(a), 3)));
+}
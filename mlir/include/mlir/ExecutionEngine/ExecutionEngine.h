@@ -54,6 +54,26 @@ private:
   llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> cachedObjects;
 };
 
+/// An object cache that also stores objects as files in a directory, so that
+/// they can be reused by later execution engines, including ones in other
+/// processes. Objects are identified by the identifier of their module, which
+/// the execution engine sets to a hash of the module and the target when this
+/// cache is used.
+class PersistentObjectCache : public SimpleObjectCache {
+public:
+  explicit PersistentObjectCache(StringRef directory) : directory(directory) {}
+
+  void notifyObjectCompiled(const llvm::Module *m,
+                            llvm::MemoryBufferRef objBuffer) override;
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *m) override;
+
+private:
+  /// Returns the path of the object file for the given module identifier.
+  std::string getObjectPath(StringRef moduleIdentifier) const;
+
+  std::string directory;
+};
+
 struct ExecutionEngineOptions {
   /// If `llvmModuleBuilder` is provided, it will be used to create an LLVM
   /// module from the given MLIR IR. Otherwise, a default
@@ -92,6 +112,18 @@ struct ExecutionEngineOptions {
   /// be dumped to a file via the `dumpToObjectFile` method.
   bool enableObjectDump = false;
 
+  /// If `objectCacheDirectory` is set, the compiled object is stored in that
+  /// directory and reused by later execution engines created for the same
+  /// module and target, without compiling the module again. The cache key is
+  /// computed before `transformer` runs, and `transformer` is skipped when the
+  /// object is found in the cache, so it must be deterministic.
+  StringRef objectCacheDirectory;
+
+  /// Identifies what `transformer` does, e.g. the optimization level of the
+  /// pipeline it runs. It is part of the object cache key, so engines with
+  /// different transformers do not share cached objects.
+  StringRef objectCacheTransformerKey;
+
   /// If enable `enableGDBNotificationListener` is set, the JIT compiler will
   /// notify the llvm's global GDB notification listener.
   bool enableGDBNotificationListener = true;
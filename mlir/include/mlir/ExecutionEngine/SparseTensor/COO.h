@@ -21,6 +21,7 @@
 #include <cassert>
 #include <cinttypes>
 #include <functional>
+#include <thread>
 #include <vector>
 
 namespace mlir {
@@ -193,15 +194,58 @@ public:
   /// is mapped to multiple values, then the relative order of those
   /// values is unspecified.
   ///
+  /// By default the elements are sorted on the calling thread.  If
+  /// `numThreads` is greater than one, large tensors are sorted by up to
+  /// that many threads, which this method starts and joins; zero means one
+  /// thread per hardware thread.
+  ///
   /// This method invalidates all iterators.
-  void sort() {
+  void sort(uint64_t numThreads = 1) {
     if (isSorted)
       return;
-    std::sort(elements.begin(), elements.end(), getElementLT());
+    const auto elementLT = getElementLT();
+    // Split large inputs into one chunk per thread, sort the chunks in
+    // parallel and then merge them pairwise, also in parallel.
+    if (numThreads == 0)
+      numThreads = std::thread::hardware_concurrency();
+    const uint64_t numElements = elements.size();
+    uint64_t numChunks =
+        std::min<uint64_t>(numThreads, numElements / kMinElementsPerChunk);
+    if (numChunks < 2) {
+      std::sort(elements.begin(), elements.end(), elementLT);
+      isSorted = true;
+      return;
+    }
+    const auto chunkBegin = [&](uint64_t chunk) {
+      return elements.begin() + chunk * numElements / numChunks;
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numChunks);
+    for (uint64_t c = 0; c < numChunks; ++c)
+      threads.emplace_back([&, c] {
+        std::sort(chunkBegin(c), chunkBegin(c + 1), elementLT);
+      });
+    for (std::thread &thread : threads)
+      thread.join();
+    for (uint64_t width = 1; width < numChunks; width *= 2) {
+      threads.clear();
+      for (uint64_t c = 0; c + width < numChunks; c += 2 * width)
+        threads.emplace_back([&, c, width] {
+          std::inplace_merge(chunkBegin(c), chunkBegin(c + width),
+                             chunkBegin(std::min(c + 2 * width, numChunks)),
+                             elementLT);
+        });
+      for (std::thread &thread : threads)
+        thread.join();
+    }
     isSorted = true;
   }
 
 private:
+  /// The minimum number of elements each thread sorts in `sort`.  Smaller
+  /// tensors are sorted sequentially.
+  static constexpr uint64_t kMinElementsPerChunk = 1 << 16;
+
   const std::vector<uint64_t> dimSizes; // per-dimension sizes
   std::vector<Element<V>> elements;     // all COO elements
   std::vector<uint64_t> coordinates;    // shared coordinate pool
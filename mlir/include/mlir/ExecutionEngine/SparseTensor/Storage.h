@@ -43,6 +43,12 @@
 namespace mlir {
 namespace sparse_tensor {
 
+/// Returns the number of threads with which the runtime sorts COO tensors.
+/// This is the value of the `SPARSE_TENSOR_SORT_THREADS` environment
+/// variable, where zero means one thread per hardware thread.  If the
+/// variable is not set, COO tensors are sorted on the calling thread.
+uint64_t getCOOSortThreads();
+
 //===----------------------------------------------------------------------===//
 // This forward decl is sufficient to split `SparseTensorStorageBase` into
 // its own header, but isn't sufficient for `SparseTensorStorage` to join it.
@@ -1043,7 +1049,7 @@ SparseTensorStorage<P, C, V>::SparseTensorStorage( // NOLINT
   assert(lvlRank == lvlCOO.getDimSizes().size() && "Level-rank mismatch");
   // Ensure the preconditions of `fromCOO`.  (One is already ensured by
   // using `lvlSizes = lvlCOO.getDimSizes()` in the ctor above.)
-  lvlCOO.sort();
+  lvlCOO.sort(getCOOSortThreads());
   // Now actually insert the `elements`.
   const auto &elements = lvlCOO.getElements();
   const uint64_t nse = elements.size();
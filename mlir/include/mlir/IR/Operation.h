@@ -833,6 +833,12 @@ public:
   /// handlers that may be listening.
   InFlightDiagnostic emitRemark(const Twine &message = {});
 
+  /// Returns the number of bytes allocated for this operation itself: its
+  /// results, operand storage, properties, successors and regions. This does
+  /// not include the contents of its regions, operands that were reallocated
+  /// out of line, or attributes, which are uniqued in the context.
+  size_t getAllocationSize();
+
   /// Returns the properties storage size.
   int getPropertiesStorageSize() const {
     return ((int)propertiesStorageSize) * 8;
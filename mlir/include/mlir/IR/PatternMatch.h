@@ -426,6 +426,16 @@ public:
     /// At this point, the operation has zero uses.
     virtual void notifyOperationRemoved(Operation *op) {}
 
+    /// Notify the listener that the specified pattern is about to be applied
+    /// at the specified root operation.
+    virtual void notifyPatternBegin(const Pattern &pattern, Operation *op) {}
+
+    /// Notify the listener that a pattern application finished with the
+    /// specified status. "success" indicates that the pattern was applied
+    /// successfully, "failure" that it could not be applied.
+    virtual void notifyPatternEnd(const Pattern &pattern,
+                                  LogicalResult status) {}
+
     /// Notify the listener that the pattern failed to match the given
     /// operation, and provide a callback to populate a diagnostic with the
     /// reason why the failure occurred. This method allows for derived
@@ -465,6 +475,13 @@ public:
     void notifyOperationRemoved(Operation *op) override {
       listener->notifyOperationRemoved(op);
     }
+    void notifyPatternBegin(const Pattern &pattern, Operation *op) override {
+      listener->notifyPatternBegin(pattern, op);
+    }
+    void notifyPatternEnd(const Pattern &pattern,
+                          LogicalResult status) override {
+      listener->notifyPatternEnd(pattern, status);
+    }
     LogicalResult notifyMatchFailure(
         Location loc,
         function_ref<void(Diagnostic &)> reasonCallback) override {
@@ -265,6 +265,12 @@ public:
   /// Runs the verifier after each individual pass.
   void enableVerifier(bool enabled = true);
 
+  /// Skips the verifier after a pass if the fingerprint of the IR is the same
+  /// as before the pass. Hashing the IR is usually cheaper than verifying it,
+  /// but the hash is computed before every pass, including the ones that do
+  /// change the IR.
+  void enableVerifierSkipIfUnchanged(bool enabled = true);
+
   //===--------------------------------------------------------------------===//
   // Instrumentations
   //===--------------------------------------------------------------------===//
@@ -408,6 +414,15 @@ public:
   /// unintentionally included in the timing results.
   void enableTiming();
 
+  /// Also report the time of each pass separately for every operation it runs
+  /// on, by nesting a timer per operation under the timer of the pass.
+  /// Operations are identified by their symbol name, or by their operation
+  /// name if they have none. This helps to find the operations that hold up
+  /// a nested pipeline. It must be called before `enableTiming`.
+  void enableTimingPerOperation(bool enabled = true) {
+    passTimingPerOperation = enabled;
+  }
+
   //===--------------------------------------------------------------------===//
   // Pass Statistics
 
@@ -446,8 +461,15 @@ private:
   /// Flag that specifies if pass timing is enabled.
   bool passTiming : 1;
 
+  /// Flag that specifies if pass timing is reported per operation.
+  bool passTimingPerOperation : 1;
+
   /// A flag that indicates if the IR should be verified in between passes.
   bool verifyPasses : 1;
+
+  /// A flag that indicates if the verifier should be skipped after passes that
+  /// didn't change the IR.
+  bool skipVerifierIfUnchanged : 1;
 };
 
 /// Register a set of useful command-line options that can be used to configure
@@ -15,6 +15,7 @@
 #define MLIR_TRANSFORMS_GREEDYPATTERNREWRITEDRIVER_H_
 
 #include "mlir/Rewrite/FrozenRewritePatternSet.h"
+#include "llvm/ADT/MapVector.h"
 
 namespace mlir {
 
@@ -79,6 +80,42 @@ public:
 
   /// An optional listener that should be notified about IR modifications.
   RewriterBase::Listener *listener = nullptr;
+
+  /// When simplifying a region, first simplify the regions of the ops nested
+  /// in it that are isolated from above, in parallel, and then simplify the
+  /// region as a whole. Such ops cannot be modified by patterns applied to
+  /// each other's bodies, so the result does not depend on the scheduling.
+  ///
+  /// Note: Only applicable when simplifying entire regions, without a
+  /// listener, and when multi-threading is enabled on the context.
+  bool parallelizeIsolatedOps = false;
+};
+
+/// A listener that counts, for each pattern, how often the greedy driver
+/// applied it and how often the pattern failed to apply. Set it as the
+/// `listener` of a GreedyRewriteConfig to find out which patterns a rewrite
+/// spends its time on.
+class PatternStatisticsListener : public RewriterBase::Listener {
+public:
+  struct Counts {
+    int64_t numSuccesses = 0;
+    int64_t numFailures = 0;
+  };
+
+  void notifyPatternEnd(const Pattern &pattern, LogicalResult status) override;
+
+  /// Return the counts of each pattern that was tried, in the order in which
+  /// the patterns were first tried.
+  const llvm::MapVector<const Pattern *, Counts> &getCounts() const {
+    return counts;
+  }
+
+  /// Print the counts, one pattern per line, starting with the pattern that
+  /// failed most often.
+  void print(raw_ostream &os) const;
+
+private:
+  llvm::MapVector<const Pattern *, Counts> counts;
 };
 
 //===----------------------------------------------------------------------===//
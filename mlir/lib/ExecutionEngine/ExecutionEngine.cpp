@@ -16,6 +16,8 @@
 #include "mlir/Support/FileUtilities.h"
 #include "mlir/Target/LLVMIR/Export.h"
 
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/ExecutionEngine/JITEventListener.h"
 #include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
@@ -28,6 +30,9 @@
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/TargetParser/Host.h"
 #include "llvm/TargetParser/SubtargetFeature.h"
@@ -98,6 +103,71 @@ void SimpleObjectCache::dumpToObjectFile(StringRef outputFilename) {
 
 bool SimpleObjectCache::isEmpty() { return cachedObjects.empty(); }
 
+void PersistentObjectCache::notifyObjectCompiled(const Module *m,
+                                                 MemoryBufferRef objBuffer) {
+  SimpleObjectCache::notifyObjectCompiled(m, objBuffer);
+
+  // Write the object to a temporary file first, so that other processes never
+  // observe a partially written object.
+  std::string path = getObjectPath(m->getModuleIdentifier());
+  if (std::error_code ec = llvm::sys::fs::create_directories(directory)) {
+    LLVM_DEBUG(dbgs() << "Could not create object cache directory "
+                      << directory << ": " << ec.message() << "\n");
+    return;
+  }
+  if (Error error = llvm::writeToOutput(path, [&](raw_ostream &os) {
+        os << objBuffer.getBuffer();
+        return Error::success();
+      })) {
+    LLVM_DEBUG(dbgs() << "Could not write " << path << ": " << error << "\n");
+    consumeError(std::move(error));
+  }
+}
+
+std::unique_ptr<MemoryBuffer>
+PersistentObjectCache::getObject(const Module *m) {
+  if (std::unique_ptr<MemoryBuffer> object = SimpleObjectCache::getObject(m))
+    return object;
+
+  std::string path = getObjectPath(m->getModuleIdentifier());
+  auto objectOrErr = MemoryBuffer::getFile(path, /*IsText=*/false,
+                                           /*RequiresNullTerminator=*/false);
+  if (!objectOrErr)
+    return nullptr;
+  LLVM_DEBUG(dbgs() << "Object for " << m->getModuleIdentifier()
+                    << " loaded from " << path << ".\n");
+
+  // Keep the object in memory as well, so that it can be dumped.
+  SimpleObjectCache::notifyObjectCompiled(m, (*objectOrErr)->getMemBufferRef());
+  return SimpleObjectCache::getObject(m);
+}
+
+std::string
+PersistentObjectCache::getObjectPath(StringRef moduleIdentifier) const {
+  SmallString<256> path(directory);
+  llvm::sys::path::append(path, moduleIdentifier + ".o");
+  return std::string(path);
+}
+
+/// Returns a key identifying the object that compiling `module` with `tm`
+/// produces, after running the transformer identified by `transformerKey`.
+static std::string
+getObjectCacheKey(const llvm::Module &module, const llvm::TargetMachine &tm,
+                  std::optional<llvm::CodeGenOpt::Level> optLevel,
+                  StringRef transformerKey) {
+  // The bitcode includes the target triple and data layout.
+  SmallVector<char, 0> buffer;
+  llvm::raw_svector_ostream os(buffer);
+  llvm::WriteBitcodeToFile(module, os);
+  os << '\0' << tm.getTargetCPU() << '\0' << tm.getTargetFeatureString()
+     << '\0' << (optLevel ? static_cast<int>(*optLevel) : -1) << '\0'
+     << transformerKey;
+
+  llvm::SHA1 hasher;
+  hasher.update(StringRef(buffer.data(), buffer.size()));
+  return llvm::toHex(hasher.result(), /*LowerCase=*/true);
+}
+
 void ExecutionEngine::dumpToObjectFile(StringRef filename) {
   if (cache == nullptr) {
     llvm::errs() << "cannot dump ExecutionEngine object code to file: "
@@ -271,6 +341,22 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
   setupTargetTripleAndDataLayout(llvmModule.get(), tm.get());
   packFunctionArguments(llvmModule.get());
 
+  // Identify the module by its contents when using a persistent object cache,
+  // and load the object if it was compiled before. Loading it here keeps it in
+  // memory for the compile layer, so the transformer is only skipped for an
+  // object that is actually used, even if the file is removed meanwhile.
+  bool isObjectCached = false;
+  if (!options.objectCacheDirectory.empty()) {
+    auto persistentCache =
+        std::make_unique<PersistentObjectCache>(options.objectCacheDirectory);
+    std::string key =
+        getObjectCacheKey(*llvmModule, *tm, options.jitCodeGenOptLevel,
+                          options.objectCacheTransformerKey);
+    llvmModule->setModuleIdentifier(key);
+    isObjectCached = persistentCache->getObject(llvmModule.get()) != nullptr;
+    engine->cache = std::move(persistentCache);
+  }
+
   auto dataLayout = llvmModule->getDataLayout();
 
   // Use absolute library path so that gdb can find the symbol table.
@@ -377,7 +463,7 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
 
   // Add a ThreadSafemodule to the engine and return.
   ThreadSafeModule tsm(std::move(llvmModule), std::move(ctx));
-  if (options.transformer)
+  if (options.transformer && !isObjectCached)
     cantFail(tsm.withModuleDo(
         [&](llvm::Module &module) { return options.transformer(&module); }));
   cantFail(jit->addIRModule(std::move(tsm)));
@@ -22,8 +22,18 @@
 
 #include "mlir/ExecutionEngine/SparseTensor/Storage.h"
 
+#include <cstdlib>
+
 using namespace mlir::sparse_tensor;
 
+uint64_t mlir::sparse_tensor::getCOOSortThreads() {
+  static const uint64_t numThreads = [] {
+    const char *env = getenv("SPARSE_TENSOR_SORT_THREADS");
+    return env ? strtoull(env, nullptr, 10) : 1;
+  }();
+  return numThreads;
+}
+
 SparseTensorStorageBase::SparseTensorStorageBase( // NOLINT
     uint64_t dimRank, const uint64_t *dimSizes, uint64_t lvlRank,
     const uint64_t *lvlSizes, const DimLevelType *lvlTypes,
@@ -172,6 +172,15 @@ Operation::Operation(Location location, OperationName name, unsigned numResults,
     name.initOpProperties(getPropertiesStorage(), properties);
 }
 
+size_t Operation::getAllocationSize() {
+  size_t byteSize =
+      totalSizeToAlloc<detail::OperandStorage, detail::OpProperties,
+                       BlockOperand, Region, OpOperand>(
+          hasOperandStorage ? 1 : 0, getPropertiesStorageSize(),
+          getNumSuccessors(), getNumRegions(), getNumOperands());
+  return byteSize + llvm::alignTo(prefixAllocSize(), alignof(Operation));
+}
+
 // Operations are deleted through the destroy() member because they are
 // allocated via malloc.
 Operation::~Operation() {
@@ -888,8 +888,10 @@ OperationFingerPrint::OperationFingerPrint(Operation *topOp) {
     for (Region &region : op->getRegions()) {
       for (Block &block : region) {
         addDataToHash(hasher, &block);
-        for (BlockArgument arg : block.getArguments())
+        for (BlockArgument arg : block.getArguments()) {
           addDataToHash(hasher, arg);
+          addDataToHash(hasher, arg.getType());
+        }
       }
     }
     //   - Location
@@ -61,7 +61,15 @@ static LogicalResult loadSourceFileBuffer(llvm::StringRef filename,
     return emitError(mlir::UnknownLoc::get(ctx),
                      "only main buffer parsed at the moment");
   }
-  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
+  // Bytecode doesn't need a null terminator, and requiring one prevents the
+  // file from being memory mapped when its size is a multiple of the page
+  // size. Try without it first so that large bytecode files are always mapped,
+  // which lets the bytecode reader reference resource blobs in place instead
+  // of copying them. Textual files are reopened with the terminator.
+  auto fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(
+      filename, /*IsText=*/false, /*RequiresNullTerminator=*/filename == "-");
+  if (fileOrErr && filename != "-" && !isBytecode(**fileOrErr))
+    fileOrErr = llvm::MemoryBuffer::getFileOrSTDIN(filename);
   if (std::error_code error = fileOrErr.getError())
     return emitError(mlir::UnknownLoc::get(ctx),
                      "could not open input file " + filename);
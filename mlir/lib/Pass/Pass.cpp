@@ -430,6 +430,7 @@ LogicalResult OpPassManager::initialize(MLIRContext *context,
 
 LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
                                      AnalysisManager am, bool verifyPasses,
+                                     bool skipVerifierIfUnchanged,
                                      unsigned parentInitGeneration) {
   std::optional<RegisteredOperationName> opInfo = op->getRegisteredInfo();
   if (!opInfo)
@@ -465,9 +466,9 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
     if (failed(pipeline.initialize(root->getContext(), parentInitGeneration)))
       return failure();
     AnalysisManager nestedAm = root == op ? am : am.nest(root);
-    return OpToOpPassAdaptor::runPipeline(pipeline, root, nestedAm,
-                                          verifyPasses, parentInitGeneration,
-                                          pi, &parentInfo);
+    return OpToOpPassAdaptor::runPipeline(
+        pipeline, root, nestedAm, verifyPasses, skipVerifierIfUnchanged,
+        parentInitGeneration, pi, &parentInfo);
   };
   pass->passState.emplace(op, am, dynamicPipelineCallback);
 
@@ -475,12 +476,24 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
   if (pi)
     pi->runBeforePass(pass, op);
 
+  // If the pass is an adaptor pass, we don't run the verifier recursively
+  // because the nested operations should have already been verified after
+  // nested passes had run. Otherwise, if requested, record a fingerprint of the
+  // IR so that the verifier can be skipped when the pass didn't change
+  // anything.
+  bool runVerifierRecursively = !isa<OpToOpPassAdaptor>(pass);
+  std::optional<OperationFingerPrint> fingerPrintBeforePass;
+#ifndef EXPENSIVE_CHECKS
+  if (verifyPasses && skipVerifierIfUnchanged && runVerifierRecursively)
+    fingerPrintBeforePass.emplace(op);
+#endif
+
   bool passFailed = false;
   op->getContext()->executeAction<PassExecutionAction>(
       [&]() {
         // Invoke the virtual runOnOperation method.
         if (auto *adaptor = dyn_cast<OpToOpPassAdaptor>(pass))
-          adaptor->runOnOperation(verifyPasses);
+          adaptor->runOnOperation(verifyPasses, skipVerifierIfUnchanged);
         else
           pass->runOnOperation();
         passFailed = pass->passState->irAndPassFailed.getInt();
@@ -495,20 +508,19 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
   if (!passFailed && verifyPasses) {
     bool runVerifierNow = true;
 
-    // If the pass is an adaptor pass, we don't run the verifier recursively
-    // because the nested operations should have already been verified after
-    // nested passes had run.
-    bool runVerifierRecursively = !isa<OpToOpPassAdaptor>(pass);
-
     // Reduce compile time by avoiding running the verifier if the pass didn't
     // change the IR since the last time the verifier was run:
     //
     //  1) If the pass said that it preserved all analyses then it can't have
     //     permuted the IR.
+    //  2) If the fingerprint of the IR is the same as before the pass, the
+    //     pass didn't modify it.
     //
     // We run these checks in EXPENSIVE_CHECKS mode out of caution.
 #ifndef EXPENSIVE_CHECKS
-    runVerifierNow = !pass->passState->preservedAnalyses.isAll();
+    runVerifierNow = !pass->passState->preservedAnalyses.isAll() &&
+                     (!fingerPrintBeforePass ||
+                      *fingerPrintBeforePass != OperationFingerPrint(op));
 #endif
     if (runVerifierNow)
       passFailed = failed(verify(op, runVerifierRecursively));
@@ -529,7 +541,8 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
 /// Run the given operation and analysis manager on a provided op pass manager.
 LogicalResult OpToOpPassAdaptor::runPipeline(
     OpPassManager &pm, Operation *op, AnalysisManager am, bool verifyPasses,
-    unsigned parentInitGeneration, PassInstrumentor *instrumentor,
+    bool skipVerifierIfUnchanged, unsigned parentInitGeneration,
+    PassInstrumentor *instrumentor,
     const PassInstrumentation::PipelineParentInfo *parentInfo) {
   assert((!instrumentor || parentInfo) &&
          "expected parent info if instrumentor is provided");
@@ -548,7 +561,8 @@ LogicalResult OpToOpPassAdaptor::runPipeline(
   }
 
   for (Pass &pass : pm.getPasses())
-    if (failed(run(&pass, op, am, verifyPasses, parentInitGeneration)))
+    if (failed(run(&pass, op, am, verifyPasses, skipVerifierIfUnchanged,
+                   parentInitGeneration)))
       return failure();
 
   if (instrumentor) {
@@ -667,15 +681,17 @@ void OpToOpPassAdaptor::runOnOperation() {
 }
 
 /// Run the held pipeline over all nested operations.
-void OpToOpPassAdaptor::runOnOperation(bool verifyPasses) {
+void OpToOpPassAdaptor::runOnOperation(bool verifyPasses,
+                                       bool skipVerifierIfUnchanged) {
   if (getContext().isMultithreadingEnabled())
-    runOnOperationAsyncImpl(verifyPasses);
+    runOnOperationAsyncImpl(verifyPasses, skipVerifierIfUnchanged);
   else
-    runOnOperationImpl(verifyPasses);
+    runOnOperationImpl(verifyPasses, skipVerifierIfUnchanged);
 }
 
 /// Run this pass adaptor synchronously.
-void OpToOpPassAdaptor::runOnOperationImpl(bool verifyPasses) {
+void OpToOpPassAdaptor::runOnOperationImpl(bool verifyPasses,
+                                           bool skipVerifierIfUnchanged) {
   auto am = getAnalysisManager();
   PassInstrumentation::PipelineParentInfo parentInfo = {llvm::get_threadid(),
                                                         this};
@@ -690,7 +706,8 @@ void OpToOpPassAdaptor::runOnOperationImpl(bool verifyPasses) {
         // Run the held pipeline over the current operation.
         unsigned initGeneration = mgr->impl->initializationGeneration;
         if (failed(runPipeline(*mgr, &op, am.nest(&op), verifyPasses,
-                               initGeneration, instrumentor, &parentInfo)))
+                               skipVerifierIfUnchanged, initGeneration,
+                               instrumentor, &parentInfo)))
           return signalPassFailure();
       }
     }
@@ -707,7 +724,8 @@ static bool hasSizeMismatch(ArrayRef<OpPassManager> lhs,
 }
 
 /// Run this pass adaptor synchronously.
-void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
+void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses,
+                                                bool skipVerifierIfUnchanged) {
   AnalysisManager am = getAnalysisManager();
   MLIRContext *context = &getContext();
 
@@ -769,7 +787,7 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
     // Get the pass manager for this operation and execute it.
     OpPassManager &pm = asyncExecutors[pmIndex][opInfo.passManagerIdx];
     LogicalResult pipelineResult = runPipeline(
-        pm, opInfo.op, opInfo.am, verifyPasses,
+        pm, opInfo.op, opInfo.am, verifyPasses, skipVerifierIfUnchanged,
         pm.impl->initializationGeneration, instrumentor, &parentInfo);
 
     // Reset the active bit for this pass manager.
@@ -789,17 +807,23 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
 PassManager::PassManager(MLIRContext *ctx, StringRef operationName,
                          Nesting nesting)
     : OpPassManager(operationName, nesting), context(ctx), passTiming(false),
-      verifyPasses(true) {}
+      passTimingPerOperation(false), verifyPasses(true),
+      skipVerifierIfUnchanged(false) {}
 
 PassManager::PassManager(OperationName operationName, Nesting nesting)
     : OpPassManager(operationName, nesting),
       context(operationName.getContext()), passTiming(false),
-      verifyPasses(true) {}
+      passTimingPerOperation(false), verifyPasses(true),
+      skipVerifierIfUnchanged(false) {}
 
 PassManager::~PassManager() = default;
 
 void PassManager::enableVerifier(bool enabled) { verifyPasses = enabled; }
 
+void PassManager::enableVerifierSkipIfUnchanged(bool enabled) {
+  skipVerifierIfUnchanged = enabled;
+}
+
 /// Run the passes within this manager on the provided operation.
 LogicalResult PassManager::run(Operation *op) {
   MLIRContext *context = getContext();
@@ -858,6 +882,7 @@ void PassManager::addInstrumentation(std::unique_ptr<PassInstrumentation> pi) {
 
 LogicalResult PassManager::runPasses(Operation *op, AnalysisManager am) {
   return OpToOpPassAdaptor::runPipeline(*this, op, am, verifyPasses,
+                                        skipVerifierIfUnchanged,
                                         impl->initializationGeneration);
 }
 
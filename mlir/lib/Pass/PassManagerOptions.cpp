@@ -78,6 +78,24 @@ struct PassManagerOptions {
               "display the results in a merged list sorted by pass name"),
           clEnumValN(PassDisplayMode::Pipeline, "pipeline",
                      "display the results with a nested pipeline view"))};
+
+  //===--------------------------------------------------------------------===//
+  // Pass Timing
+  //===--------------------------------------------------------------------===//
+  llvm::cl::opt<bool> passTimingPerOperation{
+      "mlir-timing-per-op",
+      llvm::cl::desc("Report the time of each pass for every operation it "
+                     "runs on, when timing is enabled"),
+      llvm::cl::init(false)};
+
+  //===--------------------------------------------------------------------===//
+  // Verification
+  //===--------------------------------------------------------------------===//
+  llvm::cl::opt<bool> skipVerifierIfUnchanged{
+      "mlir-skip-verifier-if-unchanged",
+      llvm::cl::desc("Fingerprint the IR before each pass, and skip the "
+                     "verifier after the pass if the fingerprint is unchanged"),
+      llvm::cl::init(false)};
 };
 } // namespace
 
@@ -143,6 +161,14 @@ LogicalResult mlir::applyPassManagerCLOptions(PassManager &pm) {
   if (options->passStatistics)
     pm.enableStatistics(options->passStatisticsDisplayMode);
 
+  // Report pass timing per operation once timing gets enabled.
+  if (options->passTimingPerOperation)
+    pm.enableTimingPerOperation();
+
+  // Skip the verifier after passes that didn't change the IR.
+  if (options->skipVerifierIfUnchanged)
+    pm.enableVerifierSkipIfUnchanged();
+
   if (options->printModuleScope && pm.getContext()->isMultithreadingEnabled()) {
     emitError(UnknownLoc::get(pm.getContext()))
         << "IR print for module scope can't be setup on a pass-manager "
@@ -7,6 +7,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "PassDetail.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/SymbolTable.h"
 #include "mlir/Pass/PassManager.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Threading.h"
@@ -23,11 +25,12 @@ using namespace mlir::detail;
 
 namespace {
 struct PassTiming : public PassInstrumentation {
-  PassTiming(TimingScope &timingScope) : rootScope(timingScope) {}
-  PassTiming(std::unique_ptr<TimingManager> tm)
+  PassTiming(TimingScope &timingScope, bool perOperation)
+      : rootScope(timingScope), perOperation(perOperation) {}
+  PassTiming(std::unique_ptr<TimingManager> tm, bool perOperation)
       : ownedTimingManager(std::move(tm)),
         ownedTimingScope(ownedTimingManager->getRootScope()),
-        rootScope(ownedTimingScope) {}
+        rootScope(ownedTimingScope), perOperation(perOperation) {}
 
   /// If a pass can spawn additional work on other threads, it records the
   /// index to its currently active timer here. Passes that run on a
@@ -49,6 +52,9 @@ struct PassTiming : public PassInstrumentation {
   /// The root timing scope into which timing is reported.
   TimingScope &rootScope;
 
+  /// Whether the time of each pass is also reported per operation.
+  bool perOperation;
+
   //===--------------------------------------------------------------------===//
   // Pipeline
   //===--------------------------------------------------------------------===//
@@ -86,7 +92,7 @@ struct PassTiming : public PassInstrumentation {
   // Pass
   //===--------------------------------------------------------------------===//
 
-  void runBeforePass(Pass *pass, Operation *) override {
+  void runBeforePass(Pass *pass, Operation *op) override {
     auto tid = llvm::get_threadid();
     auto &activeTimers = activeThreadTimers[tid];
     auto &parentScope = activeTimers.empty() ? rootScope : activeTimers.back();
@@ -103,16 +109,35 @@ struct PassTiming : public PassInstrumentation {
       activeTimers.push_back(
           parentScope.nest(pass->getThreadingSiblingOrThis(),
                            [pass]() { return std::string(pass->getName()); }));
+      if (perOperation)
+        activeTimers.push_back(nestOperation(activeTimers.back(), op));
     }
   }
 
+  /// Nest a timer for the given operation into `scope`.
+  TimingScope nestOperation(TimingScope &scope, Operation *op) {
+    if (auto symName =
+            op->getAttrOfType<StringAttr>(SymbolTable::getSymbolAttrName()))
+      return scope.nest(symName.getAsOpaquePointer(),
+                        [symName] { return ("@" + symName.getValue()).str(); });
+    OperationName name = op->getName();
+    return scope.nest(name.getAsOpaquePointer(), [name] {
+      return ("'" + name.getStringRef() + "'").str();
+    });
+  }
+
   void runAfterPass(Pass *pass, Operation *) override {
     auto tid = llvm::get_threadid();
-    if (isa<OpToOpPassAdaptor>(pass))
+    bool isAdaptor = isa<OpToOpPassAdaptor>(pass);
+    if (isAdaptor)
       parentTimerIndices.erase({tid, pass});
     auto &activeTimers = activeThreadTimers[tid];
     assert(!activeTimers.empty() && "expected active timer");
     activeTimers.pop_back();
+    if (perOperation && !isAdaptor) {
+      assert(!activeTimers.empty() && "expected active pass timer");
+      activeTimers.pop_back();
+    }
   }
 
   void runAfterPassFailed(Pass *pass, Operation *op) override {
@@ -148,7 +173,8 @@ struct PassTiming : public PassInstrumentation {
 void PassManager::enableTiming(TimingScope &timingScope) {
   if (!timingScope)
     return;
-  addInstrumentation(std::make_unique<PassTiming>(timingScope));
+  addInstrumentation(
+      std::make_unique<PassTiming>(timingScope, passTimingPerOperation));
 }
 
 /// Add an instrumentation to time the execution of passes and the computation
@@ -156,7 +182,8 @@ void PassManager::enableTiming(TimingScope &timingScope) {
 void PassManager::enableTiming(std::unique_ptr<TimingManager> tm) {
   if (!tm->getRootTimer())
     return; // no need to keep the timing manager around if it's disabled
-  addInstrumentation(std::make_unique<PassTiming>(std::move(tm)));
+  addInstrumentation(
+      std::make_unique<PassTiming>(std::move(tm), passTimingPerOperation));
 }
 
 /// Add an instrumentation to time the execution of passes and the computation
@@ -1051,6 +1051,15 @@ PDLByteCode::PDLByteCode(
                       maxLoopLevel, constraintFns, rewriteFns, configMap);
   generator.generate(module);
 
+  // Collect the root kinds of the patterns, so that the matcher can be skipped
+  // for operations that no pattern is rooted on.
+  for (const PDLByteCodePattern &pattern : patterns) {
+    if (std::optional<OperationName> rootKind = pattern.getRootKind())
+      rootKinds.insert(*rootKind);
+    else
+      hasMatchAnyOpPattern = true;
+  }
+
   // Initialize the external functions.
   for (auto &it : constraintFns)
     constraintFunctions.push_back(std::move(it.second));
@@ -2266,6 +2275,10 @@ ByteCodeExecutor::execute(PatternRewriter &rewriter,
 void PDLByteCode::match(Operation *op, PatternRewriter &rewriter,
                         SmallVectorImpl<MatchResult> &matches,
                         PDLByteCodeMutableState &state) const {
+  // Avoid running the matcher if no pattern can be rooted on this operation.
+  if (!hasMatchAnyOpPattern && !rootKinds.contains(op->getName()))
+    return;
+
   // The first memory slot is always the root operation.
   state.memory[0] = op;
 
@@ -15,6 +15,7 @@
 #define MLIR_REWRITE_BYTECODE_H_
 
 #include "mlir/IR/PatternMatch.h"
+#include "llvm/ADT/DenseSet.h"
 
 namespace mlir {
 namespace pdl_interp {
@@ -219,6 +220,11 @@ private:
 
   /// The maximum number of nested loops.
   ByteCodeField maxLoopLevel = 0;
+
+  /// The root operation kinds of the patterns. Unless a pattern may match any
+  /// operation, the matcher is only run on operations of these kinds.
+  DenseSet<OperationName> rootKinds;
+  bool hasMatchAnyOpPattern = false;
 };
 
 } // namespace detail
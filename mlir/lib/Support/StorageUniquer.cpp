@@ -12,6 +12,8 @@
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
+#include <algorithm>
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -113,7 +115,7 @@ public:
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = getDefaultNumShards())
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
@@ -175,6 +177,18 @@ public:
   }
 
 private:
+  /// Return the default number of shards: a few per hardware thread, so that
+  /// threads creating instances of the same storage type rarely contend on a
+  /// shard lock. Shards are allocated lazily, so unused ones only cost a
+  /// pointer.
+  static size_t getDefaultNumShards() {
+    static const size_t numShards = [] {
+      unsigned numThreads = llvm::hardware_concurrency().compute_thread_count();
+      return std::clamp<size_t>(llvm::PowerOf2Ceil(4 * numThreads), 8, 256);
+    }();
+    return numShards;
+  }
+
   /// Return the shard used for the given hash value.
   Shard &getShard(unsigned hashValue) {
     // Get a shard number from the provided hashvalue.
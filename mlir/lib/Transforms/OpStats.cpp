@@ -41,16 +41,22 @@ struct PrintOpStatsPass : public impl::PrintOpStatsBase<PrintOpStatsPass> {
 
 private:
   llvm::StringMap<int64_t> opCount;
+  llvm::StringMap<int64_t> opBytes;
   raw_ostream &os;
 };
 } // namespace
 
 void PrintOpStatsPass::runOnOperation() {
   opCount.clear();
+  opBytes.clear();
 
   // Compute the operation statistics for the currently visited operation.
-  getOperation()->walk(
-      [&](Operation *op) { ++opCount[op->getName().getStringRef()]; });
+  getOperation()->walk([&](Operation *op) {
+    StringRef name = op->getName().getStringRef();
+    ++opCount[name];
+    if (printMemory)
+      opBytes[name] += op->getAllocationSize();
+  });
   if (printAsJSON) {
     printSummaryInJSON();
   } else
@@ -90,8 +96,10 @@ void PrintOpStatsPass::printSummary() {
       os << llvm::right_justify(dialectName, maxLenDialect + 2) << '.';
 
     // Left justify the operation name.
-    os << llvm::left_justify(opName, maxLenOpName) << " , " << opCount[key]
-       << '\n';
+    os << llvm::left_justify(opName, maxLenOpName) << " , " << opCount[key];
+    if (printMemory)
+      os << " , " << opBytes[key];
+    os << '\n';
   }
 }
 
@@ -103,7 +111,12 @@ void PrintOpStatsPass::printSummaryInJSON() {
 
   for (unsigned i = 0, e = sorted.size(); i != e; ++i) {
     const auto &key = sorted[i];
-    os << "  \"" << key << "\" : " << opCount[key];
+    os << "  \"" << key << "\" : ";
+    if (printMemory)
+      os << "{ \"count\" : " << opCount[key] << ", \"bytes\" : " << opBytes[key]
+         << " }";
+    else
+      os << opCount[key];
     if (i != e - 1)
       os << ",\n";
     else
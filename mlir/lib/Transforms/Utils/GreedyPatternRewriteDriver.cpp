@@ -15,6 +15,7 @@
 #include "mlir/Config/mlir-config.h"
 #include "mlir/IR/Action.h"
 #include "mlir/IR/Matchers.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
 #include "mlir/Transforms/FoldUtils.h"
@@ -439,7 +440,6 @@ bool GreedyPatternRewriteDriver::processWorklist() {
     // Try to match one of the patterns. The rewriter is automatically
     // notified of any necessary changes, so there is nothing else to do
     // here.
-#ifndef NDEBUG
     auto canApply = [&](const Pattern &pattern) {
       LLVM_DEBUG({
         logger.getOStream() << "\n";
@@ -449,19 +449,26 @@ bool GreedyPatternRewriteDriver::processWorklist() {
         logger.getOStream() << ")' {\n";
         logger.indent();
       });
+      if (config.listener)
+        config.listener->notifyPatternBegin(pattern, op);
       return true;
     };
     auto onFailure = [&](const Pattern &pattern) {
       LLVM_DEBUG(logResult("failure", "pattern failed to match"));
+      if (config.listener)
+        config.listener->notifyPatternEnd(pattern, failure());
     };
     auto onSuccess = [&](const Pattern &pattern) {
       LLVM_DEBUG(logResult("success", "pattern applied successfully"));
+      if (config.listener)
+        config.listener->notifyPatternEnd(pattern, success());
       return success();
     };
+#ifndef NDEBUG
+    const bool needsCallbacks = true;
 #else
-    function_ref<bool(const Pattern &)> canApply = {};
-    function_ref<void(const Pattern &)> onFailure = {};
-    function_ref<LogicalResult(const Pattern &)> onSuccess = {};
+    // Without debug logging, the callbacks only serve the listener.
+    const bool needsCallbacks = config.listener != nullptr;
 #endif
 
 #if MLIR_ENABLE_EXPENSIVE_PATTERN_API_CHECKS
@@ -472,7 +479,9 @@ bool GreedyPatternRewriteDriver::processWorklist() {
 #endif // MLIR_ENABLE_EXPENSIVE_PATTERN_API_CHECKS
 
     LogicalResult matchResult =
-        matcher.matchAndRewrite(op, *this, canApply, onFailure, onSuccess);
+        needsCallbacks
+            ? matcher.matchAndRewrite(op, *this, canApply, onFailure, onSuccess)
+            : matcher.matchAndRewrite(op, *this);
 
     if (succeeded(matchResult)) {
       LLVM_DEBUG(logResultWithLine("success", "pattern matched"));
@@ -720,13 +729,34 @@ mlir::applyPatternsAndFoldGreedily(Region &region,
   assert(region.getParentOp()->hasTrait<OpTrait::IsIsolatedFromAbove>() &&
          "patterns can only be applied to operations IsolatedFromAbove");
 
+  // Simplify the isolated ops nested in the region in parallel first. The
+  // region-wide driver below then has little left to do in their bodies.
+  MLIRContext *ctx = region.getContext();
+  if (config.parallelizeIsolatedOps && !config.listener && !config.scope &&
+      config.strictMode == GreedyRewriteStrictness::AnyOp &&
+      ctx->isMultithreadingEnabled()) {
+    SmallVector<Operation *> isolatedOps;
+    for (Block &block : region)
+      for (Operation &op : block)
+        if (op.getNumRegions() != 0 &&
+            op.hasTrait<OpTrait::IsIsolatedFromAbove>())
+          isolatedOps.push_back(&op);
+
+    if (isolatedOps.size() > 1) {
+      GreedyRewriteConfig nestedConfig = config;
+      nestedConfig.parallelizeIsolatedOps = false;
+      parallelForEach(ctx, isolatedOps, [&](Operation *op) {
+        (void)applyPatternsAndFoldGreedily(op, patterns, nestedConfig);
+      });
+    }
+  }
+
   // Set scope if not specified.
   if (!config.scope)
     config.scope = &region;
 
   // Start the pattern driver.
-  RegionPatternRewriteDriver driver(region.getContext(), patterns, config,
-                                    region);
+  RegionPatternRewriteDriver driver(ctx, patterns, config, region);
   LogicalResult converged = std::move(driver).simplify();
   LLVM_DEBUG(if (failed(converged)) {
     llvm::dbgs() << "The pattern rewrite did not converge after scanning "
@@ -863,3 +893,34 @@ LogicalResult mlir::applyOpPatternsAndFold(
   });
   return converged;
 }
+
+//===----------------------------------------------------------------------===//
+// PatternStatisticsListener
+//===----------------------------------------------------------------------===//
+
+void PatternStatisticsListener::notifyPatternEnd(const Pattern &pattern,
+                                                 LogicalResult status) {
+  Counts &patternCounts = counts[&pattern];
+  if (succeeded(status))
+    ++patternCounts.numSuccesses;
+  else
+    ++patternCounts.numFailures;
+}
+
+void PatternStatisticsListener::print(raw_ostream &os) const {
+  SmallVector<std::pair<const Pattern *, Counts>> sorted(counts.begin(),
+                                                         counts.end());
+  llvm::stable_sort(sorted, [](const auto &lhs, const auto &rhs) {
+    return lhs.second.numFailures > rhs.second.numFailures;
+  });
+  for (const auto &[pattern, patternCounts] : sorted) {
+    if (!pattern->getDebugName().empty())
+      os << pattern->getDebugName();
+    else if (std::optional<OperationName> rootKind = pattern->getRootKind())
+      os << "<unnamed pattern on '" << *rootKind << "'>";
+    else
+      os << "<unnamed pattern>";
+    os << ": " << patternCounts.numSuccesses << " successes, "
+       << patternCounts.numFailures << " failures\n";
+  }
+}
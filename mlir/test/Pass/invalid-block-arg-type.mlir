@@ -0,0 +1,11 @@
+// RUN: mlir-opt %s -pass-pipeline='builtin.module(func.func(test-pass-invalid-block-arg-type))' -verify-diagnostics
+// RUN: mlir-opt %s -pass-pipeline='builtin.module(func.func(test-pass-invalid-block-arg-type))' -verify-diagnostics -mlir-skip-verifier-if-unchanged
+
+// The pass only changes the type of a block argument. The verifier must still
+// run after it and report the mismatch with the function signature, also when
+// it is skipped for passes that leave the fingerprint of the IR unchanged.
+
+// expected-error@below {{type of entry block argument #0(i64) must match the type of the corresponding argument in function signature(i32)}}
+func.func @foo(%arg0: i32) {
+  return
+}
@@ -0,0 +1,37 @@
+// RUN: mlir-opt %s -mlir-disable-threading=true -verify-each=false -pass-pipeline='builtin.module(func.func(cse,canonicalize))' -mlir-timing -mlir-timing-display=tree -mlir-timing-per-op 2>&1 | FileCheck -check-prefix=PEROP %s
+// RUN: mlir-opt %s -mlir-disable-threading=true -verify-each=false -pass-pipeline='builtin.module(func.func(cse,canonicalize))' -mlir-timing -mlir-timing-display=tree 2>&1 | FileCheck -check-prefix=PIPELINE %s
+
+// PEROP: Execution time report
+// PEROP: Total Execution Time:
+// PEROP: Name
+// PEROP-NEXT: Parser
+// PEROP-NEXT: 'func.func' Pipeline
+// PEROP-NEXT:   CSE
+// PEROP-NEXT:     @foo
+// PEROP-NEXT:       (A) DominanceInfo
+// PEROP-NEXT:     @bar
+// PEROP-NEXT:       (A) DominanceInfo
+// PEROP-NEXT:   Canonicalizer
+// PEROP-NEXT:     @foo
+// PEROP-NEXT:     @bar
+// PEROP-NEXT: Output
+// PEROP-NEXT: Rest
+// PEROP-NEXT: Total
+
+// PIPELINE: Name
+// PIPELINE-NEXT: Parser
+// PIPELINE-NEXT: 'func.func' Pipeline
+// PIPELINE-NEXT:   CSE
+// PIPELINE-NEXT:     (A) DominanceInfo
+// PIPELINE-NEXT:   Canonicalizer
+// PIPELINE-NEXT: Output
+// PIPELINE-NEXT: Rest
+// PIPELINE-NEXT: Total
+
+func.func @foo() {
+  return
+}
+
+func.func @bar() {
+  return
+}
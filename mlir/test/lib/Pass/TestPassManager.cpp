@@ -162,6 +162,31 @@ struct TestInvalidParentPass
   }
 };
 
+/// A test pass that changes the type of the first entry block argument of a
+/// function without updating its signature, leaving the function invalid.
+struct TestInvalidBlockArgTypePass
+    : public PassWrapper<TestInvalidBlockArgTypePass,
+                         InterfacePass<FunctionOpInterface>> {
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(TestInvalidBlockArgTypePass)
+
+  StringRef getArgument() const final {
+    return "test-pass-invalid-block-arg-type";
+  }
+  StringRef getDescription() const final {
+    return "Test a pass in the pass manager that only changes the type of a "
+           "block argument";
+  }
+  void runOnOperation() final {
+    FunctionOpInterface op = getOperation();
+    if (op.isExternal() || op.getFunctionBody().getNumArguments() == 0)
+      return;
+    BlockArgument arg = op.getFunctionBody().getArgument(0);
+    Builder b(op.getContext());
+    arg.setType(arg.getType() == b.getI64Type() ? b.getI32Type()
+                                                : b.getI64Type());
+  }
+};
+
 /// A test pass that contains a statistic.
 struct TestStatisticPass
     : public PassWrapper<TestStatisticPass, OperationPass<>> {
@@ -219,6 +244,7 @@ void registerPassManagerTestPass() {
   PassRegistration<TestFailurePass>();
   PassRegistration<TestInvalidIRPass>();
   PassRegistration<TestInvalidParentPass>();
+  PassRegistration<TestInvalidBlockArgTypePass>();
 
   PassRegistration<TestStatisticPass>();
 
@@ -26,6 +26,7 @@
 #include "mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Export.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -88,6 +89,75 @@ TEST(MLIRExecutionEngine, SKIP_WITHOUT_JIT(AddInteger)) {
   ASSERT_EQ(result, 42 + 42);
 }
 
+TEST(MLIRExecutionEngine, SKIP_WITHOUT_JIT(PersistentObjectCache)) {
+  std::string moduleStr = R"mlir(
+  func.func @foo(%arg0 : i32) -> i32 attributes { llvm.emit_c_interface } {
+    %res = arith.addi %arg0, %arg0 : i32
+    return %res : i32
+  }
+  )mlir";
+  DialectRegistry registry;
+  registerAllDialects(registry);
+  registerBuiltinDialectTranslation(registry);
+  registerLLVMDialectTranslation(registry);
+  MLIRContext context(registry);
+  OwningOpRef<ModuleOp> module =
+      parseSourceString<ModuleOp>(moduleStr, &context);
+  ASSERT_TRUE(!!module);
+  ASSERT_TRUE(succeeded(lowerToLLVMDialect(*module)));
+
+  SmallString<128> cacheDir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("mlir-object-cache", cacheDir));
+
+  int transformerRuns = 0;
+  auto transformer = [&](llvm::Module *) {
+    ++transformerRuns;
+    return llvm::Error::success();
+  };
+  // Creates an engine, checks that it computes the right result and returns
+  // whether the transformer ran.
+  auto run = [&](StringRef transformerKey) {
+    int before = transformerRuns;
+    ExecutionEngineOptions options;
+    options.transformer = transformer;
+    options.objectCacheDirectory = cacheDir;
+    options.objectCacheTransformerKey = transformerKey;
+    auto jitOrError = ExecutionEngine::create(*module, options);
+    EXPECT_TRUE(!!jitOrError);
+    if (!jitOrError) {
+      llvm::consumeError(jitOrError.takeError());
+      return false;
+    }
+    int result = 0;
+    llvm::Error error =
+        (*jitOrError)->invoke("foo", 21, ExecutionEngine::Result<int>(result));
+    EXPECT_TRUE(!error);
+    llvm::consumeError(std::move(error));
+    EXPECT_EQ(result, 42);
+    return transformerRuns != before;
+  };
+
+  // The first engine compiles the module, the second reuses the object.
+  EXPECT_TRUE(run("O0"));
+  EXPECT_FALSE(run("O0"));
+  // A different transformer must not reuse the object of the first one.
+  EXPECT_TRUE(run("O3"));
+  EXPECT_FALSE(run("O3"));
+
+  // An object that is gone from the cache is compiled and transformed again.
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(cacheDir, ec), end;
+       it != end && !ec; it.increment(ec))
+    ASSERT_FALSE(llvm::sys::fs::remove(it->path()));
+  EXPECT_TRUE(run("O0"));
+
+  for (llvm::sys::fs::directory_iterator it(cacheDir, ec), end;
+       it != end && !ec; it.increment(ec))
+    llvm::sys::fs::remove(it->path());
+  llvm::sys::fs::remove(cacheDir);
+}
+
 TEST(MLIRExecutionEngine, SKIP_WITHOUT_JIT(SubtractFloat)) {
   std::string moduleStr = R"mlir(
   func.func @foo(%arg0 : f32, %arg1 : f32) -> f32 attributes { llvm.emit_c_interface } {
@@ -290,4 +290,24 @@ TEST(OperandStorageTest, PopulateDefaultAttrs) {
 
   op->destroy();
 }
+TEST(OperationTest, AllocationSize) {
+  MLIRContext context;
+  Builder builder(&context);
+
+  Operation *useOp =
+      createOp(&context, /*operands=*/std::nullopt, builder.getIntegerType(16));
+  Value operand = useOp->getResult(0);
+  Operation *user = createOp(&context, {operand, operand},
+                             builder.getIntegerType(16), /*numRegions=*/1);
+
+  // Each operand, result and region adds to the allocation.
+  EXPECT_GE(useOp->getAllocationSize(), sizeof(Operation));
+  EXPECT_GE(user->getAllocationSize(), useOp->getAllocationSize() +
+                                           2 * sizeof(OpOperand) +
+                                           sizeof(Region));
+
+  user->destroy();
+  useOp->destroy();
+}
+
 } // namespace
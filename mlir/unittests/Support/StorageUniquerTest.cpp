@@ -7,7 +7,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir/Support/StorageUniquer.h"
+#include "llvm/Config/llvm-config.h"
 #include "gmock/gmock.h"
+#include <thread>
 
 using namespace mlir;
 
@@ -58,3 +60,36 @@ TEST(StorageUniquerTest, NonTrivialDestructor) {
 
   EXPECT_TRUE(wasDestructed);
 }
+
+#if LLVM_ENABLE_THREADS != 0
+TEST(StorageUniquerTest, ConcurrentUniquing) {
+  struct IntStorage : public SimpleStorage<IntStorage, int> {
+    using Base::Base;
+  };
+
+  StorageUniquer uniquer;
+  uniquer.registerParametricStorageType<IntStorage>();
+
+  // Create the same set of instances from several threads at once, and check
+  // that every thread observed the same instance for each key.
+  constexpr int numThreads = 8, numKeys = 2048;
+  std::vector<std::vector<IntStorage *>> results(numThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < numKeys; ++i)
+        results[t].push_back(IntStorage::get(uniquer, (i + t * 97) % numKeys));
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (int t = 0; t < numThreads; ++t) {
+    for (int i = 0; i < numKeys; ++i) {
+      IntStorage *storage = results[t][i];
+      EXPECT_EQ(std::get<0>(storage->key), (i + t * 97) % numKeys);
+      EXPECT_EQ(storage, results[0][(i + t * 97) % numKeys]);
+    }
+  }
+}
+#endif
@@ -83,4 +83,65 @@ TEST(CanonicalizerTest, TestDisablePatterns) {
   EXPECT_FALSE(module->lookupSymbol("A"));
 }
 
+TEST(CanonicalizerTest, TestPatternStatistics) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+  RewritePatternSet patterns(&context);
+  patterns.add<DisabledPattern, EnabledPattern>(&context);
+  FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+
+  const char *const code = R"mlir(
+    %0:2 = "test.foo"() {sym_name = "A"} : () -> (i32, i32)
+    %1 = "test.foo"() {sym_name = "B"} : () -> (f32)
+  )mlir";
+
+  OwningOpRef<ModuleOp> module = parseSourceString<ModuleOp>(code, &context);
+  PatternStatisticsListener statistics;
+  GreedyRewriteConfig config;
+  config.listener = &statistics;
+  ASSERT_TRUE(succeeded(
+      applyPatternsAndFoldGreedily(*module, frozenPatterns, config)));
+  EXPECT_FALSE(module->lookupSymbol("A"));
+  EXPECT_FALSE(module->lookupSymbol("B"));
+
+  // Each op is erased by exactly one of the patterns. Both patterns have the
+  // same benefit, so whichever is tried first fails on one of the two ops.
+  int64_t numFailures = 0;
+  ASSERT_EQ(statistics.getCounts().size(), 2u);
+  for (const auto &[pattern, counts] : statistics.getCounts()) {
+    EXPECT_EQ(counts.numSuccesses, 1);
+    numFailures += counts.numFailures;
+  }
+  EXPECT_EQ(numFailures, 1);
+}
+
+TEST(CanonicalizerTest, TestParallelIsolatedOps) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+  RewritePatternSet patterns(&context);
+  patterns.add<DisabledPattern, EnabledPattern>(&context);
+  FrozenRewritePatternSet frozenPatterns(std::move(patterns));
+
+  const char *const code = R"mlir(
+    module @A {
+      %0 = "test.foo"() : () -> (f32)
+      %1:2 = "test.foo"() : () -> (i32, i32)
+    }
+    module @B {
+      %0 = "test.foo"() : () -> (f32)
+    }
+  )mlir";
+
+  OwningOpRef<ModuleOp> module = parseSourceString<ModuleOp>(code, &context);
+  GreedyRewriteConfig config;
+  config.parallelizeIsolatedOps = true;
+  ASSERT_TRUE(succeeded(
+      applyPatternsAndFoldGreedily(*module, frozenPatterns, config)));
+  for (StringRef name : {"A", "B"}) {
+    auto nested = module->lookupSymbol<ModuleOp>(name);
+    ASSERT_TRUE(nested);
+    EXPECT_TRUE(nested.getBody()->empty());
+  }
+}
+
 } // end anonymous namespace
@@ -1181,8 +1181,18 @@ extern void __kmp_init_target_task();
   (((blocktime) + (KMP_BLOCKTIME_MULTIPLIER / (monitor_wakeups)) - 1) /        \
    (KMP_BLOCKTIME_MULTIPLIER / (monitor_wakeups)))
 #else
+#ifdef KMP_ADJUST_BLOCKTIME
+// Like the monitor-based wait in __kmp_wait_template(), drop the default
+// blocktime to zero while oversubscribed so that waiting threads sleep
+// instead of spinning against the threads doing the work.
+#define KMP_BLOCKTIME(team, tid)                                               \
+  (get__bt_set(team, tid) ? get__blocktime(team, tid)                          \
+   : __kmp_zero_bt        ? 0                                                  \
+                          : __kmp_dflt_blocktime)
+#else
 #define KMP_BLOCKTIME(team, tid)                                               \
   (get__bt_set(team, tid) ? get__blocktime(team, tid) : __kmp_dflt_blocktime)
+#endif /* KMP_ADJUST_BLOCKTIME */
 #if KMP_OS_UNIX && (KMP_ARCH_X86 || KMP_ARCH_X86_64)
 // HW TSC is used to reduce overhead (clock tick instead of nanosecond).
 extern kmp_uint64 __kmp_ticks_per_msec;
@@ -2324,6 +2334,7 @@ typedef enum kmp_tasking_mode {
 extern kmp_tasking_mode_t
     __kmp_tasking_mode; /* determines how/when to execute tasks */
 extern int __kmp_task_stealing_constraint;
+extern int __kmp_task_steal_local_tries;
 extern int __kmp_enable_task_throttling;
 extern kmp_int32 __kmp_default_device; // Set via OMP_DEFAULT_DEVICE if
 // specified, defaults to 0 otherwise
@@ -348,6 +348,7 @@ omp_memspace_handle_t const llvm_omp_target_device_mem_space =
 KMP_BUILD_ASSERT(sizeof(kmp_tasking_flags_t) == 4);
 
 int __kmp_task_stealing_constraint = 1; /* Constrain task stealing by default */
+int __kmp_task_steal_local_tries = 2; /* Redraws to find a same-domain victim */
 int __kmp_enable_task_throttling = 1;
 
 #ifdef DEBUG_SUSPEND
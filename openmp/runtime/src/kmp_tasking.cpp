@@ -3200,6 +3200,25 @@ static kmp_task_t *__kmp_remove_my_task(kmp_info_t *thread, kmp_int32 gtid,
   return task;
 }
 
+// __kmp_task_victim_is_remote: returns true if both threads are bound to known
+// sockets or NUMA domains and those differ. Threads without affinity, or with
+// masks spanning several domains, are never considered remote.
+static inline bool __kmp_task_victim_is_remote(kmp_info_t *thread,
+                                               kmp_info_t *victim_thr) {
+#if KMP_AFFINITY_SUPPORTED
+  const kmp_affinity_ids_t &ids = thread->th.th_topology_ids;
+  const kmp_affinity_ids_t &victim_ids = victim_thr->th.th_topology_ids;
+  static const kmp_hw_t types[] = {KMP_HW_SOCKET, KMP_HW_NUMA};
+  for (kmp_hw_t type : types) {
+    if (ids[type] < 0 || victim_ids[type] < 0)
+      continue; // unknown or spans several units
+    if (ids[type] != victim_ids[type])
+      return true;
+  }
+#endif
+  return false;
+}
+
 // __kmp_steal_task: remove a task from another thread's deque
 // Assume that calling thread has already checked existence of
 // task_team thread_data before calling this routine.
@@ -3409,6 +3428,18 @@ static inline int __kmp_execute_tasks_template(
             }
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
+            // Prefer a victim on our own socket / NUMA domain: stealing
+            // across sockets pulls the task and its data over the
+            // interconnect. Redraw a bounded number of times so that remote
+            // work is still found when nothing local is left.
+            for (int tries = __kmp_task_steal_local_tries;
+                 tries > 0 && __kmp_task_victim_is_remote(thread, other_thread);
+                 --tries) {
+              victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+              if (victim_tid >= tid)
+                ++victim_tid;
+              other_thread = threads_data[victim_tid].td.td_thr;
+            }
             // There is a slight chance that __kmp_enable_tasking() did not wake
             // up all threads waiting at the barrier.  If victim is sleeping,
             // then wake it up. Since we were going to pay the cache miss
@@ -52,6 +52,7 @@
 #include "polly/MatmulOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScheduleTreeTransform.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
@@ -172,6 +173,12 @@ static cl::opt<bool> EnableReschedule("polly-reschedule",
                                       cl::desc("Optimize SCoPs using ISL"),
                                       cl::init(true), cl::cat(PollyCategory));
 
+static cl::opt<int> OptComputeOut(
+    "polly-opt-computeout",
+    cl::desc("Bound the isl scheduler by a maximal amount of computational "
+             "steps (0 means no bound)"),
+    cl::Hidden, cl::init(2000000), cl::cat(PollyCategory));
+
 static cl::opt<bool>
     PMBasedOpts("polly-pattern-matching-based-opts",
                 cl::desc("Perform optimizations based on pattern matching"),
@@ -192,6 +199,8 @@ static cl::opt<bool> OptimizedScops(
 
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
+STATISTIC(ScopsRescheduleComputeOut,
+          "Number of scops whose rescheduling exceeded the compute budget");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
@@ -860,7 +869,19 @@ static void runIslScheduleOptimizer(
     SC = SC.set_proximity(Proximity);
     SC = SC.set_validity(Validity);
     SC = SC.set_coincidence(Validity);
-    Schedule = SC.compute_schedule();
+    {
+      // The scheduler's ILP can blow up on large SCoPs. Give up on
+      // rescheduling, and leave the SCoP untouched, once it has used its
+      // budget.
+      IslMaxOperationsGuard MaxOpGuard(Ctx, OptComputeOut);
+      Schedule = SC.compute_schedule();
+      if (MaxOpGuard.hasQuotaExceeded()) {
+        LLVM_DEBUG(dbgs() << "Schedule optimizer calculation exceeds ISL "
+                             "quota\n");
+        ScopsRescheduleComputeOut++;
+        Schedule = {};
+      }
+    }
     isl_options_set_on_error(Ctx, OnErrorStatus);
 
     ScopsRescheduled++;